@@ -35,13 +35,17 @@ layout(set=0,binding=0) readonly buffer unused_name_perframe{
 };
 
 layout(set=0,binding=1) readonly buffer unused_name_per_drawcall{
-	VulkanMeshInstance mesh_instances[m_mesh_per_drawcall_max_instance_count];
+	uint instance_indices[m_mesh_indirect_max_instance_count];
 };
 
 layout(set=0,binding=2) readonly buffer unused_name_per_drawcall_vertex_blending{
 	highp mat4 joint_matrices[m_mesh_vertex_blending_max_joint_count*m_mesh_per_drawcall_max_instance_count];
 };
 
+layout(set=0,binding=8) readonly buffer unused_name_scene_instances{
+	VulkanMeshInstance scene_instances[];
+};
+
 layout(set=1,binding=0) readonly buffer unused_name_per_mesh_joint_binding{
 	VulkanMeshVertexJointBinding indices_and_weights[];
 };
@@ -57,8 +61,9 @@ layout(location=2) out vec3 out_tangent;
 layout(location=3) out vec2 out_texcoord;
 
 void main(){
-	highp mat4 model_matrix=mesh_instances[gl_InstanceIndex].model_matrix;
-	highp float enable_vertex_blending=mesh_instances[gl_InstanceIndex].enable_vertex_blending;
+	highp uint instance_index=instance_indices[gl_InstanceIndex];
+	highp mat4 model_matrix=scene_instances[instance_index].model_matrix;
+	highp float enable_vertex_blending=scene_instances[instance_index].enable_vertex_blending;
 	highp vec3 model_position;
 	highp vec3 model_normal;
 	highp vec3 model_tangent;
@@ -39,7 +39,10 @@ highp vec3 getBaseColor(){
 }
 
 highp vec3 calculateNormal(){
-	highp vec3 tangent_normal=texture(normal_texture_sampler,in_texcoord).xyz*2.0-1.0;
+	//normal maps may be cooked to two channels, z is rebuilt from xy
+	highp vec3 tangent_normal;
+	tangent_normal.xy=texture(normal_texture_sampler,in_texcoord).xy*2.0-1.0;
+	tangent_normal.z=sqrt(max(1.0-dot(tangent_normal.xy,tangent_normal.xy),0.0));
 	
 	highp vec3 T=normalize(in_tangent.xyz);
 	highp vec3 N=normalize(in_normal);
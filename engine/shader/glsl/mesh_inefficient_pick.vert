@@ -12,15 +12,17 @@ layout(set=0,binding=0) readonly buffer unused_name_perframe{
 };
 
 layout(set=0,binding=1) readonly buffer unused_name_perdrawcall{
-	mat4 model_matrices[m_mesh_per_drawcall_max_instance_count];
-	uint node_ids[m_mesh_per_drawcall_max_instance_count];
-	float enable_vertex_blendings[m_mesh_per_drawcall_max_instance_count];
+	uint instance_indices[m_mesh_per_drawcall_max_instance_count];
 };
 
 layout(set=0,binding=2) readonly buffer unused_name_perdrawcall_vertex_blending{
 	mat4 joint_matrices[m_mesh_vertex_blending_max_joint_count*m_mesh_per_drawcall_max_instance_count];
 };
 
+layout(set=0,binding=3) readonly buffer unused_name_scene_instances{
+	VulkanMeshInstance scene_instances[];
+};
+
 layout(set=1,binding=0) readonly buffer unused_name_per_mesh_joint_binding{
 	VulkanMeshVertexJointBinding indices_and_weights[];
 };
@@ -32,8 +34,9 @@ layout(location=0) in vec3 in_position;
 layout(location=0) flat out highp uint out_nodeid;
 
 void main(){
-	highp mat4 model_matrix=model_matrices[gl_InstanceIndex];
-	highp float enable_vertex_blending=enable_vertex_blendings[gl_InstanceIndex];
+	highp uint instance_index=instance_indices[gl_InstanceIndex];
+	highp mat4 model_matrix=scene_instances[instance_index].model_matrix;
+	highp float enable_vertex_blending=scene_instances[instance_index].enable_vertex_blending;
 	highp vec3 model_position;
 
 	if(enable_vertex_blending>0.0){
@@ -65,5 +68,5 @@ void main(){
 	}
 
 	gl_Position=proj_view_matrix*model_matrix*vec4(model_position,1.0);
-	out_nodeid=node_ids[gl_InstanceIndex];
+	out_nodeid=scene_instances[instance_index].node_id;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #define m_max_point_light_count 15
 #define m_max_point_light_geom_vertices 90 // 2*3*m_max_point_light_count
 #define m_mesh_per_drawcall_max_instance_count 64
+#define m_mesh_indirect_max_instance_count 4096
 #define m_mesh_vertex_blending_max_joint_count 1024
 #define DAO_LAYOUT_MAJOR row_major
 layout(DAO_LAYOUT_MAJOR) buffer;
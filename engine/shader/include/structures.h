@@ -1,6 +1,6 @@
 struct VulkanMeshInstance {
 	highp float enable_vertex_blending;
-	highp float padding_enable_vertex_blending_1;
+	highp uint node_id;
 	highp float padding_enable_vertex_blending_2;
 	highp float padding_enable_vertex_blending_3;
 	highp mat4 model_matrix;
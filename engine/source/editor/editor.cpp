@@ -30,6 +30,8 @@ namespace Dao
 
         g_is_editor_mode = true;
         _engine_runtime = engine_runtime;
+        // editor ui is drawn inside the render tick and edits the world, keep render on the logic thread
+        _engine_runtime->setPipelinedRendering(false);
 
         EditorGlobalContextInitInfo init_info = {
             g_runtime_global_context.m_window_system.get(),
@@ -126,6 +126,8 @@
 //}
 
 #include "runtime/engine.h"
+#include "runtime/function/global/global_context.h"
+#include "runtime/function/render/window_system.h"
 #include "editor/editor.h"
 
 #include <filesystem>
@@ -143,12 +145,18 @@ int main(int argc, char** argv){
     engine->startEngine(config_file_path.generic_string());
     engine->initialize();
 
-    Dao::DaoEditor* editor = new Dao::DaoEditor();
-    editor->initialize(engine);
+    if (Dao::g_runtime_global_context.m_window_system->isHeadless()) {
+        // no window to host the editor ui, tick the runtime directly
+        engine->run();
+    }
+    else {
+        Dao::DaoEditor* editor = new Dao::DaoEditor();
+        editor->initialize(engine);
 
-    editor->run();
+        editor->run();
 
-    editor->clear();
+        editor->clear();
+    }
 
     engine->clear();
     engine->shutdownEngine();
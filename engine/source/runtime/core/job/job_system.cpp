@@ -0,0 +1,277 @@
+#include "runtime/core/job/job_system.h"
+
+#include <algorithm>
+
+namespace Dao {
+
+	namespace {
+		thread_local const JobSystem*	s_current_job_system{ nullptr };
+		thread_local uint32_t			s_current_worker_index{ 0 };
+	}
+
+	JobSystem::~JobSystem() {
+		clear();
+	}
+
+	void JobSystem::initialize(uint32_t worker_count) {
+		if (_is_running.load()) {
+			return;
+		}
+		if (worker_count == 0) {
+			uint32_t hardware_thread_count = std::thread::hardware_concurrency();
+			worker_count = hardware_thread_count > 1 ? hardware_thread_count - 1 : 1;
+		}
+
+		//half of the workers stay free for frame jobs while assets decode
+		_background_concurrency = std::max(worker_count / 2, 1u);
+		_queues.clear();
+		for (uint32_t i = 0; i < worker_count + 1; ++i) {
+			_queues.push_back(std::make_unique<WorkQueue>());
+		}
+
+		_is_running.store(true);
+		_workers.reserve(worker_count);
+		for (uint32_t i = 0; i < worker_count; ++i) {
+			_workers.emplace_back(&JobSystem::workerLoop, this, i);
+		}
+	}
+
+	void JobSystem::clear() {
+		if (!_is_running.load()) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(_sleep_mutex);
+			_is_running.store(false);
+		}
+		_sleep_condition.notify_all();
+		for (auto& worker : _workers) {
+			worker.join();
+		}
+		_workers.clear();
+
+		// finish whatever is left on the calling thread so no counter stays pending
+		uint32_t injection_index = static_cast<uint32_t>(_queues.size()) - 1;
+		while (tryExecuteOne(injection_index) || tryExecuteBackground()) {
+		}
+		_queues.clear();
+	}
+
+	void JobSystem::submit(JobFunc func, JobCounter* counter) {
+		if (counter) {
+			counter->_pending.fetch_add(1, std::memory_order_acq_rel);
+		}
+		enqueue(Job{ std::move(func), counter });
+	}
+
+	void JobSystem::submitAfter(JobCounter& dependency, JobFunc func, JobCounter* counter) {
+		if (counter) {
+			counter->_pending.fetch_add(1, std::memory_order_acq_rel);
+		}
+		{
+			std::lock_guard<std::mutex> lock(dependency._continuation_mutex);
+			if (dependency._pending.load(std::memory_order_acquire) != 0) {
+				dependency._continuations.push_back({ std::move(func), counter });
+				return;
+			}
+		}
+		enqueue(Job{ std::move(func), counter });
+	}
+
+	void JobSystem::submitBackground(JobFunc func, JobCounter* counter) {
+		if (counter) {
+			counter->_pending.fetch_add(1, std::memory_order_acq_rel);
+		}
+		Job job{ std::move(func), counter };
+		if (!_is_running.load()) {
+			execute(job);
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(_background_queue.mutex);
+			_background_queue.jobs.push_back(std::move(job));
+		}
+		_queued_background_job_count.fetch_add(1);
+		notifyWorker();
+	}
+
+	void JobSystem::wait(JobCounter& counter) {
+		uint32_t queue_index = getCurrentThreadIndex();
+		while (!counter.isDone()) {
+			if (!_is_running.load() || !tryExecuteOne(queue_index)) {
+				std::this_thread::yield();
+			}
+		}
+		// the last signaler decrements under this lock, once we own it nobody touches the counter anymore
+		std::lock_guard<std::mutex> lock(counter._continuation_mutex);
+	}
+
+	void JobSystem::parallelFor(uint32_t count, uint32_t min_batch_size, const RangeFunc& func) {
+		if (count == 0) {
+			return;
+		}
+		// a few batches per thread keeps stealing effective without drowning in tiny jobs
+		uint32_t max_batch_count = getMaxConcurrency() * 4;
+		uint32_t batch_size = std::max(min_batch_size, 1u);
+		batch_size = std::max(batch_size, (count + max_batch_count - 1) / max_batch_count);
+		uint32_t batch_count = (count + batch_size - 1) / batch_size;
+		if (batch_count == 1 || !_is_running.load()) {
+			func(0, count);
+			return;
+		}
+
+		JobCounter counter;
+		for (uint32_t batch = 1; batch < batch_count; ++batch) {
+			uint32_t begin = batch * batch_size;
+			uint32_t end = std::min(begin + batch_size, count);
+			submit([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+		func(0, std::min(batch_size, count));
+		wait(counter);
+	}
+
+	uint32_t JobSystem::getCurrentThreadIndex() const {
+		if (s_current_job_system == this) {
+			return s_current_worker_index;
+		}
+		return getWorkerCount();
+	}
+
+	void JobSystem::workerLoop(uint32_t worker_index) {
+		s_current_job_system = this;
+		s_current_worker_index = worker_index;
+
+		while (_is_running.load()) {
+			//frame jobs first, a background job is only started when nothing else is queued
+			if (tryExecuteOne(worker_index) || tryExecuteBackground()) {
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(_sleep_mutex);
+			_sleep_condition.wait(lock, [this]() {
+				return _queued_job_count.load() > 0 || canExecuteBackground() || !_is_running.load();
+			});
+		}
+
+		s_current_job_system = nullptr;
+	}
+
+	void JobSystem::enqueue(Job&& job) {
+		if (!_is_running.load()) {
+			execute(job);
+			return;
+		}
+		WorkQueue& queue = *_queues[getCurrentThreadIndex()];
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.jobs.push_back(std::move(job));
+		}
+		_queued_job_count.fetch_add(1);
+		notifyWorker();
+	}
+
+	void JobSystem::notifyWorker() {
+		{
+			// pairs with the predicate check in workerLoop, so a worker about to sleep can not miss a new job
+			std::lock_guard<std::mutex> lock(_sleep_mutex);
+		}
+		_sleep_condition.notify_one();
+	}
+
+	bool JobSystem::tryPopLocal(uint32_t queue_index, Job& out_job) {
+		WorkQueue& queue = *_queues[queue_index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty()) {
+			return false;
+		}
+		// workers run their own newest job first for cache locality, the injection queue stays fifo
+		if (queue_index < getWorkerCount()) {
+			out_job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+		}
+		else {
+			out_job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+		}
+		_queued_job_count.fetch_sub(1);
+		return true;
+	}
+
+	bool JobSystem::trySteal(uint32_t thief_index, Job& out_job) {
+		uint32_t queue_count = static_cast<uint32_t>(_queues.size());
+		for (uint32_t i = 1; i < queue_count; ++i) {
+			WorkQueue& queue = *_queues[(thief_index + i) % queue_count];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.jobs.empty()) {
+				continue;
+			}
+			out_job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			_queued_job_count.fetch_sub(1);
+			return true;
+		}
+		return false;
+	}
+
+	bool JobSystem::tryExecuteOne(uint32_t queue_index) {
+		if (_queues.empty()) {
+			return false;
+		}
+		Job job;
+		if (tryPopLocal(queue_index, job) || trySteal(queue_index, job)) {
+			execute(job);
+			return true;
+		}
+		return false;
+	}
+
+	bool JobSystem::tryExecuteBackground() {
+		if (_running_background_job_count.fetch_add(1) >= _background_concurrency && _is_running.load()) {
+			_running_background_job_count.fetch_sub(1);
+			return false;
+		}
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(_background_queue.mutex);
+			if (_background_queue.jobs.empty()) {
+				_running_background_job_count.fetch_sub(1);
+				return false;
+			}
+			job = std::move(_background_queue.jobs.front());
+			_background_queue.jobs.pop_front();
+			_queued_background_job_count.fetch_sub(1);
+		}
+		execute(job);
+		_running_background_job_count.fetch_sub(1);
+		// a sleeping worker may have skipped the queue while every background slot was taken
+		if (_queued_background_job_count.load() > 0) {
+			notifyWorker();
+		}
+		return true;
+	}
+
+	bool JobSystem::canExecuteBackground() const {
+		return _queued_background_job_count.load() > 0 && _running_background_job_count.load() < _background_concurrency;
+	}
+
+	void JobSystem::execute(Job& job) {
+		job.func();
+		signal(job.counter);
+	}
+
+	void JobSystem::signal(JobCounter* counter) {
+		if (counter == nullptr) {
+			return;
+		}
+		std::vector<JobCounter::Continuation> continuations;
+		{
+			std::lock_guard<std::mutex> lock(counter->_continuation_mutex);
+			if (counter->_pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+				return;
+			}
+			continuations.swap(counter->_continuations);
+		}
+		for (auto& continuation : continuations) {
+			enqueue(Job{ std::move(continuation.func), continuation.signal_counter });
+		}
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Dao {
+
+	class JobSystem;
+
+	/// tracks a group of jobs, reaches zero once every job submitted against it has finished.
+	/// jobs submitted with a dependency counter only start after that counter reached zero.
+	/// a counter must outlive every job that signals it and must not be reused while it still has dependents.
+	class JobCounter {
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool isDone() const { return _pending.load(std::memory_order_acquire) == 0; }
+		uint32_t getPendingCount() const { return _pending.load(std::memory_order_acquire); }
+
+	private:
+		friend class JobSystem;
+
+		struct Continuation {
+			std::function<void()>	func;
+			JobCounter*				signal_counter{ nullptr };
+		};
+
+		std::atomic<uint32_t>		_pending{ 0 };
+		std::mutex					_continuation_mutex;
+		std::vector<Continuation>	_continuations;
+	};
+
+	/// work stealing scheduler shared by the whole engine.
+	/// every worker owns a deque: the owner pushes and pops at the back, idle workers steal from the front.
+	/// threads that are not workers submit into a shared injection queue and help executing jobs while they wait.
+	/// long running low priority work like asset decoding goes to a separate background queue, see submitBackground.
+	class JobSystem {
+	public:
+		using JobFunc = std::function<void()>;
+		using RangeFunc = std::function<void(uint32_t begin, uint32_t end)>;
+
+		JobSystem() = default;
+		~JobSystem();
+
+		/// @worker_count: number of worker threads, 0 picks hardware concurrency minus the calling thread
+		void initialize(uint32_t worker_count = 0);
+		void clear();
+
+		/// fork: run func on a worker, counter (optional) is incremented now and decremented when func returns
+		void submit(JobFunc func, JobCounter* counter = nullptr);
+		/// like submit, but func is only queued after dependency reached zero
+		void submitAfter(JobCounter& dependency, JobFunc func, JobCounter* counter = nullptr);
+		/// like submit, but for low priority work that may run for several frames. background jobs sit in a fifo queue
+		/// that wait() and stealing never take from, only workers without other jobs pick them up and at most
+		/// getBackgroundConcurrency() of them run at once, so frame jobs never queue behind them
+		void submitBackground(JobFunc func, JobCounter* counter = nullptr);
+		/// join: block until counter reached zero, the calling thread executes pending jobs meanwhile
+		void wait(JobCounter& counter);
+
+		/// split [0, count) into batches of at least min_batch_size and run them in parallel, returns when all finished.
+		/// func receives half open ranges, batches never overlap
+		void parallelFor(uint32_t count, uint32_t min_batch_size, const RangeFunc& func);
+
+		/// worker threads plus the thread that joins
+		uint32_t getMaxConcurrency() const { return static_cast<uint32_t>(_workers.size()) + 1; }
+		uint32_t getWorkerCount() const { return static_cast<uint32_t>(_workers.size()); }
+		/// workers that may run background jobs at the same time
+		uint32_t getBackgroundConcurrency() const { return _background_concurrency; }
+		/// index of the calling worker in [0, getWorkerCount()), getWorkerCount() for any other thread
+		uint32_t getCurrentThreadIndex() const;
+
+	private:
+		struct Job {
+			JobFunc		func;
+			JobCounter*	counter{ nullptr };
+		};
+
+		struct WorkQueue {
+			std::mutex			mutex;
+			std::deque<Job>		jobs;
+		};
+
+		void workerLoop(uint32_t worker_index);
+		void enqueue(Job&& job);
+		bool tryPopLocal(uint32_t queue_index, Job& out_job);
+		bool trySteal(uint32_t thief_index, Job& out_job);
+		bool tryExecuteOne(uint32_t queue_index);
+		bool tryExecuteBackground();
+		bool canExecuteBackground() const;
+		void notifyWorker();
+		void execute(Job& job);
+		void signal(JobCounter* counter);
+
+	private:
+		std::vector<std::thread>					_workers;
+		// one queue per worker plus the injection queue for external threads at the end
+		std::vector<std::unique_ptr<WorkQueue>>		_queues;
+		WorkQueue									_background_queue;
+		uint32_t									_background_concurrency{ 1 };
+
+		std::mutex									_sleep_mutex;
+		std::condition_variable						_sleep_condition;
+		std::atomic<uint32_t>						_queued_job_count{ 0 };
+		std::atomic<uint32_t>						_queued_background_job_count{ 0 };
+		std::atomic<uint32_t>						_running_background_job_count{ 0 };
+		std::atomic<bool>							_is_running{ false };
+	};
+}
@@ -0,0 +1,52 @@
+#include "runtime/core/math/simd.h"
+
+#if DAO_SIMD_X86 && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Dao
+{
+    namespace Simd
+    {
+        namespace
+        {
+            bool detectAVX2()
+            {
+#if DAO_SIMD_X86 && defined(_MSC_VER)
+                int cpu_info[4];
+                __cpuid(cpu_info, 0);
+                if (cpu_info[0] < 7)
+                {
+                    return false;
+                }
+                __cpuid(cpu_info, 1);
+                const bool has_osxsave = (cpu_info[2] & (1 << 27)) != 0;
+                const bool has_avx     = (cpu_info[2] & (1 << 28)) != 0;
+                const bool has_fma     = (cpu_info[2] & (1 << 12)) != 0;
+                if (!has_osxsave || !has_avx || !has_fma)
+                {
+                    return false;
+                }
+                // the os has to save the ymm registers on context switches
+                if ((_xgetbv(0) & 0x6) != 0x6)
+                {
+                    return false;
+                }
+                __cpuidex(cpu_info, 7, 0);
+                return (cpu_info[1] & (1 << 5)) != 0;
+#elif DAO_SIMD_X86
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+                return false;
+#endif
+            }
+        } // namespace
+
+        bool hasAVX2()
+        {
+            static const bool s_has_avx2 = detectAVX2();
+            return s_has_avx2;
+        }
+    } // namespace Simd
+} // namespace Dao
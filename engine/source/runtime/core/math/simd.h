@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+// x86 builds always have sse2, avx2 kernels are picked at runtime through hasAVX2()
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DAO_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define DAO_SIMD_X86 0
+#endif
+
+// msvc accepts avx2 intrinsics in any function, gcc and clang need them enabled per function
+#if DAO_SIMD_X86 && !defined(_MSC_VER)
+#define DAO_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define DAO_TARGET_AVX2
+#endif
+
+namespace Dao
+{
+    namespace Simd
+    {
+        /// cpu and os both support avx2, the result is detected once and cached
+        bool hasAVX2();
+    } // namespace Simd
+} // namespace Dao
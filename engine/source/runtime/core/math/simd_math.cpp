@@ -0,0 +1,441 @@
+#include "runtime/core/math/simd_math.h"
+
+#include "runtime/core/math/simd.h"
+
+namespace Dao
+{
+    namespace Simd
+    {
+        // the kernels read and write the math types as plain float arrays
+        static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 has to be three packed floats");
+        static_assert(sizeof(Quaternion) == sizeof(float) * 4, "Quaternion has to be four packed floats");
+        static_assert(sizeof(Matrix4x4) == sizeof(float) * 16, "Matrix4x4 has to be sixteen packed floats");
+
+        namespace
+        {
+#if DAO_SIMD_X86
+            // each kernel returns the first element it did not process, the next narrower one continues there
+
+            size_t lerpSSE(const float* a, const float* b, float t, float* out, size_t begin, size_t end)
+            {
+                const __m128 t4 = _mm_set1_ps(t);
+                size_t       i  = begin;
+                for (; i + 4 <= end; i += 4)
+                {
+                    const __m128 a4 = _mm_loadu_ps(a + i);
+                    const __m128 b4 = _mm_loadu_ps(b + i);
+                    _mm_storeu_ps(out + i, _mm_add_ps(a4, _mm_mul_ps(t4, _mm_sub_ps(b4, a4))));
+                }
+                return i;
+            }
+
+            DAO_TARGET_AVX2
+            size_t lerpAVX2(const float* a, const float* b, float t, float* out, size_t begin, size_t end)
+            {
+                const __m256 t8 = _mm256_set1_ps(t);
+                size_t       i  = begin;
+                for (; i + 8 <= end; i += 8)
+                {
+                    const __m256 a8 = _mm256_loadu_ps(a + i);
+                    const __m256 b8 = _mm256_loadu_ps(b + i);
+                    _mm256_storeu_ps(out + i, _mm256_fmadd_ps(t8, _mm256_sub_ps(b8, a8), a8));
+                }
+                return i;
+            }
+
+            size_t nlerpSSE(const float* a, const float* b, float t, float* out, size_t begin, size_t end)
+            {
+                const __m128 t4        = _mm_set1_ps(t);
+                const __m128 sign_mask = _mm_set1_ps(-0.0f);
+                size_t       i         = begin;
+                for (; i + 4 <= end; i += 4)
+                {
+                    // four quaternions to one register per component
+                    __m128 aw = _mm_loadu_ps(a + i * 4);
+                    __m128 ax = _mm_loadu_ps(a + i * 4 + 4);
+                    __m128 ay = _mm_loadu_ps(a + i * 4 + 8);
+                    __m128 az = _mm_loadu_ps(a + i * 4 + 12);
+                    _MM_TRANSPOSE4_PS(aw, ax, ay, az);
+                    __m128 bw = _mm_loadu_ps(b + i * 4);
+                    __m128 bx = _mm_loadu_ps(b + i * 4 + 4);
+                    __m128 by = _mm_loadu_ps(b + i * 4 + 8);
+                    __m128 bz = _mm_loadu_ps(b + i * 4 + 12);
+                    _MM_TRANSPOSE4_PS(bw, bx, by, bz);
+
+                    // take the shortest path by negating b where the dot product is negative
+                    __m128 dot = _mm_mul_ps(aw, bw);
+                    dot        = _mm_add_ps(dot, _mm_mul_ps(ax, bx));
+                    dot        = _mm_add_ps(dot, _mm_mul_ps(ay, by));
+                    dot        = _mm_add_ps(dot, _mm_mul_ps(az, bz));
+                    const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), sign_mask);
+                    bw                = _mm_xor_ps(bw, flip);
+                    bx                = _mm_xor_ps(bx, flip);
+                    by                = _mm_xor_ps(by, flip);
+                    bz                = _mm_xor_ps(bz, flip);
+
+                    __m128 rw = _mm_add_ps(aw, _mm_mul_ps(t4, _mm_sub_ps(bw, aw)));
+                    __m128 rx = _mm_add_ps(ax, _mm_mul_ps(t4, _mm_sub_ps(bx, ax)));
+                    __m128 ry = _mm_add_ps(ay, _mm_mul_ps(t4, _mm_sub_ps(by, ay)));
+                    __m128 rz = _mm_add_ps(az, _mm_mul_ps(t4, _mm_sub_ps(bz, az)));
+
+                    __m128 length = _mm_mul_ps(rw, rw);
+                    length        = _mm_add_ps(length, _mm_mul_ps(rx, rx));
+                    length        = _mm_add_ps(length, _mm_mul_ps(ry, ry));
+                    length        = _mm_add_ps(length, _mm_mul_ps(rz, rz));
+                    const __m128 factor = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(length));
+                    rw                  = _mm_mul_ps(rw, factor);
+                    rx                  = _mm_mul_ps(rx, factor);
+                    ry                  = _mm_mul_ps(ry, factor);
+                    rz                  = _mm_mul_ps(rz, factor);
+
+                    _MM_TRANSPOSE4_PS(rw, rx, ry, rz);
+                    _mm_storeu_ps(out + i * 4, rw);
+                    _mm_storeu_ps(out + i * 4 + 4, rx);
+                    _mm_storeu_ps(out + i * 4 + 8, ry);
+                    _mm_storeu_ps(out + i * 4 + 12, rz);
+                }
+                return i;
+            }
+
+            // _MM_TRANSPOSE4_PS within each 128 bit lane, it is its own inverse
+            DAO_TARGET_AVX2
+            inline void transposeLanes4x4(__m256& r0, __m256& r1, __m256& r2, __m256& r3)
+            {
+                const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+                const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+                const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+                const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+                r0              = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+                r1              = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+                r2              = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+                r3              = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            }
+
+            DAO_TARGET_AVX2
+            size_t nlerpAVX2(const float* a, const float* b, float t, float* out, size_t begin, size_t end)
+            {
+                const __m256 t8        = _mm256_set1_ps(t);
+                const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+                size_t       i         = begin;
+                for (; i + 8 <= end; i += 8)
+                {
+                    // the low lanes end up with the even quaternions and the high lanes with the odd ones,
+                    // transposing back restores the order so it does not matter here
+                    __m256 aw = _mm256_loadu_ps(a + i * 4);
+                    __m256 ax = _mm256_loadu_ps(a + i * 4 + 8);
+                    __m256 ay = _mm256_loadu_ps(a + i * 4 + 16);
+                    __m256 az = _mm256_loadu_ps(a + i * 4 + 24);
+                    transposeLanes4x4(aw, ax, ay, az);
+                    __m256 bw = _mm256_loadu_ps(b + i * 4);
+                    __m256 bx = _mm256_loadu_ps(b + i * 4 + 8);
+                    __m256 by = _mm256_loadu_ps(b + i * 4 + 16);
+                    __m256 bz = _mm256_loadu_ps(b + i * 4 + 24);
+                    transposeLanes4x4(bw, bx, by, bz);
+
+                    __m256 dot        = _mm256_mul_ps(aw, bw);
+                    dot               = _mm256_fmadd_ps(ax, bx, dot);
+                    dot               = _mm256_fmadd_ps(ay, by, dot);
+                    dot               = _mm256_fmadd_ps(az, bz, dot);
+                    const __m256 flip = _mm256_and_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ), sign_mask);
+                    bw                = _mm256_xor_ps(bw, flip);
+                    bx                = _mm256_xor_ps(bx, flip);
+                    by                = _mm256_xor_ps(by, flip);
+                    bz                = _mm256_xor_ps(bz, flip);
+
+                    __m256 rw = _mm256_fmadd_ps(t8, _mm256_sub_ps(bw, aw), aw);
+                    __m256 rx = _mm256_fmadd_ps(t8, _mm256_sub_ps(bx, ax), ax);
+                    __m256 ry = _mm256_fmadd_ps(t8, _mm256_sub_ps(by, ay), ay);
+                    __m256 rz = _mm256_fmadd_ps(t8, _mm256_sub_ps(bz, az), az);
+
+                    __m256 length       = _mm256_mul_ps(rw, rw);
+                    length              = _mm256_fmadd_ps(rx, rx, length);
+                    length              = _mm256_fmadd_ps(ry, ry, length);
+                    length              = _mm256_fmadd_ps(rz, rz, length);
+                    const __m256 factor = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(length));
+                    rw                  = _mm256_mul_ps(rw, factor);
+                    rx                  = _mm256_mul_ps(rx, factor);
+                    ry                  = _mm256_mul_ps(ry, factor);
+                    rz                  = _mm256_mul_ps(rz, factor);
+
+                    transposeLanes4x4(rw, rx, ry, rz);
+                    _mm256_storeu_ps(out + i * 4, rw);
+                    _mm256_storeu_ps(out + i * 4 + 8, rx);
+                    _mm256_storeu_ps(out + i * 4 + 16, ry);
+                    _mm256_storeu_ps(out + i * 4 + 24, rz);
+                }
+                return i;
+            }
+
+            size_t composeAffineSSE(const Vector3*    translations,
+                                    const Quaternion* rotations,
+                                    const Vector3*    scales,
+                                    float*            out,
+                                    size_t            begin,
+                                    size_t            end)
+            {
+                const float* rotation_floats = reinterpret_cast<const float*>(rotations);
+                const __m128 one             = _mm_set1_ps(1.0f);
+                const __m128 last_row        = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+                size_t       i               = begin;
+                for (; i + 4 <= end; i += 4)
+                {
+                    __m128 w = _mm_loadu_ps(rotation_floats + i * 4);
+                    __m128 x = _mm_loadu_ps(rotation_floats + i * 4 + 4);
+                    __m128 y = _mm_loadu_ps(rotation_floats + i * 4 + 8);
+                    __m128 z = _mm_loadu_ps(rotation_floats + i * 4 + 12);
+                    _MM_TRANSPOSE4_PS(w, x, y, z);
+                    const __m128 sx = _mm_setr_ps(scales[i].x, scales[i + 1].x, scales[i + 2].x, scales[i + 3].x);
+                    const __m128 sy = _mm_setr_ps(scales[i].y, scales[i + 1].y, scales[i + 2].y, scales[i + 3].y);
+                    const __m128 sz = _mm_setr_ps(scales[i].z, scales[i + 1].z, scales[i + 2].z, scales[i + 3].z);
+
+                    // same terms as Quaternion::toRotationMatrix
+                    const __m128 tx  = _mm_add_ps(x, x);
+                    const __m128 ty  = _mm_add_ps(y, y);
+                    const __m128 tz  = _mm_add_ps(z, z);
+                    const __m128 twx = _mm_mul_ps(tx, w);
+                    const __m128 twy = _mm_mul_ps(ty, w);
+                    const __m128 twz = _mm_mul_ps(tz, w);
+                    const __m128 txx = _mm_mul_ps(tx, x);
+                    const __m128 txy = _mm_mul_ps(ty, x);
+                    const __m128 txz = _mm_mul_ps(tz, x);
+                    const __m128 tyy = _mm_mul_ps(ty, y);
+                    const __m128 tyz = _mm_mul_ps(tz, y);
+                    const __m128 tzz = _mm_mul_ps(tz, z);
+
+                    __m128 rows[3][4] = {
+                        {_mm_mul_ps(sx, _mm_sub_ps(one, _mm_add_ps(tyy, tzz))),
+                         _mm_mul_ps(sy, _mm_sub_ps(txy, twz)),
+                         _mm_mul_ps(sz, _mm_add_ps(txz, twy)),
+                         _mm_setr_ps(translations[i].x, translations[i + 1].x, translations[i + 2].x, translations[i + 3].x)},
+                        {_mm_mul_ps(sx, _mm_add_ps(txy, twz)),
+                         _mm_mul_ps(sy, _mm_sub_ps(one, _mm_add_ps(txx, tzz))),
+                         _mm_mul_ps(sz, _mm_sub_ps(tyz, twx)),
+                         _mm_setr_ps(translations[i].y, translations[i + 1].y, translations[i + 2].y, translations[i + 3].y)},
+                        {_mm_mul_ps(sx, _mm_sub_ps(txz, twy)),
+                         _mm_mul_ps(sy, _mm_add_ps(tyz, twx)),
+                         _mm_mul_ps(sz, _mm_sub_ps(one, _mm_add_ps(txx, tyy))),
+                         _mm_setr_ps(translations[i].z, translations[i + 1].z, translations[i + 2].z, translations[i + 3].z)}};
+                    for (size_t row = 0; row < 3; ++row)
+                    {
+                        _MM_TRANSPOSE4_PS(rows[row][0], rows[row][1], rows[row][2], rows[row][3]);
+                        for (size_t lane = 0; lane < 4; ++lane)
+                        {
+                            _mm_storeu_ps(out + (i + lane) * 16 + row * 4, rows[row][lane]);
+                        }
+                    }
+                    for (size_t lane = 0; lane < 4; ++lane)
+                    {
+                        _mm_storeu_ps(out + (i + lane) * 16 + 12, last_row);
+                    }
+                }
+                return i;
+            }
+
+            DAO_TARGET_AVX2
+            size_t composeAffineAVX2(const Vector3*    translations,
+                                     const Quaternion* rotations,
+                                     const Vector3*    scales,
+                                     float*            out,
+                                     size_t            begin,
+                                     size_t            end)
+            {
+                const float* rotation_floats = reinterpret_cast<const float*>(rotations);
+                const __m256 one             = _mm256_set1_ps(1.0f);
+                const __m128 last_row        = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+                size_t       i               = begin;
+                for (; i + 8 <= end; i += 8)
+                {
+                    // lane order after the transpose, even elements in the low half and odd ones in the high half
+                    const size_t e[8] = {i, i + 2, i + 4, i + 6, i + 1, i + 3, i + 5, i + 7};
+                    __m256       w    = _mm256_loadu_ps(rotation_floats + i * 4);
+                    __m256       x    = _mm256_loadu_ps(rotation_floats + i * 4 + 8);
+                    __m256       y    = _mm256_loadu_ps(rotation_floats + i * 4 + 16);
+                    __m256       z    = _mm256_loadu_ps(rotation_floats + i * 4 + 24);
+                    transposeLanes4x4(w, x, y, z);
+                    const __m256 sx = _mm256_setr_ps(scales[e[0]].x, scales[e[1]].x, scales[e[2]].x, scales[e[3]].x,
+                                                     scales[e[4]].x, scales[e[5]].x, scales[e[6]].x, scales[e[7]].x);
+                    const __m256 sy = _mm256_setr_ps(scales[e[0]].y, scales[e[1]].y, scales[e[2]].y, scales[e[3]].y,
+                                                     scales[e[4]].y, scales[e[5]].y, scales[e[6]].y, scales[e[7]].y);
+                    const __m256 sz = _mm256_setr_ps(scales[e[0]].z, scales[e[1]].z, scales[e[2]].z, scales[e[3]].z,
+                                                     scales[e[4]].z, scales[e[5]].z, scales[e[6]].z, scales[e[7]].z);
+
+                    const __m256 tx  = _mm256_add_ps(x, x);
+                    const __m256 ty  = _mm256_add_ps(y, y);
+                    const __m256 tz  = _mm256_add_ps(z, z);
+                    const __m256 twx = _mm256_mul_ps(tx, w);
+                    const __m256 twy = _mm256_mul_ps(ty, w);
+                    const __m256 twz = _mm256_mul_ps(tz, w);
+                    const __m256 txx = _mm256_mul_ps(tx, x);
+                    const __m256 txy = _mm256_mul_ps(ty, x);
+                    const __m256 txz = _mm256_mul_ps(tz, x);
+                    const __m256 tyy = _mm256_mul_ps(ty, y);
+                    const __m256 tyz = _mm256_mul_ps(tz, y);
+                    const __m256 tzz = _mm256_mul_ps(tz, z);
+
+                    __m256 rows[3][4] = {
+                        {_mm256_mul_ps(sx, _mm256_sub_ps(one, _mm256_add_ps(tyy, tzz))),
+                         _mm256_mul_ps(sy, _mm256_sub_ps(txy, twz)),
+                         _mm256_mul_ps(sz, _mm256_add_ps(txz, twy)),
+                         _mm256_setr_ps(translations[e[0]].x, translations[e[1]].x, translations[e[2]].x, translations[e[3]].x,
+                                        translations[e[4]].x, translations[e[5]].x, translations[e[6]].x, translations[e[7]].x)},
+                        {_mm256_mul_ps(sx, _mm256_add_ps(txy, twz)),
+                         _mm256_mul_ps(sy, _mm256_sub_ps(one, _mm256_add_ps(txx, tzz))),
+                         _mm256_mul_ps(sz, _mm256_sub_ps(tyz, twx)),
+                         _mm256_setr_ps(translations[e[0]].y, translations[e[1]].y, translations[e[2]].y, translations[e[3]].y,
+                                        translations[e[4]].y, translations[e[5]].y, translations[e[6]].y, translations[e[7]].y)},
+                        {_mm256_mul_ps(sx, _mm256_sub_ps(txz, twy)),
+                         _mm256_mul_ps(sy, _mm256_add_ps(tyz, twx)),
+                         _mm256_mul_ps(sz, _mm256_sub_ps(one, _mm256_add_ps(txx, tyy))),
+                         _mm256_setr_ps(translations[e[0]].z, translations[e[1]].z, translations[e[2]].z, translations[e[3]].z,
+                                        translations[e[4]].z, translations[e[5]].z, translations[e[6]].z, translations[e[7]].z)}};
+                    for (size_t row = 0; row < 3; ++row)
+                    {
+                        // register k now holds the row of element 2k in its low half and of element 2k + 1 in its high half
+                        transposeLanes4x4(rows[row][0], rows[row][1], rows[row][2], rows[row][3]);
+                        for (size_t k = 0; k < 4; ++k)
+                        {
+                            _mm_storeu_ps(out + (i + 2 * k) * 16 + row * 4, _mm256_castps256_ps128(rows[row][k]));
+                            _mm_storeu_ps(out + (i + 2 * k + 1) * 16 + row * 4, _mm256_extractf128_ps(rows[row][k], 1));
+                        }
+                    }
+                    for (size_t lane = 0; lane < 8; ++lane)
+                    {
+                        _mm_storeu_ps(out + (i + lane) * 16 + 12, last_row);
+                    }
+                }
+                return i;
+            }
+
+            size_t mul4x4SSE(const float* a, const float* b, float* out, size_t begin, size_t end)
+            {
+                size_t i = begin;
+                for (; i < end; ++i)
+                {
+                    const float* a_mat = a + i * 16;
+                    const float* b_mat = b + i * 16;
+                    const __m128 b0    = _mm_loadu_ps(b_mat);
+                    const __m128 b1    = _mm_loadu_ps(b_mat + 4);
+                    const __m128 b2    = _mm_loadu_ps(b_mat + 8);
+                    const __m128 b3    = _mm_loadu_ps(b_mat + 12);
+                    for (size_t row = 0; row < 4; ++row)
+                    {
+                        // a row of the product is the rows of b weighted by the same row of a
+                        __m128 r = _mm_mul_ps(_mm_set1_ps(a_mat[row * 4]), b0);
+                        r        = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a_mat[row * 4 + 1]), b1));
+                        r        = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a_mat[row * 4 + 2]), b2));
+                        r        = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a_mat[row * 4 + 3]), b3));
+                        _mm_storeu_ps(out + i * 16 + row * 4, r);
+                    }
+                }
+                return i;
+            }
+
+            DAO_TARGET_AVX2
+            size_t mul4x4AVX2(const float* a, const float* b, float* out, size_t begin, size_t end)
+            {
+                size_t i = begin;
+                for (; i < end; ++i)
+                {
+                    const float* a_mat = a + i * 16;
+                    const float* b_mat = b + i * 16;
+                    // every row of b in both halves, two rows of the product are built at once
+                    const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b_mat));
+                    const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b_mat + 4));
+                    const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b_mat + 8));
+                    const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b_mat + 12));
+                    for (size_t row = 0; row < 4; row += 2)
+                    {
+                        const __m256 a_rows = _mm256_loadu_ps(a_mat + row * 4);
+                        __m256       r      = _mm256_mul_ps(_mm256_permute_ps(a_rows, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+                        r                   = _mm256_fmadd_ps(_mm256_permute_ps(a_rows, _MM_SHUFFLE(1, 1, 1, 1)), b1, r);
+                        r                   = _mm256_fmadd_ps(_mm256_permute_ps(a_rows, _MM_SHUFFLE(2, 2, 2, 2)), b2, r);
+                        r                   = _mm256_fmadd_ps(_mm256_permute_ps(a_rows, _MM_SHUFFLE(3, 3, 3, 3)), b3, r);
+                        _mm256_storeu_ps(out + i * 16 + row * 4, r);
+                    }
+                }
+                return i;
+            }
+#endif
+        } // namespace
+
+        void lerpN(const Vector3* a, const Vector3* b, float t, Vector3* out, size_t count)
+        {
+            // the components are independent, the arrays are lerped as flat floats
+            const float* a_floats   = reinterpret_cast<const float*>(a);
+            const float* b_floats   = reinterpret_cast<const float*>(b);
+            float*       out_floats = reinterpret_cast<float*>(out);
+            const size_t end        = count * 3;
+            size_t       next       = 0;
+#if DAO_SIMD_X86
+            if (hasAVX2())
+            {
+                next = lerpAVX2(a_floats, b_floats, t, out_floats, next, end);
+            }
+            next = lerpSSE(a_floats, b_floats, t, out_floats, next, end);
+#endif
+            for (; next < end; ++next)
+            {
+                out_floats[next] = a_floats[next] + t * (b_floats[next] - a_floats[next]);
+            }
+        }
+
+        void nlerpN(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count)
+        {
+            size_t next = 0;
+#if DAO_SIMD_X86
+            const float* a_floats   = reinterpret_cast<const float*>(a);
+            const float* b_floats   = reinterpret_cast<const float*>(b);
+            float*       out_floats = reinterpret_cast<float*>(out);
+            if (hasAVX2())
+            {
+                next = nlerpAVX2(a_floats, b_floats, t, out_floats, next, count);
+            }
+            next = nlerpSSE(a_floats, b_floats, t, out_floats, next, count);
+#endif
+            for (; next < count; ++next)
+            {
+                out[next] = Quaternion::nLerp(t, a[next], b[next], true);
+            }
+        }
+
+        void composeAffineN(const Vector3*    translations,
+                            const Quaternion* rotations,
+                            const Vector3*    scales,
+                            Matrix4x4*        out,
+                            size_t            count)
+        {
+            size_t next = 0;
+#if DAO_SIMD_X86
+            float* out_floats = reinterpret_cast<float*>(out);
+            if (hasAVX2())
+            {
+                next = composeAffineAVX2(translations, rotations, scales, out_floats, next, count);
+            }
+            next = composeAffineSSE(translations, rotations, scales, out_floats, next, count);
+#endif
+            for (; next < count; ++next)
+            {
+                out[next].makeTransform(translations[next], scales[next], rotations[next]);
+            }
+        }
+
+        void mul4x4N(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t count)
+        {
+            size_t next = 0;
+#if DAO_SIMD_X86
+            const float* a_floats   = reinterpret_cast<const float*>(a);
+            const float* b_floats   = reinterpret_cast<const float*>(b);
+            float*       out_floats = reinterpret_cast<float*>(out);
+            if (hasAVX2())
+            {
+                next = mul4x4AVX2(a_floats, b_floats, out_floats, next, count);
+            }
+            next = mul4x4SSE(a_floats, b_floats, out_floats, next, count);
+#endif
+            for (; next < count; ++next)
+            {
+                out[next] = a[next] * b[next];
+            }
+        }
+    } // namespace Simd
+} // namespace Dao
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "runtime/core/math/matrix4.h"
+#include "runtime/core/math/quaternion.h"
+#include "runtime/core/math/vector3.h"
+
+#include <cstddef>
+
+namespace Dao
+{
+    namespace Simd
+    {
+        // batched kernels over arrays of math types, they run 8 elements at once with avx2, 4 with sse
+        // and fall back to the scalar math types elsewhere. out may alias the first input
+
+        /// out[i] = Vector3::lerp(a[i], b[i], t)
+        void lerpN(const Vector3* a, const Vector3* b, float t, Vector3* out, size_t count);
+
+        /// out[i] = Quaternion::nLerp(t, a[i], b[i], true)
+        void nlerpN(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count);
+
+        /// out[i] is the scale, then rotate, then translate matrix of Matrix4x4::makeTransform
+        void composeAffineN(const Vector3*    translations,
+                            const Quaternion* rotations,
+                            const Vector3*    scales,
+                            Matrix4x4*        out,
+                            size_t            count);
+
+        /// out[i] = a[i] * b[i], out must not alias b
+        void mul4x4N(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t count);
+    } // namespace Simd
+} // namespace Dao
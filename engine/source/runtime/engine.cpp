@@ -4,6 +4,7 @@
 #include "runtime/function/global/global_context.h"
 #include "runtime/function/render/render_system.h"
 #include "runtime/function/render/window_system.h"
+#include "runtime/resource/config_manager/config_manager.h"
 #include "runtime/function/input/input_system.h"
 #include "runtime/function/framework/world/world_manager.h"
 #include "runtime/core/meta/reflection/reflection_register.h"
@@ -16,12 +17,19 @@ namespace Dao {
 		Reflection::TypeMetaRegister::metaRegister();
 		g_runtime_global_context.startSystems(config_file_path);
 
+		m_is_pipelined_rendering = g_runtime_global_context.m_config_manager->isPipelinedRendering();
+		m_max_frame_latency = g_runtime_global_context.m_config_manager->getMaxFrameLatency();
+		//the rhi was created with this size
+		m_framebuffer_size = g_runtime_global_context.m_window_system->getFramebufferSize();
+		m_is_window_minimized = g_runtime_global_context.m_window_system->isMinimized();
+
 		LOG_INFO("engine start");
 	}
 
 	void DaoEngine::shutdownEngine() {
 		LOG_INFO("engine shutdown");
 
+		stopRenderThread();
 		g_runtime_global_context.shutdownSystems();
 		Reflection::TypeMetaRegister::metaUnregister();
 	}
@@ -33,10 +41,17 @@ namespace Dao {
 	void DaoEngine::run() {
 		std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
 		ASSERT(window_system);
+		//nobody can close a headless window, it stops after the configured number of frames
+		const uint32_t headless_frame_count = window_system->isHeadless() ?
+			g_runtime_global_context.m_config_manager->getHeadlessFrameCount() : 0;
+		uint32_t ticked_frame_count = 0;
 		
 		while (!window_system->shouldClose()){
 			const float delta_time = calculateDeltaTime();
 			tickOneFrame(delta_time);
+			if (headless_frame_count != 0 && ++ticked_frame_count >= headless_frame_count) {
+				window_system->setShouldClose(true);
+			}
 		}
 	}
 
@@ -52,12 +67,24 @@ namespace Dao {
 
 	bool DaoEngine::tickOneFrame(float delta_time) {
 		logicalTick(delta_time);
+		updateWindowSwapData();
 		calculateFPS(delta_time);
 
-		g_runtime_global_context.m_render_system->swapLogicRenderData();
-		rendererTick(delta_time);
+		if (m_is_pipelined_rendering) {
+			submitRenderFrame(delta_time);
+		}
+		else {
+			g_runtime_global_context.m_render_system->swapLogicRenderData();
+			rendererTick(delta_time);
+		}
 
-		g_runtime_global_context.m_window_system->pollEvents();
+		//nothing is rendered while minimized, sleep until an event arrives instead of spinning
+		if (g_runtime_global_context.m_window_system->isMinimized()) {
+			g_runtime_global_context.m_window_system->waitEvents();
+		}
+		else {
+			g_runtime_global_context.m_window_system->pollEvents();
+		}
 		g_runtime_global_context.m_window_system->setTitle(std::string("Dao - " + std::to_string(getFPS()) + " FPS").c_str());
 
 		const bool should_not_window_close = !(g_runtime_global_context.m_window_system->shouldClose());
@@ -74,6 +101,104 @@ namespace Dao {
 		g_runtime_global_context.m_render_system->tick(delta_time);
 	}
 
+	void DaoEngine::updateWindowSwapData() {
+		std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
+		const std::array<int, 2> framebuffer_size = window_system->getFramebufferSize();
+		const bool is_window_minimized = window_system->isMinimized();
+		if (framebuffer_size == m_framebuffer_size && is_window_minimized == m_is_window_minimized) {
+			return;
+		}
+		m_framebuffer_size = framebuffer_size;
+		m_is_window_minimized = is_window_minimized;
+
+		WindowSwapData window_swap_data;
+		window_swap_data.m_framebuffer_width = static_cast<uint32_t>(framebuffer_size[0]);
+		window_swap_data.m_framebuffer_height = static_cast<uint32_t>(framebuffer_size[1]);
+		window_swap_data.m_is_minimized = is_window_minimized;
+		g_runtime_global_context.m_render_system->getSwapContext().getLogicSwapData().m_window_swap_data = window_swap_data;
+	}
+
+	void DaoEngine::setPipelinedRendering(bool enable) {
+		if (!enable) {
+			stopRenderThread();
+		}
+		m_is_pipelined_rendering = enable;
+	}
+
+	void DaoEngine::startRenderThread() {
+		{
+			std::lock_guard<std::mutex> lock(m_render_frame_mutex);
+			m_is_render_thread_running = true;
+			m_submitted_frame = 0;
+			m_consumed_frame = 0;
+			m_rendered_frame = 0;
+		}
+		m_render_thread = std::thread(&DaoEngine::renderThreadLoop, this);
+	}
+
+	void DaoEngine::stopRenderThread() {
+		if (!m_render_thread.joinable()) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_render_frame_mutex);
+			m_is_render_thread_running = false;
+		}
+		m_render_frame_condition.notify_all();
+		// the render thread drains every submitted frame before it exits
+		m_render_thread.join();
+	}
+
+	void DaoEngine::submitRenderFrame(float delta_time) {
+		if (!m_render_thread.joinable()) {
+			startRenderThread();
+		}
+		{
+			std::unique_lock<std::mutex> lock(m_render_frame_mutex);
+			// the render side swap data must be consumed before it is overwritten,
+			// and no more than m_max_frame_latency frames may wait for the renderer
+			m_render_frame_condition.wait(lock, [this]() {
+				return m_consumed_frame == m_submitted_frame &&
+					m_submitted_frame - m_rendered_frame < m_max_frame_latency;
+			});
+			g_runtime_global_context.m_render_system->swapLogicRenderData();
+			m_render_delta_time = delta_time;
+			++m_submitted_frame;
+		}
+		m_render_frame_condition.notify_all();
+	}
+
+	void DaoEngine::renderThreadLoop() {
+		std::shared_ptr<RenderSystem> render_system = g_runtime_global_context.m_render_system;
+		while (true) {
+			float delta_time;
+			{
+				std::unique_lock<std::mutex> lock(m_render_frame_mutex);
+				m_render_frame_condition.wait(lock, [this]() {
+					return m_submitted_frame > m_consumed_frame || !m_is_render_thread_running;
+				});
+				if (m_submitted_frame == m_consumed_frame) {
+					break;
+				}
+				delta_time = m_render_delta_time;
+			}
+
+			render_system->processSwapData();
+			{
+				std::lock_guard<std::mutex> lock(m_render_frame_mutex);
+				++m_consumed_frame;
+			}
+			m_render_frame_condition.notify_all();
+
+			render_system->renderFrame(delta_time);
+			{
+				std::lock_guard<std::mutex> lock(m_render_frame_mutex);
+				++m_rendered_frame;
+			}
+			m_render_frame_condition.notify_all();
+		}
+	}
+
 	const float DaoEngine::s_fps_alpha = 1.0f / 100;
 	void DaoEngine::calculateFPS(float delta_time) {
 		m_frame_count++;
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 
 namespace Dao {
@@ -33,6 +37,13 @@ namespace Dao {
 		int getFPS() const {
 			return m_fps;
 		}
+
+		/// render frame N on a dedicated thread while logic ticks frame N+1.
+		/// not for hosts whose ui runs inside the render tick and touches the world (the editor)
+		void setPipelinedRendering(bool enable);
+		bool isPipelinedRendering() const {
+			return m_is_pipelined_rendering;
+		}
 	
 	protected:
 		void logicalTick(float delta_time);
@@ -40,6 +51,14 @@ namespace Dao {
 
 		void calculateFPS(float delta_time);
 		float calculateDeltaTime();
+		/// hand the framebuffer size and minimized state to the renderer when they changed,
+		/// glfw only answers on the main thread
+		void updateWindowSwapData();
+
+		void startRenderThread();
+		void stopRenderThread();
+		void renderThreadLoop();
+		void submitRenderFrame(float delta_time);
 
 	protected:
 		std::chrono::steady_clock::time_point m_last_tick_time_point{ std::chrono::steady_clock::now() };
@@ -48,5 +67,21 @@ namespace Dao {
 		float m_average_duration{ 0.f };
 		int m_frame_count{ 0 };
 		int m_fps{ 0 };
+
+		// window state last handed to the renderer
+		std::array<int, 2> m_framebuffer_size{ 0, 0 };
+		bool m_is_window_minimized{ false };
+
+		// pipelined rendering, frame counters are guarded by m_render_frame_mutex
+		bool m_is_pipelined_rendering{ false };
+		uint32_t m_max_frame_latency{ 1 };
+		std::thread m_render_thread;
+		std::mutex m_render_frame_mutex;
+		std::condition_variable m_render_frame_condition;
+		bool m_is_render_thread_running{ false };
+		uint64_t m_submitted_frame{ 0 };
+		uint64_t m_consumed_frame{ 0 };
+		uint64_t m_rendered_frame{ 0 };
+		float m_render_delta_time{ 0.f };
 	};
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "runtime/function/animation/animation_clip_cooker.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/platform/file_system/cooked_file.h"
+
+#include <fstream>
+#include <type_traits>
+
+namespace Dao {
+
+    namespace {
+        static_assert(std::is_trivially_copyable<CompressedAnimationChannel>::value, "cooked channels are written as raw bytes");
+
+        bool isTrackInClip(uint32_t first_key, uint32_t key_count, uint32_t clip_key_count) {
+            return first_key <= clip_key_count && key_count <= clip_key_count - first_key;
+        }
+    }
+
+    std::filesystem::path AnimationClipCooker::getCookedPath(const std::filesystem::path& source_path) {
+        std::filesystem::path cooked_path = source_path;
+        cooked_path += ".danim";
+        return cooked_path;
+    }
+
+    bool AnimationClipCooker::cook(const std::filesystem::path& cooked_path, int64_t source_write_time, const CompressedAnimationClip& clip) {
+        CookedAnimationClipHeader header{};
+        header.magic = s_magic;
+        header.version = s_version;
+        header.source_write_time = source_write_time;
+        header.total_frame = clip.m_total_frame;
+        header.channel_count = static_cast<uint32_t>(clip.m_channels.size());
+        header.key_count = static_cast<uint32_t>(clip.m_key_frames.size());
+
+        const uint64_t channels_size = clip.m_channels.size() * sizeof(CompressedAnimationChannel);
+        const uint64_t key_frames_size = clip.m_key_frames.size() * sizeof(uint16_t);
+        const uint64_t key_values_size = clip.m_key_values.size() * sizeof(uint16_t);
+        const uint64_t channels_offset = sizeof(header);
+        const uint64_t key_frames_offset = channels_offset + channels_size;
+        const uint64_t key_values_offset = key_frames_offset + key_frames_size;
+        return WriteCookedFile(cooked_path, {
+            { 0, &header, sizeof(header) },
+            { channels_offset, clip.m_channels.data(), channels_size },
+            { key_frames_offset, clip.m_key_frames.data(), key_frames_size },
+            { key_values_offset, clip.m_key_values.data(), key_values_size }
+        });
+    }
+
+    std::shared_ptr<CompressedAnimationClip> AnimationClipCooker::load(const std::filesystem::path& cooked_path, int64_t source_write_time) {
+        std::ifstream file(cooked_path, std::ios::binary);
+        if (!file) {
+            return nullptr;
+        }
+        CookedAnimationClipHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            header.magic != s_magic || header.version != s_version || header.source_write_time != source_write_time) {
+            return nullptr;
+        }
+
+        std::shared_ptr<CompressedAnimationClip> clip = std::make_shared<CompressedAnimationClip>();
+        clip->m_total_frame = header.total_frame;
+        clip->m_channels.resize(header.channel_count);
+        clip->m_key_frames.resize(header.key_count);
+        clip->m_key_values.resize(size_t(header.key_count) * 3);
+        file.read(reinterpret_cast<char*>(clip->m_channels.data()), static_cast<std::streamsize>(clip->m_channels.size() * sizeof(CompressedAnimationChannel)));
+        file.read(reinterpret_cast<char*>(clip->m_key_frames.data()), static_cast<std::streamsize>(clip->m_key_frames.size() * sizeof(uint16_t)));
+        file.read(reinterpret_cast<char*>(clip->m_key_values.data()), static_cast<std::streamsize>(clip->m_key_values.size() * sizeof(uint16_t)));
+        if (!file) {
+            LOG_WARN("cooked animation clip {} is truncated", cooked_path.generic_string());
+            return nullptr;
+        }
+        // the sampler indexes the key arrays without checks
+        for (const CompressedAnimationChannel& channel : clip->m_channels) {
+            if (!isTrackInClip(channel.m_position.m_first_key, channel.m_position.m_key_count, header.key_count) ||
+                !isTrackInClip(channel.m_rotation.m_first_key, channel.m_rotation.m_key_count, header.key_count) ||
+                !isTrackInClip(channel.m_scaling.m_first_key, channel.m_scaling.m_key_count, header.key_count)) {
+                LOG_WARN("cooked animation clip {} is corrupted", cooked_path.generic_string());
+                return nullptr;
+            }
+        }
+        return clip;
+    }
+}
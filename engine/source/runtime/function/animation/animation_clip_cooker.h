@@ -0,0 +1,36 @@
+#pragma once
+
+#include "runtime/function/animation/animation_compression.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace Dao {
+
+    /// layout of a cooked clip file, the channels follow the header, then the key frames and the key values
+    struct CookedAnimationClipHeader {
+        uint32_t magic;
+        uint32_t version;
+        // last write time of the source file the clip was cooked from
+        int64_t  source_write_time;
+        int32_t  total_frame;
+        uint32_t channel_count;
+        uint32_t key_count;
+        uint32_t reserved;
+    };
+
+    /// versioned binary container for compressed clips, cooked once from the .json source so loading skips parsing and compression
+    class AnimationClipCooker {
+    public:
+        static constexpr uint32_t s_magic = 0x4D4E4144; //"DANM"
+        static constexpr uint32_t s_version = 1;
+
+        /// the cooked file lives next to its source
+        static std::filesystem::path getCookedPath(const std::filesystem::path& source_path);
+
+        static bool cook(const std::filesystem::path& cooked_path, int64_t source_write_time, const CompressedAnimationClip& clip);
+        /// fails for missing files, other versions and files cooked from a different source write time
+        static std::shared_ptr<CompressedAnimationClip> load(const std::filesystem::path& cooked_path, int64_t source_write_time);
+    };
+}
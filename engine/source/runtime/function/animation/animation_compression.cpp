@@ -0,0 +1,255 @@
+#include "runtime/function/animation/animation_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Dao {
+
+    namespace {
+        // the three smallest components of a unit quaternion are within +-1/sqrt(2)
+        constexpr float    s_smallest_three_range = 0.70710678f;
+        constexpr uint16_t s_rotation_value_max = 0x7fff;
+        constexpr uint16_t s_vector_value_max = 0xffff;
+
+        // 15 bits per component, the index of the dropped largest component goes into the top bits of the first two
+        void encodeRotation(const Quaternion& rotation, uint16_t* out) {
+            Quaternion normalized = rotation;
+            normalized.normalise();
+            const float components[4] = { normalized.w, normalized.x, normalized.y, normalized.z };
+            uint32_t largest = 0;
+            for (uint32_t i = 1; i < 4; ++i) {
+                if (std::fabs(components[i]) > std::fabs(components[largest])) {
+                    largest = i;
+                }
+            }
+            // q and -q are the same rotation, the dropped component is always positive
+            const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+            uint16_t values[3];
+            uint32_t value_index = 0;
+            for (uint32_t i = 0; i < 4; ++i) {
+                if (i == largest) {
+                    continue;
+                }
+                const float normalized_value = std::clamp(components[i] * sign / s_smallest_three_range * 0.5f + 0.5f, 0.0f, 1.0f);
+                values[value_index++] = static_cast<uint16_t>(std::lround(normalized_value * s_rotation_value_max));
+            }
+            out[0] = static_cast<uint16_t>(values[0] | ((largest >> 1) << 15));
+            out[1] = static_cast<uint16_t>(values[1] | ((largest & 1) << 15));
+            out[2] = values[2];
+        }
+
+        Quaternion decodeRotation(const uint16_t* in) {
+            const uint32_t largest = ((in[0] >> 15) << 1) | (in[1] >> 15);
+            float components[4];
+            float sum = 0.0f;
+            uint32_t value_index = 0;
+            for (uint32_t i = 0; i < 4; ++i) {
+                if (i == largest) {
+                    continue;
+                }
+                const float value = (static_cast<float>(in[value_index++] & s_rotation_value_max) / s_rotation_value_max * 2.0f - 1.0f) * s_smallest_three_range;
+                components[i] = value;
+                sum += value * value;
+            }
+            components[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+            return Quaternion(components[0], components[1], components[2], components[3]);
+        }
+
+        void encodeVector(const Vector3& value, const Vector3& min, const Vector3& extent, uint16_t* out) {
+            const float values[3] = { value.x, value.y, value.z };
+            const float mins[3] = { min.x, min.y, min.z };
+            const float extents[3] = { extent.x, extent.y, extent.z };
+            for (uint32_t i = 0; i < 3; ++i) {
+                const float normalized_value = extents[i] > 0.0f ? std::clamp((values[i] - mins[i]) / extents[i], 0.0f, 1.0f) : 0.0f;
+                out[i] = static_cast<uint16_t>(std::lround(normalized_value * s_vector_value_max));
+            }
+        }
+
+        Vector3 decodeVector(const uint16_t* in, const Vector3& min, const Vector3& extent) {
+            return Vector3(
+                min.x + static_cast<float>(in[0]) / s_vector_value_max * extent.x,
+                min.y + static_cast<float>(in[1]) / s_vector_value_max * extent.y,
+                min.z + static_cast<float>(in[2]) / s_vector_value_max * extent.z
+            );
+        }
+
+        bool isVectorWithin(const Vector3& a, const Vector3& b, float tolerance) {
+            return std::fabs(a.x - b.x) <= tolerance && std::fabs(a.y - b.y) <= tolerance && std::fabs(a.z - b.z) <= tolerance;
+        }
+
+        // compares the chord between the unit quaternions, 2 * sin(angle / 4), the cosine of small angles rounds to 1 in float
+        bool isRotationWithin(const Quaternion& a, const Quaternion& b, float max_chord) {
+            Quaternion normalized_a = a;
+            Quaternion normalized_b = b;
+            normalized_a.normalise();
+            normalized_b.normalise();
+            if (normalized_a.dot(normalized_b) < 0.0f) {
+                normalized_b = -normalized_b;
+            }
+            const Quaternion chord = normalized_a - normalized_b;
+            return chord.dot(chord) <= max_chord * max_chord;
+        }
+
+        // greedy reduction, a key is dropped while the line between the decoded neighbours it would be interpolated
+        // from stays within the tolerance of every source key it spans. the first and the last key are always kept
+        template<typename T, typename Interpolate, typename IsWithin>
+        std::vector<uint32_t> reduceKeys(const std::vector<T>& source, const std::vector<T>& decoded, Interpolate interpolate, IsWithin is_within) {
+            const uint32_t key_count = static_cast<uint32_t>(decoded.size());
+            std::vector<uint32_t> kept_keys{ 0 };
+            uint32_t start = 0;
+            for (uint32_t end = 2; end < key_count; ++end) {
+                bool is_reducible = true;
+                for (uint32_t key = start + 1; key < end && is_reducible; ++key) {
+                    const float t = static_cast<float>(key - start) / static_cast<float>(end - start);
+                    is_reducible = is_within(interpolate(decoded[start], decoded[end], t), source[key]);
+                }
+                if (!is_reducible) {
+                    kept_keys.push_back(end - 1);
+                    start = end - 1;
+                }
+            }
+            if (key_count > 1) {
+                kept_keys.push_back(key_count - 1);
+            }
+            return kept_keys;
+        }
+
+        CompressedVectorTrack compressVectorTrack(const std::vector<Vector3>& keys, uint32_t frame_count, float tolerance, CompressedAnimationClip& clip) {
+            CompressedVectorTrack track;
+            const std::vector<Vector3> source(keys.begin(), keys.begin() + frame_count);
+            const bool is_constant = std::all_of(source.begin(), source.end(), [&](const Vector3& key) { return isVectorWithin(key, source[0], tolerance); });
+            if (is_constant) {
+                track.m_min = source[0];
+                return track;
+            }
+
+            Vector3 max = source[0];
+            track.m_min = source[0];
+            for (const Vector3& key : source) {
+                track.m_min.makeFloor(key);
+                max.makeCeil(key);
+            }
+            track.m_extent = max - track.m_min;
+
+            std::vector<uint16_t> encoded(size_t(frame_count) * 3);
+            std::vector<Vector3> decoded(frame_count);
+            for (uint32_t frame = 0; frame < frame_count; ++frame) {
+                encodeVector(source[frame], track.m_min, track.m_extent, &encoded[size_t(frame) * 3]);
+                decoded[frame] = decodeVector(&encoded[size_t(frame) * 3], track.m_min, track.m_extent);
+            }
+            const std::vector<uint32_t> kept_keys = reduceKeys(source, decoded,
+                [](const Vector3& a, const Vector3& b, float t) { return Vector3::lerp(a, b, t); },
+                [tolerance](const Vector3& a, const Vector3& b) { return isVectorWithin(a, b, tolerance); });
+
+            track.m_first_key = static_cast<uint32_t>(clip.m_key_frames.size());
+            track.m_key_count = static_cast<uint32_t>(kept_keys.size());
+            for (uint32_t frame : kept_keys) {
+                clip.m_key_frames.push_back(static_cast<uint16_t>(frame));
+                clip.m_key_values.insert(clip.m_key_values.end(), encoded.begin() + size_t(frame) * 3, encoded.begin() + size_t(frame) * 3 + 3);
+            }
+            return track;
+        }
+
+        CompressedRotationTrack compressRotationTrack(const std::vector<Quaternion>& keys, uint32_t frame_count, float tolerance, CompressedAnimationClip& clip) {
+            CompressedRotationTrack track;
+            const std::vector<Quaternion> source(keys.begin(), keys.begin() + frame_count);
+            const float max_chord = 2.0f * std::sin(tolerance * 0.25f);
+            const bool is_constant = std::all_of(source.begin(), source.end(), [&](const Quaternion& key) { return isRotationWithin(key, source[0], max_chord); });
+            if (is_constant) {
+                track.m_constant = source[0];
+                track.m_constant.normalise();
+                return track;
+            }
+
+            std::vector<uint16_t> encoded(size_t(frame_count) * 3);
+            std::vector<Quaternion> decoded(frame_count);
+            for (uint32_t frame = 0; frame < frame_count; ++frame) {
+                encodeRotation(source[frame], &encoded[size_t(frame) * 3]);
+                decoded[frame] = decodeRotation(&encoded[size_t(frame) * 3]);
+            }
+            const std::vector<uint32_t> kept_keys = reduceKeys(source, decoded,
+                [](const Quaternion& a, const Quaternion& b, float t) { return Quaternion::nLerp(t, a, b, true); },
+                [max_chord](const Quaternion& a, const Quaternion& b) { return isRotationWithin(a, b, max_chord); });
+
+            track.m_first_key = static_cast<uint32_t>(clip.m_key_frames.size());
+            track.m_key_count = static_cast<uint32_t>(kept_keys.size());
+            for (uint32_t frame : kept_keys) {
+                clip.m_key_frames.push_back(static_cast<uint16_t>(frame));
+                clip.m_key_values.insert(clip.m_key_values.end(), encoded.begin() + size_t(frame) * 3, encoded.begin() + size_t(frame) * 3 + 3);
+            }
+            return track;
+        }
+
+        // the stored key at or before the frame, tracks always start with frame 0
+        uint32_t findKey(const std::vector<uint16_t>& key_frames, uint32_t first_key, uint32_t key_count, uint32_t frame) {
+            const auto begin = key_frames.begin() + first_key;
+            const auto found = std::upper_bound(begin, begin + key_count, frame);
+            return static_cast<uint32_t>(std::max<ptrdiff_t>(found - key_frames.begin() - 1, first_key));
+        }
+
+        Vector3 sampleVectorTrack(const CompressedAnimationClip& clip, const CompressedVectorTrack& track, uint32_t frame) {
+            if (track.m_key_count == 0) {
+                return track.m_min;
+            }
+            const uint32_t key = findKey(clip.m_key_frames, track.m_first_key, track.m_key_count, frame);
+            const Vector3 value = decodeVector(&clip.m_key_values[size_t(key) * 3], track.m_min, track.m_extent);
+            if (key + 1 == track.m_first_key + track.m_key_count || clip.m_key_frames[key] == frame) {
+                return value;
+            }
+            const Vector3 next_value = decodeVector(&clip.m_key_values[size_t(key + 1) * 3], track.m_min, track.m_extent);
+            const float t = static_cast<float>(frame - clip.m_key_frames[key]) / static_cast<float>(clip.m_key_frames[key + 1] - clip.m_key_frames[key]);
+            return Vector3::lerp(value, next_value, t);
+        }
+
+        Quaternion sampleRotationTrack(const CompressedAnimationClip& clip, const CompressedRotationTrack& track, uint32_t frame) {
+            if (track.m_key_count == 0) {
+                return track.m_constant;
+            }
+            const uint32_t key = findKey(clip.m_key_frames, track.m_first_key, track.m_key_count, frame);
+            const Quaternion value = decodeRotation(&clip.m_key_values[size_t(key) * 3]);
+            if (key + 1 == track.m_first_key + track.m_key_count || clip.m_key_frames[key] == frame) {
+                return value;
+            }
+            const Quaternion next_value = decodeRotation(&clip.m_key_values[size_t(key + 1) * 3]);
+            const float t = static_cast<float>(frame - clip.m_key_frames[key]) / static_cast<float>(clip.m_key_frames[key + 1] - clip.m_key_frames[key]);
+            return Quaternion::nLerp(t, value, next_value, true);
+        }
+    }
+
+    void CompressedAnimationClip::sampleChannel(size_t channel_index, uint32_t frame, Vector3& out_position, Quaternion& out_rotation, Vector3& out_scaling) const {
+        const CompressedAnimationChannel& channel = m_channels[channel_index];
+        if (channel.m_frame_count > 0) {
+            frame = std::min(frame, channel.m_frame_count - 1);
+        }
+        out_position = sampleVectorTrack(*this, channel.m_position, frame);
+        out_rotation = sampleRotationTrack(*this, channel.m_rotation, frame);
+        out_scaling = sampleVectorTrack(*this, channel.m_scaling, frame);
+    }
+
+    std::shared_ptr<CompressedAnimationClip> CompressAnimationClip(const AnimationClip& clip, const AnimationCompressionSettings& settings) {
+        std::shared_ptr<CompressedAnimationClip> compressed_clip = std::make_shared<CompressedAnimationClip>();
+        compressed_clip->m_total_frame = clip.m_total_frame;
+        const size_t channel_count = std::min(static_cast<size_t>(std::max(clip.m_node_count, 0)), clip.m_node_channels.size());
+        compressed_clip->m_channels.resize(channel_count);
+        for (size_t channel_index = 0; channel_index < channel_count; ++channel_index) {
+            const AnimationChannel& source_channel = clip.m_node_channels[channel_index];
+            CompressedAnimationChannel& channel = compressed_clip->m_channels[channel_index];
+            const size_t frame_count = std::min({ source_channel.m_position_keys.size(), source_channel.m_rotation_keys.size(), source_channel.m_scaling_keys.size() });
+            if (frame_count > size_t(std::numeric_limits<uint16_t>::max()) + 1) {
+                return nullptr;
+            }
+            // channels without keys stay empty and are skipped by the sampler
+            channel.m_frame_count = static_cast<uint32_t>(frame_count);
+            if (frame_count == 0) {
+                continue;
+            }
+            channel.m_position = compressVectorTrack(source_channel.m_position_keys, channel.m_frame_count, settings.m_translation_tolerance, *compressed_clip);
+            channel.m_rotation = compressRotationTrack(source_channel.m_rotation_keys, channel.m_frame_count, settings.m_rotation_tolerance, *compressed_clip);
+            channel.m_scaling = compressVectorTrack(source_channel.m_scaling_keys, channel.m_frame_count, settings.m_scale_tolerance, *compressed_clip);
+        }
+        compressed_clip->m_key_frames.shrink_to_fit();
+        compressed_clip->m_key_values.shrink_to_fit();
+        return compressed_clip;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "runtime/core/math/quaternion.h"
+#include "runtime/core/math/vector3.h"
+#include "runtime/resource/res_type/data/animation_clip.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Dao {
+
+    struct AnimationCompressionSettings {
+        // largest error of a reduced key, in model units for translations and scales, in radians for rotations
+        float m_translation_tolerance{ 0.0001f };
+        float m_rotation_tolerance{ 0.0005f };
+        float m_scale_tolerance{ 0.0001f };
+    };
+
+    // a track without keys is constant, its value is m_min. keys store every component as 16 bit fraction of m_extent
+    struct CompressedVectorTrack {
+        uint32_t m_first_key{ 0 };
+        uint32_t m_key_count{ 0 };
+        Vector3  m_min{ Vector3::ZERO };
+        Vector3  m_extent{ Vector3::ZERO };
+    };
+
+    // a track without keys is constant, keys are smallest three encoded in 3 x 16 bit
+    struct CompressedRotationTrack {
+        uint32_t   m_first_key{ 0 };
+        uint32_t   m_key_count{ 0 };
+        Quaternion m_constant{ Quaternion::IDENTITY };
+    };
+
+    struct CompressedAnimationChannel {
+        // frames the source channel had keys for, sampling clamps to the last one
+        uint32_t                m_frame_count{ 0 };
+        CompressedVectorTrack   m_position;
+        CompressedRotationTrack m_rotation;
+        CompressedVectorTrack   m_scaling;
+    };
+
+    /// an AnimationClip with constant tracks collapsed, reduced keyframes and quantized keys.
+    /// the keys of all tracks share two flat arrays so sampling a clip walks a few small buffers
+    class CompressedAnimationClip {
+    public:
+        int                                     m_total_frame{ 0 };
+        std::vector<CompressedAnimationChannel> m_channels;
+        // frame of every stored key, ascending within a track
+        std::vector<uint16_t>                   m_key_frames;
+        // three values per stored key
+        std::vector<uint16_t>                   m_key_values;
+
+        /// decompress the channel at a source frame, frames between reduced keys are interpolated
+        void sampleChannel(size_t channel_index, uint32_t frame, Vector3& out_position, Quaternion& out_rotation, Vector3& out_scaling) const;
+    };
+
+    /// @return: nullptr for clips with more frames than a key frame index can hold
+    std::shared_ptr<CompressedAnimationClip> CompressAnimationClip(const AnimationClip& clip, const AnimationCompressionSettings& settings);
+}
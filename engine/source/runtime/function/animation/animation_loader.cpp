@@ -1,7 +1,10 @@
 #include "runtime/function/animation/animation_loader.h"
 
+#include "runtime/core/base/macro.h"
 #include "runtime/function/global/global_context.h"
+#include "runtime/function/animation/animation_clip_cooker.h"
 #include "runtime/function/animation/utilities.h"
+#include "runtime/platform/file_system/cooked_file.h"
 #include "runtime/resource/res_type/data/mesh_data.h"
 #include "runtime/resource/asset_manager/asset_manager.h"
 
@@ -58,6 +61,25 @@ namespace Dao {
         return std::make_shared<AnimationClip>(animation_clip.m_clip_data);
     }
 
+    std::shared_ptr<CompressedAnimationClip> AnimationLoader::loadCompressedAnimationClip(std::string animation_clip_url) {
+        const std::filesystem::path source_path = g_runtime_global_context.m_asset_manager->getFullPath(animation_clip_url);
+        const std::filesystem::path cooked_path = AnimationClipCooker::getCookedPath(source_path);
+        const int64_t source_write_time = GetCookSourceWriteTime(source_path);
+        std::shared_ptr<CompressedAnimationClip> clip = AnimationClipCooker::load(cooked_path, source_write_time);
+        if (clip) {
+            return clip;
+        }
+
+        std::shared_ptr<AnimationClip> source_clip = loadAnimationClipData(animation_clip_url);
+        clip = CompressAnimationClip(*source_clip, AnimationCompressionSettings{});
+        if (!clip) {
+            LOG_ERROR("animation clip {} has more frames than a compressed clip can hold", animation_clip_url);
+            return nullptr;
+        }
+        AnimationClipCooker::cook(cooked_path, source_write_time, *clip);
+        return clip;
+    }
+
     std::shared_ptr<SkeletonData> AnimationLoader::loadSkeletonData(std::string skeleton_data_url) {
         SkeletonData data;
         g_runtime_global_context.m_asset_manager->loadAsset(skeleton_data_url, data);
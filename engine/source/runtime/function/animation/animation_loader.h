@@ -1,5 +1,6 @@
 #pragma once
 
+#include "runtime/function/animation/animation_compression.h"
 #include "runtime/resource/res_type/data/animation_clip.h"
 #include "runtime/resource/res_type/data/animation_skeleton_node_map.h"
 #include "runtime/resource/res_type/data/skeleton_data.h"
@@ -13,6 +14,8 @@ namespace Dao {
     class AnimationLoader {
     public:
         std::shared_ptr<AnimationClip> loadAnimationClipData(std::string animation_clip_url);
+        /// load the cooked clip, the source is only parsed and compressed when its cooked file is missing or stale
+        std::shared_ptr<CompressedAnimationClip> loadCompressedAnimationClip(std::string animation_clip_url);
         std::shared_ptr<SkeletonData> loadSkeletonData(std::string skeleton_data_url);
         std::shared_ptr<AnimSkelMap> loadAnimSkelMap(std::string anim_skel_map_url);
         std::shared_ptr<BoneBlendMask> loadSkeletonMask(std::string skeleton_mask_file_url);
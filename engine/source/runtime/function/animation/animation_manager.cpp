@@ -1,12 +1,15 @@
 #include "runtime/function/animation/animation_manager.h"
 
+#include "runtime/core/base/macro.h"
 #include "runtime/function/animation/animation_loader.h"
-#include "runtime/function/animation/skeleton.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace Dao {
 
     std::map<std::string, std::shared_ptr<SkeletonData>> AnimationManager::_skeleton_definition_cache;
-    std::map<std::string, std::shared_ptr<AnimationClip>> AnimationManager::_animation_data_cache;
+    std::map<std::string, std::shared_ptr<CompressedAnimationClip>> AnimationManager::_animation_data_cache;
     std::map<std::string, std::shared_ptr<AnimSkelMap>> AnimationManager::_animation_skeleton_map_cache;
     std::map<std::string, std::shared_ptr<BoneBlendMask>> AnimationManager::_skeleton_mask_cache;
 
@@ -24,12 +27,12 @@ namespace Dao {
         return res;
     }
 
-    std::shared_ptr<AnimationClip> AnimationManager::tryLoadAnimation(std::string file_path) {
-        std::shared_ptr<AnimationClip> res;
+    std::shared_ptr<CompressedAnimationClip> AnimationManager::tryLoadAnimation(std::string file_path) {
+        std::shared_ptr<CompressedAnimationClip> res;
         AnimationLoader loader;
         auto found = _animation_data_cache.find(file_path);
         if (found == _animation_data_cache.end()) {
-            res = loader.loadAnimationClipData(file_path);
+            res = loader.loadCompressedAnimationClip(file_path);
             _animation_data_cache.emplace(file_path, res);
         }
         else {
@@ -66,56 +69,50 @@ namespace Dao {
         return res;
     }
 
-    BlendStateWithClipData AnimationManager::getBlendStateWithClipData(const BlendState& blend_state) {
-
-        for (auto animation_file_path : blend_state.m_blend_clip_file_path) {
-            tryLoadAnimation(animation_file_path);
-        }
-        for (auto anim_skel_map_path : blend_state.m_blend_anim_skel_map_path) {
-            tryLoadAnimationSkeletonMap(anim_skel_map_path);
-        }
-        for (auto skeleton_mask_path : blend_state.m_blend_mask_file_path) {
-            tryLoadSkeletonMask(skeleton_mask_path);
+    std::shared_ptr<const BlendStateInstance> AnimationManager::createBlendStateInstance(const BlendState& blend_state, size_t skeleton_bone_count) {
+        const size_t clip_count = static_cast<size_t>(std::max(blend_state.m_clip_count, 0));
+        if (blend_state.m_blend_clip_file_path.size() < clip_count || blend_state.m_blend_anim_skel_map_path.size() < clip_count ||
+            blend_state.m_blend_weight.size() < clip_count || blend_state.m_blend_ratio.size() < clip_count ||
+            blend_state.m_blend_clip_file_length.size() < clip_count) {
+            LOG_ERROR("blend state describes less clips than its clip count");
+            return nullptr;
         }
 
-        BlendStateWithClipData blend_state_with_clip_data;
-        blend_state_with_clip_data.m_clip_count = blend_state.m_clip_count;
-        blend_state_with_clip_data.m_blend_ratio = blend_state.m_blend_ratio;
-        for (const auto& iter : blend_state.m_blend_clip_file_path) {
-            blend_state_with_clip_data.m_blend_clip.push_back(*_animation_data_cache[iter]);
-        }
-        for (const auto& iter : blend_state.m_blend_anim_skel_map_path) {
-            blend_state_with_clip_data.m_blend_anim_skel_map.push_back(*_animation_skeleton_map_cache[iter]);
-        }
-        std::vector<std::shared_ptr<BoneBlendMask>> blend_masks;
-        for (auto& iter : blend_state.m_blend_mask_file_path) {
-            blend_masks.push_back(_skeleton_mask_cache[iter]);
-            tryLoadAnimationSkeletonMap(_skeleton_mask_cache[iter]->m_skeleton_file_path);
+        std::shared_ptr<BlendStateInstance> instance = std::make_shared<BlendStateInstance>();
+        instance->m_clips.resize(clip_count);
+        std::vector<std::shared_ptr<BoneBlendMask>> blend_masks(clip_count);
+        for (size_t clip_index = 0; clip_index < clip_count; ++clip_index) {
+            BlendStateClip& clip = instance->m_clips[clip_index];
+            clip.m_clip = tryLoadAnimation(blend_state.m_blend_clip_file_path[clip_index]);
+            clip.m_anim_skel_map = tryLoadAnimationSkeletonMap(blend_state.m_blend_anim_skel_map_path[clip_index]);
+            if (!clip.m_clip || !clip.m_anim_skel_map) {
+                LOG_ERROR("failed to load animation clip {}", blend_state.m_blend_clip_file_path[clip_index]);
+                return nullptr;
+            }
+            // a clip without mask drives every bone
+            if (clip_index < blend_state.m_blend_mask_file_path.size()) {
+                blend_masks[clip_index] = tryLoadSkeletonMask(blend_state.m_blend_mask_file_path[clip_index]);
+            }
         }
-        size_t skeleton_bone_count = _skeleton_definition_cache[blend_masks[0]->m_skeleton_file_path]->m_bones_map.size();
-        blend_state_with_clip_data.m_blend_weight.resize(blend_state.m_clip_count);
-        for (size_t clip_index = 0; clip_index < blend_state.m_clip_count; ++clip_index) {
-            blend_state_with_clip_data.m_blend_weight[clip_index].blend_weight.resize(skeleton_bone_count);
+
+        for (size_t clip_index = 0; clip_index < clip_count; ++clip_index) {
+            instance->m_clips[clip_index].m_bone_weight.resize(skeleton_bone_count);
         }
         for (size_t bone_index = 0; bone_index < skeleton_bone_count; ++bone_index) {
             float sum_weight = 0;
-            for (size_t clip_index = 0; clip_index < blend_state.m_clip_count; ++clip_index) {
-                if (blend_masks[clip_index]->m_enabled[bone_index]) {
+            for (size_t clip_index = 0; clip_index < clip_count; ++clip_index) {
+                const std::shared_ptr<BoneBlendMask>& mask = blend_masks[clip_index];
+                if (!mask || (bone_index < mask->m_enabled.size() && mask->m_enabled[bone_index])) {
                     sum_weight += blend_state.m_blend_weight[clip_index];
                 }
             }
-            if (fabs(sum_weight) < 0.0001f) {
-                // LOG_ERROR
-            }
-            for (size_t clip_index = 0; clip_index < blend_state.m_clip_count; ++clip_index) {
-                if (blend_masks[clip_index]->m_enabled[bone_index]) {
-                    blend_state_with_clip_data.m_blend_weight[clip_index].blend_weight[bone_index] = blend_state.m_blend_weight[clip_index] / sum_weight;
-                }
-                else {
-                    blend_state_with_clip_data.m_blend_weight[clip_index].blend_weight[bone_index] = 0;
-                }
+            for (size_t clip_index = 0; clip_index < clip_count; ++clip_index) {
+                const std::shared_ptr<BoneBlendMask>& mask = blend_masks[clip_index];
+                const bool is_enabled = !mask || (bone_index < mask->m_enabled.size() && mask->m_enabled[bone_index]);
+                instance->m_clips[clip_index].m_bone_weight[bone_index] =
+                    (is_enabled && fabs(sum_weight) >= 0.0001f) ? blend_state.m_blend_weight[clip_index] / sum_weight : 0;
             }
         }
-        return blend_state_with_clip_data;
+        return instance;
     }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "runtime/function/animation/blend_state_instance.h"
 #include "runtime/resource/res_type/data/animation_clip.h"
 #include "runtime/resource/res_type/data/animation_skeleton_node_map.h"
 #include "runtime/resource/res_type/data/blend_state.h"
@@ -15,16 +16,18 @@ namespace Dao {
     class AnimationManager {
     public:
         static std::shared_ptr<SkeletonData>  tryLoadSkeleton(std::string file_path);
-        static std::shared_ptr<AnimationClip> tryLoadAnimation(std::string file_path);
+        static std::shared_ptr<CompressedAnimationClip> tryLoadAnimation(std::string file_path);
         static std::shared_ptr<AnimSkelMap>   tryLoadAnimationSkeletonMap(std::string file_path);
         static std::shared_ptr<BoneBlendMask> tryLoadSkeletonMask(std::string file_path);
-        static BlendStateWithClipData getBlendStateWithClipData(const BlendState& blend_state);
+        /// load everything the blend state references and precompute the per bone weights of its clips
+        /// @return: nullptr when a clip or its skeleton map is missing
+        static std::shared_ptr<const BlendStateInstance> createBlendStateInstance(const BlendState& blend_state, size_t skeleton_bone_count);
 
         AnimationManager() = default;
 
     private:
         static std::map<std::string, std::shared_ptr<SkeletonData>> _skeleton_definition_cache;
-        static std::map<std::string, std::shared_ptr<AnimationClip>> _animation_data_cache;
+        static std::map<std::string, std::shared_ptr<CompressedAnimationClip>> _animation_data_cache;
         static std::map<std::string, std::shared_ptr<AnimSkelMap>> _animation_skeleton_map_cache;
         static std::map<std::string, std::shared_ptr<BoneBlendMask>> _skeleton_mask_cache;
     };
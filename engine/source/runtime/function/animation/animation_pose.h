@@ -0,0 +1,27 @@
+#pragma once
+
+#include "runtime/core/math/quaternion.h"
+#include "runtime/core/math/vector3.h"
+
+#include <vector>
+
+namespace Dao {
+
+    /// transforms of every bone of a skeleton in topological order, one array per component
+    /// so a pass over the pose streams through memory instead of chasing bone objects
+    struct AnimationPose {
+        std::vector<Vector3>    m_translations;
+        std::vector<Quaternion> m_rotations;
+        std::vector<Vector3>    m_scales;
+
+        void resize(size_t bone_count) {
+            m_translations.resize(bone_count, Vector3::ZERO);
+            m_rotations.resize(bone_count, Quaternion::IDENTITY);
+            m_scales.resize(bone_count, Vector3::UNIT_SCALE);
+        }
+
+        size_t size() const {
+            return m_translations.size();
+        }
+    };
+}
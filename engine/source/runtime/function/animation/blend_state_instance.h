@@ -0,0 +1,23 @@
+#pragma once
+
+#include "runtime/function/animation/animation_compression.h"
+#include "runtime/resource/res_type/data/animation_skeleton_node_map.h"
+
+#include <memory>
+#include <vector>
+
+namespace Dao {
+
+    struct BlendStateClip {
+        std::shared_ptr<const CompressedAnimationClip> m_clip;
+        std::shared_ptr<const AnimSkelMap>             m_anim_skel_map;
+        // per skeleton bone, normalized over the clips the bone is enabled in
+        std::vector<float>                             m_bone_weight;
+    };
+
+    /// a BlendState resolved once against the animation caches, the clips are shared with the caches
+    /// so evaluating it every frame only decompresses the keys it samples. the blend ratios stay in the BlendState
+    struct BlendStateInstance {
+        std::vector<BlendStateClip> m_clips;
+    };
+}
@@ -1,116 +1,178 @@
 #include "runtime/function/animation/skeleton.h"
 
+#include "runtime/core/base/macro.h"
 #include "runtime/core/math/math.h"
-#include "runtime/function/animation/utilities.h"
+#include "runtime/core/math/simd_math.h"
+#include "runtime/function/animation/blend_state_instance.h"
+#include "runtime/resource/res_type/data/skeleton_data.h"
 
-namespace Dao {
+#include <algorithm>
 
-    Skeleton::~Skeleton() {
-        delete[] _bones;
-    }
+namespace Dao {
 
     void Skeleton::resetSkeleton() {
-        for (size_t i = 0; i < _bone_count; ++i) {
-            _bones[i].resetToInitialPose();
-        }
+        _local_pose = _binding_pose;
     }
 
     void Skeleton::buildSkeleton(const SkeletonData& skeleton_definition) {
-        _is_flat = skeleton_definition.m_is_flat;
-        if (_bones != nullptr) {
-            delete[] _bones;
-        }
-        if (!_is_flat || !skeleton_definition.m_in_topological_order) {
-            // LOG_ERROR
+        _bone_count = 0;
+        if (!skeleton_definition.m_is_flat || !skeleton_definition.m_in_topological_order) {
+            LOG_ERROR("only flat skeletons in topological order are supported");
             return;
         }
-        _bone_count = skeleton_definition.m_bones_map.size();
-        _bones = new Bone[_bone_count];
-        for (size_t i = 0; i < _bone_count; ++i) {
-            const RawBone bone_definition = skeleton_definition.m_bones_map[i];
-            Bone* parent_bone = find_by_index(_bones, bone_definition.m_parent_index, i, _is_flat);
-            _bones[i].initialize(std::make_shared<RawBone>(bone_definition), parent_bone);
+        _bone_count = static_cast<int32_t>(skeleton_definition.m_bones_map.size());
+        _parent_indices.resize(_bone_count);
+        _inverse_tposes.resize(_bone_count);
+        _binding_pose.resize(_bone_count);
+        for (int32_t i = 0; i < _bone_count; ++i) {
+            const RawBone& bone_definition = skeleton_definition.m_bones_map[i];
+            //a bone can only hang below bones that come before it
+            const int32_t parent_index = bone_definition.m_parent_index;
+            _parent_indices[i] = (parent_index >= 0 && parent_index < i) ? parent_index : -1;
+            _inverse_tposes[i] = bone_definition.m_tpose_matrix;
+
+            Quaternion rotation = bone_definition.m_binding_pose.m_rotation;
+            if (rotation.isNaN()) {
+                rotation = Quaternion::IDENTITY;
+            }
+            rotation.normalise();
+            _binding_pose.m_translations[i] = bone_definition.m_binding_pose.m_position;
+            _binding_pose.m_rotations[i] = rotation;
+            _binding_pose.m_scales[i] = bone_definition.m_binding_pose.m_scale;
         }
+        _local_pose = _binding_pose;
+        _model_pose = _binding_pose;
+        _skinning_matrices.resize(_bone_count);
+        _blend_pose.resize(_bone_count);
+        _blend_weights.resize(_bone_count);
+        _sampled_bone_indices.reserve(_bone_count);
+        updateModelPose();
     }
 
-    void Skeleton::applyAnimation(const BlendStateWithClipData& blend_state) {
-        if (!_bones) {
+    void Skeleton::applyAnimation(const BlendStateInstance& blend_state, const std::vector<float>& blend_ratio) {
+        if (_bone_count == 0) {
             return;
         }
         resetSkeleton();
-        for (size_t clip_index = 0; clip_index < 1; ++clip_index) {
-            const AnimationClip& animation_clip = blend_state.m_blend_clip[clip_index];
-            const float phase = blend_state.m_blend_ratio[clip_index];
-            const AnimSkelMap& anim_skel_map = blend_state.m_blend_anim_skel_map[clip_index];
-
-            float exact_frame = phase * (animation_clip.m_total_frame - 1);
-            int current_frame_low = floor(exact_frame);
-            int current_frame_high = ceil(exact_frame);
-            float lerp_ratio = exact_frame - current_frame_low;
-            for (size_t node_index = 0; node_index < animation_clip.m_node_count && node_index < anim_skel_map.m_convert.size(); ++node_index) {
-                AnimationChannel channel = animation_clip.m_node_channels[node_index];
-                size_t bone_index = anim_skel_map.m_convert[node_index];
-                float weight = 1; // blend_state.blend_weight[clip_index]->blend_weight[bone_index];
-                weight = 1;
-                if (fabs(weight) < 0.0001f) {
-                    continue;
-                }
-                if (bone_index == std::numeric_limits<size_t>().max()) {
-                    // LOG_WARNING
-                    continue;
-                }
-                Bone* bone = &_bones[bone_index];
-                if (channel.m_position_keys.size() <= current_frame_high) {
-                    current_frame_high = channel.m_position_keys.size() - 1;
-                }
-                if (channel.m_scaling_keys.size() <= current_frame_high) {
-                    current_frame_high = channel.m_scaling_keys.size() - 1;
-                }
-                if (channel.m_rotation_keys.size() <= current_frame_high) {
-                    current_frame_high = channel.m_rotation_keys.size() - 1;
-                }
-                current_frame_low = (current_frame_low < current_frame_high) ? current_frame_low : current_frame_high;
-                Vector3 position = Vector3::lerp(channel.m_position_keys[current_frame_low], channel.m_position_keys[current_frame_high], lerp_ratio);
-                Vector3 scaling = Vector3::lerp(channel.m_scaling_keys[current_frame_low], channel.m_scaling_keys[current_frame_high], lerp_ratio);
-                Quaternion rotation = Quaternion::nLerp(lerp_ratio, channel.m_rotation_keys[current_frame_low], channel.m_rotation_keys[current_frame_high], true);
-                bone->rotate(rotation);
-                bone->scale(scaling);
-                bone->translate(position);
+
+        //every clip is accumulated into the blend pose with its per bone weight, bones no clip drives keep the binding pose
+        std::fill(_blend_pose.m_translations.begin(), _blend_pose.m_translations.end(), Vector3::ZERO);
+        std::fill(_blend_pose.m_rotations.begin(), _blend_pose.m_rotations.end(), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+        std::fill(_blend_pose.m_scales.begin(), _blend_pose.m_scales.end(), Vector3::ZERO);
+        std::fill(_blend_weights.begin(), _blend_weights.end(), 0.0f);
+        const size_t clip_count = std::min(blend_state.m_clips.size(), blend_ratio.size());
+        for (size_t clip_index = 0; clip_index < clip_count; ++clip_index) {
+            const BlendStateClip& clip = blend_state.m_clips[clip_index];
+            const size_t sample_count = sampleClip(clip, blend_ratio[clip_index]);
+            for (size_t sample_index = 0; sample_index < sample_count; ++sample_index) {
+                const int32_t bone_index = _sampled_bone_indices[sample_index];
+                const float weight = clip.m_bone_weight[bone_index];
+                Quaternion& blend_rotation = _blend_pose.m_rotations[bone_index];
+                //keep the rotations in one hemisphere so opposite signs do not cancel out
+                const Quaternion& rotation = _sample_from.m_rotations[sample_index];
+                const float rotation_weight = blend_rotation.dot(rotation) < 0.0f ? -weight : weight;
+                blend_rotation = blend_rotation + rotation * rotation_weight;
+                _blend_pose.m_translations[bone_index] += _sample_from.m_translations[sample_index] * weight;
+                _blend_pose.m_scales[bone_index] += _sample_from.m_scales[sample_index] * weight;
+                _blend_weights[bone_index] += weight;
             }
         }
-        for (size_t i = 0; i < _bone_count; ++i) {
-            _bones[i].update();
+
+        //keys are relative to the binding pose
+        for (int32_t bone_index = 0; bone_index < _bone_count; ++bone_index) {
+            const float weight = _blend_weights[bone_index];
+            if (weight < 0.0001f) {
+                continue;
+            }
+            Quaternion rotation = _blend_pose.m_rotations[bone_index];
+            rotation.normalise();
+            _local_pose.m_rotations[bone_index] = _local_pose.m_rotations[bone_index] * rotation;
+            _local_pose.m_scales[bone_index] = _local_pose.m_scales[bone_index] * (_blend_pose.m_scales[bone_index] / weight);
+            _local_pose.m_translations[bone_index] = _local_pose.m_translations[bone_index] + _blend_pose.m_translations[bone_index] / weight;
         }
+        updateModelPose();
     }
 
-    AnimationResult Skeleton::outputAnimationResult() {
-        AnimationResult animation_result;
-        for (size_t i = 0; i < _bone_count; ++i) {
-            std::shared_ptr<AnimationResultElement> animation_result_element = std::make_shared<AnimationResultElement>();
-            Bone* bone = &_bones[i];
-            animation_result_element->m_index = bone->getID() + 1;
-            Vector3 temp_translation = bone->getDerivedPosition();
-
-            // TODO(the unit of the joint matrices is wrong)
-            Vector3 temp_scale = bone->getDerivedScale();
+    size_t Skeleton::sampleClip(const BlendStateClip& clip, float phase) {
+        const CompressedAnimationClip& animation_clip = *clip.m_clip;
+        const AnimSkelMap& anim_skel_map = *clip.m_anim_skel_map;
 
-            Quaternion temp_rotation = bone->getDerivedOrientation();
-            auto objMat = Transform(bone->getDerivedPosition(), bone->getDerivedOrientation(), bone->getDerivedScale()).getMatrix();
+        float exact_frame = phase * (animation_clip.m_total_frame - 1);
+        const int frame_low = static_cast<int>(floor(exact_frame));
+        const int frame_high = static_cast<int>(ceil(exact_frame));
+        float lerp_ratio = exact_frame - frame_low;
 
-            auto resMat = objMat * bone->getInverseTpose();
+        //gather the two keys of every channel the clip drives, then interpolate all of them in one batch
+        const size_t channel_count = std::min(animation_clip.m_channels.size(), anim_skel_map.m_convert.size());
+        _sampled_bone_indices.clear();
+        _sample_from.resize(std::max(_sample_from.size(), channel_count));
+        _sample_to.resize(std::max(_sample_to.size(), channel_count));
+        for (size_t node_index = 0; node_index < channel_count; ++node_index) {
+            const CompressedAnimationChannel& channel = animation_clip.m_channels[node_index];
+            const int bone_index = anim_skel_map.m_convert[node_index];
+            if (bone_index < 0 || bone_index >= _bone_count || bone_index >= static_cast<int>(clip.m_bone_weight.size())) {
+                continue;
+            }
+            //masked out bones are not sampled at all
+            if (clip.m_bone_weight[bone_index] < 0.0001f) {
+                continue;
+            }
+            if (channel.m_frame_count == 0) {
+                continue;
+            }
+            //the clip clamps both frames to the last key of the channel
+            const size_t sample_index = _sampled_bone_indices.size();
+            _sampled_bone_indices.push_back(bone_index);
+            animation_clip.sampleChannel(node_index, static_cast<uint32_t>(std::max(frame_low, 0)),
+                _sample_from.m_translations[sample_index], _sample_from.m_rotations[sample_index], _sample_from.m_scales[sample_index]);
+            animation_clip.sampleChannel(node_index, static_cast<uint32_t>(std::max(frame_high, 0)),
+                _sample_to.m_translations[sample_index], _sample_to.m_rotations[sample_index], _sample_to.m_scales[sample_index]);
+        }
+        const size_t sample_count = _sampled_bone_indices.size();
+        Simd::lerpN(_sample_from.m_translations.data(), _sample_to.m_translations.data(), lerp_ratio, _sample_from.m_translations.data(), sample_count);
+        Simd::nlerpN(_sample_from.m_rotations.data(), _sample_to.m_rotations.data(), lerp_ratio, _sample_from.m_rotations.data(), sample_count);
+        Simd::lerpN(_sample_from.m_scales.data(), _sample_to.m_scales.data(), lerp_ratio, _sample_from.m_scales.data(), sample_count);
+        return sample_count;
+    }
 
-            animation_result_element->m_transform = resMat.toMatrix4x4_();
+    void Skeleton::updateModelPose() {
+        for (int32_t i = 0; i < _bone_count; ++i) {
+            const int32_t parent_index = _parent_indices[i];
+            if (parent_index < 0) {
+                _model_pose.m_rotations[i] = _local_pose.m_rotations[i];
+                _model_pose.m_scales[i] = _local_pose.m_scales[i];
+                _model_pose.m_translations[i] = _local_pose.m_translations[i];
+            }
+            else {
+                const Quaternion& parent_rotation = _model_pose.m_rotations[parent_index];
+                const Vector3& parent_scale = _model_pose.m_scales[parent_index];
+                Quaternion rotation = parent_rotation * _local_pose.m_rotations[i];
+                rotation.normalise();
+                _model_pose.m_rotations[i] = rotation;
+                _model_pose.m_scales[i] = parent_scale * _local_pose.m_scales[i];
+                _model_pose.m_translations[i] = parent_rotation * (parent_scale * _local_pose.m_translations[i]) + _model_pose.m_translations[parent_index];
+            }
+        }
+        //the palette has no dependencies between bones, it is built in batches
+        Simd::composeAffineN(_model_pose.m_translations.data(), _model_pose.m_rotations.data(), _model_pose.m_scales.data(), _skinning_matrices.data(), _bone_count);
+        Simd::mul4x4N(_skinning_matrices.data(), _inverse_tposes.data(), _skinning_matrices.data(), _bone_count);
+    }
 
-            animation_result.m_node.push_back(*animation_result_element);
+    void Skeleton::outputAnimationResult(AnimationResult& animation_result) const {
+        animation_result.m_node.resize(_bone_count);
+        for (int32_t i = 0; i < _bone_count; ++i) {
+            AnimationResultElement& element = animation_result.m_node[i];
+            // TODO(the unit of the joint matrices is wrong)
+            element.m_index = i + 1;
+            element.m_transform = Matrix4x4(_skinning_matrices[i]).toMatrix4x4_();
         }
-        return animation_result;
     }
 
-    const Bone* Skeleton::getBones() const {
-        return _bones;
+    const std::vector<Matrix4x4>& Skeleton::getSkinningMatrices() const {
+        return _skinning_matrices;
     }
 
     int32_t Skeleton::getBonesCount() const {
         return _bone_count;
     }
-}
\ No newline at end of file
+}
@@ -1,26 +1,51 @@
 #pragma once
 
+#include "runtime/core/math/matrix4.h"
+#include "runtime/function/animation/animation_pose.h"
 #include "runtime/resource/res_type/components/animation.h"
-#include "runtime/function/animation/bone.h"
+
+#include <cstdint>
+#include <vector>
 
 namespace Dao {
 
 	class SkeletonData;
-	class BlendStateWithClipData;
+	struct BlendStateClip;
+	struct BlendStateInstance;
 
 	class Skeleton {
 	public:
-		~Skeleton();
 		void            buildSkeleton(const SkeletonData& skeleton_definition);
-		void            applyAnimation(const BlendStateWithClipData& blend_state);
-		AnimationResult outputAnimationResult();
+		/// blend all clips of the state with their per bone weights, blend_ratio holds the phase of every clip
+		void            applyAnimation(const BlendStateInstance& blend_state, const std::vector<float>& blend_ratio);
+		/// fill the result in place, its elements are reused between frames
+		void            outputAnimationResult(AnimationResult& animation_result) const;
 		void            resetSkeleton();
-		const Bone* getBones() const;
+		/// model space transform times inverse t-pose of every bone, valid after applyAnimation
+		const std::vector<Matrix4x4>& getSkinningMatrices() const;
 		int32_t         getBonesCount() const;
 
 	private:
-		bool _is_flat{ false };
-		int _bone_count{ 0 };
-		Bone* _bones{ nullptr };
+		//model pose from the local pose, parents come before their children so a single linear pass is enough
+		void            updateModelPose();
+		//interpolated keys of the bones the clip drives end up in _sample_from
+		//@return: number of sampled bones, their indices are in _sampled_bone_indices
+		size_t          sampleClip(const BlendStateClip& clip, float phase);
+
+		int32_t _bone_count{ 0 };
+		//-1 for roots
+		std::vector<int32_t>   _parent_indices;
+		std::vector<Matrix4x4> _inverse_tposes;
+		AnimationPose          _binding_pose;
+		AnimationPose          _local_pose;
+		AnimationPose          _model_pose;
+		std::vector<Matrix4x4> _skinning_matrices;
+		//keys of the sampled channels, reused between frames
+		std::vector<int32_t>   _sampled_bone_indices;
+		AnimationPose          _sample_from;
+		AnimationPose          _sample_to;
+		//weighted sums of the sampled clips
+		AnimationPose          _blend_pose;
+		std::vector<float>     _blend_weights;
 	};
-}
\ No newline at end of file
+}
@@ -1,30 +1,10 @@
 #include "runtime/function/animation/utilities.h"
 
-#include "runtime/function/animation/bone.h"
+#include "runtime/resource/res_type/data/skeleton_data.h"
 
-namespace Dao {
-    Bone* find_by_index(Bone* bones, int key, int size, bool is_flat) {
-        if (key == std::numeric_limits<int>::max()) {
-            return nullptr;
-        }
-        if (is_flat) {
-            if (key >= size) {
-                return nullptr;
-            }
-            else {
-                return &bones[key];
-            }
-        }
-        else {
-            for (int i = 0; i < size; ++i) {
-                if (bones[i].getID() == key) {
-                    return &bones[i];
-                }
-            }
-        }
-        return nullptr;
-    }
+#include <limits>
 
+namespace Dao {
     std::shared_ptr<RawBone> find_by_index(std::vector<std::shared_ptr<RawBone>>& bones, int key, bool is_flat) {
         if (key == std::numeric_limits<int>::max()) {
             return nullptr;
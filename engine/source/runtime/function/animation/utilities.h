@@ -7,7 +7,6 @@
 
 namespace Dao {
 
-    class Bone;
     class RawBone;
     class SkeletonData;
 
@@ -21,7 +20,6 @@ namespace Dao {
         base.insert(base.end(), addition.begin(), addition.end());
     }
 
-    Bone* find_by_index(Bone* bones, int key, int size, bool is_flat = false);
     std::shared_ptr<RawBone> find_by_index(std::vector<std::shared_ptr<RawBone>>& bones, int key, bool is_flat = false);
     int find_index_by_name(const SkeletonData& skeleton, const std::string& name);
 }
\ No newline at end of file
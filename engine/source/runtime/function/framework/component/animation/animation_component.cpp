@@ -8,13 +8,21 @@ namespace Dao {
 		m_parent_object = parent_object;
 		auto skeleton_res = AnimationManager::tryLoadSkeleton(m_animation_res.m_skeleton_file_path);
 		m_skeleton.buildSkeleton(*skeleton_res);
+		m_blend_state_instance = AnimationManager::createBlendStateInstance(m_animation_res.m_blend_state, skeleton_res->m_bones_map.size());
 	}
 
 	void AnimationComponent::tick(float delta_time) {
-		m_animation_res.m_blend_state.m_blend_ratio[0] += (delta_time / m_animation_res.m_blend_state.m_blend_clip_file_length[0]);
-		m_animation_res.m_blend_state.m_blend_ratio[0] -= floor(m_animation_res.m_blend_state.m_blend_ratio[0]);
-		m_skeleton.applyAnimation(AnimationManager::getBlendStateWithClipData(m_animation_res.m_blend_state));
-		m_animation_res.m_animation_result = m_skeleton.outputAnimationResult();
+		if (!m_blend_state_instance) {
+			return;
+		}
+		//every clip loops at its own length
+		BlendState& blend_state = m_animation_res.m_blend_state;
+		for (size_t clip_index = 0; clip_index < m_blend_state_instance->m_clips.size(); ++clip_index) {
+			blend_state.m_blend_ratio[clip_index] += (delta_time / blend_state.m_blend_clip_file_length[clip_index]);
+			blend_state.m_blend_ratio[clip_index] -= floor(blend_state.m_blend_ratio[clip_index]);
+		}
+		m_skeleton.applyAnimation(*m_blend_state_instance, m_animation_res.m_blend_state.m_blend_ratio);
+		m_skeleton.outputAnimationResult(m_animation_res.m_animation_result);
 	}
 
 	const AnimationResult& AnimationComponent::getResult() const {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "runtime/function/animation/blend_state_instance.h"
 #include "runtime/function/animation/skeleton.h"
 #include "runtime/function/framework/component/component.h"
 #include "runtime/resource/res_type/components/animation.h"
@@ -23,5 +24,6 @@ namespace Dao {
 	protected:
 		META(Enable) AnimationComponentRes m_animation_res;
 		Skeleton m_skeleton;
+		std::shared_ptr<const BlendStateInstance> m_blend_state_instance;
 	};
 }
\ No newline at end of file
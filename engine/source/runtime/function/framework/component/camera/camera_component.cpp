@@ -36,7 +36,7 @@ namespace Dao {
 		swap_context.getLogicSwapData().m_camera_swap_data = camera_swap_data;
 	}
 
-	void CameraComponent::tick(float delta_time) {
+	void CameraComponent::lateTick(float delta_time, float interpolation_alpha) {
 		if (!m_parent_object.lock()) {
 			return;
 		}
@@ -49,13 +49,18 @@ namespace Dao {
 			return;
 		}
 
+		// follow the same interpolated position the character mesh is rendered at
+		const TransformComponent* transform_component = m_parent_object.lock()->tryGetComponentConst(TransformComponent);
+		const Vector3 character_position = transform_component ?
+			transform_component->getInterpolatedTransform(interpolation_alpha).m_position : current_character->getPosition();
+
 		switch (_camera_mode)
 		{
 		case Dao::CameraMode::FIRST_PERSON:
-			tickFirstPersonCamera(delta_time);
+			tickFirstPersonCamera(delta_time, character_position);
 			break;
 		case Dao::CameraMode::THIRD_PERSON:
-			tickThirdPersonCamera(delta_time);
+			tickThirdPersonCamera(delta_time, character_position);
 			break;
 		case Dao::CameraMode::FREE:
 			tickFreeCamera(delta_time);
@@ -67,7 +72,7 @@ namespace Dao {
 		}
 	}
 
-	void CameraComponent::tickFirstPersonCamera(float delta_time) {
+	void CameraComponent::tickFirstPersonCamera(float delta_time, const Vector3& character_position) {
 		std::shared_ptr<Level> current_level = g_runtime_global_context.m_world_manager->getCurrentActiveLevel().lock();
 		std::shared_ptr<Character> current_character = current_level->getCurrentActiveCharacter().lock();
 		if (current_character == nullptr) {
@@ -79,7 +84,7 @@ namespace Dao {
 		q_pitch.fromAngleAxis(g_runtime_global_context.m_input_system->m_cursor_delta_pitch, _left);
 
 		const float offset = static_cast<FirstPersonCameraParameter*>(_camera_res.m_parameter)->m_vertical_offset;
-		_position = current_character->getPosition() + offset * Vector3::UNIT_Z;
+		_position = character_position + offset * Vector3::UNIT_Z;
 		_forward = q_yaw * q_pitch * _forward;
 		_left = q_yaw * q_pitch * _left;
 		_up = _forward.crossProduct(_left);
@@ -99,7 +104,7 @@ namespace Dao {
 		current_character->setRotation(object_rotation);
 	}
 
-	void CameraComponent::tickThirdPersonCamera(float delta_time) {
+	void CameraComponent::tickThirdPersonCamera(float delta_time, const Vector3& character_position) {
 		std::shared_ptr<Level> current_level = g_runtime_global_context.m_world_manager->getCurrentActiveLevel().lock();
 		std::shared_ptr<Character> current_character = current_level->getCurrentActiveCharacter().lock();
 		if (current_character == nullptr) {
@@ -117,8 +122,8 @@ namespace Dao {
 		const float vertical_offset = param->m_vertical_offset;
 		const float horizontal_offset = param->m_horizontal_offset;
 		Vector3 offset = Vector3(0, horizontal_offset, vertical_offset);
-		Vector3 center_pos = current_character->getPosition() + Vector3::UNIT_Z * vertical_offset;
-		_position = current_character->getRotation() * param->m_cursor_pitch * offset + current_character->getPosition();
+		Vector3 center_pos = character_position + Vector3::UNIT_Z * vertical_offset;
+		_position = current_character->getRotation() * param->m_cursor_pitch * offset + character_position;
 		_forward = center_pos - _position;
 		_up = current_character->getRotation() * param->m_cursor_pitch * Vector3::UNIT_Z;
 		_left = _up.crossProduct(_forward);
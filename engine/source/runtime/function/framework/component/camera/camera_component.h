@@ -24,7 +24,7 @@ namespace Dao {
 
 		void postLoadResource(std::weak_ptr<GObject> parent_object) override;
 
-		void tick(float delta_time) override;
+		void lateTick(float delta_time, float interpolation_alpha) override;
 
 		CameraMode getCameraMode() const { return _camera_mode; }
 		void setCameraMode(CameraMode mode) { _camera_mode = mode; }
@@ -33,8 +33,8 @@ namespace Dao {
 		Vector3 getForward() const { return _forward; }
 
 	private:
-		void tickFirstPersonCamera(float delta_time);
-		void tickThirdPersonCamera(float delta_time);
+		void tickFirstPersonCamera(float delta_time, const Vector3& character_position);
+		void tickThirdPersonCamera(float delta_time, const Vector3& character_position);
 		void tickFreeCamera(float delta_time);
 
 	private:
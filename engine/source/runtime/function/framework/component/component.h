@@ -25,6 +25,11 @@ namespace Dao {
 
 		virtual void tick(float delta_time) {};
 
+		/// called once per rendered frame after the fixed simulation steps of that frame
+		/// @delta_time: variable frame time
+		/// @interpolation_alpha: fraction of a fixed step between the last two simulated states
+		virtual void lateTick(float delta_time, float interpolation_alpha) {};
+
 		bool isDirty() const {
 			return m_is_dirty;
 		}
@@ -37,29 +37,33 @@ namespace Dao {
 		}
 	}
 
-	void MeshComponent::tick(float delta_time) {
+	void MeshComponent::lateTick(float delta_time, float interpolation_alpha) {
 		if (!m_parent_object.lock()) {
 			return;
 		}
 		TransformComponent* transform_component = m_parent_object.lock()->tryGetComponent(TransformComponent);
 		const AnimationComponent* animation_component = m_parent_object.lock()->tryGetComponentConst(AnimationComponent);
-		if (transform_component->isDirty()) {
+		if (transform_component->isDirty() || transform_component->isInterpolating()) {
+			const Matrix4x4 object_matrix = transform_component->getInterpolatedMatrix(interpolation_alpha);
 			std::vector<GameObjectPartDesc> dirty_mesh_parts;
-			SkeletonAnimationResult animation_result;
-			animation_result.m_transforms.push_back({ Matrix4x4::IDENTITY });
+			//one palette per object, every part is skinned by the same skeleton
+			std::shared_ptr<SkeletonAnimationResult> animation_result;
 			if (animation_component != nullptr) {
-				for (auto& node : animation_component->getResult().m_node) {
-					animation_result.m_transforms.push_back({ Matrix4x4(node.m_transform) });
+				const std::vector<Matrix4x4>& skinning_matrices = animation_component->getSkeleton().getSkinningMatrices();
+				animation_result = std::make_shared<SkeletonAnimationResult>();
+				animation_result->m_transforms.reserve(skinning_matrices.size() + 1);
+				animation_result->m_transforms.push_back({ Matrix4x4::IDENTITY });
+				for (const Matrix4x4& skinning_matrix : skinning_matrices) {
+					animation_result->m_transforms.push_back({ skinning_matrix });
 				}
 			}
 			for (auto& mesh_part : _raw_meshes) {
 				if (animation_component) {
 					mesh_part.m_with_animation = true;
-					mesh_part.m_skeleton_animation_result = animation_result;
 					mesh_part.m_skeleton_binding_desc.m_skeleton_binding_file = mesh_part.m_mesh_desc.m_mesh_file;
 				}
 				Matrix4x4 object_transform_matrix = mesh_part.m_transform_desc.m_transform_matrix;
-				mesh_part.m_transform_desc.m_transform_matrix = transform_component->getMatrix() * object_transform_matrix;
+				mesh_part.m_transform_desc.m_transform_matrix = object_matrix * object_transform_matrix;
 				dirty_mesh_parts.push_back(mesh_part);
 				mesh_part.m_transform_desc.m_transform_matrix = object_transform_matrix;
 			}
@@ -67,7 +71,7 @@ namespace Dao {
 			RenderSwapContext& render_swap_context = g_runtime_global_context.m_render_system->getSwapContext();
 			RenderSwapData& logic_swap_data = render_swap_context.getLogicSwapData();
 
-			logic_swap_data.addDirtyGameObject(GameObjectDesc{ m_parent_object.lock()->getID(),dirty_mesh_parts });
+			logic_swap_data.addDirtyGameObject(GameObjectDesc{ m_parent_object.lock()->getID(), dirty_mesh_parts, std::move(animation_result) });
 			transform_component->setDirtyFlag(false);
 		}
 	}
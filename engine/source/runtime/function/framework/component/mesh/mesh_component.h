@@ -19,7 +19,7 @@ namespace Dao {
 
 		void postLoadResource(std::weak_ptr<GObject> parent_object) override;
 
-		void tick(float delta_time) override;
+		void lateTick(float delta_time, float interpolation_alpha) override;
 
 		const std::vector<GameObjectPartDesc>& getRawMeshes() const { return _raw_meshes; }
 
@@ -30,7 +30,27 @@ namespace Dao {
 		m_is_dirty = true;
 	}
 
+	Transform TransformComponent::getInterpolatedTransform(float alpha) const {
+		const Transform& previous = m_transform_buffer[m_current_index];
+		const Transform& latest = m_transform_buffer[m_next_index];
+		return Transform(
+			Vector3::lerp(previous.m_position, latest.m_position, alpha),
+			Quaternion::nLerp(alpha, previous.m_rotation, latest.m_rotation, true),
+			Vector3::lerp(previous.m_scale, latest.m_scale, alpha)
+		);
+	}
+
+	bool TransformComponent::isInterpolating() const {
+		const Transform& previous = m_transform_buffer[m_current_index];
+		const Transform& latest = m_transform_buffer[m_next_index];
+		return previous.m_position != latest.m_position || previous.m_rotation != latest.m_rotation || previous.m_scale != latest.m_scale;
+	}
+
 	void TransformComponent::tick(float delta_time) {
+		// the step that just ended moved us, renderers still show an interpolated state and need the final one
+		if (isInterpolating()) {
+			m_is_dirty = true;
+		}
 		std::swap(m_current_index, m_next_index);
 		if (m_is_dirty) {
 			tryUpdateRigidBodyComponent();
@@ -38,6 +58,10 @@ namespace Dao {
 		if (g_is_editor_mode) {
 			m_transform_buffer[m_next_index] = m_transform;
 		}
+		else {
+			// start the next step from the newest state so partial writes do not resurrect an older one
+			m_transform_buffer[m_next_index] = m_transform_buffer[m_current_index];
+		}
 	}
 
 	void TransformComponent::tryUpdateRigidBodyComponent() {
@@ -30,6 +30,12 @@ namespace Dao {
 
 		Matrix4x4 getMatrix() const { return m_transform_buffer[m_current_index].getMatrix(); }
 
+		/// blend between the state before and after the last fixed step, alpha 1 is the newest state
+		Transform getInterpolatedTransform(float alpha) const;
+		Matrix4x4 getInterpolatedMatrix(float alpha) const { return getInterpolatedTransform(alpha).getMatrix(); }
+		/// true while the last fixed step changed the transform, renderers have to resubmit every frame then
+		bool isInterpolating() const;
+
 		void tick(float delta_time) override;
 
 		void tryUpdateRigidBodyComponent();
@@ -9,12 +9,15 @@
 #include "runtime/function/physics/physics_manager.h"
 #include "runtime/function/physics/physics_scene.h"
 
+#include <cmath>
 #include <limits.h>
 
 namespace Dao {
 	void Level::clear() {
 		m_current_active_character.reset();
 		m_gobjects.clear();
+		m_time_accumulator = 0.f;
+		m_interpolation_alpha = 1.f;
 
 		ASSERT(g_runtime_global_context.m_physics_manager);
 		g_runtime_global_context.m_physics_manager->deletePhysicsScene(m_physics_scene);
@@ -113,20 +116,53 @@ namespace Dao {
 			return;
 		}
 
+		std::shared_ptr<PhysicsScene> physics_scene = m_physics_scene.lock();
+		if (physics_scene) {
+			const float fixed_delta_time = physics_scene->getFixedDeltaTime();
+			const uint32_t max_substeps = physics_scene->getMaxSubsteps();
+
+			m_time_accumulator += delta_time;
+			uint32_t substep_count = 0;
+			while (m_time_accumulator >= fixed_delta_time && substep_count < max_substeps) {
+				fixedTick(fixed_delta_time);
+				m_time_accumulator -= fixed_delta_time;
+				++substep_count;
+			}
+			if (m_time_accumulator >= fixed_delta_time) {
+				// fell behind more than max_substeps allow, slow the simulation down instead of catching up
+				m_time_accumulator = std::fmod(m_time_accumulator, fixed_delta_time);
+			}
+			m_interpolation_alpha = m_time_accumulator / fixed_delta_time;
+		}
+		else {
+			fixedTick(delta_time);
+			m_interpolation_alpha = 1.f;
+		}
+
+		// the editor manipulates transforms directly, show the latest state instead of lagging one step behind
+		const float interpolation_alpha = g_is_editor_mode ? 1.f : m_interpolation_alpha;
+		for (const auto& id_object_parir : m_gobjects) {
+			if (id_object_parir.second) {
+				id_object_parir.second->lateTick(delta_time, interpolation_alpha);
+			}
+		}
+	}
+
+	void Level::fixedTick(float fixed_delta_time) {
 		for (const auto& id_object_parir: m_gobjects) {
 			ASSERT(id_object_parir.second);
 			if (id_object_parir.second) {
-				id_object_parir.second->tick(delta_time);
+				id_object_parir.second->tick(fixed_delta_time);
 			}
 		}
 
 		if (m_current_active_character && g_is_editor_mode == false) {
-			m_current_active_character->tick(delta_time);
+			m_current_active_character->tick(fixed_delta_time);
 		}
 
 		std::shared_ptr<PhysicsScene> physics_scene = m_physics_scene.lock();
 		if (physics_scene) {
-			physics_scene->tick(delta_time);
+			physics_scene->tick(fixed_delta_time);
 		}
 	}
 
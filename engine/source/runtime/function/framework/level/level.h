@@ -24,6 +24,7 @@ namespace Dao {
 
 		bool save();
 
+		/// runs logic and physics in fixed steps, then late ticks every object once with the interpolation alpha
 		void tick(float delta_time);
 
 		const std::string& getLevelResUrl() const { return m_level_res_url; }
@@ -35,9 +36,11 @@ namespace Dao {
 		void deleteGObjectByID(GObjectID go_id);
 
 		std::weak_ptr<PhysicsScene> getPhysicsScene() const { return m_physics_scene; }
+		float getInterpolationAlpha() const { return m_interpolation_alpha; }
 
 	protected:
 		void clear();
+		void fixedTick(float fixed_delta_time);
 
 	protected:
 		bool m_is_loaded{ false };
@@ -45,5 +48,8 @@ namespace Dao {
 		LevelObjectMap m_gobjects;
 		std::shared_ptr<Character> m_current_active_character;
 		std::weak_ptr<PhysicsScene> m_physics_scene;
+
+		float m_time_accumulator{ 0.f };
+		float m_interpolation_alpha{ 1.f };
 	};
 }
\ No newline at end of file
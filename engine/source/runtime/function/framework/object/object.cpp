@@ -37,6 +37,14 @@ namespace Dao {
 		}
 	}
 
+	void GObject::lateTick(float delta_time, float interpolation_alpha) {
+		for (auto& component : m_components) {
+			if (shouldComponentTick(component.getTypeName())) {
+				component->lateTick(delta_time, interpolation_alpha);
+			}
+		}
+	}
+
 	bool GObject::hasComponent(const std::string& component_type_name) const {
 		for (const auto& component : m_components) {
 			if (component.getTypeName() == component_type_name) {
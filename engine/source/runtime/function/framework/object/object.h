@@ -19,6 +19,7 @@ namespace Dao {
 		virtual ~GObject();
 
 		virtual void tick(float delta_time);
+		virtual void lateTick(float delta_time, float interpolation_alpha);
 
 		bool load(const ObjectInstanceRes& object_instance_res);
 		void save(ObjectInstanceRes& object_instance_res);
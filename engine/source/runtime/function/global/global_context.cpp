@@ -1,6 +1,7 @@
 #include "global_context.h"
 
 #include "runtime/core/log/log_system.h"
+#include "runtime/core/job/job_system.h"
 #include "runtime/resource/asset_manager/asset_manager.h"
 #include "runtime/resource/config_manager/config_manager.h"
 #include "runtime/platform/file_system/file_system.h"
@@ -22,8 +23,13 @@ namespace Dao {
 		m_config_manager = std::make_shared<ConfigManager>();
 		m_config_manager->initialize(config_file_path);
 
+		m_job_system = std::make_shared<JobSystem>();
+		m_job_system->initialize();
+
 		m_window_system = std::make_shared<WindowSystem>();
-		m_window_system->initialize(WindowCreateInfo());
+		WindowCreateInfo window_create_info;
+		window_create_info.headless = m_config_manager->isHeadless();
+		m_window_system->initialize(window_create_info);
 
 		m_input_system = std::make_shared<InputSystem>();
 		m_input_system->initialize();
@@ -58,6 +64,9 @@ namespace Dao {
 		m_input_system->clear();
 		m_input_system.reset();
 
+		m_job_system->clear();
+		m_job_system.reset();
+
 		m_window_system.reset();
 
 		m_asset_manager.reset();
@@ -15,6 +15,7 @@ namespace Dao {
 	class WorldManager;
 	class ParticleManager;
 	class PhysicsManager;
+	class JobSystem;
 
 	class RuntimeGlobalContext {
 	public:
@@ -32,6 +33,7 @@ namespace Dao {
 		std::shared_ptr<WorldManager>       m_world_manager;
 		std::shared_ptr<ParticleManager>	m_particle_manager;
 		std::shared_ptr<PhysicsManager>     m_physics_manager;
+		std::shared_ptr<JobSystem>			m_job_system;
 	};
 	
 	extern RuntimeGlobalContext g_runtime_global_context;
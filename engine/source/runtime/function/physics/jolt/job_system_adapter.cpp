@@ -0,0 +1,60 @@
+#include "runtime/function/physics/jolt/job_system_adapter.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
+
+#include <chrono>
+#include <thread>
+
+namespace Dao {
+    JoltJobSystemAdapter::JoltJobSystemAdapter(std::shared_ptr<Dao::JobSystem> job_system, uint32_t max_jobs, uint32_t max_barriers) :
+        JPH::JobSystemWithBarrier(max_barriers),
+        m_job_system(job_system) {
+        ASSERT(m_job_system);
+        m_jobs.Init(max_jobs, max_jobs);
+    }
+
+    int JoltJobSystemAdapter::GetMaxConcurrency() const {
+        return static_cast<int>(m_job_system->getMaxConcurrency());
+    }
+
+    JPH::JobHandle JoltJobSystemAdapter::CreateJob(const char* in_name, JPH::ColorArg in_color, const JobFunction& in_job_function, JPH::uint32 in_num_dependencies) {
+        // spin until the free list has room, same policy as JPH::JobSystemThreadPool
+        JPH::uint32 index;
+        for (;;) {
+            index = m_jobs.ConstructObject(in_name, in_color, this, in_job_function, in_num_dependencies);
+            if (index != AvailableJobs::cInvalidObjectIndex) {
+                break;
+            }
+            JPH_ASSERT(false, "No jobs available!");
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        Job* job = &m_jobs.Get(index);
+
+        // the handle keeps a reference, the job may finish before we return
+        JobHandle handle(job);
+        if (in_num_dependencies == 0) {
+            QueueJob(job);
+        }
+        return handle;
+    }
+
+    void JoltJobSystemAdapter::QueueJob(Job* in_job) {
+        // reference held by the queued task, Execute is a no-op if a barrier already ran the job
+        in_job->AddRef();
+        m_job_system->submit([in_job]() {
+            in_job->Execute();
+            in_job->Release();
+        });
+    }
+
+    void JoltJobSystemAdapter::QueueJobs(Job** in_jobs, JPH::uint in_num_jobs) {
+        for (JPH::uint i = 0; i < in_num_jobs; ++i) {
+            QueueJob(in_jobs[i]);
+        }
+    }
+
+    void JoltJobSystemAdapter::FreeJob(Job* in_job) {
+        m_jobs.DestructObject(in_job);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+#include <memory>
+
+namespace Dao {
+
+    class JobSystem;
+
+    /// runs Jolt jobs on the engine job system instead of a private JPH::JobSystemThreadPool,
+    /// barriers come from JPH::JobSystemWithBarrier so a waiting thread still helps with its own jobs
+    class JoltJobSystemAdapter final :public JPH::JobSystemWithBarrier {
+    public:
+        JoltJobSystemAdapter(std::shared_ptr<Dao::JobSystem> job_system, uint32_t max_jobs, uint32_t max_barriers);
+        ~JoltJobSystemAdapter() override = default;
+
+        int GetMaxConcurrency() const override;
+        JobHandle CreateJob(const char* in_name, JPH::ColorArg in_color, const JobFunction& in_job_function, JPH::uint32 in_num_dependencies = 0) override;
+
+    protected:
+        void QueueJob(Job* in_job) override;
+        void QueueJobs(Job** in_jobs, JPH::uint in_num_jobs) override;
+        void FreeJob(Job* in_job) override;
+
+    private:
+        using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+
+        std::shared_ptr<Dao::JobSystem> m_job_system;
+        AvailableJobs m_jobs;
+    };
+}
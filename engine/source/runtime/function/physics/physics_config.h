@@ -14,8 +14,9 @@ namespace Dao {
         uint32_t m_max_contact_constraints{ 10240 };
         uint32_t m_max_job_count{ 1024 };
         uint32_t m_max_barrier_count{ 8 };
-        uint32_t m_max_concurrent_job_count{ 4 };
         Vector3 m_gravity{ 0.f, 0.f, -9.8f };
         float m_update_frequency{ 60.f };
+        // upper bound of fixed steps run in one frame, the remaining time is dropped to avoid a spiral of death
+        uint32_t m_max_substeps{ 4 };
     };
 }
\ No newline at end of file
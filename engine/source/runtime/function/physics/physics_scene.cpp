@@ -1,7 +1,9 @@
 #include "runtime/function/physics/physics_scene.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
 #include "runtime/resource/res_type/components/rigid_body.h"
+#include "runtime/function/physics/jolt/job_system_adapter.h"
 #include "runtime/function/physics/jolt/utils.h"
 #include "runtime/function/physics/physics_config.h"
 
@@ -9,7 +11,6 @@
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/JobSystem.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Collision/CastResult.h>
@@ -36,10 +37,11 @@ namespace Dao {
         m_physics.m_jolt_physics_system = new JPH::PhysicsSystem();
         m_physics.m_jolt_broad_phase_layer_interface = new BPLayerInterfaceImpl();
 
-        m_physics.m_jolt_job_system = new JPH::JobSystemThreadPool(
+        // jolt jobs share the engine workers instead of spawning a pool per scene
+        m_physics.m_jolt_job_system = new JoltJobSystemAdapter(
+            g_runtime_global_context.m_job_system,
             m_config.m_max_job_count,
-            m_config.m_max_barrier_count,
-            static_cast<int>(m_config.m_max_concurrent_job_count)
+            m_config.m_max_barrier_count
         );
 
         // 16M temp memory
@@ -161,10 +163,8 @@ namespace Dao {
     }
 
     void PhysicsScene::tick(float delta_time) {
-        const float time_step = 1.f / m_config.m_update_frequency;
-
         m_physics.m_jolt_physics_system->Update(
-            time_step,
+            delta_time,
             m_physics.m_collision_steps,
             m_physics.m_temp_allocator,
             m_physics.m_jolt_job_system
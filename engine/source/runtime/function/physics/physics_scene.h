@@ -42,11 +42,15 @@ namespace Dao {
 		virtual ~PhysicsScene();
 
 		const Vector3& getGravity() const { return m_config.m_gravity; }
+		float getFixedDeltaTime() const { return 1.f / m_config.m_update_frequency; }
+		uint32_t getMaxSubsteps() const { return m_config.m_max_substeps; }
 
 		uint32_t createRigidBody(const Transform& global_transform, const RigidBodyComponentRes& rigidbody_actor_res);
 		void removeRigidBody(uint32_t body_id);
 
 		void updateRigidBodyGlobalTransform(uint32_t body_id, const Transform& global_transform);
+		/// advance the simulation by exactly one step
+		/// @delta_time: step length, expected to be getFixedDeltaTime()
 		void tick(float delta_time);
 
 		/// cast a ray and find the hits
@@ -0,0 +1,990 @@
+#include "runtime/function/render/interface/null/null_rhi.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/function/render/window_system.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Dao {
+
+	namespace {
+		//allocations vma would place in host visible memory, their pMappedData has to be writable
+		bool isHostVisibleAllocation(const VmaAllocationCreateInfo* allocation_create_info) {
+			if (allocation_create_info == nullptr) {
+				return false;
+			}
+			if (allocation_create_info->flags & VMA_ALLOCATION_CREATE_MAPPED_BIT) {
+				return true;
+			}
+			if (allocation_create_info->requiredFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+				return true;
+			}
+			switch (allocation_create_info->usage) {
+			case VMA_MEMORY_USAGE_CPU_ONLY:
+			case VMA_MEMORY_USAGE_CPU_TO_GPU:
+			case VMA_MEMORY_USAGE_GPU_TO_CPU:
+			case VMA_MEMORY_USAGE_CPU_COPY:
+				return true;
+			default:
+				return false;
+			}
+		}
+	}
+
+	NullRHI::~NullRHI() {
+		//handles the renderer never destroyed, most of them live as long as the rhi
+		for (const auto& handle : _handles) {
+			handle.second(handle.first);
+		}
+		_handles.clear();
+	}
+
+	void NullRHI::releaseHandle(void* handle) {
+		if (handle == nullptr) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(_handles_mutex);
+		auto found = _handles.find(handle);
+		//destroying twice or destroying something the rhi did not create is ignored
+		if (found != _handles.end()) {
+			found->second(handle);
+			_handles.erase(found);
+		}
+	}
+
+	void NullRHI::initialize(RHIInitInfo init_info) {
+		std::array<int, 2> window_size = init_info.window_system->getWindowSize();
+		_viewport = { 0.0f,0.0f,(float)window_size[0],(float)window_size[1],0.0f,1.0f };
+		_scissor = { {0,0},{(uint32_t)window_size[0],(uint32_t)window_size[1]} };
+
+		_graphics_queue = newHandle<RHIQueue>();
+		_compute_queue = newHandle<RHIQueue>();
+
+		createCommandPool();
+		for (uint8_t i = 0; i < k_max_frames_in_flight; ++i) {
+			_command_buffers[i] = newHandle<RHICommandBuffer>();
+			_frame_in_flight_fences[i] = newHandle<RHIFence>();
+			_texture_copy_semaphores[i] = newHandle<RHISemaphore>();
+		}
+		_descriptor_pool = newHandle<RHIDescriptorPool>();
+
+		createSwapchain();
+		createSwapchainImageViews();
+		createFramebufferImageAndView();
+
+		LOG_INFO("null rhi initialized, no gpu work will be submitted");
+	}
+
+	void NullRHI::prepareContext() {
+		_statistics.draw_calls = 0;
+		_statistics.dispatches = 0;
+		_statistics.pipeline_binds = 0;
+		_statistics.descriptor_set_binds = 0;
+		_statistics.vertex_buffer_binds = 0;
+		_statistics.index_buffer_binds = 0;
+		_statistics.render_passes = 0;
+		_statistics.descriptor_writes = 0;
+		_statistics.queue_submits = 0;
+	}
+
+	const NullRHIStatistics& NullRHI::getStatistics() const {
+		return _statistics;
+	}
+
+	// allocate
+	bool NullRHI::allocateCommandBuffers(
+		const RHICommandBufferAllocateInfo* allocate_info,
+		RHICommandBuffer*& command_buffers
+	) {
+		command_buffers = newHandleArray<RHICommandBuffer>(allocate_info->commandBufferCount);
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::allocateDescriptorSets(
+		const RHIDescriptorSetAllocateInfo* allocate_info,
+		RHIDescriptorSet*& descriptor_sets
+	) {
+		descriptor_sets = newHandleArray<RHIDescriptorSet>(allocate_info->descriptorSetCount);
+		return RHI_SUCCESS;
+	}
+
+	// create
+	void NullRHI::createSwapchain() {
+		_swapchain_extent = { _scissor.extent.width,_scissor.extent.height };
+	}
+
+	void NullRHI::recreateSwapchain() {
+
+	}
+
+	void NullRHI::setFramebufferSize(uint32_t width, uint32_t height) {
+
+	}
+
+	void NullRHI::createSwapchainImageViews() {
+		_swapchain_imageviews.resize(k_max_frames_in_flight);
+		for (size_t i = 0; i < _swapchain_imageviews.size(); ++i) {
+			_swapchain_imageviews[i] = newHandle<RHIImageView>();
+		}
+	}
+
+	void NullRHI::createFramebufferImageAndView() {
+		_depth_image = newHandle<RHIImage>();
+		_depth_image_view = newHandle<RHIImageView>();
+	}
+
+	void NullRHI::createCommandPool() {
+		_command_pool = newHandle<RHICommandPool>();
+	}
+
+	bool NullRHI::createCommandPool(
+		const RHICommandPoolCreateInfo* pcreate_info,
+		RHICommandPool*& command_pool
+	) {
+		command_pool = newHandle<RHICommandPool>();
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createDescriptorPool(
+		const RHIDescriptorPoolCreateInfo* create_info,
+		RHIDescriptorPool*& descriptor_pool
+	) {
+		descriptor_pool = newHandle<RHIDescriptorPool>();
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createDescriptorSetLayout(
+		const RHIDescriptorSetLayoutCreateInfo* create_info,
+		RHIDescriptorSetLayout*& set_layout
+	) {
+		set_layout = newHandle<RHIDescriptorSetLayout>();
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createGraphicsPipelines(
+		RHIPipelineCache* pipeline_cache,
+		uint32_t create_info_count,
+		const RHIGraphicsPipelineCreateInfo* create_infos,
+		RHIPipeline*& pipelines
+	) {
+		pipelines = newHandleArray<RHIPipeline>(create_info_count);
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createComputePipelines(
+		RHIPipelineCache* pipeline_cache,
+		uint32_t create_info_count,
+		const RHIComputePipelineCreateInfo* create_infos,
+		RHIPipeline*& pipelines
+	) {
+		pipelines = newHandleArray<RHIPipeline>(create_info_count);
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createPipelineLayout(
+		const RHIPipelineLayoutCreateInfo* create_info,
+		RHIPipelineLayout*& pipeline_layout
+	) {
+		pipeline_layout = newHandle<RHIPipelineLayout>();
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createRenderPass(
+		const RHIRenderPassCreateInfo* create_info,
+		RHIRenderPass*& render_pass
+	) {
+		render_pass = newHandle<RHIRenderPass>();
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createSampler(
+		const RHISamplerCreateInfo* create_info,
+		RHISampler*& sampler
+	) {
+		sampler = newHandle<RHISampler>();
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createSemaphore(
+		const RHISemaphoreCreateInfo* create_info,
+		RHISemaphore*& semaphore
+	) {
+		semaphore = newHandle<RHISemaphore>();
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createFence(
+		const RHIFenceCreateInfo* create_info,
+		RHIFence*& fence
+	) {
+		fence = newHandle<RHIFence>();
+		return RHI_SUCCESS;
+	}
+
+	void NullRHI::createBuffer(
+		RHIDeviceSize size,
+		RHIBufferUsageFlags usage,
+		RHIMemoryPropertyFlags properties,
+		RHIBuffer*& buffer,
+		RHIDeviceMemory*& buffer_memory
+	) {
+		buffer = newHandle<RHIBuffer>();
+		// only host visible memory is ever mapped, keep device local allocations free
+		buffer_memory = newHandle<NullDeviceMemory>((properties & RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ? size : 0);
+		++_statistics.buffers_created;
+	}
+
+	void NullRHI::createBufferAndInitialize(
+		RHIBufferUsageFlags usage,
+		RHIMemoryPropertyFlags properties,
+		RHIBuffer*& buffer,
+		RHIDeviceMemory*& buffer_memory,
+		RHIDeviceSize size,
+		void* data,
+		int datasize
+	) {
+		buffer = newHandle<RHIBuffer>();
+		buffer_memory = newHandle<NullDeviceMemory>(size);
+		if (data != nullptr && datasize > 0) {
+			std::memcpy(((NullDeviceMemory*)buffer_memory)->getData(), data, std::min((size_t)datasize, (size_t)size));
+			_statistics.bytes_uploaded += datasize;
+		}
+		++_statistics.buffers_created;
+	}
+
+	bool NullRHI::createBufferVMA(
+		VmaAllocator allocator,
+		const RHIBufferCreateInfo* buffer_create_info,
+		const VmaAllocationCreateInfo* allocation_create_info,
+		RHIBuffer*& buffer,
+		VmaAllocation* allocation,
+		VmaAllocationInfo* allocation_info
+	) {
+		buffer = newHandle<RHIBuffer>();
+		//host visible allocations get a host side backing store, it stands in for the vma allocation
+		NullDeviceMemory* memory = nullptr;
+		if (isHostVisibleAllocation(allocation_create_info)) {
+			memory = newHandle<NullDeviceMemory>(buffer_create_info->size);
+		}
+		if (allocation != nullptr) {
+			*allocation = reinterpret_cast<VmaAllocation>(memory);
+		}
+		if (allocation_info != nullptr) {
+			*allocation_info = {};
+			allocation_info->size = buffer_create_info->size;
+			allocation_info->pMappedData = memory != nullptr ? memory->getData() : nullptr;
+		}
+		++_statistics.buffers_created;
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::createBufferWithAlignmentVMA(
+		VmaAllocator allocator,
+		const RHIBufferCreateInfo* buffer_create_info,
+		const VmaAllocationCreateInfo* allocation_create_info,
+		RHIDeviceSize min_aligment,
+		RHIBuffer*& buffer,
+		VmaAllocation* allocation,
+		VmaAllocationInfo* allocation_info
+	) {
+		return createBufferVMA(allocator, buffer_create_info, allocation_create_info, buffer, allocation, allocation_info);
+	}
+
+	void NullRHI::copyBuffer(
+		RHIBuffer* src_buffer,
+		RHIBuffer* dst_buffer,
+		RHIDeviceSize src_offset,
+		RHIDeviceSize dst_offset,
+		RHIDeviceSize size
+	) {
+		_statistics.bytes_uploaded += size;
+	}
+
+	void NullRHI::createImage(
+		uint32_t image_width,
+		uint32_t image_height,
+		RHIFormat format,
+		RHIImageTiling image_tilling,
+		RHIImageUsageFlags image_usage_flags,
+		RHIMemoryPropertyFlags memory_property_flags,
+		RHIImage*& image,
+		RHIDeviceMemory*& memory,
+		RHIImageCreateFlags image_create_flags,
+		uint32_t array_layers,
+		uint32_t miplevels
+	) {
+		image = newHandle<RHIImage>();
+		memory = newHandle<NullDeviceMemory>(0);
+		++_statistics.images_created;
+	}
+
+	void NullRHI::createImageView(
+		RHIImage* image,
+		RHIFormat format,
+		RHIImageAspectFlags image_aspect_flags,
+		RHIImageViewType view_type,
+		uint32_t layout_count,
+		uint32_t miplevels,
+		RHIImageView*& image_view
+	) {
+		image_view = newHandle<RHIImageView>();
+	}
+
+	void NullRHI::createGlobalImage(
+		RHIImage*& image,
+		RHIImageView*& image_view,
+		VmaAllocation& image_allocation,
+		uint32_t texture_image_width,
+		uint32_t texture_image_height,
+		void* texture_image_pixels,
+		RHIFormat texture_image_format,
+		uint32_t miplevels
+	) {
+		image = newHandle<RHIImage>();
+		image_view = newHandle<RHIImageView>();
+		image_allocation = nullptr;
+		++_statistics.images_created;
+	}
+
+	void NullRHI::createCubeMap(
+		RHIImage*& image,
+		RHIImageView*& image_view,
+		VmaAllocation& image_allocation,
+		uint32_t texture_image_width,
+		uint32_t texture_image_height,
+		std::array<void*, 6> texture_image_pixels,
+		RHIFormat texture_image_format,
+		uint32_t miplevels
+	) {
+		image = newHandle<RHIImage>();
+		image_view = newHandle<RHIImageView>();
+		image_allocation = nullptr;
+		++_statistics.images_created;
+	}
+
+	bool NullRHI::createFramebuffer(
+		const RHIFramebufferCreateInfo* create_info,
+		RHIFramebuffer*& frame_buffer
+	) {
+		frame_buffer = newHandle<RHIFramebuffer>();
+		return RHI_SUCCESS;
+	}
+
+	RHIShader* NullRHI::createShaderModule(const std::vector<unsigned char>& shader_code) {
+		return newHandle<RHIShader>();
+	}
+
+	RHISampler* NullRHI::getOrCreateDefaultSampler(RHIDefaultSamplerType type) {
+		switch (type)
+		{
+		case Dao::Default_Sampler_Linear:
+			if (_linear_sampler == nullptr) {
+				_linear_sampler = newHandle<RHISampler>();
+			}
+			return _linear_sampler;
+		case Dao::Default_Sampler_Nearest:
+			if (_nearest_sampler == nullptr) {
+				_nearest_sampler = newHandle<RHISampler>();
+			}
+			return _nearest_sampler;
+		default:
+			return nullptr;
+		}
+	}
+
+	RHISampler* NullRHI::getOrCreateMipmapSampler(uint32_t width, uint32_t height) {
+		uint32_t mip_levels = floor(log2(std::max(width, height))) + 1;
+		auto find_sampler = _mipmap_sampler_map.find(mip_levels);
+		if (find_sampler != _mipmap_sampler_map.end()) {
+			return find_sampler->second;
+		}
+		RHISampler* sampler = newHandle<RHISampler>();
+		_mipmap_sampler_map.insert(std::make_pair(mip_levels, sampler));
+		return sampler;
+	}
+
+	// command PFN
+	bool NullRHI::waitForFencesPFN(
+		uint32_t fence_count,
+		RHIFence* const* fences,
+		RHIBool32 wait_all,
+		uint64_t timeout
+	) {
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::resetFencesPFN(
+		uint32_t fence_count,
+		RHIFence* const* fences
+	) {
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::resetCommandPoolPFN(
+		RHICommandPool* command_pool,
+		RHICommandPoolResetFlags flags
+	) {
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::beginCommandBufferPFN(
+		RHICommandBuffer* command_buffer,
+		const RHICommandBufferBeginInfo* begin_info
+	) {
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::endCommandBufferPFN(RHICommandBuffer* command_buffer) {
+		return RHI_SUCCESS;
+	}
+
+	void NullRHI::cmdBeginRenderPassPFN(
+		RHICommandBuffer* command_buffer,
+		const RHIRenderPassBeginInfo* render_pass_begin,
+		RHISubpassContents contents
+	) {
+		++_statistics.render_passes;
+	}
+
+	void NullRHI::cmdNextSubpassPFN(
+		RHICommandBuffer* command_buffer,
+		RHISubpassContents contents
+	) {
+
+	}
+
+	void NullRHI::cmdEndRenderPassPFN(RHICommandBuffer* command_buffer) {
+
+	}
+
+	void NullRHI::cmdExecuteCommandsPFN(
+		RHICommandBuffer* command_buffer,
+		uint32_t command_buffer_count,
+		RHICommandBuffer* const* command_buffers
+	) {
+
+	}
+
+	void NullRHI::cmdBindPipelinePFN(
+		RHICommandBuffer* command_buffer,
+		RHIPipelineBindPoint pipeline_bind_point,
+		RHIPipeline* pipeline
+	) {
+		++_statistics.pipeline_binds;
+	}
+
+	void NullRHI::cmdSetViewportPFN(
+		RHICommandBuffer* command_buffer,
+		uint32_t first_viewport,
+		uint32_t viewport_count,
+		const RHIViewport* viewports
+	) {
+
+	}
+
+	void NullRHI::cmdSetScissorPFN(
+		RHICommandBuffer* command_buffer,
+		uint32_t first_scissor,
+		uint32_t scissor_count,
+		const RHIRect2D* scissor
+	) {
+
+	}
+
+	void NullRHI::cmdBindVertexBuffersPFN(
+		RHICommandBuffer* command_buffer,
+		uint32_t first_binding,
+		uint32_t binding_count,
+		RHIBuffer* const* buffers,
+		const RHIDeviceSize* offsets
+	) {
+		++_statistics.vertex_buffer_binds;
+	}
+
+	void NullRHI::cmdBindIndexBufferPFN(
+		RHICommandBuffer* command_buffer,
+		RHIBuffer* buffer,
+		RHIDeviceSize offset,
+		RHIIndexType index_type
+	) {
+		++_statistics.index_buffer_binds;
+	}
+
+	void NullRHI::cmdBindDescriptorSetsPFN(
+		RHICommandBuffer* command_buffer,
+		RHIPipelineBindPoint pipeline_bind_point,
+		RHIPipelineLayout* layout,
+		uint32_t first_set,
+		uint32_t descriptor_set_count,
+		const RHIDescriptorSet* const* descriptor_sets,
+		uint32_t dynamic_offset_count,
+		const uint32_t* dynamic_offsets
+	) {
+		++_statistics.descriptor_set_binds;
+	}
+
+	void NullRHI::cmdDrawIndexedPFN(
+		RHICommandBuffer* command_buffer,
+		uint32_t index_count,
+		uint32_t instance_count,
+		uint32_t first_index,
+		int32_t vertex_offset,
+		uint32_t first_instance
+	) {
+		++_statistics.draw_calls;
+	}
+
+	void NullRHI::cmdClearAttachmentsPFN(
+		RHICommandBuffer* command_buffer,
+		uint32_t attachment_count,
+		const RHIClearAttachment* attachments,
+		uint32_t rect_count,
+		const RHIClearRect* rects
+	) {
+
+	}
+
+	// command
+	bool NullRHI::beginCommandBuffer(
+		RHICommandBuffer* command_buffer,
+		const RHICommandBufferBeginInfo* begin_info
+	) {
+		return RHI_SUCCESS;
+	}
+
+	void NullRHI::cmdCopyImageToBuffer(
+		RHICommandBuffer* command_buffer,
+		RHIImage* src_image,
+		RHIImageLayout src_image_layout,
+		RHIBuffer* dst_buffer,
+		uint32_t region_count,
+		const RHIBufferImageCopy* regions
+	) {
+
+	}
+
+	void NullRHI::cmdCopyImageToImage(
+		RHICommandBuffer* command_buffer,
+		RHIImage* src_image,
+		RHIImageAspectFlagBits src_flags,
+		RHIImage* dest_image,
+		RHIImageAspectFlagBits dst_flags,
+		uint32_t width,
+		uint32_t height
+	) {
+
+	}
+
+	void NullRHI::cmdCopyBuffer(
+		RHICommandBuffer* command_buffer,
+		RHIBuffer* src_buffer,
+		RHIBuffer* dst_buffer,
+		uint32_t region_count,
+		RHIBufferCopy* regions
+	) {
+		for (uint32_t i = 0; i < region_count; ++i) {
+			_statistics.bytes_uploaded += regions[i].size;
+		}
+	}
+
+	void NullRHI::cmdDraw(
+		RHICommandBuffer* command_buffer,
+		uint32_t vertex_count,
+		uint32_t instance_count,
+		uint32_t first_vertex,
+		uint32_t first_instance
+	) {
+		++_statistics.draw_calls;
+	}
+
+	void NullRHI::cmdDispatch(
+		RHICommandBuffer* command_buffer,
+		uint32_t group_count_x,
+		uint32_t gourp_count_y,
+		uint32_t group_count_z
+	) {
+		++_statistics.dispatches;
+	}
+
+	void NullRHI::cmdDispatchIndirect(
+		RHICommandBuffer* command_buffer,
+		RHIBuffer* buffer,
+		RHIDeviceSize offset
+	) {
+		++_statistics.dispatches;
+	}
+
+	void NullRHI::cmdDrawIndexedIndirect(
+		RHICommandBuffer* command_buffer,
+		RHIBuffer* buffer,
+		RHIDeviceSize offset,
+		uint32_t draw_count,
+		uint32_t stride
+	) {
+		//one indirect command issues draw_count draws
+		_statistics.draw_calls += draw_count;
+	}
+
+	void NullRHI::cmdPipelineBarrier(
+		RHICommandBuffer* command_buffer,
+		RHIPipelineStageFlags src_stage_mask,
+		RHIPipelineStageFlags dst_stage_mask,
+		RHIDependencyFlags dependency_flags,
+		uint32_t memory_barrier_count,
+		const RHIMemoryBarrier* memory_barriers,
+		uint32_t buffer_memory_barrier_count,
+		const RHIBufferMemoryBarrier* buffer_memory_barriers,
+		uint32_t image_memory_barrier_count,
+		const RHIImageMemoryBarrier* image_memory_barriers
+	) {
+
+	}
+
+	bool NullRHI::endCommandBuffer(RHICommandBuffer* command_buffer) {
+		return RHI_SUCCESS;
+	}
+
+	void NullRHI::updateDescriptorSets(
+		uint32_t descriptor_write_count,
+		const RHIWriteDescriptorSet* descriptor_writes,
+		uint32_t descriptor_copy_count,
+		const RHICopyDescriptorSet* descriptor_copies
+	) {
+		_statistics.descriptor_writes += descriptor_write_count;
+	}
+
+	bool NullRHI::queueSubmit(
+		RHIQueue* queue,
+		uint32_t submit_count,
+		const RHISubmitInfo* submits,
+		RHIFence* fence
+	) {
+		_statistics.queue_submits += submit_count;
+		return RHI_SUCCESS;
+	}
+
+	bool NullRHI::queueWaitIdle(RHIQueue* queue) {
+		return RHI_SUCCESS;
+	}
+
+	void NullRHI::resetCommandPool() {
+
+	}
+
+	void NullRHI::waitForFences() {
+
+	}
+
+	// query
+	void NullRHI::getPhysicalDeviceProperties(RHIPhysicalDeviceProperties* properties) {
+		*properties = {};
+		std::strncpy(properties->deviceName, "Dao Null Device", RHI_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1);
+		properties->limits.maxImageDimension2D = 16384;
+		properties->limits.maxUniformBufferRange = 1u << 16;
+		properties->limits.maxStorageBufferRange = 1u << 27;
+		properties->limits.maxPushConstantsSize = 128;
+		properties->limits.maxSamplerAnisotropy = 16.0f;
+		properties->limits.minMemoryMapAlignment = 64;
+		properties->limits.minTexelBufferOffsetAlignment = 256;
+		properties->limits.minUniformBufferOffsetAlignment = 256;
+		properties->limits.minStorageBufferOffsetAlignment = 256;
+		properties->limits.nonCoherentAtomSize = 256;
+	}
+
+	RHICommandBuffer* NullRHI::getCurrentCommandBuffer() const {
+		return _command_buffers[_current_frame_index];
+	}
+
+	RHICommandBuffer* const* NullRHI::getCommandBufferList() const {
+		return _command_buffers;
+	}
+
+	RHICommandPool* NullRHI::getCommandPool() const {
+		return _command_pool;
+	}
+
+	RHIDescriptorPool* NullRHI::getDescriptorPool() const {
+		return _descriptor_pool;
+	}
+
+	RHIFence* const* NullRHI::getFenceList() const {
+		return _frame_in_flight_fences;
+	}
+
+	QueueFamilyIndices NullRHI::getQueueFamilyIndices() const {
+		QueueFamilyIndices indices;
+		indices.graphics_family = 0;
+		indices.present_family = 0;
+		indices.compute_family = 0;
+		return indices;
+	}
+
+	RHIQueue* NullRHI::getGraphicsQueue() const {
+		return _graphics_queue;
+	}
+
+	RHIQueue* NullRHI::getComputeQueue() const {
+		return _compute_queue;
+	}
+
+	RHISwapChainDesc NullRHI::getSwapchainInfo() {
+		RHISwapChainDesc desc{};
+		desc.image_format = RHI_FORMAT_B8G8R8A8_UNORM;
+		desc.extent = _swapchain_extent;
+		desc.viewport = &_viewport;
+		desc.scissor = &_scissor;
+		desc.imageViews = _swapchain_imageviews;
+		return desc;
+	}
+
+	RHIDepthImageDesc NullRHI::getDepthImageInfo() const {
+		RHIDepthImageDesc desc{};
+		desc.depth_image_format = RHI_FORMAT_D32_SFLOAT;
+		desc.depth_image = _depth_image;
+		desc.depth_image_view = _depth_image_view;
+		return desc;
+	}
+
+	uint8_t NullRHI::getMaxFramesInFlight() const {
+		return k_max_frames_in_flight;
+	}
+
+	uint8_t NullRHI::getCurrentFrameIndex() const {
+		return _current_frame_index;
+	}
+
+	void NullRHI::setCurrentFrameIndex(uint8_t index) {
+		_current_frame_index = index;
+	}
+
+	uint32_t NullRHI::getCurrentSwapchainImageIndex() const {
+		return _current_swapchain_image_index;
+	}
+
+	VmaAllocator NullRHI::getAssetsAllocator() const {
+		return nullptr;
+	}
+
+	// command write
+	RHICommandBuffer* NullRHI::beginSingleTimeCommands() {
+		return newHandle<RHICommandBuffer>();
+	}
+
+	void NullRHI::endSingleTimeCommands(RHICommandBuffer* command_buffer) {
+		releaseHandle(command_buffer);
+		++_statistics.queue_submits;
+	}
+
+	void NullRHI::createThreadCommandPools(uint32_t thread_count) {
+		while (_thread_command_buffers.size() < thread_count) {
+			_thread_command_buffers.push_back(newHandle<RHICommandBuffer>());
+		}
+	}
+
+	RHICommandBuffer* NullRHI::beginSecondaryCommandBuffer(
+		uint32_t thread_index,
+		RHIRenderPass* render_pass,
+		uint32_t subpass,
+		RHIFramebuffer* framebuffer
+	) {
+		//nothing is recorded, one handle per thread is enough
+		return _thread_command_buffers[thread_index];
+	}
+
+	bool NullRHI::prepareBeforePass(std::function<void()> pass_update_after_recreate_swapchain) {
+		return RHI_FALSE;
+	}
+
+	void NullRHI::submitRendering(std::function<void()> pass_update_after_recreate_swapchain) {
+		++_statistics.queue_submits;
+		++_statistics.frame_count;
+		_current_swapchain_image_index = (_current_swapchain_image_index + 1) % _swapchain_imageviews.size();
+		_current_frame_index = (_current_frame_index + 1) % k_max_frames_in_flight;
+	}
+
+	void NullRHI::pushEvent(RHICommandBuffer* command_buffer, const char* name, const float* color) {
+
+	}
+
+	void NullRHI::popEvent(RHICommandBuffer* commond_buffer) {
+
+	}
+
+	// asynchronous upload
+	uint64_t NullRHI::uploadBuffer(RHIBuffer* dst_buffer, RHIDeviceSize dst_offset, const void* data, RHIDeviceSize size) {
+		_statistics.bytes_uploaded += size;
+		return ++_upload_serial;
+	}
+
+	uint64_t NullRHI::createGlobalImageAsync(
+		RHIImage*& image,
+		RHIImageView*& image_view,
+		VmaAllocation& image_allocation,
+		uint32_t texture_image_width,
+		uint32_t texture_image_height,
+		void* texture_image_pixels,
+		RHIFormat texture_image_format,
+		uint32_t miplevels
+	) {
+		createGlobalImage(image, image_view, image_allocation, texture_image_width, texture_image_height, texture_image_pixels, texture_image_format, miplevels);
+		return ++_upload_serial;
+	}
+
+	void NullRHI::flushUploads() {
+
+	}
+
+	bool NullRHI::isUploadComplete(uint64_t upload_id) const {
+		//nothing is ever in flight
+		return true;
+	}
+
+	// destroy
+	void NullRHI::clear() {
+
+	}
+
+	void NullRHI::clearSwapChain() {
+
+	}
+
+	void NullRHI::destroyDefaultSampler(RHIDefaultSamplerType type) {
+		switch (type)
+		{
+		case Dao::Default_Sampler_Linear:
+			releaseHandle(_linear_sampler);
+			_linear_sampler = nullptr;
+			break;
+		case Dao::Default_Sampler_Nearest:
+			releaseHandle(_nearest_sampler);
+			_nearest_sampler = nullptr;
+			break;
+		default:
+			break;
+		}
+	}
+
+	void NullRHI::destroyMipmappedSampler() {
+		for (auto sampler : _mipmap_sampler_map) {
+			releaseHandle(sampler.second);
+		}
+		_mipmap_sampler_map.clear();
+	}
+
+	void NullRHI::destroyShaderModule(RHIShader* shader) {
+		releaseHandle(shader);
+	}
+
+	void NullRHI::destroySemaphore(RHISemaphore* semaphore) {
+		releaseHandle(semaphore);
+	}
+
+	void NullRHI::destroySampler(RHISampler* sampler) {
+		releaseHandle(sampler);
+	}
+
+	void NullRHI::destroyInstance(RHIInstance* instance) {
+
+	}
+
+	void NullRHI::destroyImageView(RHIImageView* image_view) {
+		releaseHandle(image_view);
+	}
+
+	void NullRHI::destroyImage(RHIImage* image) {
+		releaseHandle(image);
+	}
+
+	void NullRHI::destroyFrameBuffer(RHIFramebuffer* frame_buffer) {
+		releaseHandle(frame_buffer);
+	}
+
+	void NullRHI::destroyFence(RHIFence* fance) {
+		releaseHandle(fance);
+	}
+
+	void NullRHI::destroyDevice() {
+
+	}
+
+	void NullRHI::destroyCommandPool(RHICommandPool* command_pool) {
+		releaseHandle(command_pool);
+	}
+
+	void NullRHI::destroyBuffer(RHIBuffer*& buffer) {
+		releaseHandle(buffer);
+		buffer = nullptr;
+	}
+
+	void NullRHI::freeCommandBuffers(
+		RHICommandPool* command_pool,
+		uint32_t command_buffer_count,
+		RHICommandBuffer* command_buffers
+	) {
+		//the buffers were allocated as one array
+		releaseHandle(command_buffers);
+	}
+
+	// memory
+	void NullRHI::freeMemory(RHIDeviceMemory*& memory) {
+		releaseHandle(memory);
+		memory = nullptr;
+	}
+
+	bool NullRHI::mapMemory(
+		RHIDeviceMemory* memory,
+		RHIDeviceSize offset,
+		RHIDeviceSize size,
+		RHIMemoryMapFlags flags,
+		void** data
+	) {
+		NullDeviceMemory* null_memory = (NullDeviceMemory*)memory;
+		if (null_memory->getData() == nullptr || offset >= null_memory->getSize()) {
+			LOG_ERROR("mapMemory failed, memory is not host visible!");
+			return RHI_FALSE;
+		}
+		*data = null_memory->getData() + offset;
+		return RHI_SUCCESS;
+	}
+
+	void NullRHI::unmapMemory(RHIDeviceMemory* memory) {
+
+	}
+
+	void NullRHI::invalidateMappedMemoryRanges(
+		void* next,
+		RHIDeviceMemory* memory,
+		RHIDeviceSize offset,
+		RHIDeviceSize size
+	) {
+
+	}
+
+	void NullRHI::flushMappedMemoryRanges(
+		void* next,
+		RHIDeviceMemory* memory,
+		RHIDeviceSize offset,
+		RHIDeviceSize size
+	) {
+
+	}
+
+	// semaphores
+	RHISemaphore*& NullRHI::getTextureCopySemaphore(uint32_t index) {
+		return _texture_copy_semaphores[index];
+	}
+
+	bool NullRHI::isPointLightShadowEnabled() {
+		return false;
+	}
+
+	bool NullRHI::isMultiDrawIndirectEnabled() {
+		return true;
+	}
+
+	bool NullRHI::isTextureCompressionBCEnabled() {
+		return true;
+	}
+}
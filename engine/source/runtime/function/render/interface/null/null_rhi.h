@@ -0,0 +1,518 @@
+#pragma once
+
+#include "runtime/function/render/interface/rhi.h"
+#include "runtime/function/render/interface/null/null_rhi_res.h"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Dao {
+
+	// counters accumulated by NullRHI, reset at the start of every frame in prepareContext.
+	// atomic since passes may record secondary command buffers on several job workers
+	struct NullRHIStatistics {
+		std::atomic<uint32_t> draw_calls{ 0 };
+		std::atomic<uint32_t> dispatches{ 0 };
+		std::atomic<uint32_t> pipeline_binds{ 0 };
+		std::atomic<uint32_t> descriptor_set_binds{ 0 };
+		std::atomic<uint32_t> vertex_buffer_binds{ 0 };
+		std::atomic<uint32_t> index_buffer_binds{ 0 };
+		std::atomic<uint32_t> render_passes{ 0 };
+		std::atomic<uint32_t> descriptor_writes{ 0 };
+		std::atomic<uint32_t> queue_submits{ 0 };
+		std::atomic<uint32_t> buffers_created{ 0 };
+		std::atomic<uint32_t> images_created{ 0 };
+		std::atomic<uint64_t> bytes_uploaded{ 0 };
+		std::atomic<uint64_t> frame_count{ 0 };
+	};
+
+	// RHI backend without a device: every call succeeds, allocates empty handles and only records statistics.
+	// used by the headless window mode for servers, CI and CPU-side profiling of the render path.
+	class NullRHI final : public RHI {
+	public:
+
+		~NullRHI() override final;
+
+		void initialize(RHIInitInfo init_info) override;
+		void prepareContext() override;
+
+		// allocate 
+		bool allocateCommandBuffers(
+			const RHICommandBufferAllocateInfo* allocate_info,
+			RHICommandBuffer*& command_buffers
+		) override;
+		bool allocateDescriptorSets(
+			const RHIDescriptorSetAllocateInfo* allocate_info,
+			RHIDescriptorSet*& descriptor_sets
+		) override;
+
+		// create
+		void createSwapchain() override;
+		void recreateSwapchain() override;
+		void setFramebufferSize(uint32_t width, uint32_t height) override;
+		void createSwapchainImageViews() override;
+		void createFramebufferImageAndView() override;
+		void createCommandPool() override;
+		bool createCommandPool(
+			const RHICommandPoolCreateInfo* pcreate_info,
+			RHICommandPool*& command_pool
+		) override;
+		bool createDescriptorPool(
+			const RHIDescriptorPoolCreateInfo* create_info,
+			RHIDescriptorPool*& descriptor_pool
+		) override;
+		bool createDescriptorSetLayout(
+			const RHIDescriptorSetLayoutCreateInfo* create_info,
+			RHIDescriptorSetLayout*& set_layout
+		) override;
+		bool createGraphicsPipelines(
+			RHIPipelineCache* pipeline_cache,
+			uint32_t create_info_count,
+			const RHIGraphicsPipelineCreateInfo* create_infos,
+			RHIPipeline*& pipelines
+		) override;
+		bool createComputePipelines(
+			RHIPipelineCache* pipeline_cache,
+			uint32_t create_info_count,
+			const RHIComputePipelineCreateInfo* create_infos,
+			RHIPipeline*& pipelines
+		) override;
+		bool createPipelineLayout(
+			const RHIPipelineLayoutCreateInfo* create_info,
+			RHIPipelineLayout*& pipeline_layout
+		) override;
+		bool createRenderPass(
+			const RHIRenderPassCreateInfo* create_info,
+			RHIRenderPass*& render_pass
+		) override;
+		bool createSampler(
+			const RHISamplerCreateInfo* create_info,
+			RHISampler*& sampler
+		) override;
+		bool createSemaphore(
+			const RHISemaphoreCreateInfo* create_info,
+			RHISemaphore*& semaphore
+		) override;
+		bool createFence(
+			const RHIFenceCreateInfo* create_info,
+			RHIFence*& fence
+		) override;
+		void createBuffer(
+			RHIDeviceSize size,
+			RHIBufferUsageFlags usage,
+			RHIMemoryPropertyFlags properties,
+			RHIBuffer*& buffer,
+			RHIDeviceMemory*& buffer_memory
+		) override;
+		void createBufferAndInitialize(
+			RHIBufferUsageFlags usage,
+			RHIMemoryPropertyFlags properties,
+			RHIBuffer*& buffer,
+			RHIDeviceMemory*& buffer_memory,
+			RHIDeviceSize size,
+			void* data = nullptr,
+			int datasize = 0
+		) override;
+		bool createBufferVMA(
+			VmaAllocator allocator,
+			const RHIBufferCreateInfo* buffer_create_info,
+			const VmaAllocationCreateInfo* allocation_create_info,
+			RHIBuffer*& buffer,
+			VmaAllocation* allocation,
+			VmaAllocationInfo* allocation_info
+		) override;
+		bool createBufferWithAlignmentVMA(
+			VmaAllocator allocator,
+			const RHIBufferCreateInfo* buffer_create_info,
+			const VmaAllocationCreateInfo* allocation_create_info,
+			RHIDeviceSize min_aligment,
+			RHIBuffer*& buffer,
+			VmaAllocation* allocation,
+			VmaAllocationInfo* allocation_info
+		) override;
+		void copyBuffer(
+			RHIBuffer* src_buffer,
+			RHIBuffer* dst_buffer,
+			RHIDeviceSize src_offset,
+			RHIDeviceSize dst_offset,
+			RHIDeviceSize size
+		) override;
+		void createImage(
+			uint32_t image_width,
+			uint32_t image_height,
+			RHIFormat format,
+			RHIImageTiling image_tilling,
+			RHIImageUsageFlags image_usage_flags,
+			RHIMemoryPropertyFlags memory_property_flags,
+			RHIImage*& image,
+			RHIDeviceMemory*& memory,
+			RHIImageCreateFlags image_create_flags,
+			uint32_t array_layers,
+			uint32_t miplevels
+		) override;
+		void createImageView(
+			RHIImage* image,
+			RHIFormat format,
+			RHIImageAspectFlags image_aspect_flags,
+			RHIImageViewType view_type,
+			uint32_t layout_count,
+			uint32_t miplevels,
+			RHIImageView*& image_view
+		) override;
+		void createGlobalImage(
+			RHIImage*& image,
+			RHIImageView*& image_view,
+			VmaAllocation& image_allocation,
+			uint32_t texture_image_width,
+			uint32_t texture_image_height,
+			void* texture_image_pixels,
+			RHIFormat texture_image_format,
+			uint32_t miplevels = 1
+		) override;
+		void createCubeMap(
+			RHIImage*& image,
+			RHIImageView*& image_view,
+			VmaAllocation& image_allocation,
+			uint32_t texture_image_width,
+			uint32_t texture_image_height,
+			std::array<void*, 6> texture_image_pixels,
+			RHIFormat texture_image_format,
+			uint32_t miplevels = 1
+		) override;
+		bool createFramebuffer(
+			const RHIFramebufferCreateInfo* create_info,
+			RHIFramebuffer*& frame_buffer
+		) override;
+		RHIShader* createShaderModule(const std::vector<unsigned char>& shader_code) override;
+		RHISampler* getOrCreateDefaultSampler(RHIDefaultSamplerType type) override;
+		RHISampler* getOrCreateMipmapSampler(uint32_t width, uint32_t height) override;
+
+		// command PFN
+		bool waitForFencesPFN(
+			uint32_t fence_count,
+			RHIFence* const* fences,
+			RHIBool32 wait_all,
+			uint64_t timeout
+		) override;
+		bool resetFencesPFN(
+			uint32_t fence_count,
+			RHIFence* const* fences
+		) override;
+		bool resetCommandPoolPFN(
+			RHICommandPool* command_pool,
+			RHICommandPoolResetFlags flags
+		) override;
+		bool beginCommandBufferPFN(
+			RHICommandBuffer* command_buffer,
+			const RHICommandBufferBeginInfo* begin_info
+		) override;
+		bool endCommandBufferPFN(RHICommandBuffer* command_buffer) override;
+		void cmdBeginRenderPassPFN(
+			RHICommandBuffer* command_buffer,
+			const RHIRenderPassBeginInfo* render_pass_begin,
+			RHISubpassContents contents
+		) override;
+		void cmdNextSubpassPFN(
+			RHICommandBuffer* command_buffer,
+			RHISubpassContents contents
+		) override;
+		void cmdEndRenderPassPFN(RHICommandBuffer* command_buffer) override;
+		void cmdExecuteCommandsPFN(
+			RHICommandBuffer* command_buffer,
+			uint32_t command_buffer_count,
+			RHICommandBuffer* const* command_buffers
+		) override;
+		void cmdBindPipelinePFN(
+			RHICommandBuffer* command_buffer,
+			RHIPipelineBindPoint pipeline_bind_point,
+			RHIPipeline* pipeline
+		) override;
+		void cmdSetViewportPFN(
+			RHICommandBuffer* command_buffer,
+			uint32_t first_viewport,
+			uint32_t viewport_count,
+			const RHIViewport* viewports
+		) override;
+		void cmdSetScissorPFN(
+			RHICommandBuffer* command_buffer,
+			uint32_t first_scissor,
+			uint32_t scissor_count,
+			const RHIRect2D* scissor
+		) override;
+		void cmdBindVertexBuffersPFN(
+			RHICommandBuffer* command_buffer,
+			uint32_t first_binding,
+			uint32_t binding_count,
+			RHIBuffer* const* buffers,
+			const RHIDeviceSize* offsets
+		) override;
+		void cmdBindIndexBufferPFN(
+			RHICommandBuffer* command_buffer,
+			RHIBuffer* buffer,
+			RHIDeviceSize offset,
+			RHIIndexType index_type
+		) override;
+		void cmdBindDescriptorSetsPFN(
+			RHICommandBuffer* command_buffer,
+			RHIPipelineBindPoint pipeline_bind_point,
+			RHIPipelineLayout* layout,
+			uint32_t first_set,
+			uint32_t descriptor_set_count,
+			const RHIDescriptorSet* const* descriptor_sets,
+			uint32_t dynamic_offset_count,
+			const uint32_t* dynamic_offsets
+		) override;
+		void cmdDrawIndexedPFN(
+			RHICommandBuffer* command_buffer,
+			uint32_t index_count,
+			uint32_t instance_count,
+			uint32_t first_index,
+			int32_t vertex_offset,
+			uint32_t first_instance
+		) override;
+		void cmdClearAttachmentsPFN(
+			RHICommandBuffer* command_buffer,
+			uint32_t attachment_count,
+			const RHIClearAttachment* attachments,
+			uint32_t rect_count,
+			const RHIClearRect* rects
+		) override;
+
+		// command
+		bool beginCommandBuffer(
+			RHICommandBuffer* command_buffer,
+			const RHICommandBufferBeginInfo* begin_info
+		) override;
+		void cmdCopyImageToBuffer(
+			RHICommandBuffer* command_buffer,
+			RHIImage* src_image,
+			RHIImageLayout src_image_layout,
+			RHIBuffer* dst_buffer,
+			uint32_t region_count,
+			const RHIBufferImageCopy* regions
+		) override;
+		void cmdCopyImageToImage(
+			RHICommandBuffer* command_buffer,
+			RHIImage* src_image,
+			RHIImageAspectFlagBits src_flags,
+			RHIImage* dest_image,
+			RHIImageAspectFlagBits dst_flags,
+			uint32_t width,
+			uint32_t height
+		) override;
+		void cmdCopyBuffer(
+			RHICommandBuffer* command_buffer,
+			RHIBuffer* src_buffer,
+			RHIBuffer* dst_buffer,
+			uint32_t region_count,
+			RHIBufferCopy* regions
+		) override;
+		void cmdDraw(
+			RHICommandBuffer* command_buffer,
+			uint32_t vertex_count,
+			uint32_t instance_count,
+			uint32_t first_vertex,
+			uint32_t first_instance
+		) override;
+		void cmdDispatch(
+			RHICommandBuffer* command_buffer,
+			uint32_t group_count_x,
+			uint32_t gourp_count_y,
+			uint32_t group_count_z
+		) override;
+		void cmdDispatchIndirect(
+			RHICommandBuffer* command_buffer,
+			RHIBuffer* buffer,
+			RHIDeviceSize offset
+		) override;
+		void cmdDrawIndexedIndirect(
+			RHICommandBuffer* command_buffer,
+			RHIBuffer* buffer,
+			RHIDeviceSize offset,
+			uint32_t draw_count,
+			uint32_t stride
+		) override;
+		void cmdPipelineBarrier(
+			RHICommandBuffer* command_buffer,
+			RHIPipelineStageFlags src_stage_mask,
+			RHIPipelineStageFlags dst_stage_mask,
+			RHIDependencyFlags dependency_flags,
+			uint32_t memory_barrier_count,
+			const RHIMemoryBarrier* memory_barriers,
+			uint32_t buffer_memory_barrier_count,
+			const RHIBufferMemoryBarrier* buffer_memory_barriers,
+			uint32_t image_memory_barrier_count,
+			const RHIImageMemoryBarrier* image_memory_barriers
+		) override;
+		bool endCommandBuffer(RHICommandBuffer* command_buffer) override;
+		void updateDescriptorSets(
+			uint32_t descriptor_write_count,
+			const RHIWriteDescriptorSet* descriptor_writes,
+			uint32_t descriptor_copy_count,
+			const RHICopyDescriptorSet* descriptor_copies
+		) override;
+		bool queueSubmit(
+			RHIQueue* queue,
+			uint32_t submit_count,
+			const RHISubmitInfo* submits,
+			RHIFence* fence
+		) override;
+		bool queueWaitIdle(RHIQueue* queue) override;
+		void resetCommandPool() override;
+		void waitForFences() override;
+
+		// query
+		void getPhysicalDeviceProperties(RHIPhysicalDeviceProperties* properties) override;
+		RHICommandBuffer* getCurrentCommandBuffer() const override;
+		RHICommandBuffer* const* getCommandBufferList() const override;
+		RHICommandPool* getCommandPool() const override;
+		RHIDescriptorPool* getDescriptorPool() const override;
+		RHIFence* const* getFenceList() const override;
+		QueueFamilyIndices getQueueFamilyIndices() const override;
+		RHIQueue* getGraphicsQueue() const override;
+		RHIQueue* getComputeQueue() const override;
+		RHISwapChainDesc getSwapchainInfo() override;
+		RHIDepthImageDesc getDepthImageInfo() const override;
+		uint8_t getMaxFramesInFlight() const override;
+		uint8_t getCurrentFrameIndex() const override;
+		void setCurrentFrameIndex(uint8_t index) override;
+		uint32_t getCurrentSwapchainImageIndex() const override;
+		VmaAllocator getAssetsAllocator() const override;
+
+		// command write
+		RHICommandBuffer* beginSingleTimeCommands() override;
+		void endSingleTimeCommands(RHICommandBuffer* command_buffer) override;
+		void createThreadCommandPools(uint32_t thread_count) override;
+		RHICommandBuffer* beginSecondaryCommandBuffer(
+			uint32_t thread_index,
+			RHIRenderPass* render_pass,
+			uint32_t subpass,
+			RHIFramebuffer* framebuffer
+		) override;
+		bool prepareBeforePass(std::function<void()> pass_update_after_recreate_swapchain) override;
+		void submitRendering(std::function<void()> pass_update_after_recreate_swapchain) override;
+		void pushEvent(RHICommandBuffer* command_buffer, const char* name, const float* color) override;
+		void popEvent(RHICommandBuffer* commond_buffer) override;
+
+		// asynchronous upload
+		uint64_t uploadBuffer(RHIBuffer* dst_buffer, RHIDeviceSize dst_offset, const void* data, RHIDeviceSize size) override;
+		uint64_t createGlobalImageAsync(
+			RHIImage*& image,
+			RHIImageView*& image_view,
+			VmaAllocation& image_allocation,
+			uint32_t texture_image_width,
+			uint32_t texture_image_height,
+			void* texture_image_pixels,
+			RHIFormat texture_image_format,
+			uint32_t miplevels = 1
+		) override;
+		void flushUploads() override;
+		bool isUploadComplete(uint64_t upload_id) const override;
+
+		// destroy
+		void clear() override;
+		void clearSwapChain() override;
+		void destroyDefaultSampler(RHIDefaultSamplerType type) override;
+		void destroyMipmappedSampler() override;
+		void destroyShaderModule(RHIShader* shader) override;
+		void destroySemaphore(RHISemaphore* semaphore) override;
+		void destroySampler(RHISampler* sampler) override;
+		void destroyInstance(RHIInstance* instance) override;
+		void destroyImageView(RHIImageView* image_view) override;
+		void destroyImage(RHIImage* image) override;
+		void destroyFrameBuffer(RHIFramebuffer* frame_buffer) override;
+		void destroyFence(RHIFence* fance) override;
+		void destroyDevice() override;
+		void destroyCommandPool(RHICommandPool* command_pool) override;
+		void destroyBuffer(RHIBuffer*& buffer) override;
+		void freeCommandBuffers(
+			RHICommandPool* command_pool,
+			uint32_t command_buffer_count,
+			RHICommandBuffer* command_buffers
+		) override;
+
+		// memory
+		void freeMemory(RHIDeviceMemory*& memory) override;
+		bool mapMemory(
+			RHIDeviceMemory* memory,
+			RHIDeviceSize offset,
+			RHIDeviceSize size,
+			RHIMemoryMapFlags flags,
+			void** data
+		) override;
+		void unmapMemory(RHIDeviceMemory* memory) override;
+		void invalidateMappedMemoryRanges(
+			void* next,
+			RHIDeviceMemory* memory,
+			RHIDeviceSize offset,
+			RHIDeviceSize size
+		) override;
+		void flushMappedMemoryRanges(
+			void* next,
+			RHIDeviceMemory* memory,
+			RHIDeviceSize offset,
+			RHIDeviceSize size
+		) override;
+
+		// semaphores
+		RHISemaphore*& getTextureCopySemaphore(uint32_t index) override;
+
+		bool isPointLightShadowEnabled() override;
+		bool isMultiDrawIndirectEnabled() override;
+		bool isTextureCompressionBCEnabled() override;
+
+		const NullRHIStatistics& getStatistics() const;
+
+	private:
+		// every handle is registered with its deleter, destroy calls free it early and the rest goes with the rhi
+		template<typename T, typename... TArgs>
+		T* newHandle(TArgs&&... args) {
+			T* handle = new T(std::forward<TArgs>(args)...);
+			registerHandle(handle, [](void* p) { delete static_cast<T*>(p); });
+			return handle;
+		}
+		template<typename T>
+		T* newHandleArray(uint32_t count) {
+			T* handles = new T[count];
+			registerHandle(handles, [](void* p) { delete[] static_cast<T*>(p); });
+			return handles;
+		}
+		void registerHandle(void* handle, void (*deleter)(void*)) {
+			std::lock_guard<std::mutex> lock(_handles_mutex);
+			_handles.emplace(handle, deleter);
+		}
+		void releaseHandle(void* handle);
+
+	public:
+		static uint8_t const				k_max_frames_in_flight{ 3 };
+	private:
+		RHIViewport							_viewport;
+		RHIRect2D							_scissor;
+		RHIExtent2D							_swapchain_extent;
+		std::vector<RHIImageView*>			_swapchain_imageviews;
+		RHIImage*							_depth_image{ nullptr };
+		RHIImageView*						_depth_image_view{ nullptr };
+		RHIQueue*							_graphics_queue{ nullptr };
+		RHIQueue*							_compute_queue{ nullptr };
+		RHIDescriptorPool*					_descriptor_pool{ nullptr };
+		RHICommandPool*						_command_pool{ nullptr };
+		RHICommandBuffer*					_command_buffers[k_max_frames_in_flight];
+		std::vector<RHICommandBuffer*>		_thread_command_buffers;
+		RHIFence*							_frame_in_flight_fences[k_max_frames_in_flight];
+		RHISemaphore*						_texture_copy_semaphores[k_max_frames_in_flight];
+		RHISampler*							_linear_sampler{ nullptr };
+		RHISampler*							_nearest_sampler{ nullptr };
+		std::map<uint32_t, RHISampler*>		_mipmap_sampler_map;
+		uint8_t								_current_frame_index{ 0 };
+		uint64_t							_upload_serial{ 0 };
+		uint32_t							_current_swapchain_image_index{ 0 };
+		NullRHIStatistics					_statistics;
+		std::mutex							_handles_mutex;
+		std::unordered_map<void*, void (*)(void*)>	_handles;
+	};
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "runtime/function/render/interface/rhi.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace Dao {
+	// host side backing store, so mapMemory of a NullRHI allocation returns writable memory.
+	// contents start undefined, same as freshly allocated device memory
+	class NullDeviceMemory :public RHIDeviceMemory {
+	public:
+		explicit NullDeviceMemory(RHIDeviceSize size) :
+			_size(size), 
+			_data(size > 0 ? new uint8_t[static_cast<size_t>(size)] : nullptr) {
+		}
+		uint8_t* getData() const {
+			return _data.get();
+		}
+		RHIDeviceSize getSize() const {
+			return _size;
+		}
+	private:
+		RHIDeviceSize				_size;
+		std::unique_ptr<uint8_t[]>	_data;
+	};
+}
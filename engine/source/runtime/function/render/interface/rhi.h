@@ -40,6 +40,9 @@ namespace Dao {
 		// create
 		virtual void createSwapchain() = 0;
 		virtual void recreateSwapchain() = 0;
+		/// size the swapchain is recreated at, polled on the thread owning the window.
+		/// the swapchain is kept while the size is empty (minimized window)
+		virtual void setFramebufferSize(uint32_t width, uint32_t height) = 0;
 		virtual void createSwapchainImageViews() = 0;
 		virtual void createFramebufferImageAndView() = 0;
 		virtual void createCommandPool() = 0;
@@ -149,6 +152,7 @@ namespace Dao {
 			uint32_t miplevels,
 			RHIImageView*& image_view
 		) = 0;
+		/// texture_image_pixels holds miplevels levels packed from the largest one, the levels are not generated
 		virtual void createGlobalImage(
 			RHIImage*& image,
 			RHIImageView*& image_view,
@@ -159,6 +163,7 @@ namespace Dao {
 			RHIFormat texture_image_format,
 			uint32_t miplevels = 1
 		) = 0;
+		/// every face holds miplevels levels packed from the largest one
 		virtual void createCubeMap(
 			RHIImage*& image,
 			RHIImageView*& image_view,
@@ -207,6 +212,11 @@ namespace Dao {
 			RHISubpassContents contents
 		) = 0;
 		virtual void cmdEndRenderPassPFN(RHICommandBuffer* command_buffer) = 0;
+		virtual void cmdExecuteCommandsPFN(
+			RHICommandBuffer* command_buffer,
+			uint32_t command_buffer_count,
+			RHICommandBuffer* const* command_buffers
+		) = 0;
 		virtual void cmdBindPipelinePFN(
 			RHICommandBuffer* command_buffer,
 			RHIPipelineBindPoint pipeline_bind_point,
@@ -310,6 +320,13 @@ namespace Dao {
 			RHIBuffer* buffer,
 			RHIDeviceSize offset
 		) = 0;
+		virtual void cmdDrawIndexedIndirect(
+			RHICommandBuffer* command_buffer,
+			RHIBuffer* buffer,
+			RHIDeviceSize offset,
+			uint32_t draw_count,
+			uint32_t stride
+		) = 0;
 		virtual void cmdPipelineBarrier(
 			RHICommandBuffer* command_buffer,
 			RHIPipelineStageFlags src_stage_mask,
@@ -354,15 +371,51 @@ namespace Dao {
 		virtual uint8_t getMaxFramesInFlight() const = 0;
 		virtual uint8_t getCurrentFrameIndex() const = 0;
 		virtual void setCurrentFrameIndex(uint8_t index) = 0;
+		virtual uint32_t getCurrentSwapchainImageIndex() const = 0;
+		virtual VmaAllocator getAssetsAllocator() const = 0;
 
 		// command write
 		virtual RHICommandBuffer* beginSingleTimeCommands() = 0;
 		virtual void endSingleTimeCommands(RHICommandBuffer* command_buffer) = 0;
+		/// one command pool per recording thread and frame in flight, for secondary command buffers.
+		/// a thread index must not be used by two threads at once, resetCommandPool recycles the buffers of the current frame
+		virtual void createThreadCommandPools(uint32_t thread_count) = 0;
+		/// begin a secondary command buffer of the current frame that continues subpass of render_pass inside framebuffer,
+		/// finish it with endCommandBufferPFN and run it with cmdExecuteCommandsPFN
+		virtual RHICommandBuffer* beginSecondaryCommandBuffer(
+			uint32_t thread_index,
+			RHIRenderPass* render_pass,
+			uint32_t subpass,
+			RHIFramebuffer* framebuffer
+		) = 0;
 		virtual bool prepareBeforePass(std::function<void()> pass_update_after_recreate_swapchain) = 0;
 		virtual void submitRendering(std::function<void()> pass_update_after_recreate_swapchain) = 0;
 		virtual void pushEvent(RHICommandBuffer* command_buffer, const char* name, const float* color) = 0;
 		virtual void popEvent(RHICommandBuffer* commond_buffer) = 0;
 
+		// asynchronous upload
+		/// copy data through the staging ring into dst_buffer, the copy is submitted with the next flushUploads.
+		/// the gpu must not read the range before isUploadComplete returned true
+		/// @return: upload id
+		virtual uint64_t uploadBuffer(RHIBuffer* dst_buffer, RHIDeviceSize dst_offset, const void* data, RHIDeviceSize size) = 0;
+		/// like createGlobalImage, but returns before the pixels reached the image.
+		/// texture_image_pixels holds miplevels levels packed from the largest one, no level is generated,
+		/// so block compressed formats are uploaded as they are
+		/// @return: upload id, 0 (always complete) if nothing was uploaded
+		virtual uint64_t createGlobalImageAsync(
+			RHIImage*& image,
+			RHIImageView*& image_view,
+			VmaAllocation& image_allocation,
+			uint32_t texture_image_width,
+			uint32_t texture_image_height,
+			void* texture_image_pixels,
+			RHIFormat texture_image_format,
+			uint32_t miplevels = 1
+		) = 0;
+		/// submit the uploads requested since the last call and retire finished ones, called once per frame
+		virtual void flushUploads() = 0;
+		virtual bool isUploadComplete(uint64_t upload_id) const = 0;
+
 		// destroy
 		virtual void clear() = 0;
 		virtual void clearSwapChain() = 0;
@@ -413,6 +466,10 @@ namespace Dao {
 
 		// 
 		virtual bool isPointLightShadowEnabled() = 0;
+		/// multi draw indirect with non zero first instance is available
+		virtual bool isMultiDrawIndirectEnabled() = 0;
+		/// BC1-BC7 images can be sampled
+		virtual bool isTextureCompressionBCEnabled() = 0;
 	};
 
 	inline RHI::~RHI() = default;
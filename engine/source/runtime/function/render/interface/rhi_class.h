@@ -60,6 +60,7 @@ namespace Dao {
     struct RHIDescriptorSetLayoutCreateInfo;
     struct RHIDeviceCreateInfo;
     struct RHIDeviceQueueCreateInfo;
+    struct RHIDrawIndexedIndirectCommand;
     struct RHIExtensionProperties;
     struct RHIFenceCreateInfo;
     struct RHIFormatProperties;
@@ -377,6 +378,15 @@ namespace Dao {
         const float* pQueuePriorities;
     };
 
+    struct RHIDrawIndexedIndirectCommand
+    {
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        uint32_t firstInstance;
+    };
+
     struct RHIExtensionProperties
     {
         char extensionName[RHI_MAX_EXTENSION_NAME_SIZE];
@@ -1119,6 +1129,8 @@ namespace Dao {
         std::optional<uint32_t> graphics_family;
         std::optional<uint32_t> present_family;
         std::optional<uint32_t> compute_family;
+        // a transfer only family if the device has one, the graphics family otherwise
+        std::optional<uint32_t> transfer_family;
 
         bool isComplete() { return graphics_family.has_value() && present_family.has_value() && compute_family.has_value(); }
     };
@@ -71,6 +71,9 @@ namespace Dao {
 
 	void VulkanRHI::initialize(RHIInitInfo init_info) {
 		m_window = init_info.window_system->getWindow();
+		std::array<int, 2> framebuffer_size = init_info.window_system->getFramebufferSize();
+		m_framebuffer_width = static_cast<uint32_t>(framebuffer_size[0]);
+		m_framebuffer_height = static_cast<uint32_t>(framebuffer_size[1]);
 		std::array<int, 2> window_size = init_info.window_system->getWindowSize();
 		m_viewport = { 0.0f,0.0f,(float)window_size[0],(float)window_size[1],0.0f,1.0f };
 		m_scissor = { {0,0},{(uint32_t)window_size[0],(uint32_t)window_size[1]} };
@@ -109,6 +112,7 @@ namespace Dao {
 		createSwapchainImageViews();
         createFramebufferImageAndView();
 		createAssetAllocator();
+		m_upload_manager.initialize(this, m_queue_indices.transfer_family.value(), m_transfer_queue);
 	}
 
 	void VulkanRHI::prepareContext() {
@@ -117,6 +121,7 @@ namespace Dao {
 	}
 
 	void VulkanRHI::clear() {
+		m_upload_manager.clear();
 		if (_enable_validation_layers) {
 			destroyDebugUtilsMessengerEXT(m_instance, _debug_messenger, nullptr);
 		}
@@ -303,6 +308,12 @@ namespace Dao {
         if (res_reset_command_pool != VK_SUCCESS) {
             LOG_ERROR("failed to reset command pool");
         }
+        for (ThreadCommandPool& thread_command_pool : m_thread_command_pools[m_current_frame_index]) {
+            if (f_vkResetCommandPool(m_device, thread_command_pool.command_pool, 0) != VK_SUCCESS) {
+                LOG_ERROR("failed to reset thread command pool");
+            }
+            thread_command_pool.used_command_buffer_count = 0;
+        }
     }
 
     bool VulkanRHI::prepareBeforePass(std::function<void()> pass_update_after_recreate_swapchain) {
@@ -446,6 +457,62 @@ namespace Dao {
         delete(command_buffer);
     }
 
+    void VulkanRHI::createThreadCommandPools(uint32_t thread_count) {
+        VkCommandPoolCreateInfo command_pool_create_info{};
+        command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        command_pool_create_info.pNext = nullptr;
+        command_pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        command_pool_create_info.queueFamilyIndex = m_queue_indices.graphics_family.value();
+        for (uint32_t frame_index = 0; frame_index < k_max_frames_in_flight; ++frame_index) {
+            std::vector<ThreadCommandPool>& thread_command_pools = m_thread_command_pools[frame_index];
+            for (uint32_t thread_index = static_cast<uint32_t>(thread_command_pools.size()); thread_index < thread_count; ++thread_index) {
+                ThreadCommandPool thread_command_pool;
+                if (vkCreateCommandPool(m_device, &command_pool_create_info, nullptr, &thread_command_pool.command_pool) != VK_SUCCESS) {
+                    LOG_ERROR("vkCreateCommandPool failed!");
+                }
+                thread_command_pools.push_back(thread_command_pool);
+            }
+        }
+    }
+
+    RHICommandBuffer* VulkanRHI::beginSecondaryCommandBuffer(
+        uint32_t thread_index,
+        RHIRenderPass* render_pass,
+        uint32_t subpass,
+        RHIFramebuffer* framebuffer
+    ) {
+        ASSERT(thread_index < m_thread_command_pools[m_current_frame_index].size());
+        ThreadCommandPool& thread_command_pool = m_thread_command_pools[m_current_frame_index][thread_index];
+        if (thread_command_pool.used_command_buffer_count == thread_command_pool.command_buffers.size()) {
+            VkCommandBufferAllocateInfo command_buffer_allocate_info{};
+            command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            command_buffer_allocate_info.commandPool = thread_command_pool.command_pool;
+            command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            command_buffer_allocate_info.commandBufferCount = 1U;
+            VkCommandBuffer vk_command_buffer;
+            if (vkAllocateCommandBuffers(m_device, &command_buffer_allocate_info, &vk_command_buffer) != VK_SUCCESS) {
+                LOG_ERROR("vkAllocateCommandBuffers failed");
+            }
+            RHICommandBuffer* rhi_command_buffer = new VulkanCommandBuffer();
+            ((VulkanCommandBuffer*)rhi_command_buffer)->setResource(vk_command_buffer);
+            thread_command_pool.command_buffers.push_back(rhi_command_buffer);
+        }
+        RHICommandBuffer* command_buffer = thread_command_pool.command_buffers[thread_command_pool.used_command_buffer_count++];
+
+        RHICommandBufferInheritanceInfo inheritance_info{};
+        inheritance_info.sType = RHI_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance_info.renderPass = render_pass;
+        inheritance_info.subpass = subpass;
+        inheritance_info.framebuffer = framebuffer;
+
+        RHICommandBufferBeginInfo begin_info{};
+        begin_info.sType = RHI_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = RHI_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | RHI_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        begin_info.pInheritanceInfo = &inheritance_info;
+        beginCommandBufferPFN(command_buffer, &begin_info);
+        return command_buffer;
+    }
+
     bool VulkanRHI::checkValidationLayerSupport() {
         uint32_t layerCount;
         vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
@@ -599,7 +666,8 @@ namespace Dao {
         std::set<uint32_t> queue_families = {
             m_queue_indices.graphics_family.value(),
             m_queue_indices.present_family.value(),
-            m_queue_indices.compute_family.value()
+            m_queue_indices.compute_family.value(),
+            m_queue_indices.transfer_family.value()
         };
         float queue_priority = 1.0f;
         for (uint32_t queue_family : queue_families) {
@@ -618,6 +686,19 @@ namespace Dao {
         if (_enable_point_light_shadow) {
             physical_device_feature.geometryShader = VK_TRUE;
         }
+        // indirect mesh draws index the per instance data through first instance
+        VkPhysicalDeviceFeatures supported_physical_device_features;
+        vkGetPhysicalDeviceFeatures(m_physical_device, &supported_physical_device_features);
+        _enable_multi_draw_indirect = supported_physical_device_features.multiDrawIndirect && supported_physical_device_features.drawIndirectFirstInstance;
+        if (_enable_multi_draw_indirect) {
+            physical_device_feature.multiDrawIndirect = VK_TRUE;
+            physical_device_feature.drawIndirectFirstInstance = VK_TRUE;
+        }
+        // cooked textures fall back to 8 bit per channel without it
+        _enable_texture_compression_bc = supported_physical_device_features.textureCompressionBC;
+        if (_enable_texture_compression_bc) {
+            physical_device_feature.textureCompressionBC = VK_TRUE;
+        }
 
         VkDeviceCreateInfo device_create_info{};
         device_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -644,12 +725,15 @@ namespace Dao {
         m_compute_queue = new VulkanQueue();
         ((VulkanQueue*)m_compute_queue)->setResource(vk_compute_queue);
 
+        vkGetDeviceQueue(m_device, m_queue_indices.transfer_family.value(), 0, &m_transfer_queue);
+
         f_vkResetCommandPool = (PFN_vkResetCommandPool)vkGetDeviceProcAddr(m_device, "vkResetCommandPool");
         f_vkBeginCommandBuffer = (PFN_vkBeginCommandBuffer)vkGetDeviceProcAddr(m_device, "vkBeginCommandBuffer");
         f_vkEndCommandBuffer = (PFN_vkEndCommandBuffer)vkGetDeviceProcAddr(m_device, "vkEndCommandBuffer");
         f_vkCmdBeginRenderPass = (PFN_vkCmdBeginRenderPass)vkGetDeviceProcAddr(m_device, "vkCmdBeginRenderPass");
         f_vkCmdNextSubpass = (PFN_vkCmdNextSubpass)vkGetDeviceProcAddr(m_device, "vkCmdNextSubpass");
         f_vkCmdEndRenderPass = (PFN_vkCmdEndRenderPass)vkGetDeviceProcAddr(m_device, "vkCmdEndRenderPass");
+        f_vkCmdExecuteCommands = (PFN_vkCmdExecuteCommands)vkGetDeviceProcAddr(m_device, "vkCmdExecuteCommands");
         f_vkCmdBindPipeline = (PFN_vkCmdBindPipeline)vkGetDeviceProcAddr(m_device, "vkCmdBindPipeline");
         f_vkCmdSetViewport = (PFN_vkCmdSetViewport)vkGetDeviceProcAddr(m_device, "vkCmdSetViewport");
         f_vkCmdSetScissor = (PFN_vkCmdSetScissor)vkGetDeviceProcAddr(m_device, "vkCmdSetScissor");
@@ -1586,6 +1670,18 @@ namespace Dao {
         f_vkCmdEndRenderPass(((VulkanCommandBuffer*)command_buffer)->getResource());
     }
 
+    void VulkanRHI::cmdExecuteCommandsPFN(
+        RHICommandBuffer* command_buffer,
+        uint32_t command_buffer_count,
+        RHICommandBuffer* const* command_buffers
+    ) {
+        std::vector<VkCommandBuffer> vk_command_buffer_list(command_buffer_count);
+        for (uint32_t i = 0; i < command_buffer_count; ++i) {
+            vk_command_buffer_list[i] = ((VulkanCommandBuffer*)command_buffers[i])->getResource();
+        }
+        f_vkCmdExecuteCommands(((VulkanCommandBuffer*)command_buffer)->getResource(), command_buffer_count, vk_command_buffer_list.data());
+    }
+
     void VulkanRHI::cmdBindPipelinePFN(
         RHICommandBuffer* command_buffer,
         RHIPipelineBindPoint pipeline_bind_point,
@@ -2167,6 +2263,19 @@ namespace Dao {
         );
     }
 
+    void VulkanRHI::cmdDrawIndexedIndirect(
+        RHICommandBuffer* command_buffer,
+        RHIBuffer* buffer,
+        RHIDeviceSize offset,
+        uint32_t draw_count,
+        uint32_t stride
+    ) {
+        vkCmdDrawIndexedIndirect(
+            ((VulkanCommandBuffer*)command_buffer)->getResource(),
+            ((VulkanBuffer*)buffer)->getResource(), offset, draw_count, stride
+        );
+    }
+
     void VulkanRHI::cmdCopyImageToBuffer(
         RHICommandBuffer* command_buffer,
         RHIImage* src_image,
@@ -2291,7 +2400,7 @@ namespace Dao {
         pool_sizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
         pool_sizes[0].descriptorCount = 3 + 2 + 2 + 2 + 1 + 1 + 3 + 3;
         pool_sizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        pool_sizes[1].descriptorCount = 1 + 1 + 1 * _max_vertex_blending_mesh_count;
+        pool_sizes[1].descriptorCount = 1 + 1 + 4 + 1 * _max_vertex_blending_mesh_count; // +scene instance buffer of the mesh, shadow and pick passes
         pool_sizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
         pool_sizes[2].descriptorCount = 1 * _max_material_count;
         pool_sizes[3].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -2915,17 +3024,19 @@ namespace Dao {
         vkFlushMappedMemoryRanges(m_device, 1, &mapped_range);
     }
 
+    void VulkanRHI::setFramebufferSize(uint32_t width, uint32_t height) {
+        m_framebuffer_width = width;
+        m_framebuffer_height = height;
+    }
+
     RHISemaphore*& VulkanRHI::getTextureCopySemaphore(uint32_t index) {
         return m_image_available_for_texturescopy_semaphores[index];
     }
 
     void VulkanRHI::recreateSwapchain() {
-        int width = 0;
-        int height = 0;
-        glfwGetFramebufferSize(m_window, &width, &height);
-        while (width == 0 || height == 0) {
-            glfwGetFramebufferSize(m_window, &width, &height);
-            glfwWaitEvents();
+        //a minimized window has no extent, the swapchain is recreated once the main thread reports the restored size
+        if (m_framebuffer_width == 0 || m_framebuffer_height == 0) {
+            return;
         }
         VkResult result = f_vkWaitForFences(m_device, k_max_frames_in_flight, m_is_frame_in_flight_fences, VK_TRUE, UINT64_MAX);
         if (result != VK_SUCCESS) {
@@ -2991,6 +3102,15 @@ namespace Dao {
             }
             ++i;
         }
+        // uploads overlap with rendering on a transfer only family, without one they share the graphics queue
+        indices.transfer_family = indices.graphics_family;
+        for (uint32_t family_index = 0; family_index < queue_family_count; ++family_index) {
+            VkQueueFlags queue_flags = queue_families[family_index].queueFlags;
+            if ((queue_flags & VK_QUEUE_TRANSFER_BIT) && !(queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+                indices.transfer_family = family_index;
+                break;
+            }
+        }
         return indices;
     }
 
@@ -3095,9 +3215,7 @@ namespace Dao {
             return capabilities.currentExtent;
         }
         else {
-            int width, height;
-            glfwGetFramebufferSize(m_window, &width, &height);
-            VkExtent2D actual_extent = { static_cast<uint32_t>(width),static_cast<uint32_t>(height) };
+            VkExtent2D actual_extent = { m_framebuffer_width,m_framebuffer_height };
             actual_extent.width = std::clamp(actual_extent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
             actual_extent.height = std::clamp(actual_extent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
             return actual_extent;
@@ -3123,10 +3241,68 @@ namespace Dao {
         }
     }
 
+    uint64_t VulkanRHI::uploadBuffer(RHIBuffer* dst_buffer, RHIDeviceSize dst_offset, const void* data, RHIDeviceSize size) {
+        return m_upload_manager.uploadBuffer(((VulkanBuffer*)dst_buffer)->getResource(), dst_offset, data, size);
+    }
+
+    uint64_t VulkanRHI::createGlobalImageAsync(
+        RHIImage*& image,
+        RHIImageView*& image_view,
+        VmaAllocation& image_allocation,
+        uint32_t texture_image_width,
+        uint32_t texture_image_height,
+        void* texture_image_pixels,
+        RHIFormat texture_image_format,
+        uint32_t miplevels
+    ) {
+        VkFormat vulkan_image_format;
+        uint32_t mip_levels = std::max(miplevels, 1u);
+        std::vector<VkDeviceSize> level_offsets(mip_levels);
+        VkDeviceSize texture_byte_size = 0;
+        for (uint32_t level = 0; level < mip_levels; ++level) {
+            VkDeviceSize level_byte_size;
+            if (!texture_image_pixels || !VulkanUtil::getGlobalImageFormat(
+                texture_image_format,
+                std::max(texture_image_width >> level, 1u),
+                std::max(texture_image_height >> level, 1u),
+                vulkan_image_format, level_byte_size
+            )) {
+                return 0;
+            }
+            level_offsets[level] = texture_byte_size;
+            texture_byte_size += level_byte_size;
+        }
+        VkImage vk_image;
+        VulkanUtil::createGlobalImageResource(this, vk_image, image_allocation, texture_image_width, texture_image_height, vulkan_image_format, mip_levels);
+        uint64_t upload_id = m_upload_manager.uploadImage(vk_image, texture_image_width, texture_image_height, level_offsets, texture_image_pixels, texture_byte_size);
+        VkImageView vk_image_view = VulkanUtil::createImageView(m_device, vk_image, vulkan_image_format, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_VIEW_TYPE_2D, 1, mip_levels);
+        image = new VulkanImage();
+        image_view = new VulkanImageView();
+        ((VulkanImage*)image)->setResource(vk_image);
+        ((VulkanImageView*)image_view)->setResource(vk_image_view);
+        return upload_id;
+    }
+
+    void VulkanRHI::flushUploads() {
+        m_upload_manager.flush();
+    }
+
+    bool VulkanRHI::isUploadComplete(uint64_t upload_id) const {
+        return m_upload_manager.isUploadComplete(upload_id);
+    }
+
     bool VulkanRHI::isPointLightShadowEnabled() {
         return _enable_point_light_shadow;
     }
 
+    bool VulkanRHI::isMultiDrawIndirectEnabled() {
+        return _enable_multi_draw_indirect;
+    }
+
+    bool VulkanRHI::isTextureCompressionBCEnabled() {
+        return _enable_texture_compression_bc;
+    }
+
     RHICommandBuffer* VulkanRHI::getCurrentCommandBuffer() const {
         return m_current_command_buffer;
     }
@@ -3188,4 +3364,12 @@ namespace Dao {
     void VulkanRHI::setCurrentFrameIndex(uint8_t index) {
         m_current_frame_index = index;
     }
+
+    uint32_t VulkanRHI::getCurrentSwapchainImageIndex() const {
+        return m_current_swapchain_image_index;
+    }
+
+    VmaAllocator VulkanRHI::getAssetsAllocator() const {
+        return m_assets_allocator;
+    }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "runtime/function/render/interface/rhi.h"
 #include "runtime/function/render/interface/vulkan/vulkan_rhi_res.h"
+#include "runtime/function/render/interface/vulkan/vulkan_upload_manager.h"
 
 #include <vma/vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
@@ -32,6 +33,7 @@ namespace Dao {
 		// create
 		void createSwapchain() override;
 		void recreateSwapchain() override;
+		void setFramebufferSize(uint32_t width, uint32_t height) override;
 		void createSwapchainImageViews() override;
 		void createFramebufferImageAndView() override;
 		bool createCommandPool(
@@ -198,6 +200,11 @@ namespace Dao {
 			RHISubpassContents contents
 		) override;
 		void cmdEndRenderPassPFN(RHICommandBuffer* command_buffer) override;
+		void cmdExecuteCommandsPFN(
+			RHICommandBuffer* command_buffer,
+			uint32_t command_buffer_count,
+			RHICommandBuffer* const* command_buffers
+		) override;
 		void cmdBindPipelinePFN(
 			RHICommandBuffer* command_buffer,
 			RHIPipelineBindPoint pipeline_bind_point,
@@ -301,6 +308,13 @@ namespace Dao {
 			RHIBuffer* buffer,
 			RHIDeviceSize offset
 		) override;
+		void cmdDrawIndexedIndirect(
+			RHICommandBuffer* command_buffer,
+			RHIBuffer* buffer,
+			RHIDeviceSize offset,
+			uint32_t draw_count,
+			uint32_t stride
+		) override;
 		void cmdPipelineBarrier(
 			RHICommandBuffer* command_buffer,
 			RHIPipelineStageFlags src_stage_mask,
@@ -351,15 +365,39 @@ namespace Dao {
 		uint8_t getMaxFramesInFlight() const override;
 		uint8_t getCurrentFrameIndex() const override;
 		void setCurrentFrameIndex(uint8_t index) override;
+		uint32_t getCurrentSwapchainImageIndex() const override;
+		VmaAllocator getAssetsAllocator() const override;
 
 		// command write
 		RHICommandBuffer* beginSingleTimeCommands() override;
 		void endSingleTimeCommands(RHICommandBuffer* command_buffer) override;
+		void createThreadCommandPools(uint32_t thread_count) override;
+		RHICommandBuffer* beginSecondaryCommandBuffer(
+			uint32_t thread_index,
+			RHIRenderPass* render_pass,
+			uint32_t subpass,
+			RHIFramebuffer* framebuffer
+		) override;
 		bool prepareBeforePass(std::function<void()> pass_update_after_recreate_swapchain) override;
 		void submitRendering(std::function<void()> pass_update_after_recreate_swapchain) override;
 		void pushEvent(RHICommandBuffer* command_buffer, const char* name, const float* color) override;
 		void popEvent(RHICommandBuffer* commond_buffer) override;
 
+		// asynchronous upload
+		uint64_t uploadBuffer(RHIBuffer* dst_buffer, RHIDeviceSize dst_offset, const void* data, RHIDeviceSize size) override;
+		uint64_t createGlobalImageAsync(
+			RHIImage*& image,
+			RHIImageView*& image_view,
+			VmaAllocation& image_allocation,
+			uint32_t texture_image_width,
+			uint32_t texture_image_height,
+			void* texture_image_pixels,
+			RHIFormat texture_image_format,
+			uint32_t miplevels = 1
+		) override;
+		void flushUploads() override;
+		bool isUploadComplete(uint64_t upload_id) const override;
+
 		// destroy
 		void clear() override;
 		void clearSwapChain() override;
@@ -410,6 +448,8 @@ namespace Dao {
 
 	public:
 		bool isPointLightShadowEnabled() override;
+		bool isMultiDrawIndirectEnabled() override;
+		bool isTextureCompressionBCEnabled() override;
 
 	public:
 		static uint8_t	const				k_max_frames_in_flight{ 3 };
@@ -437,11 +477,15 @@ namespace Dao {
 		QueueFamilyIndices					m_queue_indices;
 
 		GLFWwindow*							m_window{ nullptr };
+		// polled by the main thread, glfw can not be queried from the render thread
+		uint32_t							m_framebuffer_width{ 0 };
+		uint32_t							m_framebuffer_height{ 0 };
 		VkInstance							m_instance{ nullptr };
 		VkSurfaceKHR						m_surface{ nullptr };
 		VkPhysicalDevice					m_physical_device{ nullptr };
 		VkDevice							m_device{ nullptr };
 		VkQueue								m_present_queue{ nullptr };
+		VkQueue								m_transfer_queue{ nullptr };
 
 		VkSwapchainKHR						m_swapchain{ nullptr };
 		std::vector<VkImage>				m_swapchain_images;
@@ -464,11 +508,22 @@ namespace Dao {
 		VkFence								m_is_frame_in_flight_fences[k_max_frames_in_flight];
 
 		VkCommandBuffer						m_vk_current_command_buffer;
+
+		// per thread pools for secondary command buffers, buffers are reused once their pool is reset
+		struct ThreadCommandPool {
+			VkCommandPool					command_pool{ VK_NULL_HANDLE };
+			std::vector<RHICommandBuffer*>	command_buffers;
+			uint32_t						used_command_buffer_count{ 0 };
+		};
+		std::vector<ThreadCommandPool>		m_thread_command_pools[k_max_frames_in_flight];
 		uint32_t							m_current_swapchain_image_index;
 
 		// asset allocator
 		VmaAllocator						m_assets_allocator;
 
+		// streams mesh and texture data on the transfer queue
+		VulkanUploadManager					m_upload_manager;
+
 		// function pointers
 		PFN_vkCmdBeginDebugUtilsLabelEXT	f_vkCmdBeginDebugUtilsLabelEXT;
 		PFN_vkCmdEndDebugUtilsLabelEXT		f_vkCmdEndDebugUtilsLabelEXT;
@@ -480,6 +535,7 @@ namespace Dao {
 		PFN_vkCmdBeginRenderPass			f_vkCmdBeginRenderPass;
 		PFN_vkCmdNextSubpass				f_vkCmdNextSubpass;
 		PFN_vkCmdEndRenderPass				f_vkCmdEndRenderPass;
+		PFN_vkCmdExecuteCommands			f_vkCmdExecuteCommands;
 		PFN_vkCmdBindPipeline				f_vkCmdBindPipeline;
 		PFN_vkCmdSetViewport				f_vkCmdSetViewport;
 		PFN_vkCmdSetScissor					f_vkCmdSetScissor;
@@ -503,6 +559,8 @@ namespace Dao {
 		bool								_enable_validation_layers{ true };
 		bool								_enable_debug_utils_label{ true };
 		bool								_enable_point_light_shadow{ true };
+		bool								_enable_multi_draw_indirect{ false };
+		bool								_enable_texture_compression_bc{ false };
 
 		// used in descriptor pool creation
 		uint32_t							_max_vertex_blending_mesh_count{ 256 };
@@ -0,0 +1,370 @@
+#include "runtime/function/render/interface/vulkan/vulkan_upload_manager.h"
+#include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
+#include "runtime/function/render/interface/vulkan/vulkan_util.h"
+#include "runtime/core/base/macro.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Dao {
+
+	namespace {
+		//keeps buffer to image copies aligned to the texel size of every supported format
+		constexpr uint64_t s_staging_alignment = 16;
+
+		VkImageMemoryBarrier makeImageBarrier(
+			VkImage image,
+			VkImageLayout old_layout,
+			VkImageLayout new_layout,
+			VkAccessFlags src_access_mask,
+			VkAccessFlags dst_access_mask,
+			uint32_t base_miplevel,
+			uint32_t miplevel_count,
+			uint32_t src_queue_family = VK_QUEUE_FAMILY_IGNORED,
+			uint32_t dst_queue_family = VK_QUEUE_FAMILY_IGNORED
+		) {
+			VkImageMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.oldLayout = old_layout;
+			barrier.newLayout = new_layout;
+			barrier.srcAccessMask = src_access_mask;
+			barrier.dstAccessMask = dst_access_mask;
+			barrier.srcQueueFamilyIndex = src_queue_family;
+			barrier.dstQueueFamilyIndex = dst_queue_family;
+			barrier.image = image;
+			barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			barrier.subresourceRange.baseMipLevel = base_miplevel;
+			barrier.subresourceRange.levelCount = miplevel_count;
+			barrier.subresourceRange.baseArrayLayer = 0;
+			barrier.subresourceRange.layerCount = 1;
+			return barrier;
+		}
+
+		VkBufferMemoryBarrier makeBufferBarrier(
+			VkBuffer buffer,
+			VkDeviceSize offset,
+			VkDeviceSize size,
+			VkAccessFlags src_access_mask,
+			VkAccessFlags dst_access_mask,
+			uint32_t src_queue_family,
+			uint32_t dst_queue_family
+		) {
+			VkBufferMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			barrier.srcAccessMask = src_access_mask;
+			barrier.dstAccessMask = dst_access_mask;
+			barrier.srcQueueFamilyIndex = src_queue_family;
+			barrier.dstQueueFamilyIndex = dst_queue_family;
+			barrier.buffer = buffer;
+			barrier.offset = offset;
+			barrier.size = size;
+			return barrier;
+		}
+	}
+
+	void VulkanUploadManager::initialize(VulkanRHI* rhi, uint32_t transfer_queue_family, VkQueue transfer_queue) {
+		_rhi = rhi;
+		_device = rhi->m_device;
+		_transfer_queue = transfer_queue;
+		_transfer_queue_family = transfer_queue_family;
+		_graphics_queue = static_cast<VulkanQueue*>(rhi->m_graphics_queue)->getResource();
+		_graphics_queue_family = rhi->m_queue_indices.graphics_family.value();
+
+		VkCommandPoolCreateInfo command_pool_create_info{};
+		command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		command_pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		command_pool_create_info.queueFamilyIndex = _transfer_queue_family;
+		if (vkCreateCommandPool(_device, &command_pool_create_info, nullptr, &_transfer_command_pool) != VK_SUCCESS) {
+			LOG_ERROR("vkCreateCommandPool failed!");
+		}
+		command_pool_create_info.queueFamilyIndex = _graphics_queue_family;
+		if (vkCreateCommandPool(_device, &command_pool_create_info, nullptr, &_graphics_command_pool) != VK_SUCCESS) {
+			LOG_ERROR("vkCreateCommandPool failed!");
+		}
+
+		VulkanUtil::createBuffer(
+			rhi->m_physical_device, _device, s_staging_ring_size,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			_staging_ring, _staging_ring_memory
+		);
+		void* staging_ring_pointer = nullptr;
+		if (vkMapMemory(_device, _staging_ring_memory, 0, VK_WHOLE_SIZE, 0, &staging_ring_pointer) != VK_SUCCESS) {
+			LOG_ERROR("failed to map upload staging ring");
+		}
+		_staging_ring_pointer = static_cast<uint8_t*>(staging_ring_pointer);
+	}
+
+	void VulkanUploadManager::clear() {
+		if (_device == VK_NULL_HANDLE) {
+			return;
+		}
+		submitPendingBatch();
+		while (!_in_flight_batches.empty()) {
+			vkWaitForFences(_device, 1, &_in_flight_batches.front().fence, VK_TRUE, UINT64_MAX);
+			retireBatch(_in_flight_batches.front());
+			_in_flight_batches.pop_front();
+		}
+		vkUnmapMemory(_device, _staging_ring_memory);
+		vkDestroyBuffer(_device, _staging_ring, nullptr);
+		vkFreeMemory(_device, _staging_ring_memory, nullptr);
+		vkDestroyCommandPool(_device, _transfer_command_pool, nullptr);
+		vkDestroyCommandPool(_device, _graphics_command_pool, nullptr);
+		_device = VK_NULL_HANDLE;
+	}
+
+	uint64_t VulkanUploadManager::uploadBuffer(VkBuffer dst_buffer, VkDeviceSize dst_offset, const void* data, VkDeviceSize size) {
+		if (size == 0) {
+			return _completed_batch_serial;
+		}
+		BufferCopy copy;
+		stage(data, size, copy.src_buffer, copy.region.srcOffset);
+		copy.dst_buffer = dst_buffer;
+		copy.region.dstOffset = dst_offset;
+		copy.region.size = size;
+		_pending_buffer_copies.push_back(copy);
+		return _next_batch_serial;
+	}
+
+	uint64_t VulkanUploadManager::uploadImage(VkImage image, uint32_t width, uint32_t height, const std::vector<VkDeviceSize>& level_offsets, const void* pixels, VkDeviceSize byte_size) {
+		ImageCopy copy;
+		stage(pixels, byte_size, copy.src_buffer, copy.src_offset);
+		copy.image = image;
+		copy.width = width;
+		copy.height = height;
+		copy.miplevels = static_cast<uint32_t>(level_offsets.size());
+		copy.level_offsets = level_offsets;
+		_pending_image_copies.push_back(std::move(copy));
+		return _next_batch_serial;
+	}
+
+	void VulkanUploadManager::flush() {
+		while (!_in_flight_batches.empty() && vkGetFenceStatus(_device, _in_flight_batches.front().fence) == VK_SUCCESS) {
+			retireBatch(_in_flight_batches.front());
+			_in_flight_batches.pop_front();
+		}
+		submitPendingBatch();
+	}
+
+	void VulkanUploadManager::stage(const void* data, VkDeviceSize size, VkBuffer& src_buffer, VkDeviceSize& src_offset) {
+		if (size > s_staging_ring_size) {
+			DedicatedStaging staging;
+			VulkanUtil::createBuffer(
+				_rhi->m_physical_device, _device, size,
+				VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				staging.buffer, staging.memory
+			);
+			void* staging_data = nullptr;
+			vkMapMemory(_device, staging.memory, 0, size, 0, &staging_data);
+			memcpy(staging_data, data, static_cast<size_t>(size));
+			vkUnmapMemory(_device, staging.memory);
+			_pending_dedicated_stagings.push_back(staging);
+			src_buffer = staging.buffer;
+			src_offset = 0;
+			return;
+		}
+
+		uint64_t position = (_staging_head + s_staging_alignment - 1) / s_staging_alignment * s_staging_alignment;
+		if (position % s_staging_ring_size + size > s_staging_ring_size) {
+			//does not fit before the end of the ring, skip to its start
+			position = (position / s_staging_ring_size + 1) * s_staging_ring_size;
+		}
+		while (position + size - _staging_tail > s_staging_ring_size) {
+			if (!_pending_buffer_copies.empty() || !_pending_image_copies.empty()) {
+				submitPendingBatch();
+			}
+			else if (_in_flight_batches.empty()) {
+				//nothing holds staging memory
+				_staging_tail = position;
+			}
+			else {
+				//the ring is full, wait for the oldest batch
+				vkWaitForFences(_device, 1, &_in_flight_batches.front().fence, VK_TRUE, UINT64_MAX);
+				retireBatch(_in_flight_batches.front());
+				_in_flight_batches.pop_front();
+			}
+		}
+
+		src_buffer = _staging_ring;
+		src_offset = position % s_staging_ring_size;
+		memcpy(_staging_ring_pointer + src_offset, data, static_cast<size_t>(size));
+		_staging_head = position + size;
+	}
+
+	void VulkanUploadManager::submitPendingBatch() {
+		if (_pending_buffer_copies.empty() && _pending_image_copies.empty()) {
+			return;
+		}
+
+		Batch batch;
+		batch.serial = _next_batch_serial++;
+
+		VkCommandBufferAllocateInfo allocate_info{};
+		allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocate_info.commandBufferCount = 1;
+		allocate_info.commandPool = _transfer_command_pool;
+		vkAllocateCommandBuffers(_device, &allocate_info, &batch.transfer_command_buffer);
+		allocate_info.commandPool = _graphics_command_pool;
+		vkAllocateCommandBuffers(_device, &allocate_info, &batch.graphics_command_buffer);
+
+		VkCommandBufferBeginInfo begin_info{};
+		begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkBeginCommandBuffer(batch.transfer_command_buffer, &begin_info);
+		recordTransferCommands(batch.transfer_command_buffer);
+		vkEndCommandBuffer(batch.transfer_command_buffer);
+		vkBeginCommandBuffer(batch.graphics_command_buffer, &begin_info);
+		recordGraphicsCommands(batch.graphics_command_buffer);
+		vkEndCommandBuffer(batch.graphics_command_buffer);
+
+		VkSemaphoreCreateInfo semaphore_create_info{};
+		semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		vkCreateSemaphore(_device, &semaphore_create_info, nullptr, &batch.transfer_finished_semaphore);
+		VkFenceCreateInfo fence_create_info{};
+		fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		vkCreateFence(_device, &fence_create_info, nullptr, &batch.fence);
+
+		VkSubmitInfo transfer_submit_info{};
+		transfer_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		transfer_submit_info.commandBufferCount = 1;
+		transfer_submit_info.pCommandBuffers = &batch.transfer_command_buffer;
+		transfer_submit_info.signalSemaphoreCount = 1;
+		transfer_submit_info.pSignalSemaphores = &batch.transfer_finished_semaphore;
+		if (vkQueueSubmit(_transfer_queue, 1, &transfer_submit_info, VK_NULL_HANDLE) != VK_SUCCESS) {
+			LOG_ERROR("failed to submit upload batch to the transfer queue");
+		}
+
+		VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		VkSubmitInfo graphics_submit_info{};
+		graphics_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		graphics_submit_info.waitSemaphoreCount = 1;
+		graphics_submit_info.pWaitSemaphores = &batch.transfer_finished_semaphore;
+		graphics_submit_info.pWaitDstStageMask = &wait_stage;
+		graphics_submit_info.commandBufferCount = 1;
+		graphics_submit_info.pCommandBuffers = &batch.graphics_command_buffer;
+		if (vkQueueSubmit(_graphics_queue, 1, &graphics_submit_info, batch.fence) != VK_SUCCESS) {
+			LOG_ERROR("failed to submit upload batch to the graphics queue");
+		}
+
+		batch.staging_end = _staging_head;
+		batch.dedicated_stagings.swap(_pending_dedicated_stagings);
+		_pending_buffer_copies.clear();
+		_pending_image_copies.clear();
+		_in_flight_batches.push_back(std::move(batch));
+	}
+
+	void VulkanUploadManager::retireBatch(Batch& batch) {
+		vkFreeCommandBuffers(_device, _transfer_command_pool, 1, &batch.transfer_command_buffer);
+		vkFreeCommandBuffers(_device, _graphics_command_pool, 1, &batch.graphics_command_buffer);
+		vkDestroySemaphore(_device, batch.transfer_finished_semaphore, nullptr);
+		vkDestroyFence(_device, batch.fence, nullptr);
+		for (DedicatedStaging& staging : batch.dedicated_stagings) {
+			vkDestroyBuffer(_device, staging.buffer, nullptr);
+			vkFreeMemory(_device, staging.memory, nullptr);
+		}
+		_staging_tail = batch.staging_end;
+		_completed_batch_serial = batch.serial;
+	}
+
+	void VulkanUploadManager::recordTransferCommands(VkCommandBuffer command_buffer) {
+		std::vector<VkImageMemoryBarrier> image_barriers;
+		image_barriers.reserve(_pending_image_copies.size());
+		for (const ImageCopy& copy : _pending_image_copies) {
+			image_barriers.push_back(makeImageBarrier(
+				copy.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				0, VK_ACCESS_TRANSFER_WRITE_BIT, 0, copy.miplevels
+			));
+		}
+		if (!image_barriers.empty()) {
+			vkCmdPipelineBarrier(
+				command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+				0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(image_barriers.size()), image_barriers.data()
+			);
+		}
+
+		for (const BufferCopy& copy : _pending_buffer_copies) {
+			vkCmdCopyBuffer(command_buffer, copy.src_buffer, copy.dst_buffer, 1, &copy.region);
+		}
+		std::vector<VkBufferImageCopy> regions;
+		for (const ImageCopy& copy : _pending_image_copies) {
+			regions.resize(copy.miplevels);
+			for (uint32_t level = 0; level < copy.miplevels; ++level) {
+				VkBufferImageCopy& region = regions[level];
+				region = {};
+				region.bufferOffset = copy.src_offset + copy.level_offsets[level];
+				region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.imageSubresource.mipLevel = level;
+				region.imageSubresource.baseArrayLayer = 0;
+				region.imageSubresource.layerCount = 1;
+				region.imageExtent = { std::max(copy.width >> level, 1u), std::max(copy.height >> level, 1u), 1 };
+			}
+			vkCmdCopyBufferToImage(
+				command_buffer, copy.src_buffer, copy.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				static_cast<uint32_t>(regions.size()), regions.data()
+			);
+		}
+
+		//a dedicated transfer queue has to release the resources to the graphics queue family
+		if (_transfer_queue_family == _graphics_queue_family) {
+			return;
+		}
+		std::vector<VkBufferMemoryBarrier> buffer_barriers;
+		buffer_barriers.reserve(_pending_buffer_copies.size());
+		for (const BufferCopy& copy : _pending_buffer_copies) {
+			buffer_barriers.push_back(makeBufferBarrier(
+				copy.dst_buffer, copy.region.dstOffset, copy.region.size,
+				VK_ACCESS_TRANSFER_WRITE_BIT, 0, _transfer_queue_family, _graphics_queue_family
+			));
+		}
+		//release and acquire have to name the same layout transition
+		image_barriers.clear();
+		for (const ImageCopy& copy : _pending_image_copies) {
+			image_barriers.push_back(makeImageBarrier(
+				copy.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+				VK_ACCESS_TRANSFER_WRITE_BIT, 0, 0, copy.miplevels, _transfer_queue_family, _graphics_queue_family
+			));
+		}
+		vkCmdPipelineBarrier(
+			command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
+			static_cast<uint32_t>(buffer_barriers.size()), buffer_barriers.data(),
+			static_cast<uint32_t>(image_barriers.size()), image_barriers.data()
+		);
+	}
+
+	void VulkanUploadManager::recordGraphicsCommands(VkCommandBuffer command_buffer) {
+		//acquire what the transfer queue released, on a shared queue family this only makes the copies visible
+		const bool is_ownership_transfer = _transfer_queue_family != _graphics_queue_family;
+		const uint32_t src_queue_family = is_ownership_transfer ? _transfer_queue_family : VK_QUEUE_FAMILY_IGNORED;
+		const uint32_t dst_queue_family = is_ownership_transfer ? _graphics_queue_family : VK_QUEUE_FAMILY_IGNORED;
+		const VkAccessFlags src_access_mask = is_ownership_transfer ? 0 : VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		std::vector<VkBufferMemoryBarrier> buffer_barriers;
+		buffer_barriers.reserve(_pending_buffer_copies.size());
+		for (const BufferCopy& copy : _pending_buffer_copies) {
+			buffer_barriers.push_back(makeBufferBarrier(
+				copy.dst_buffer, copy.region.dstOffset, copy.region.size, src_access_mask,
+				VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT,
+				src_queue_family, dst_queue_family
+			));
+		}
+		//every level was copied, the images go straight to shader reads
+		std::vector<VkImageMemoryBarrier> image_barriers;
+		image_barriers.reserve(_pending_image_copies.size());
+		for (const ImageCopy& copy : _pending_image_copies) {
+			image_barriers.push_back(makeImageBarrier(
+				copy.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+				src_access_mask, VK_ACCESS_SHADER_READ_BIT,
+				0, copy.miplevels, src_queue_family, dst_queue_family
+			));
+		}
+		vkCmdPipelineBarrier(
+			command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			0, 0, nullptr,
+			static_cast<uint32_t>(buffer_barriers.size()), buffer_barriers.data(),
+			static_cast<uint32_t>(image_barriers.size()), image_barriers.data()
+		);
+	}
+}
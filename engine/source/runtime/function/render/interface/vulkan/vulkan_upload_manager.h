@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Dao {
+
+	class VulkanRHI;
+
+	/// streams buffer and texture data to the gpu without waiting for the queue.
+	/// data is copied into a persistently mapped staging ring at once, the copies requested during a frame
+	/// are recorded into one batch by flush: a submission on the transfer queue does the copies,
+	/// a second one on the graphics queue takes over ownership and signals the batch fence.
+	/// upload ids are batch serials, an upload is complete once the fence of its batch signaled.
+	/// not thread safe, only used from the render thread
+	class VulkanUploadManager {
+	public:
+		static constexpr VkDeviceSize s_staging_ring_size = 64 * 1024 * 1024;
+
+		void initialize(VulkanRHI* rhi, uint32_t transfer_queue_family, VkQueue transfer_queue);
+		void clear();
+
+		uint64_t uploadBuffer(VkBuffer dst_buffer, VkDeviceSize dst_offset, const void* data, VkDeviceSize size);
+		/// image has to be created with transfer dst usage, pixels holds one level per entry of level_offsets
+		/// at that offset, the levels are copied as they are
+		uint64_t uploadImage(VkImage image, uint32_t width, uint32_t height, const std::vector<VkDeviceSize>& level_offsets, const void* pixels, VkDeviceSize byte_size);
+
+		/// submit the pending batch and retire the batches whose fence signaled
+		void flush();
+		bool isUploadComplete(uint64_t upload_id) const { return upload_id <= _completed_batch_serial; }
+
+	private:
+		struct BufferCopy {
+			VkBuffer		src_buffer;
+			VkBuffer		dst_buffer;
+			VkBufferCopy	region;
+		};
+
+		struct ImageCopy {
+			VkBuffer		src_buffer;
+			VkDeviceSize	src_offset;
+			VkImage			image;
+			uint32_t		width;
+			uint32_t		height;
+			uint32_t		miplevels;
+			//relative to src_offset
+			std::vector<VkDeviceSize>	level_offsets;
+		};
+
+		//staging buffer for an upload larger than the ring, destroyed with its batch
+		struct DedicatedStaging {
+			VkBuffer		buffer{ VK_NULL_HANDLE };
+			VkDeviceMemory	memory{ VK_NULL_HANDLE };
+		};
+
+		struct Batch {
+			uint64_t						serial{ 0 };
+			VkCommandBuffer					transfer_command_buffer{ VK_NULL_HANDLE };
+			VkCommandBuffer					graphics_command_buffer{ VK_NULL_HANDLE };
+			VkSemaphore						transfer_finished_semaphore{ VK_NULL_HANDLE };
+			VkFence							fence{ VK_NULL_HANDLE };
+			//ring position up to which the staging memory is released when the batch retires
+			uint64_t						staging_end{ 0 };
+			std::vector<DedicatedStaging>	dedicated_stagings;
+		};
+
+		/// @return: source buffer and offset holding a copy of data
+		void stage(const void* data, VkDeviceSize size, VkBuffer& src_buffer, VkDeviceSize& src_offset);
+		void submitPendingBatch();
+		void retireBatch(Batch& batch);
+		void recordTransferCommands(VkCommandBuffer command_buffer);
+		void recordGraphicsCommands(VkCommandBuffer command_buffer);
+
+	private:
+		VulkanRHI*						_rhi{ nullptr };
+		VkDevice						_device{ VK_NULL_HANDLE };
+		VkQueue							_transfer_queue{ VK_NULL_HANDLE };
+		VkQueue							_graphics_queue{ VK_NULL_HANDLE };
+		uint32_t						_transfer_queue_family{ 0 };
+		uint32_t						_graphics_queue_family{ 0 };
+		VkCommandPool					_transfer_command_pool{ VK_NULL_HANDLE };
+		VkCommandPool					_graphics_command_pool{ VK_NULL_HANDLE };
+
+		VkBuffer						_staging_ring{ VK_NULL_HANDLE };
+		VkDeviceMemory					_staging_ring_memory{ VK_NULL_HANDLE };
+		uint8_t*						_staging_ring_pointer{ nullptr };
+		//monotonic positions, the ring offset is position % s_staging_ring_size
+		uint64_t						_staging_head{ 0 };
+		uint64_t						_staging_tail{ 0 };
+
+		//copies waiting for the next flush
+		std::vector<BufferCopy>			_pending_buffer_copies;
+		std::vector<ImageCopy>			_pending_image_copies;
+		std::vector<DedicatedStaging>	_pending_dedicated_stagings;
+
+		std::deque<Batch>				_in_flight_batches;
+		uint64_t						_next_batch_serial{ 1 };
+		uint64_t						_completed_batch_serial{ 0 };
+	};
+}
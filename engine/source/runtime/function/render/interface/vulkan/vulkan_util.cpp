@@ -236,22 +236,13 @@ namespace Dao {
 		return image_view;
 	}
 
-	void VulkanUtil::createGlobalImage(
-		RHI* rhi,
-		VkImage& image,
-		VkImageView& image_view,
-		VmaAllocation& image_allocation,
+	bool VulkanUtil::getGlobalImageFormat(
+		RHIFormat texture_image_format,
 		uint32_t texture_image_width,
 		uint32_t texture_image_height,
-		void* texture_image_pixels,
-		RHIFormat texture_image_format,
-		uint32_t miplevels
+		VkFormat& vulkan_image_format,
+		VkDeviceSize& texture_byte_size
 	) {
-		if (!texture_image_pixels) {
-			return;
-		}
-		VkDeviceSize texture_byte_size;
-		VkFormat vulkan_image_format;
 		switch (texture_image_format) {
 		case RHIFormat::RHI_FORMAT_R8G8B8_UNORM:
 			texture_byte_size = texture_image_width * texture_image_height * 3;
@@ -285,33 +276,49 @@ namespace Dao {
 			texture_byte_size = texture_image_width * texture_image_height * 4 * 4;
 			vulkan_image_format = VK_FORMAT_R32G32B32A32_SFLOAT;
 			break;
+		case RHIFormat::RHI_FORMAT_R16G16B16A16_SFLOAT:
+			texture_byte_size = texture_image_width * texture_image_height * 2 * 4;
+			vulkan_image_format = VK_FORMAT_R16G16B16A16_SFLOAT;
+			break;
+		//block compressed formats store 4x4 texel blocks, partial blocks at the edges are padded
+		case RHIFormat::RHI_FORMAT_BC1_RGB_UNORM_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC1_RGBA_UNORM_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC4_UNORM_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC4_SNORM_BLOCK:
+			texture_byte_size = VkDeviceSize((texture_image_width + 3) / 4) * ((texture_image_height + 3) / 4) * 8;
+			vulkan_image_format = static_cast<VkFormat>(texture_image_format);
+			break;
+		case RHIFormat::RHI_FORMAT_BC2_UNORM_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC2_SRGB_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC3_UNORM_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC3_SRGB_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC5_UNORM_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC5_SNORM_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC6H_UFLOAT_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC6H_SFLOAT_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC7_UNORM_BLOCK:
+		case RHIFormat::RHI_FORMAT_BC7_SRGB_BLOCK:
+			texture_byte_size = VkDeviceSize((texture_image_width + 3) / 4) * ((texture_image_height + 3) / 4) * 16;
+			vulkan_image_format = static_cast<VkFormat>(texture_image_format);
+			break;
 		default:
 			LOG_ERROR("invalid texture byte size");
-			break;
+			return false;
 		}
-		VkBuffer inefficient_staging_buffer;
-		VkDeviceMemory inefficient_staging_buffer_memory;
-		VulkanUtil::createBuffer(
-			static_cast<VulkanRHI*>(rhi)->m_physical_device,
-			static_cast<VulkanRHI*>(rhi)->m_device,
-			texture_byte_size,
-			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-			inefficient_staging_buffer,
-			inefficient_staging_buffer_memory
-		);
-		void* data;
-		vkMapMemory(
-			static_cast<VulkanRHI*>(rhi)->m_device,
-			inefficient_staging_buffer_memory,
-			0, texture_byte_size, 0, &data
-		);
-		memcpy(data, texture_image_pixels, static_cast<size_t>(texture_byte_size));
-		vkUnmapMemory(
-			static_cast<VulkanRHI*>(rhi)->m_device,
-			inefficient_staging_buffer_memory
-		);
-		uint32_t mip_levels = (miplevels != 0) ? miplevels : floor(log2(std::max(texture_image_width, texture_image_height))) + 1;
+		return true;
+	}
+
+	void VulkanUtil::createGlobalImageResource(
+		RHI* rhi,
+		VkImage& image,
+		VmaAllocation& image_allocation,
+		uint32_t texture_image_width,
+		uint32_t texture_image_height,
+		VkFormat vulkan_image_format,
+		uint32_t mip_levels
+	) {
 		VkImageCreateInfo image_create_info{};
 		image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 		image_create_info.flags = 0;
@@ -337,28 +344,120 @@ namespace Dao {
 			&image_allocation,
 			nullptr
 		);
+	}
+
+	bool VulkanUtil::getPackedImageCopyRegions(
+		RHIFormat texture_image_format,
+		uint32_t texture_image_width,
+		uint32_t texture_image_height,
+		uint32_t layer_count,
+		uint32_t miplevels,
+		VkFormat& vulkan_image_format,
+		VkDeviceSize& layer_byte_size,
+		std::vector<VkBufferImageCopy>& regions
+	) {
+		std::vector<VkDeviceSize> level_offsets(miplevels);
+		layer_byte_size = 0;
+		for (uint32_t level = 0; level < miplevels; ++level) {
+			VkDeviceSize level_byte_size;
+			if (!getGlobalImageFormat(
+				texture_image_format,
+				std::max(texture_image_width >> level, 1u),
+				std::max(texture_image_height >> level, 1u),
+				vulkan_image_format,
+				level_byte_size
+			)) {
+				return false;
+			}
+			level_offsets[level] = layer_byte_size;
+			layer_byte_size += level_byte_size;
+		}
+		regions.clear();
+		regions.reserve(size_t(layer_count) * miplevels);
+		for (uint32_t layer = 0; layer < layer_count; ++layer) {
+			for (uint32_t level = 0; level < miplevels; ++level) {
+				VkBufferImageCopy region{};
+				region.bufferOffset = layer_byte_size * layer + level_offsets[level];
+				region.bufferRowLength = 0;
+				region.bufferImageHeight = 0;
+				region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.imageSubresource.mipLevel = level;
+				region.imageSubresource.baseArrayLayer = layer;
+				region.imageSubresource.layerCount = 1;
+				region.imageExtent = { std::max(texture_image_width >> level, 1u),std::max(texture_image_height >> level, 1u),1 };
+				region.imageOffset = { 0,0,0 };
+				regions.push_back(region);
+			}
+		}
+		return true;
+	}
+
+	void VulkanUtil::createGlobalImage(
+		RHI* rhi,
+		VkImage& image,
+		VkImageView& image_view,
+		VmaAllocation& image_allocation,
+		uint32_t texture_image_width,
+		uint32_t texture_image_height,
+		void* texture_image_pixels,
+		RHIFormat texture_image_format,
+		uint32_t miplevels
+	) {
+		if (!texture_image_pixels) {
+			return;
+		}
+		//the levels come precomputed from the texture cooker, nothing is generated here
+		uint32_t mip_levels = std::max(miplevels, 1u);
+		VkDeviceSize texture_byte_size;
+		VkFormat vulkan_image_format;
+		std::vector<VkBufferImageCopy> regions;
+		if (!getPackedImageCopyRegions(texture_image_format, texture_image_width, texture_image_height, 1, mip_levels, vulkan_image_format, texture_byte_size, regions)) {
+			return;
+		}
+		VkBuffer inefficient_staging_buffer;
+		VkDeviceMemory inefficient_staging_buffer_memory;
+		VulkanUtil::createBuffer(
+			static_cast<VulkanRHI*>(rhi)->m_physical_device,
+			static_cast<VulkanRHI*>(rhi)->m_device,
+			texture_byte_size,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			inefficient_staging_buffer,
+			inefficient_staging_buffer_memory
+		);
+		void* data;
+		vkMapMemory(
+			static_cast<VulkanRHI*>(rhi)->m_device,
+			inefficient_staging_buffer_memory,
+			0, texture_byte_size, 0, &data
+		);
+		memcpy(data, texture_image_pixels, static_cast<size_t>(texture_byte_size));
+		vkUnmapMemory(
+			static_cast<VulkanRHI*>(rhi)->m_device,
+			inefficient_staging_buffer_memory
+		);
+		createGlobalImageResource(rhi, image, image_allocation, texture_image_width, texture_image_height, vulkan_image_format, mip_levels);
 		transitionImageLayout(
 			rhi,
 			image,
 			VK_IMAGE_LAYOUT_UNDEFINED,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			1,
-			1,
+			mip_levels,
 			VK_IMAGE_ASPECT_COLOR_BIT
 		);
-		VulkanUtil::copyBufferToImage(rhi, inefficient_staging_buffer, image, texture_image_width, texture_image_height, 1);
+		VulkanUtil::copyBufferToImage(rhi, inefficient_staging_buffer, image, regions);
 		transitionImageLayout(
 			rhi,
 			image,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-			1,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
 			1,
+			mip_levels,
 			VK_IMAGE_ASPECT_COLOR_BIT
 		);
 		vkDestroyBuffer(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer, nullptr);
 		vkFreeMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, nullptr);
-		genMipmappedImage(rhi, image, texture_image_width, texture_image_height, mip_levels);
 		image_view = createImageView(
 			static_cast<VulkanRHI*>(rhi)->m_device,
 			image,
@@ -381,48 +480,15 @@ namespace Dao {
 		RHIFormat texture_image_format,
 		uint32_t miplevels
 	) {
+		//every face holds its own packed mip chain, the staging buffer keeps them face after face
+		uint32_t mip_levels = std::max(miplevels, 1u);
 		VkDeviceSize texture_layer_byte_size;
-		VkDeviceSize cube_byte_size;
 		VkFormat vulkan_image_format;
-		switch (texture_image_format) {
-		case RHIFormat::RHI_FORMAT_R8G8B8_UNORM:
-			texture_layer_byte_size = texture_image_width * texture_image_height * 3;
-			vulkan_image_format = VK_FORMAT_R8G8B8_UNORM;
-			break;
-		case RHIFormat::RHI_FORMAT_R8G8B8_SRGB:
-			texture_layer_byte_size = texture_image_width * texture_image_height * 3;
-			vulkan_image_format = VK_FORMAT_R8G8B8_SRGB;
-			break;
-		case RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM:
-			texture_layer_byte_size = texture_image_width * texture_image_height * 4;
-			vulkan_image_format = VK_FORMAT_R8G8B8A8_UNORM;
-			break;
-		case RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB:
-			texture_layer_byte_size = texture_image_width * texture_image_height * 4;
-			vulkan_image_format = VK_FORMAT_R8G8B8A8_SRGB;
-			break;
-		case RHIFormat::RHI_FORMAT_R32_SFLOAT:
-			texture_layer_byte_size = texture_image_width * texture_image_height * 4;
-			vulkan_image_format = VK_FORMAT_R32_SFLOAT;
-			break;
-		case RHIFormat::RHI_FORMAT_R32G32_SFLOAT:
-			texture_layer_byte_size = texture_image_width * texture_image_height * 4 * 2;
-			vulkan_image_format = VK_FORMAT_R32G32_SFLOAT;
-			break;
-		case RHIFormat::RHI_FORMAT_R32G32B32_SFLOAT:
-			texture_layer_byte_size = texture_image_width * texture_image_height * 4 * 3;
-			vulkan_image_format = VK_FORMAT_R32G32B32_SFLOAT;
-			break;
-		case RHIFormat::RHI_FORMAT_R32G32B32A32_SFLOAT:
-			texture_layer_byte_size = texture_image_width * texture_image_height * 4 * 4;
-			vulkan_image_format = VK_FORMAT_R32G32B32A32_SFLOAT;
-			break;
-		default:
-			texture_layer_byte_size = VkDeviceSize(-1);
-			LOG_ERROR("invalid texture byte size");
+		std::vector<VkBufferImageCopy> regions;
+		if (!getPackedImageCopyRegions(texture_image_format, texture_image_width, texture_image_height, 6, mip_levels, vulkan_image_format, texture_layer_byte_size, regions)) {
 			return;
 		}
-		cube_byte_size = texture_layer_byte_size * 6;
+		VkDeviceSize cube_byte_size = texture_layer_byte_size * 6;
 		VkImageCreateInfo image_create_info{};
 		image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 		image_create_info.flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
@@ -430,12 +496,12 @@ namespace Dao {
 		image_create_info.extent.width = static_cast<uint32_t>(texture_image_width);
 		image_create_info.extent.height = static_cast<uint32_t>(texture_image_height);
 		image_create_info.extent.depth = 1;
-		image_create_info.mipLevels = miplevels;
+		image_create_info.mipLevels = mip_levels;
 		image_create_info.arrayLayers = 6;
 		image_create_info.format = vulkan_image_format;
 		image_create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
 		image_create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		image_create_info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		image_create_info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 		image_create_info.samples = VK_SAMPLE_COUNT_1_BIT;
 		image_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 		VmaAllocationCreateInfo allocInfo = {};
@@ -479,20 +545,21 @@ namespace Dao {
 			VK_IMAGE_LAYOUT_UNDEFINED,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			6,
-			miplevels,
+			mip_levels,
 			VK_IMAGE_ASPECT_COLOR_BIT
 		);
-		copyBufferToImage(
+		copyBufferToImage(rhi, inefficient_staging_buffer, image, regions);
+		transitionImageLayout(
 			rhi,
-			inefficient_staging_buffer,
 			image,
-			static_cast<uint32_t>(texture_image_width),
-			static_cast<uint32_t>(texture_image_height),
-			6
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			6,
+			mip_levels,
+			VK_IMAGE_ASPECT_COLOR_BIT
 		);
 		vkDestroyBuffer(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer, nullptr);
 		vkFreeMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, nullptr);
-		generateTextureMipmaps(rhi, image, vulkan_image_format, texture_image_width, texture_image_height, 6, miplevels);
 		image_view = createImageView(
 			static_cast<VulkanRHI*>(rhi)->m_device,
 			image,
@@ -500,105 +567,8 @@ namespace Dao {
 			VK_IMAGE_ASPECT_COLOR_BIT,
 			VK_IMAGE_VIEW_TYPE_CUBE,
 			6,
-			miplevels
-		);
-	}
-
-	void VulkanUtil::generateTextureMipmaps(
-		RHI* rhi,
-		VkImage image,
-		VkFormat image_format,
-		uint32_t texture_width,
-		uint32_t texture_height,
-		uint32_t layers,
-		uint32_t miplevels
-	) {
-		VkFormatProperties format_properties;
-		vkGetPhysicalDeviceFormatProperties(
-			static_cast<VulkanRHI*>(rhi)->m_physical_device,
-			image_format, &format_properties
-		);
-		if (!(format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)) {
-			LOG_ERROR("linear bliting not supported");
-			return;
-		}
-		RHICommandBuffer* rhi_command_buffer = static_cast<VulkanRHI*>(rhi)->beginSingleTimeCommands();
-		VkCommandBuffer command_buffer = static_cast<VulkanCommandBuffer*>(rhi_command_buffer)->getResource();
-		VkImageMemoryBarrier barrier{};
-		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		barrier.image = image;
-		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		barrier.subresourceRange.baseArrayLayer = 0;
-		barrier.subresourceRange.layerCount = layers;
-		barrier.subresourceRange.levelCount = 1;
-		int32_t mip_width = texture_width;
-		int32_t mip_height = texture_height;
-		for (uint32_t i = 1; i < miplevels; ++i) {
-			barrier.subresourceRange.baseMipLevel = i - 1;
-			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-			barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-			vkCmdPipelineBarrier(
-				command_buffer,
-				VK_PIPELINE_STAGE_TRANSFER_BIT,
-				VK_PIPELINE_STAGE_TRANSFER_BIT,
-				0, 0, nullptr, 0, nullptr, 1, &barrier
-			);
-			VkImageBlit blit{};
-			blit.srcOffsets[0] = { 0,0,0 };
-			blit.srcOffsets[1] = { mip_width,mip_height,1 };
-			blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			blit.srcSubresource.mipLevel = i - 1;
-			blit.srcSubresource.baseArrayLayer = 0;
-			blit.srcSubresource.layerCount = layers;
-			blit.dstOffsets[0] = { 0,0,0 };
-			blit.dstOffsets[1] = { mip_width > 1 ? mip_width / 2 : 1,mip_height > 1 ? mip_height / 2 : 1,1 };
-			blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			blit.dstSubresource.mipLevel = i;
-			blit.dstSubresource.baseArrayLayer = 0;
-			blit.dstSubresource.layerCount = layers;
-			vkCmdBlitImage(
-				command_buffer,
-				image,
-				VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-				image,
-				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-				1,
-				&blit,
-				VK_FILTER_LINEAR
-			);
-			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-			barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-			vkCmdPipelineBarrier(
-				command_buffer,
-				VK_PIPELINE_STAGE_TRANSFER_BIT,
-				VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-				0, 0, nullptr, 0, nullptr, 1, &barrier
-			);
-			if (mip_width > 1) {
-				mip_width /= 2;
-			}
-			if (mip_height > 1) {
-				mip_height /= 2;
-			}
-		}
-		barrier.subresourceRange.baseMipLevel = miplevels - 1;
-		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		vkCmdPipelineBarrier(
-			command_buffer,
-			VK_PIPELINE_STAGE_TRANSFER_BIT,
-			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-			0, 0, nullptr, 0, nullptr, 1, &barrier
+			mip_levels
 		);
-		static_cast<VulkanRHI*>(rhi)->endSingleTimeCommands(rhi_command_buffer);
 	}
 
 	void VulkanUtil::transitionImageLayout(
@@ -680,9 +650,7 @@ namespace Dao {
 		RHI* rhi,
 		VkBuffer buffer,
 		VkImage image,
-		uint32_t width,
-		uint32_t height,
-		uint32_t layout_count
+		const std::vector<VkBufferImageCopy>& regions
 	) {
 		if (rhi == nullptr) {
 			LOG_ERROR("rhi is nullptr");
@@ -690,107 +658,10 @@ namespace Dao {
 		}
 		RHICommandBuffer* rhi_command_buffer = static_cast<VulkanRHI*>(rhi)->beginSingleTimeCommands();
 		VkCommandBuffer command_buffer = static_cast<VulkanCommandBuffer*>(rhi_command_buffer)->getResource();
-		VkBufferImageCopy region{};
-		region.bufferOffset = 0;
-		region.bufferRowLength = 0;
-		region.bufferImageHeight = 0;
-		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		region.imageSubresource.mipLevel = 0;
-		region.imageSubresource.baseArrayLayer = 0;
-		region.imageSubresource.layerCount = layout_count;
-		region.imageExtent = { width,height,1 };
-		region.imageOffset = { 0,0,0 };
 		vkCmdCopyBufferToImage(
 			command_buffer, buffer, image, 
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-			1, &region
-		);
-		static_cast<VulkanRHI*>(rhi)->endSingleTimeCommands(rhi_command_buffer);
-	}
-
-	void VulkanUtil::genMipmappedImage(
-		RHI* rhi,
-		VkImage image,
-		uint32_t width,
-		uint32_t height,
-		uint32_t mip_levels
-	) {
-		if (rhi == nullptr) {
-			LOG_ERROR("rhi is nullptr");
-			return;
-		}
-		RHICommandBuffer* rhi_command_buffer = static_cast<VulkanRHI*>(rhi)->beginSingleTimeCommands();
-		VkCommandBuffer command_buffer = static_cast<VulkanCommandBuffer*>(rhi_command_buffer)->getResource();
-		for (uint32_t i = 1; i < mip_levels; ++i) {
-			VkImageBlit imageBlit{};
-			imageBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			imageBlit.srcSubresource.layerCount = 1;
-			imageBlit.srcSubresource.mipLevel = i - 1;
-			imageBlit.srcOffsets[1].x = std::max((int32_t)(width >> (i - 1)), 1);
-			imageBlit.srcOffsets[1].y = std::max((int32_t)(height >> (i - 1)), 1);
-			imageBlit.srcOffsets[1].z = 1;
-			imageBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			imageBlit.dstSubresource.layerCount = 1;
-			imageBlit.dstSubresource.mipLevel = i;
-			imageBlit.dstOffsets[1].x = std::max((int32_t)(width >> i), 1);
-			imageBlit.dstOffsets[1].y = std::max((int32_t)(height >> i), 1);
-			imageBlit.dstOffsets[1].z = 1;
-			VkImageSubresourceRange mipSubRange{};
-			mipSubRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			mipSubRange.baseMipLevel = i;
-			mipSubRange.levelCount = 1;
-			mipSubRange.layerCount = 1;
-			VkImageMemoryBarrier barrier{};
-			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-			barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-			barrier.srcAccessMask = 0;
-			barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			barrier.image = image;
-			barrier.subresourceRange = mipSubRange;
-			vkCmdPipelineBarrier(
-				command_buffer,
-				VK_PIPELINE_STAGE_TRANSFER_BIT,
-				VK_PIPELINE_STAGE_TRANSFER_BIT,
-				0, 0, nullptr, 0, nullptr, 1, &barrier
-			);
-			vkCmdBlitImage(
-				command_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image,
-				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageBlit, VK_FILTER_LINEAR
-			);
-			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-			barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-			vkCmdPipelineBarrier(
-				command_buffer,
-				VK_PIPELINE_STAGE_TRANSFER_BIT,
-				VK_PIPELINE_STAGE_TRANSFER_BIT,
-				0, 0, nullptr, 0, nullptr, 1, &barrier
-			);
-		}
-		VkImageSubresourceRange mipSubRange{};
-		mipSubRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		mipSubRange.baseMipLevel = 0;
-		mipSubRange.levelCount = mip_levels;
-		mipSubRange.layerCount = 1;
-		VkImageMemoryBarrier barrier{};
-		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-		barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.image = image;
-		barrier.subresourceRange = mipSubRange;
-		vkCmdPipelineBarrier(
-			command_buffer,
-			VK_PIPELINE_STAGE_TRANSFER_BIT,
-			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-			0, 0, nullptr, 0, nullptr, 1, &barrier
+			static_cast<uint32_t>(regions.size()), regions.data()
 		);
 		static_cast<VulkanRHI*>(rhi)->endSingleTimeCommands(rhi_command_buffer);
 	}
@@ -73,6 +73,37 @@ namespace Dao {
 			uint32_t layout_count,
 			uint32_t miplevels
 		);
+		/// vulkan format and byte size of the first mip of a sampled 2d texture
+		/// @return: false if the format is not supported
+		static bool getGlobalImageFormat(
+			RHIFormat texture_image_format,
+			uint32_t texture_image_width,
+			uint32_t texture_image_height,
+			VkFormat& vulkan_image_format,
+			VkDeviceSize& texture_byte_size
+		);
+		/// allocate a sampled 2d texture that can be a transfer source and destination, contents and layout are undefined
+		static void createGlobalImageResource(
+			RHI* rhi,
+			VkImage& image,
+			VmaAllocation& image_allocation,
+			uint32_t texture_image_width,
+			uint32_t texture_image_height,
+			VkFormat vulkan_image_format,
+			uint32_t mip_levels
+		);
+		/// copy regions of miplevels levels packed from the largest one, layer after layer
+		/// @return: false for unsupported formats
+		static bool getPackedImageCopyRegions(
+			RHIFormat texture_image_format,
+			uint32_t texture_image_width,
+			uint32_t texture_image_height,
+			uint32_t layer_count,
+			uint32_t miplevels,
+			VkFormat& vulkan_image_format,
+			VkDeviceSize& layer_byte_size,
+			std::vector<VkBufferImageCopy>& regions
+		);
 		static void createGlobalImage(
 			RHI* rhi,
 			VkImage& image,
@@ -95,15 +126,6 @@ namespace Dao {
 			RHIFormat texture_image_format,
 			uint32_t miplevels = 1
 		);
-		static void generateTextureMipmaps(
-			RHI* rhi,
-			VkImage image,
-			VkFormat image_format,
-			uint32_t texture_width,
-			uint32_t texture_height,
-			uint32_t layers,
-			uint32_t miplevels
-		);
 		static void transitionImageLayout(
 			RHI* rhi,
 			VkImage image,
@@ -117,16 +139,7 @@ namespace Dao {
 			RHI* rhi,
 			VkBuffer buffer,
 			VkImage image,
-			uint32_t width,
-			uint32_t height,
-			uint32_t layer_count
-		);
-		static void genMipmappedImage(
-			RHI* rhi,
-			VkImage image,
-			uint32_t width,
-			uint32_t height,
-			uint32_t mip_levels
+			const std::vector<VkBufferImageCopy>& regions
 		);
 		static VkSampler getOrCreateMipmapSampler(
 			VkPhysicalDevice physical_device,
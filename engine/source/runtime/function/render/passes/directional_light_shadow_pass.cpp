@@ -31,10 +31,37 @@ namespace Dao {
 		}
 	}
 
+	void DirectionalLightShadowPass::recordCommandBuffer(uint32_t thread_index) {
+		_command_buffer = m_rhi->beginSecondaryCommandBuffer(thread_index, m_framebuffer.render_pass, 0, m_framebuffer.framebuffer);
+		UploadRingbufferAllocator upload_allocator(m_global_render_resource->m_storage_buffer, m_rhi->getCurrentFrameIndex());
+		drawModel(_command_buffer, upload_allocator);
+		m_rhi->endCommandBufferPFN(_command_buffer);
+	}
+
 	void DirectionalLightShadowPass::draw() {
 		float color[4] = { 1.0f,1.0f,1.0f,1.0f };
 		m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Directional Light Shadow", color);
-		drawModel();
+		//directional light shadow begin pass
+		RHIRenderPassBeginInfo renderpass_begin_info{};
+		renderpass_begin_info.sType = RHI_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderpass_begin_info.renderPass = m_framebuffer.render_pass;
+		renderpass_begin_info.framebuffer = m_framebuffer.framebuffer;
+		renderpass_begin_info.renderArea.offset = { 0,0 };
+		renderpass_begin_info.renderArea.extent = {
+			s_directional_light_shadow_map_dimension,
+			s_directional_light_shadow_map_dimension
+		};
+
+		RHIClearValue clear_values[2];
+		clear_values[0].color = { 1.0f };
+		clear_values[1].depthStencil = { 1.0f,0 };
+		renderpass_begin_info.clearValueCount = sizeof(clear_values) / sizeof(clear_values[0]);
+		renderpass_begin_info.pClearValues = clear_values;
+
+		m_rhi->cmdBeginRenderPassPFN(m_rhi->getCurrentCommandBuffer(), &renderpass_begin_info, RHI_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+		m_rhi->cmdExecuteCommandsPFN(m_rhi->getCurrentCommandBuffer(), 1, &_command_buffer);
+		//directional light shadow end pass
+		m_rhi->cmdEndRenderPassPFN(m_rhi->getCurrentCommandBuffer());
 		m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
 	}
 
@@ -183,7 +210,7 @@ namespace Dao {
 	void DirectionalLightShadowPass::setupDescriptorSetLayout() {
 		m_descriptor_infos.resize(1);
 
-		RHIDescriptorSetLayoutBinding mesh_directional_light_shadow_global_layout_bindings[3];
+		RHIDescriptorSetLayoutBinding mesh_directional_light_shadow_global_layout_bindings[4];
 
 		RHIDescriptorSetLayoutBinding& mesh_directional_light_shadow_global_layout_perframe_storage_buffer_binding = mesh_directional_light_shadow_global_layout_bindings[0];
 		mesh_directional_light_shadow_global_layout_perframe_storage_buffer_binding.binding = 0;
@@ -203,6 +230,12 @@ namespace Dao {
 		mesh_directional_light_shadow_global_layout_per_drawcall_vertex_blending_storage_buffer_binding.descriptorCount = 1;
 		mesh_directional_light_shadow_global_layout_per_drawcall_vertex_blending_storage_buffer_binding.stageFlags = RHI_SHADER_STAGE_VERTEX_BIT;
 
+		RHIDescriptorSetLayoutBinding& mesh_directional_light_shadow_global_layout_scene_instance_storage_buffer_binding = mesh_directional_light_shadow_global_layout_bindings[3];
+		mesh_directional_light_shadow_global_layout_scene_instance_storage_buffer_binding.binding = 3;
+		mesh_directional_light_shadow_global_layout_scene_instance_storage_buffer_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		mesh_directional_light_shadow_global_layout_scene_instance_storage_buffer_binding.descriptorCount = 1;
+		mesh_directional_light_shadow_global_layout_scene_instance_storage_buffer_binding.stageFlags = RHI_SHADER_STAGE_VERTEX_BIT;
+
 		RHIDescriptorSetLayoutCreateInfo mesh_directional_light_shadow_global_layout_create_info;
 		mesh_directional_light_shadow_global_layout_create_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 		mesh_directional_light_shadow_global_layout_create_info.pNext = nullptr;
@@ -378,7 +411,7 @@ namespace Dao {
 
 		RHIDescriptorBufferInfo mesh_directional_light_shadow_perdrawcall_storage_buffer_info = {};
 		mesh_directional_light_shadow_perdrawcall_storage_buffer_info.offset = 0;
-		mesh_directional_light_shadow_perdrawcall_storage_buffer_info.range = sizeof(MeshDirectionalLightShadowPerdrawcallStorageBufferObject);
+		mesh_directional_light_shadow_perdrawcall_storage_buffer_info.range = sizeof(uint32_t) * s_mesh_indirect_max_instance_count;
 		mesh_directional_light_shadow_perdrawcall_storage_buffer_info.buffer = m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer;
 
 		ASSERT(mesh_directional_light_shadow_perdrawcall_storage_buffer_info.range < m_global_render_resource->m_storage_buffer.m_max_storage_buffer_range);
@@ -390,9 +423,14 @@ namespace Dao {
 
 		ASSERT(mesh_directional_light_shadow_perdrawcall_vertex_blending_storage_buffer_info.range < m_global_render_resource->m_storage_buffer.m_max_storage_buffer_range);
 
+		RHIDescriptorBufferInfo mesh_directional_light_shadow_scene_instance_storage_buffer_info = {};
+		mesh_directional_light_shadow_scene_instance_storage_buffer_info.offset = 0;
+		mesh_directional_light_shadow_scene_instance_storage_buffer_info.range = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getBufferSize();
+		mesh_directional_light_shadow_scene_instance_storage_buffer_info.buffer = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getBuffer();
+
 		RHIDescriptorSet* descriptor_set_to_write = m_descriptor_infos[0].descriptor_set;
 
-		RHIWriteDescriptorSet descriptor_writes[3];
+		RHIWriteDescriptorSet descriptor_writes[4];
 		
 		RHIWriteDescriptorSet& mesh_directional_light_shadow_perframe_storage_buffer_write_info = descriptor_writes[0];
 		mesh_directional_light_shadow_perframe_storage_buffer_write_info.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -424,183 +462,167 @@ namespace Dao {
 		mesh_directional_light_shadow_perdrawcall_vertex_blending_buffer_write_info.descriptorCount = 1;
 		mesh_directional_light_shadow_perdrawcall_vertex_blending_buffer_write_info.pBufferInfo = &mesh_directional_light_shadow_perdrawcall_vertex_blending_storage_buffer_info;
 
+		RHIWriteDescriptorSet& mesh_directional_light_shadow_scene_instance_buffer_write_info = descriptor_writes[3];
+		mesh_directional_light_shadow_scene_instance_buffer_write_info.sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		mesh_directional_light_shadow_scene_instance_buffer_write_info.pNext = nullptr;
+		mesh_directional_light_shadow_scene_instance_buffer_write_info.dstSet = descriptor_set_to_write;
+		mesh_directional_light_shadow_scene_instance_buffer_write_info.dstBinding = 3;
+		mesh_directional_light_shadow_scene_instance_buffer_write_info.dstArrayElement = 0;
+		mesh_directional_light_shadow_scene_instance_buffer_write_info.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		mesh_directional_light_shadow_scene_instance_buffer_write_info.descriptorCount = 1;
+		mesh_directional_light_shadow_scene_instance_buffer_write_info.pBufferInfo = &mesh_directional_light_shadow_scene_instance_storage_buffer_info;
+
 		m_rhi->updateDescriptorSets(
 			sizeof(descriptor_writes) / sizeof(descriptor_writes[0]),
 			descriptor_writes, 0, nullptr
 		);
 	}
 
-	void DirectionalLightShadowPass::drawModel() {
-		struct MeshNode {
-			const Matrix4x4* model_matrix{ nullptr };
-			const Matrix4x4* joint_matrices{ nullptr };
-			uint32_t joint_count{ 0 };
-		};
-
-		std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> directional_light_mesh_drawcall_batch;
-		//reorginize mesh
-		for (RenderMeshNode& node : *(m_visible_nodes.p_directional_light_visible_mesh_nodes)) {
-			auto& mesh_instanced = directional_light_mesh_drawcall_batch[node.ref_material];
-			auto& mesh_nodes = mesh_instanced[node.ref_mesh];
-
-			MeshNode temp;
-			temp.model_matrix = node.model_matrix;
-			if (node.enable_vertex_blending) {
-				temp.joint_matrices = node.joint_matrices;
-				temp.joint_count = node.joint_count;
-			}
-			mesh_nodes.push_back(temp);
-		}
-		//directional light shadow begin pass
-		RHIRenderPassBeginInfo renderpass_begin_info{};
-		renderpass_begin_info.sType = RHI_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		renderpass_begin_info.renderPass = m_framebuffer.render_pass;
-		renderpass_begin_info.framebuffer = m_framebuffer.framebuffer;
-		renderpass_begin_info.renderArea.offset = { 0,0 };
-		renderpass_begin_info.renderArea.extent = {
-			s_directional_light_shadow_map_dimension,
-			s_directional_light_shadow_map_dimension
-		};
-
-		RHIClearValue clear_values[2];
-		clear_values[0].color = { 1.0f };
-		clear_values[1].depthStencil = { 1.0f,0 };
-		renderpass_begin_info.clearValueCount = sizeof(clear_values) / sizeof(clear_values[0]);
-		renderpass_begin_info.pClearValues = clear_values;
-
-		m_rhi->cmdBeginRenderPassPFN(m_rhi->getCurrentCommandBuffer(), &renderpass_begin_info, RHI_SUBPASS_CONTENTS_INLINE);
-
+	void DirectionalLightShadowPass::drawModel(RHICommandBuffer* command_buffer, UploadRingbufferAllocator& upload_allocator) {
+		_draw_list.build(*(m_visible_nodes.p_directional_light_visible_mesh_nodes), draw_list_pass_directional_light_shadow, 0);
+		const uint32_t instance_base_index = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getFrameBaseIndex(m_rhi->getCurrentFrameIndex());
 		//mesh
 		if (m_rhi->isPointLightShadowEnabled()) {
 			float color[4] = { 1.0f,1.0f,1.0f,1.0f };
-			m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Mesh", color);
-			m_rhi->cmdBindPipelinePFN(m_rhi->getCurrentCommandBuffer(), RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[0].pipeline);
+			m_rhi->pushEvent(command_buffer, "Mesh", color);
+			m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[0].pipeline);
 			//perframe storage buffer
-			uint32_t perframe_dynamic_offset = roundUp(
-				m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-				m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment
-			);
-			m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perframe_dynamic_offset + sizeof(MeshPerframeStorageBufferObject);
-
-			ASSERT(
-				m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-				(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-					m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-			);
+			uint32_t perframe_dynamic_offset = upload_allocator.allocate(sizeof(MeshPerframeStorageBufferObject));
 
 			MeshDirectionalLightShadowPerframeStorageBufferObject& perframe_storage_buffer_object = (*reinterpret_cast<MeshDirectionalLightShadowPerframeStorageBufferObject*>(
 				reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perframe_dynamic_offset));
 
 			perframe_storage_buffer_object = _mesh_directional_light_shadow_perframe_storage_buffer_object;
 
-			for (auto& [material, mesh_instanced] : directional_light_mesh_drawcall_batch) {
-				//TODO(render form near to far)
-				for (auto& [mesh, mesh_nodes] : mesh_instanced) {
-					uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-					if (total_instance_count > 0) {
-						//bind per mesh
-						m_rhi->cmdBindDescriptorSetsPFN(
-							m_rhi->getCurrentCommandBuffer(),
-							RHI_PIPELINE_BIND_POINT_GRAPHICS,
-							m_render_pipelines[0].layout,
-							1, 1,
-							&mesh->mesh_vertex_blending_descriptor_set,
-							0,
-							nullptr
-						);
-
-						RHIBuffer* vertex_buffers[] = { mesh->mesh_vertex_position_buffer };
-						RHIDeviceSize offsets[] = { 0 };
-						m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, vertex_buffers, offsets);
-						m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh->mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
-						uint32_t drawcall_max_instance_count = sizeof(MeshDirectionalLightShadowPerdrawcallStorageBufferObject::mesh_instances) / sizeof(MeshDirectionalLightShadowPerdrawcallStorageBufferObject::mesh_instances[0]);
-						uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
-
-						for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index) {
-							uint32_t current_instance_count = (total_instance_count - drawcall_max_instance_count * drawcall_index) < drawcall_max_instance_count ? (total_instance_count - drawcall_max_instance_count * drawcall_index) : drawcall_max_instance_count;
-							//perdrawcall storage buffer
-							uint32_t perdrawcall_dynamic_offset = roundUp(
-								m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-								m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment
-							);
-							m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perdrawcall_dynamic_offset + sizeof(MeshDirectionalLightShadowPerdrawcallStorageBufferObject);
-
-							ASSERT(
-								m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-								(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-									m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-							);
-
-							MeshDirectionalLightShadowPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object = (*reinterpret_cast<MeshDirectionalLightShadowPerdrawcallStorageBufferObject*>(
-								reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_dynamic_offset));
-
-							for (uint32_t i = 0; i < current_instance_count; ++i) {
-								perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix = *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-								perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 : -1.0;
-							}
+			const std::vector<RenderDrawBatch>& batches = _draw_list.getBatches();
+			const bool multi_draw_indirect = m_rhi->isMultiDrawIndirectEnabled();
+			for (uint32_t batch_index = 0; batch_index < static_cast<uint32_t>(batches.size()); ++batch_index) {
+				const RenderDrawBatch& batch = batches[batch_index];
+
+				//runs of pooled meshes go out as one indirect draw, the shadow pipeline does not depend on the material
+				const uint32_t run_end = multi_draw_indirect ? _draw_list.getIndirectRunEnd(batch_index, s_mesh_indirect_max_instance_count, false) : batch_index;
+				if (run_end > batch_index) {
+					IndirectDraws indirect_draws = uploadIndirectDraws(upload_allocator, _draw_list, batch_index, run_end, instance_base_index);
+
+					m_rhi->cmdBindDescriptorSetsPFN(
+						command_buffer,
+						RHI_PIPELINE_BIND_POINT_GRAPHICS,
+						m_render_pipelines[0].layout,
+						1, 1,
+						&batch.mesh->mesh_vertex_blending_descriptor_set,
+						0, nullptr
+					);
+
+					RHIBuffer* vertex_buffers[] = { m_global_render_resource->m_mesh_pool.getVertexPositionBuffer() };
+					RHIDeviceSize offsets[] = { 0 };
+					m_rhi->cmdBindVertexBuffersPFN(command_buffer, 0, 1, vertex_buffers, offsets);
+					m_rhi->cmdBindIndexBufferPFN(command_buffer, m_global_render_resource->m_mesh_pool.getIndexBuffer(), 0, RHI_INDEX_TYPE_UINT16);
+
+					uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,indirect_draws.instance_indices_dynamic_offset,0 };
+					m_rhi->cmdBindDescriptorSetsPFN(
+						command_buffer,
+						RHI_PIPELINE_BIND_POINT_GRAPHICS,
+						m_render_pipelines[0].layout,
+						0, 1,
+						&m_descriptor_infos[0].descriptor_set,
+						(sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0])),
+						dynamic_offsets
+					);
+
+					m_rhi->cmdDrawIndexedIndirect(
+						command_buffer,
+						m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer,
+						indirect_draws.commands_offset,
+						indirect_draws.command_count,
+						sizeof(RHIDrawIndexedIndirectCommand)
+					);
+					batch_index = run_end - 1;
+					continue;
+				}
 
-							//perdrawcall vertex blending storage buffer
-							uint32_t per_drawcall_vertex_blending_dynamic_offset;
-							bool enable_vertex_blending = true;
-							for (uint32_t i = 0; i < current_instance_count; ++i) {
-								if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
-									enable_vertex_blending = false;
-									break;
-								}
-							}
-							if (enable_vertex_blending) {
-								per_drawcall_vertex_blending_dynamic_offset = roundUp(
-									m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-									m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment
-								);
-								m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = per_drawcall_vertex_blending_dynamic_offset + sizeof(MeshDirectionalLightShadowPerDrawcallVertexBlendingStorageBufferObject);
-
-								ASSERT(
-									m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-									(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-										m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-								);
-
-								MeshDirectionalLightShadowPerDrawcallVertexBlendingStorageBufferObject& perdrawcall_vertex_blending_storage_buffer_object = (*reinterpret_cast<MeshDirectionalLightShadowPerDrawcallVertexBlendingStorageBufferObject*>(
-									reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + per_drawcall_vertex_blending_dynamic_offset));
-								for (uint32_t i = 0; i < current_instance_count; ++i) {
-									if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
-										for (uint32_t j = 0; j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count; ++j) {
-											perdrawcall_vertex_blending_storage_buffer_object.joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices[j];
-										}
-									}
+				VulkanMesh* mesh = batch.mesh;
+				const RenderDrawInstance* mesh_nodes = _draw_list.getInstances(batch);
+				uint32_t total_instance_count = batch.instance_count;
+
+				//bind per mesh
+				m_rhi->cmdBindDescriptorSetsPFN(
+					command_buffer,
+					RHI_PIPELINE_BIND_POINT_GRAPHICS,
+					m_render_pipelines[0].layout,
+					1, 1,
+					&mesh->mesh_vertex_blending_descriptor_set,
+					0,
+					nullptr
+				);
+
+				RHIBuffer* vertex_buffers[] = { mesh->mesh_vertex_position_buffer };
+				RHIDeviceSize offsets[] = { 0 };
+				m_rhi->cmdBindVertexBuffersPFN(command_buffer, 0, 1, vertex_buffers, offsets);
+				m_rhi->cmdBindIndexBufferPFN(command_buffer, mesh->mesh_index_buffer, 0, mesh->mesh_index_type);
+
+				uint32_t drawcall_max_instance_count = sizeof(MeshDirectionalLightShadowPerdrawcallStorageBufferObject::instance_indices) / sizeof(MeshDirectionalLightShadowPerdrawcallStorageBufferObject::instance_indices[0]);
+				uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
+
+				for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index) {
+					uint32_t current_instance_count = (total_instance_count - drawcall_max_instance_count * drawcall_index) < drawcall_max_instance_count ? (total_instance_count - drawcall_max_instance_count * drawcall_index) : drawcall_max_instance_count;
+					//perdrawcall storage buffer
+					uint32_t perdrawcall_dynamic_offset = upload_allocator.allocate(sizeof(MeshDirectionalLightShadowPerdrawcallStorageBufferObject));
+
+					MeshDirectionalLightShadowPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object = (*reinterpret_cast<MeshDirectionalLightShadowPerdrawcallStorageBufferObject*>(
+						reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_dynamic_offset));
+
+					for (uint32_t i = 0; i < current_instance_count; ++i) {
+						perdrawcall_storage_buffer_object.instance_indices[i] = instance_base_index + mesh_nodes[drawcall_max_instance_count * drawcall_index + i].instance_slot;
+					}
+
+					//perdrawcall vertex blending storage buffer
+					uint32_t per_drawcall_vertex_blending_dynamic_offset;
+					bool enable_vertex_blending = true;
+					for (uint32_t i = 0; i < current_instance_count; ++i) {
+						if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
+							enable_vertex_blending = false;
+							break;
+						}
+					}
+					if (enable_vertex_blending) {
+						per_drawcall_vertex_blending_dynamic_offset = upload_allocator.allocate(sizeof(MeshDirectionalLightShadowPerDrawcallVertexBlendingStorageBufferObject));
+
+						MeshDirectionalLightShadowPerDrawcallVertexBlendingStorageBufferObject& perdrawcall_vertex_blending_storage_buffer_object = (*reinterpret_cast<MeshDirectionalLightShadowPerDrawcallVertexBlendingStorageBufferObject*>(
+							reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + per_drawcall_vertex_blending_dynamic_offset));
+						for (uint32_t i = 0; i < current_instance_count; ++i) {
+							if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
+								for (uint32_t j = 0; j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count; ++j) {
+									perdrawcall_vertex_blending_storage_buffer_object.joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices[j];
 								}
 							}
-							else {
-								per_drawcall_vertex_blending_dynamic_offset = 0;
-							}
-
-							//bind perdrawcall
-							uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,perdrawcall_dynamic_offset,per_drawcall_vertex_blending_dynamic_offset };
-							m_rhi->cmdBindDescriptorSetsPFN(
-								m_rhi->getCurrentCommandBuffer(),
-								RHI_PIPELINE_BIND_POINT_GRAPHICS,
-								m_render_pipelines[0].layout,
-								0, 1,
-								&m_descriptor_infos[0].descriptor_set,
-								sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]),
-								dynamic_offsets
-							);
-							m_rhi->cmdDrawIndexedPFN(
-								m_rhi->getCurrentCommandBuffer(),
-								mesh->mesh_index_count,
-								current_instance_count,
-								0, 0, 0
-							);
 						}
 					}
+					else {
+						per_drawcall_vertex_blending_dynamic_offset = 0;
+					}
+
+					//bind perdrawcall
+					uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,perdrawcall_dynamic_offset,per_drawcall_vertex_blending_dynamic_offset };
+					m_rhi->cmdBindDescriptorSetsPFN(
+						command_buffer,
+						RHI_PIPELINE_BIND_POINT_GRAPHICS,
+						m_render_pipelines[0].layout,
+						0, 1,
+						&m_descriptor_infos[0].descriptor_set,
+						sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]),
+						dynamic_offsets
+					);
+					m_rhi->cmdDrawIndexedPFN(
+						command_buffer,
+						mesh->mesh_index_count,
+						current_instance_count,
+						mesh->mesh_first_index,
+						mesh->mesh_first_vertex,
+						0
+					);
 				}
 			}
-			m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
+			m_rhi->popEvent(command_buffer);
 		}
-
-		//directional light shadow end pass
-		m_rhi->cmdEndRenderPassPFN(m_rhi->getCurrentCommandBuffer());
 	}
 }
\ No newline at end of file
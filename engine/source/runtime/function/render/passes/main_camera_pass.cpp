@@ -480,7 +480,7 @@ namespace Dao {
         }
 
         {
-            RHIDescriptorSetLayoutBinding mesh_global_layout_bindings[8];
+            RHIDescriptorSetLayoutBinding mesh_global_layout_bindings[9];
 
             RHIDescriptorSetLayoutBinding& mesh_global_layout_perframe_storage_buffer_binding = mesh_global_layout_bindings[0];
             mesh_global_layout_perframe_storage_buffer_binding.binding = 0;
@@ -526,6 +526,13 @@ namespace Dao {
             mesh_global_layout_directional_light_shadow_texture_binding = mesh_global_layout_brdfLUT_texture_binding;
             mesh_global_layout_directional_light_shadow_texture_binding.binding = 7;
 
+            RHIDescriptorSetLayoutBinding& mesh_global_layout_scene_instance_storage_buffer_binding = mesh_global_layout_bindings[8];
+            mesh_global_layout_scene_instance_storage_buffer_binding.binding = 8;
+            mesh_global_layout_scene_instance_storage_buffer_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            mesh_global_layout_scene_instance_storage_buffer_binding.descriptorCount = 1;
+            mesh_global_layout_scene_instance_storage_buffer_binding.stageFlags = RHI_SHADER_STAGE_VERTEX_BIT;
+            mesh_global_layout_scene_instance_storage_buffer_binding.pImmutableSamplers = nullptr;
+
             RHIDescriptorSetLayoutCreateInfo mesh_global_layout_create_info;
             mesh_global_layout_create_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
             mesh_global_layout_create_info.pNext = nullptr;
@@ -1368,7 +1375,8 @@ namespace Dao {
 
         RHIDescriptorBufferInfo mesh_perdrawcall_storage_buffer_info = {};
         mesh_perdrawcall_storage_buffer_info.offset = 0;
-        mesh_perdrawcall_storage_buffer_info.range = sizeof(MeshPerdrawcallStorageBufferObject);
+        //indirect draws read the instance indices of a whole run through the same binding
+        mesh_perdrawcall_storage_buffer_info.range = sizeof(uint32_t) * s_mesh_indirect_max_instance_count;
         mesh_perdrawcall_storage_buffer_info.buffer = m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer;
 
         ASSERT(mesh_perdrawcall_storage_buffer_info.range < m_global_render_resource->m_storage_buffer.m_max_storage_buffer_range);
@@ -1380,6 +1388,11 @@ namespace Dao {
 
         ASSERT(mesh_perdrawcall_vertex_blending_storage_buffer_info.range < m_global_render_resource->m_storage_buffer.m_max_storage_buffer_range);
 
+        RHIDescriptorBufferInfo mesh_scene_instance_storage_buffer_info = {};
+        mesh_scene_instance_storage_buffer_info.offset = 0;
+        mesh_scene_instance_storage_buffer_info.range = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getBufferSize();
+        mesh_scene_instance_storage_buffer_info.buffer = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getBuffer();
+
         RHIDescriptorImageInfo brdf_texture_image_info = {};
         brdf_texture_image_info.sampler = m_global_render_resource->m_ibl_resource.m_brdfLUT_texture_sampler;
         brdf_texture_image_info.imageView = m_global_render_resource->m_ibl_resource.m_brdfLUT_texture_image_view;
@@ -1405,7 +1418,7 @@ namespace Dao {
         directional_light_shadow_texture_image_info.imageView = m_directional_light_shadow_color_image_view;
         directional_light_shadow_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-        RHIWriteDescriptorSet mesh_descriptor_writes_info[8];
+        RHIWriteDescriptorSet mesh_descriptor_writes_info[9];
 
         mesh_descriptor_writes_info[0].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         mesh_descriptor_writes_info[0].pNext = nullptr;
@@ -1459,6 +1472,11 @@ namespace Dao {
         mesh_descriptor_writes_info[7].dstBinding = 7;
         mesh_descriptor_writes_info[7].pImageInfo = &directional_light_shadow_texture_image_info;
 
+        mesh_descriptor_writes_info[8] = mesh_descriptor_writes_info[2];
+        mesh_descriptor_writes_info[8].dstBinding = 8;
+        mesh_descriptor_writes_info[8].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        mesh_descriptor_writes_info[8].pBufferInfo = &mesh_scene_instance_storage_buffer_info;
+
         m_rhi->updateDescriptorSets(
             sizeof(mesh_descriptor_writes_info) / sizeof(mesh_descriptor_writes_info[0]),
             mesh_descriptor_writes_info, 0, nullptr
@@ -1735,18 +1753,15 @@ namespace Dao {
             renderpass_begin_info.clearValueCount = (sizeof(clear_values) / sizeof(clear_values[0]));
             renderpass_begin_info.pClearValues = clear_values;
 
-            m_rhi->cmdBeginRenderPassPFN(m_rhi->getCurrentCommandBuffer(), &renderpass_begin_info, RHI_SUBPASS_CONTENTS_INLINE);
+            m_rhi->cmdBeginRenderPassPFN(m_rhi->getCurrentCommandBuffer(), &renderpass_begin_info, RHI_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
         }
 
-        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "BasePass", color);
-
-        drawMeshGbuffer();
-
-        m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
+        //base pass, recorded by recordMeshGbuffer
+        m_rhi->cmdExecuteCommandsPFN(m_rhi->getCurrentCommandBuffer(), 1, &_mesh_command_buffer);
 
         m_rhi->cmdNextSubpassPFN(m_rhi->getCurrentCommandBuffer(), RHI_SUBPASS_CONTENTS_INLINE);
 
+        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Deferred Lighting", color);
 
         drawDeferredLighting();
@@ -1843,16 +1858,10 @@ namespace Dao {
 
         m_rhi->cmdNextSubpassPFN(m_rhi->getCurrentCommandBuffer(), RHI_SUBPASS_CONTENTS_INLINE);
 
-        m_rhi->cmdNextSubpassPFN(m_rhi->getCurrentCommandBuffer(), RHI_SUBPASS_CONTENTS_INLINE);
-
-        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Forward Lighting", color);
-
-        drawMeshLighting();
-        drawSkybox();
-        particle_pass.draw();
+        m_rhi->cmdNextSubpassPFN(m_rhi->getCurrentCommandBuffer(), RHI_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 
-        m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
+        //forward lighting, recorded by recordForwardLighting
+        m_rhi->cmdExecuteCommandsPFN(m_rhi->getCurrentCommandBuffer(), 1, &_mesh_command_buffer);
 
         m_rhi->cmdNextSubpassPFN(m_rhi->getCurrentCommandBuffer(), RHI_SUBPASS_CONTENTS_INLINE);
 
@@ -1903,153 +1912,181 @@ namespace Dao {
         m_rhi->cmdEndRenderPassPFN(m_rhi->getCurrentCommandBuffer());
     }
 
-    void MainCameraPass::drawMeshGbuffer() {
-        struct MeshNode {
-            const Matrix4x4* model_matrix{ nullptr };
-            const Matrix4x4* joint_matrices{ nullptr };
-            uint32_t joint_count{ 0 };
-        };
-
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
-
-        //reorganize mesh
-        for (RenderMeshNode& node : *(m_visible_nodes.p_main_camera_visible_mesh_nodes)) {
-            auto& mesh_instanced = main_camera_mesh_drawcall_batch[node.ref_material];
-            auto& mesh_nodes = mesh_instanced[node.ref_mesh];
-
-            MeshNode temp;
-            temp.model_matrix = node.model_matrix;
-            if (node.enable_vertex_blending) {
-                temp.joint_matrices = node.joint_matrices;
-                temp.joint_count = node.joint_count;
-            }
-
-            mesh_nodes.push_back(temp);
-        }
+    void MainCameraPass::recordMeshGbuffer(uint32_t thread_index, uint32_t current_swapchain_image_index) {
+        _mesh_command_buffer = m_rhi->beginSecondaryCommandBuffer(
+            thread_index, m_framebuffer.render_pass, main_camera_subpass_basepass, _swapchain_framebuffers[current_swapchain_image_index]
+        );
+        UploadRingbufferAllocator upload_allocator(m_global_render_resource->m_storage_buffer, m_rhi->getCurrentFrameIndex());
 
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Mesh GBuffer", color);
+        m_rhi->pushEvent(_mesh_command_buffer, "BasePass", color);
+        drawMeshGbuffer(_mesh_command_buffer, upload_allocator);
+        m_rhi->popEvent(_mesh_command_buffer);
 
-        m_rhi->cmdBindPipelinePFN(m_rhi->getCurrentCommandBuffer(), RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[render_pipeline_type_mesh_gbuffer].pipeline);
-        m_rhi->cmdSetViewportPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, m_rhi->getSwapchainInfo().viewport);
-        m_rhi->cmdSetScissorPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, m_rhi->getSwapchainInfo().scissor);
+        m_rhi->endCommandBufferPFN(_mesh_command_buffer);
+    }
 
-        //perframe storage buffer
-        uint32_t perframe_dynamic_offset = roundUp(
-            m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-            m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment
+    void MainCameraPass::recordForwardLighting(uint32_t thread_index, uint32_t current_swapchain_image_index, ParticlePass& particle_pass) {
+        _mesh_command_buffer = m_rhi->beginSecondaryCommandBuffer(
+            thread_index, m_framebuffer.render_pass, main_camera_subpass_forward_lighting, _swapchain_framebuffers[current_swapchain_image_index]
         );
+        UploadRingbufferAllocator upload_allocator(m_global_render_resource->m_storage_buffer, m_rhi->getCurrentFrameIndex());
 
-        m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perframe_dynamic_offset + sizeof(MeshPerframeStorageBufferObject);
-        ASSERT(
-            m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-            (m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-        );
+        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        m_rhi->pushEvent(_mesh_command_buffer, "Forward Lighting", color);
+        drawMeshLighting(_mesh_command_buffer, upload_allocator);
+        drawSkybox(_mesh_command_buffer, upload_allocator);
+        //the whole subpass comes from secondary command buffers, so the particles go into this one too
+        particle_pass.setRenderCommandBufferHandle(_mesh_command_buffer);
+        particle_pass.draw();
+        m_rhi->popEvent(_mesh_command_buffer);
+
+        m_rhi->endCommandBufferPFN(_mesh_command_buffer);
+    }
+
+    void MainCameraPass::drawMeshGbuffer(RHICommandBuffer* command_buffer, UploadRingbufferAllocator& upload_allocator) {
+        _draw_list.build(*(m_visible_nodes.p_main_camera_visible_mesh_nodes), draw_list_pass_main_camera, render_pipeline_type_mesh_gbuffer, &m_mesh_perframe_storage_buffer_object.camera_position);
+        const uint32_t instance_base_index = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getFrameBaseIndex(m_rhi->getCurrentFrameIndex());
+
+        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        m_rhi->pushEvent(command_buffer, "Mesh GBuffer", color);
+
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[render_pipeline_type_mesh_gbuffer].pipeline);
+        m_rhi->cmdSetViewportPFN(command_buffer, 0, 1, m_rhi->getSwapchainInfo().viewport);
+        m_rhi->cmdSetScissorPFN(command_buffer, 0, 1, m_rhi->getSwapchainInfo().scissor);
+
+        //perframe storage buffer
+        uint32_t perframe_dynamic_offset = upload_allocator.allocate(sizeof(MeshPerframeStorageBufferObject));
 
         (*reinterpret_cast<MeshPerframeStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perframe_dynamic_offset)) = m_mesh_perframe_storage_buffer_object;
 
-        for (auto& pair1 : main_camera_mesh_drawcall_batch) {
-            VulkanPBRMaterial& material = (*pair1.first);
-            auto& mesh_instanced = pair1.second;
-            //bind per material
+        VulkanPBRMaterial* bound_material = nullptr;
+        const std::vector<RenderDrawBatch>& batches = _draw_list.getBatches();
+        const bool multi_draw_indirect = m_rhi->isMultiDrawIndirectEnabled();
+        for (uint32_t batch_index = 0; batch_index < static_cast<uint32_t>(batches.size()); ++batch_index) {
+            const RenderDrawBatch& batch = batches[batch_index];
+            //bind per material, batches of one material are adjacent
+            if (batch.material != bound_material) {
+                m_rhi->cmdBindDescriptorSetsPFN(
+                    command_buffer,
+                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_render_pipelines[render_pipeline_type_mesh_gbuffer].layout,
+                    2, 1, &batch.material->material_descriptor_set, 0, nullptr
+                );
+                bound_material = batch.material;
+            }
+
+            //pooled meshes of this material go out as one indirect draw
+            const uint32_t run_end = multi_draw_indirect ? _draw_list.getIndirectRunEnd(batch_index, s_mesh_indirect_max_instance_count, true) : batch_index;
+            if (run_end > batch_index) {
+                IndirectDraws indirect_draws = uploadIndirectDraws(upload_allocator, _draw_list, batch_index, run_end, instance_base_index);
+
+                m_rhi->cmdBindDescriptorSetsPFN(
+                    command_buffer,
+                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_render_pipelines[render_pipeline_type_mesh_gbuffer].layout,
+                    1, 1, &batch.mesh->mesh_vertex_blending_descriptor_set,
+                    0, nullptr
+                );
+
+                const RenderMeshPool& mesh_pool = m_global_render_resource->m_mesh_pool;
+                RHIBuffer* vertex_buffers[] = { mesh_pool.getVertexPositionBuffer(),mesh_pool.getVertexVaryingEnableBlendingBuffer(),mesh_pool.getVertexVaryingBuffer() };
+                RHIDeviceSize offsets[] = { 0, 0, 0 };
+                m_rhi->cmdBindVertexBuffersPFN(command_buffer, 0, (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])), vertex_buffers, offsets);
+                m_rhi->cmdBindIndexBufferPFN(command_buffer, mesh_pool.getIndexBuffer(), 0, RHI_INDEX_TYPE_UINT16);
+
+                uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,indirect_draws.instance_indices_dynamic_offset,0 };
+                m_rhi->cmdBindDescriptorSetsPFN(
+                    command_buffer,
+                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_render_pipelines[render_pipeline_type_mesh_gbuffer].layout,
+                    0, 1, &m_descriptor_infos[layout_type_mesh_global].descriptor_set,
+                    3, dynamic_offsets
+                );
+
+                m_rhi->cmdDrawIndexedIndirect(
+                    command_buffer,
+                    m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer,
+                    indirect_draws.commands_offset,
+                    indirect_draws.command_count,
+                    sizeof(RHIDrawIndexedIndirectCommand)
+                );
+                batch_index = run_end - 1;
+                continue;
+            }
+
+            VulkanMesh& mesh = *batch.mesh;
+            const RenderDrawInstance* mesh_nodes = _draw_list.getInstances(batch);
+            uint32_t total_instance_count = batch.instance_count;
+
+            //bind per mesh
             m_rhi->cmdBindDescriptorSetsPFN(
-                m_rhi->getCurrentCommandBuffer(),
+                command_buffer,
                 RHI_PIPELINE_BIND_POINT_GRAPHICS,
                 m_render_pipelines[render_pipeline_type_mesh_gbuffer].layout,
-                2, 1, &material.material_descriptor_set, 0, nullptr
+                1, 1, &mesh.mesh_vertex_blending_descriptor_set,
+                0, nullptr
             );
-            //TODO(render from near to far)
-            for (auto& pair2 : mesh_instanced) {
-                VulkanMesh& mesh = (*pair2.first);
-                auto& mesh_nodes = pair2.second;
-
-                uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-                if (total_instance_count > 0) {
-                    //bind per mesh
-                    m_rhi->cmdBindDescriptorSetsPFN(
-                        m_rhi->getCurrentCommandBuffer(),
-                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                        m_render_pipelines[render_pipeline_type_mesh_gbuffer].layout,
-                        1, 1, &mesh.mesh_vertex_blending_descriptor_set,
-                        0, nullptr
-                    );
-
-                    RHIBuffer* vertex_buffers[] = { mesh.mesh_vertex_position_buffer,mesh.mesh_vertex_varying_enable_blending_buffer,mesh.mesh_vertex_varying_buffer };
-                    RHIDeviceSize offsets[] = { 0, 0, 0 };
-                    m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(), 0, (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])), vertex_buffers, offsets);
-                    m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
-                    uint32_t drawcall_max_instance_count = (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) / sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
-                    uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
-
-                    for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index) {
-                        uint32_t current_instance_count = ((total_instance_count - drawcall_max_instance_count * drawcall_index) < drawcall_max_instance_count) ? (total_instance_count - drawcall_max_instance_count * drawcall_index) : drawcall_max_instance_count;
-
-                        //per drawcall storage buffer
-                        uint32_t perdrawcall_dynamic_offset = roundUp(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()], m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment);
-                        m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
-
-                        ASSERT(
-                            m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                            (m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-                        );
-
-                        MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object = (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_dynamic_offset));
-                        for (uint32_t i = 0; i < current_instance_count; ++i) {
-                            perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix = *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-                            perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 : -1.0;
-                        }
 
-                        //per drawcall vertex blending storage buffer
-                        uint32_t perdrawcall_vertex_blending_dynamic_offset;
-                        bool least_one_enable_vertex_blending = true;
-                        for (uint32_t i = 0; i < current_instance_count; ++i) {
-                            if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
-                                least_one_enable_vertex_blending = false;
-                                break;
-                            }
-                        }
-                        if (least_one_enable_vertex_blending) {
-                            perdrawcall_vertex_blending_dynamic_offset = roundUp(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()], m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment);
-                            m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perdrawcall_vertex_blending_dynamic_offset + sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
-                            ASSERT(
-                                m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                                (m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                    m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-                            );
-
-                            MeshPerdrawcallVertexBlendingStorageBufferObject& perdrawcall_vertex_blending_storage_buffer_object = (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_vertex_blending_dynamic_offset));
-                            for (uint32_t i = 0; i < current_instance_count; ++i) {
-                                if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
-                                    for (uint32_t j = 0; j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count; ++j) {
-                                        perdrawcall_vertex_blending_storage_buffer_object.joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices[j];
-                                    }
-                                }
+            RHIBuffer* vertex_buffers[] = { mesh.mesh_vertex_position_buffer,mesh.mesh_vertex_varying_enable_blending_buffer,mesh.mesh_vertex_varying_buffer };
+            RHIDeviceSize offsets[] = { 0, 0, 0 };
+            m_rhi->cmdBindVertexBuffersPFN(command_buffer, 0, (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])), vertex_buffers, offsets);
+            m_rhi->cmdBindIndexBufferPFN(command_buffer, mesh.mesh_index_buffer, 0, mesh.mesh_index_type);
+
+            uint32_t drawcall_max_instance_count = (sizeof(MeshPerdrawcallStorageBufferObject::instance_indices) / sizeof(MeshPerdrawcallStorageBufferObject::instance_indices[0]));
+            uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
+
+            for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index) {
+                uint32_t current_instance_count = ((total_instance_count - drawcall_max_instance_count * drawcall_index) < drawcall_max_instance_count) ? (total_instance_count - drawcall_max_instance_count * drawcall_index) : drawcall_max_instance_count;
+
+                //per drawcall storage buffer
+                uint32_t perdrawcall_dynamic_offset = upload_allocator.allocate(sizeof(MeshPerdrawcallStorageBufferObject));
+
+                MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object = (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_dynamic_offset));
+                for (uint32_t i = 0; i < current_instance_count; ++i) {
+                    perdrawcall_storage_buffer_object.instance_indices[i] = instance_base_index + mesh_nodes[drawcall_max_instance_count * drawcall_index + i].instance_slot;
+                }
+
+                //per drawcall vertex blending storage buffer
+                uint32_t perdrawcall_vertex_blending_dynamic_offset;
+                bool least_one_enable_vertex_blending = true;
+                for (uint32_t i = 0; i < current_instance_count; ++i) {
+                    if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
+                        least_one_enable_vertex_blending = false;
+                        break;
+                    }
+                }
+                if (least_one_enable_vertex_blending) {
+                    perdrawcall_vertex_blending_dynamic_offset = upload_allocator.allocate(sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject));
+
+                    MeshPerdrawcallVertexBlendingStorageBufferObject& perdrawcall_vertex_blending_storage_buffer_object = (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_vertex_blending_dynamic_offset));
+                    for (uint32_t i = 0; i < current_instance_count; ++i) {
+                        if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
+                            for (uint32_t j = 0; j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count; ++j) {
+                                perdrawcall_vertex_blending_storage_buffer_object.joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices[j];
                             }
                         }
-                        else {
-                            perdrawcall_vertex_blending_dynamic_offset = 0;
-                        }
-
-                        //bind perdrawcall
-                        uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,perdrawcall_dynamic_offset,perdrawcall_vertex_blending_dynamic_offset };
-                        m_rhi->cmdBindDescriptorSetsPFN(
-                            m_rhi->getCurrentCommandBuffer(),
-                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                            m_render_pipelines[render_pipeline_type_mesh_gbuffer].layout,
-                            0, 1, &m_descriptor_infos[layout_type_mesh_global].descriptor_set,
-                            3, dynamic_offsets
-                        );
-
-                        m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_count, current_instance_count, 0, 0, 0);
                     }
                 }
+                else {
+                    perdrawcall_vertex_blending_dynamic_offset = 0;
+                }
+
+                //bind perdrawcall
+                uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,perdrawcall_dynamic_offset,perdrawcall_vertex_blending_dynamic_offset };
+                m_rhi->cmdBindDescriptorSetsPFN(
+                    command_buffer,
+                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_render_pipelines[render_pipeline_type_mesh_gbuffer].layout,
+                    0, 1, &m_descriptor_infos[layout_type_mesh_global].descriptor_set,
+                    3, dynamic_offsets
+                );
+
+                m_rhi->cmdDrawIndexedPFN(command_buffer, mesh.mesh_index_count, current_instance_count, mesh.mesh_first_index, mesh.mesh_first_vertex, 0);
             }
         }
 
-        m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
+        m_rhi->popEvent(command_buffer);
     }
 
     void MainCameraPass::drawDeferredLighting() {
@@ -2082,190 +2119,178 @@ namespace Dao {
         m_rhi->cmdDraw(m_rhi->getCurrentCommandBuffer(), 3, 1, 0, 0);
     }
 
-    void MainCameraPass::drawMeshLighting() {
-        struct MeshNode {
-            const Matrix4x4* model_matrix{ nullptr };
-            const Matrix4x4* joint_matrices{ nullptr };
-            uint32_t joint_count{ 0 };
-        };
-
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
-
-        //reorganize mesh
-        for (RenderMeshNode& node : *(m_visible_nodes.p_main_camera_visible_mesh_nodes)) {
-            auto& mesh_instanced = main_camera_mesh_drawcall_batch[node.ref_material];
-            auto& mesh_nodes = mesh_instanced[node.ref_mesh];
-
-            MeshNode temp;
-            temp.model_matrix = node.model_matrix;
-            if (node.enable_vertex_blending)
-            {
-                temp.joint_matrices = node.joint_matrices;
-                temp.joint_count = node.joint_count;
-            }
-
-            mesh_nodes.push_back(temp);
-        }
+    void MainCameraPass::drawMeshLighting(RHICommandBuffer* command_buffer, UploadRingbufferAllocator& upload_allocator) {
+        _draw_list.build(*(m_visible_nodes.p_main_camera_visible_mesh_nodes), draw_list_pass_main_camera, render_pipeline_type_mesh_lighting, &m_mesh_perframe_storage_buffer_object.camera_position);
+        const uint32_t instance_base_index = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getFrameBaseIndex(m_rhi->getCurrentFrameIndex());
 
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Model", color);
+        m_rhi->pushEvent(command_buffer, "Model", color);
 
-        m_rhi->cmdBindPipelinePFN(m_rhi->getCurrentCommandBuffer(), RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[render_pipeline_type_mesh_lighting].pipeline);
-        m_rhi->cmdSetViewportPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, m_rhi->getSwapchainInfo().viewport);
-        m_rhi->cmdSetScissorPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, m_rhi->getSwapchainInfo().scissor);
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[render_pipeline_type_mesh_lighting].pipeline);
+        m_rhi->cmdSetViewportPFN(command_buffer, 0, 1, m_rhi->getSwapchainInfo().viewport);
+        m_rhi->cmdSetScissorPFN(command_buffer, 0, 1, m_rhi->getSwapchainInfo().scissor);
 
         //perframe storage buffer
-        uint32_t perframe_dynamic_offset = roundUp(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()], m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment);
+        uint32_t perframe_dynamic_offset = upload_allocator.allocate(sizeof(MeshPerframeStorageBufferObject));
 
-        m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perframe_dynamic_offset + sizeof(MeshPerframeStorageBufferObject);
+        (*reinterpret_cast<MeshPerframeStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perframe_dynamic_offset)) = m_mesh_perframe_storage_buffer_object;
 
-        ASSERT(
-            m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-            (m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-        );
+        VulkanPBRMaterial* bound_material = nullptr;
+        const std::vector<RenderDrawBatch>& batches = _draw_list.getBatches();
+        const bool multi_draw_indirect = m_rhi->isMultiDrawIndirectEnabled();
+        for (uint32_t batch_index = 0; batch_index < static_cast<uint32_t>(batches.size()); ++batch_index) {
+            const RenderDrawBatch& batch = batches[batch_index];
+            //bind per material, batches of one material are adjacent
+            if (batch.material != bound_material) {
+                m_rhi->cmdBindDescriptorSetsPFN(
+                    command_buffer,
+                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_render_pipelines[render_pipeline_type_mesh_lighting].layout,
+                    2, 1, &batch.material->material_descriptor_set,
+                    0, nullptr
+                );
+                bound_material = batch.material;
+            }
 
-        (*reinterpret_cast<MeshPerframeStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perframe_dynamic_offset)) = m_mesh_perframe_storage_buffer_object;
+            //pooled meshes of this material go out as one indirect draw
+            const uint32_t run_end = multi_draw_indirect ? _draw_list.getIndirectRunEnd(batch_index, s_mesh_indirect_max_instance_count, true) : batch_index;
+            if (run_end > batch_index) {
+                IndirectDraws indirect_draws = uploadIndirectDraws(upload_allocator, _draw_list, batch_index, run_end, instance_base_index);
+
+                m_rhi->cmdBindDescriptorSetsPFN(
+                    command_buffer,
+                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_render_pipelines[render_pipeline_type_mesh_lighting].layout,
+                    1, 1, &batch.mesh->mesh_vertex_blending_descriptor_set,
+                    0, nullptr
+                );
+
+                const RenderMeshPool& mesh_pool = m_global_render_resource->m_mesh_pool;
+                RHIBuffer* vertex_buffers[] = { mesh_pool.getVertexPositionBuffer(),mesh_pool.getVertexVaryingEnableBlendingBuffer(),mesh_pool.getVertexVaryingBuffer() };
+                RHIDeviceSize offsets[] = { 0, 0, 0 };
+                m_rhi->cmdBindVertexBuffersPFN(command_buffer, 0, (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])), vertex_buffers, offsets);
+                m_rhi->cmdBindIndexBufferPFN(command_buffer, mesh_pool.getIndexBuffer(), 0, RHI_INDEX_TYPE_UINT16);
+
+                uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,indirect_draws.instance_indices_dynamic_offset,0 };
+                m_rhi->cmdBindDescriptorSetsPFN(
+                    command_buffer,
+                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_render_pipelines[render_pipeline_type_mesh_lighting].layout,
+                    0, 1, &m_descriptor_infos[layout_type_mesh_global].descriptor_set,
+                    3, dynamic_offsets
+                );
+
+                m_rhi->cmdDrawIndexedIndirect(
+                    command_buffer,
+                    m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer,
+                    indirect_draws.commands_offset,
+                    indirect_draws.command_count,
+                    sizeof(RHIDrawIndexedIndirectCommand)
+                );
+                batch_index = run_end - 1;
+                continue;
+            }
 
-        for (auto& pair1 : main_camera_mesh_drawcall_batch) {
-            VulkanPBRMaterial& material = (*pair1.first);
-            auto& mesh_instanced = pair1.second;
-            //bind per material
+            VulkanMesh& mesh = *batch.mesh;
+            const RenderDrawInstance* mesh_nodes = _draw_list.getInstances(batch);
+            uint32_t total_instance_count = batch.instance_count;
+
+            //bind per mesh
             m_rhi->cmdBindDescriptorSetsPFN(
-                m_rhi->getCurrentCommandBuffer(),
+                command_buffer,
                 RHI_PIPELINE_BIND_POINT_GRAPHICS,
                 m_render_pipelines[render_pipeline_type_mesh_lighting].layout,
-                2, 1, &material.material_descriptor_set,
+                1, 1, &mesh.mesh_vertex_blending_descriptor_set,
                 0, nullptr
             );
 
-            //TODO(render from near to far)
-            for (auto& pair2 : mesh_instanced) {
-                VulkanMesh& mesh = (*pair2.first);
-                auto& mesh_nodes = pair2.second;
-
-                uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-                if (total_instance_count > 0) {
-                    //bind per mesh
-                    m_rhi->cmdBindDescriptorSetsPFN(
-                        m_rhi->getCurrentCommandBuffer(),
-                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                        m_render_pipelines[render_pipeline_type_mesh_lighting].layout,
-                        1, 1, &mesh.mesh_vertex_blending_descriptor_set,
-                        0, nullptr
-                    );
-
-                    RHIBuffer* vertex_buffers[3] = { mesh.mesh_vertex_position_buffer,mesh.mesh_vertex_varying_enable_blending_buffer,mesh.mesh_vertex_varying_buffer };
-                    RHIDeviceSize offsets[] = { 0, 0, 0 };
-                    m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(), 0, (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])), vertex_buffers, offsets);
-                    m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
-                    uint32_t drawcall_max_instance_count = (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) / sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
-                    uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
-
-                    for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index) {
-                        uint32_t current_instance_count =
-                            ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
-                                drawcall_max_instance_count) ?
-                            (total_instance_count - drawcall_max_instance_count * drawcall_index) :
-                            drawcall_max_instance_count;
-
-                        //per drawcall storage buffer
-                        uint32_t perdrawcall_dynamic_offset = roundUp(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()], m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment);
-                        m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
-
-                        ASSERT(
-                            m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                            (m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-                        );
-
-                        MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object = (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_dynamic_offset));
-                        for (uint32_t i = 0; i < current_instance_count; ++i) {
-                            perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix = *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-                            perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 : -1.0;
-                        }
+            RHIBuffer* vertex_buffers[3] = { mesh.mesh_vertex_position_buffer,mesh.mesh_vertex_varying_enable_blending_buffer,mesh.mesh_vertex_varying_buffer };
+            RHIDeviceSize offsets[] = { 0, 0, 0 };
+            m_rhi->cmdBindVertexBuffersPFN(command_buffer, 0, (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])), vertex_buffers, offsets);
+            m_rhi->cmdBindIndexBufferPFN(command_buffer, mesh.mesh_index_buffer, 0, mesh.mesh_index_type);
 
-                        //per drawcall vertex blending storage buffer
-                        uint32_t perdrawcall_vertex_blending_dynamic_offset;
-                        bool least_one_enable_vertex_blending = true;
-                        for (uint32_t i = 0; i < current_instance_count; ++i) {
-                            if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
-                                least_one_enable_vertex_blending = false;
-                                break;
-                            }
-                        }
-                        if (least_one_enable_vertex_blending) {
-                            perdrawcall_vertex_blending_dynamic_offset = roundUp(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()], m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment);
-                            m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perdrawcall_vertex_blending_dynamic_offset + sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
-
-                            ASSERT(
-                                m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                                (m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                    m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-                            );
-
-                            MeshPerdrawcallVertexBlendingStorageBufferObject& perdrawcall_vertex_blending_storage_buffer_object = (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_vertex_blending_dynamic_offset));
-                            for (uint32_t i = 0; i < current_instance_count; ++i) {
-                                if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
-                                    for (uint32_t j = 0; j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count; ++j) {
-                                        perdrawcall_vertex_blending_storage_buffer_object.joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices[j];
-                                    }
-                                }
+            uint32_t drawcall_max_instance_count = (sizeof(MeshPerdrawcallStorageBufferObject::instance_indices) / sizeof(MeshPerdrawcallStorageBufferObject::instance_indices[0]));
+            uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
+
+            for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index) {
+                uint32_t current_instance_count =
+                    ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
+                        drawcall_max_instance_count) ?
+                    (total_instance_count - drawcall_max_instance_count * drawcall_index) :
+                    drawcall_max_instance_count;
+
+                //per drawcall storage buffer
+                uint32_t perdrawcall_dynamic_offset = upload_allocator.allocate(sizeof(MeshPerdrawcallStorageBufferObject));
+
+                MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object = (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_dynamic_offset));
+                for (uint32_t i = 0; i < current_instance_count; ++i) {
+                    perdrawcall_storage_buffer_object.instance_indices[i] = instance_base_index + mesh_nodes[drawcall_max_instance_count * drawcall_index + i].instance_slot;
+                }
+
+                //per drawcall vertex blending storage buffer
+                uint32_t perdrawcall_vertex_blending_dynamic_offset;
+                bool least_one_enable_vertex_blending = true;
+                for (uint32_t i = 0; i < current_instance_count; ++i) {
+                    if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
+                        least_one_enable_vertex_blending = false;
+                        break;
+                    }
+                }
+                if (least_one_enable_vertex_blending) {
+                    perdrawcall_vertex_blending_dynamic_offset = upload_allocator.allocate(sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject));
+
+                    MeshPerdrawcallVertexBlendingStorageBufferObject& perdrawcall_vertex_blending_storage_buffer_object = (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_vertex_blending_dynamic_offset));
+                    for (uint32_t i = 0; i < current_instance_count; ++i) {
+                        if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices) {
+                            for (uint32_t j = 0; j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count; ++j) {
+                                perdrawcall_vertex_blending_storage_buffer_object.joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices[j];
                             }
                         }
-                        else {
-                            perdrawcall_vertex_blending_dynamic_offset = 0;
-                        }
-
-                        // bind perdrawcall
-                        uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,perdrawcall_dynamic_offset,perdrawcall_vertex_blending_dynamic_offset };
-                        m_rhi->cmdBindDescriptorSetsPFN(
-                            m_rhi->getCurrentCommandBuffer(),
-                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                            m_render_pipelines[render_pipeline_type_mesh_lighting].layout,
-                            0, 1, &m_descriptor_infos[layout_type_mesh_global].descriptor_set,
-                            3, dynamic_offsets
-                        );
-
-                        m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_count, current_instance_count, 0, 0, 0);
                     }
                 }
+                else {
+                    perdrawcall_vertex_blending_dynamic_offset = 0;
+                }
+
+                // bind perdrawcall
+                uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,perdrawcall_dynamic_offset,perdrawcall_vertex_blending_dynamic_offset };
+                m_rhi->cmdBindDescriptorSetsPFN(
+                    command_buffer,
+                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_render_pipelines[render_pipeline_type_mesh_lighting].layout,
+                    0, 1, &m_descriptor_infos[layout_type_mesh_global].descriptor_set,
+                    3, dynamic_offsets
+                );
+
+                m_rhi->cmdDrawIndexedPFN(command_buffer, mesh.mesh_index_count, current_instance_count, mesh.mesh_first_index, mesh.mesh_first_vertex, 0);
             }
         }
 
-        m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
+        m_rhi->popEvent(command_buffer);
     }
 
-    void MainCameraPass::drawSkybox() {
-        uint32_t perframe_dynamic_offset = roundUp(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()], m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment);
-
-        m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perframe_dynamic_offset + sizeof(MeshPerframeStorageBufferObject);
-        ASSERT(
-            m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-            (m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-        );
+    void MainCameraPass::drawSkybox(RHICommandBuffer* command_buffer, UploadRingbufferAllocator& upload_allocator) {
+        uint32_t perframe_dynamic_offset = upload_allocator.allocate(sizeof(MeshPerframeStorageBufferObject));
 
         (*reinterpret_cast<MeshPerframeStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perframe_dynamic_offset)) = m_mesh_perframe_storage_buffer_object;
 
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Skybox", color);
+        m_rhi->pushEvent(command_buffer, "Skybox", color);
 
-        m_rhi->cmdBindPipelinePFN(m_rhi->getCurrentCommandBuffer(), RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[render_pipeline_type_skybox].pipeline);
+        m_rhi->cmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS, m_render_pipelines[render_pipeline_type_skybox].pipeline);
         m_rhi->cmdBindDescriptorSetsPFN(
-            m_rhi->getCurrentCommandBuffer(),
+            command_buffer,
             RHI_PIPELINE_BIND_POINT_GRAPHICS,
             m_render_pipelines[render_pipeline_type_skybox].layout,
             0, 1, &m_descriptor_infos[layout_type_skybox].descriptor_set,
             1, &perframe_dynamic_offset
         );
-        m_rhi->cmdDraw(m_rhi->getCurrentCommandBuffer(), 36, 1, 0, 0);
-        m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
+        m_rhi->cmdDraw(command_buffer, 36, 1, 0, 0);
+        m_rhi->popEvent(command_buffer);
     }
 
     void MainCameraPass::drawAxis() {
-        if (!m_is_show_axis) {
+        if (!m_is_show_axis || !m_visible_nodes.p_axis_node->ref_mesh) {
             return;
         }
 
@@ -2299,10 +2324,10 @@ namespace Dao {
         RHIBuffer* vertex_buffers[3] = { m_visible_nodes.p_axis_node->ref_mesh->mesh_vertex_position_buffer,m_visible_nodes.p_axis_node->ref_mesh->mesh_vertex_varying_enable_blending_buffer,m_visible_nodes.p_axis_node->ref_mesh->mesh_vertex_varying_buffer };
         RHIDeviceSize offsets[3] = { 0, 0, 0 };
         m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(), 0, (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])), vertex_buffers, offsets);
-        m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), m_visible_nodes.p_axis_node->ref_mesh->mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
+        m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), m_visible_nodes.p_axis_node->ref_mesh->mesh_index_buffer, 0, m_visible_nodes.p_axis_node->ref_mesh->mesh_index_type);
         (*reinterpret_cast<AxisStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_axis_inefficient_storage_buffer_memory_pointer))) = m_axis_storage_buffer_object;
 
-        m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(), m_visible_nodes.p_axis_node->ref_mesh->mesh_index_count, 1, 0, 0, 0);
+        m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(), m_visible_nodes.p_axis_node->ref_mesh->mesh_index_count, 1, m_visible_nodes.p_axis_node->ref_mesh->mesh_first_index, m_visible_nodes.p_axis_node->ref_mesh->mesh_first_vertex, 0);
 
         m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
     }
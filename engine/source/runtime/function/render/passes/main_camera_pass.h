@@ -1,6 +1,7 @@
 #pragma once
 
 #include "runtime/function/render/render_pass.h"
+#include "runtime/function/render/render_draw_list.h"
 #include "runtime/function/render/passes/color_grading_pass.h"
 #include "runtime/function/render/passes/combine_ui_pass.h"
 #include "runtime/function/render/passes/fxaa_pass.h"
@@ -59,6 +60,10 @@ namespace Dao {
 			ParticlePass& particle_pass,
 			uint32_t current_swapchain_image_index
 		);
+		/// record the base pass into a secondary command buffer for draw, safe to run on a job worker next to other passes
+		void recordMeshGbuffer(uint32_t thread_index, uint32_t current_swapchain_image_index);
+		/// record meshes, skybox and particles of the forward lighting subpass for drawForward
+		void recordForwardLighting(uint32_t thread_index, uint32_t current_swapchain_image_index, ParticlePass& particle_pass);
 
 		RHIImageView* m_point_light_shadow_color_image_view;
 		RHIImageView* m_directional_light_shadow_color_image_view;
@@ -88,14 +93,17 @@ namespace Dao {
 		void setupAxisDescriptorSet();
 		void setupGbufferLightingDescriptorSet();
 
-		void drawMeshGbuffer();
+		void drawMeshGbuffer(RHICommandBuffer* command_buffer, UploadRingbufferAllocator& upload_allocator);
 		void drawDeferredLighting();
-		void drawMeshLighting();
-		void drawSkybox();
+		void drawMeshLighting(RHICommandBuffer* command_buffer, UploadRingbufferAllocator& upload_allocator);
+		void drawSkybox(RHICommandBuffer* command_buffer, UploadRingbufferAllocator& upload_allocator);
 		void drawAxis();
 
 	private:
 		std::vector<RHIFramebuffer*> _swapchain_framebuffers;
 		std::shared_ptr<ParticlePass> _particle_pass;
+		RenderDrawList _draw_list;
+		//mesh draws of the base pass or the forward lighting subpass of the current frame
+		RHICommandBuffer* _mesh_command_buffer{ nullptr };
 	};
 }
\ No newline at end of file
@@ -9,7 +9,6 @@
 #include <mesh_inefficient_pick_vert.h>
 #include <mesh_inefficient_pick_frag.h>
 
-#include <map>
 
 namespace Dao {
 	void PickPass::initialize(const RenderPassInitInfo* init_info) {
@@ -132,7 +131,7 @@ namespace Dao {
 	void PickPass::setupDescriptorSetLayout() {
 		m_descriptor_infos.resize(1);
 
-		RHIDescriptorSetLayoutBinding mesh_inefficient_pick_global_layout_bindings[3] = {};
+		RHIDescriptorSetLayoutBinding mesh_inefficient_pick_global_layout_bindings[4] = {};
 
 		RHIDescriptorSetLayoutBinding& mesh_inefficient_pick_global_layout_perframe_storage_buffer_binding = mesh_inefficient_pick_global_layout_bindings[0];
 		mesh_inefficient_pick_global_layout_perframe_storage_buffer_binding.binding = 0;
@@ -154,6 +153,13 @@ namespace Dao {
 		mesh_inefficient_pick_global_layout_perdrawcall_vertex_blending_storage_buffer_binding.stageFlags = RHI_SHADER_STAGE_VERTEX_BIT;
 		mesh_inefficient_pick_global_layout_perdrawcall_vertex_blending_storage_buffer_binding.pImmutableSamplers = nullptr;
 
+		RHIDescriptorSetLayoutBinding& mesh_inefficient_pick_global_layout_scene_instance_storage_buffer_binding = mesh_inefficient_pick_global_layout_bindings[3];
+		mesh_inefficient_pick_global_layout_scene_instance_storage_buffer_binding.binding = 3;
+		mesh_inefficient_pick_global_layout_scene_instance_storage_buffer_binding.descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		mesh_inefficient_pick_global_layout_scene_instance_storage_buffer_binding.descriptorCount = 1;
+		mesh_inefficient_pick_global_layout_scene_instance_storage_buffer_binding.stageFlags = RHI_SHADER_STAGE_VERTEX_BIT;
+		mesh_inefficient_pick_global_layout_scene_instance_storage_buffer_binding.pImmutableSamplers = nullptr;
+
 		RHIDescriptorSetLayoutCreateInfo mesh_inefficient_pick_global_layout_create_info{};
 		mesh_inefficient_pick_global_layout_create_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 		mesh_inefficient_pick_global_layout_create_info.pNext = nullptr;
@@ -328,7 +334,12 @@ namespace Dao {
 
 		ASSERT(mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info.range < m_global_render_resource->m_storage_buffer.m_max_storage_buffer_range);
 
-		RHIWriteDescriptorSet mesh_descriptor_writes_info[3] = {};
+		RHIDescriptorBufferInfo mesh_inefficient_pick_scene_instance_storage_buffer_info{};
+		mesh_inefficient_pick_scene_instance_storage_buffer_info.offset = 0;
+		mesh_inefficient_pick_scene_instance_storage_buffer_info.range = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getBufferSize();
+		mesh_inefficient_pick_scene_instance_storage_buffer_info.buffer = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getBuffer();
+
+		RHIWriteDescriptorSet mesh_descriptor_writes_info[4] = {};
 
 		mesh_descriptor_writes_info[0].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 		mesh_descriptor_writes_info[0].pNext = nullptr;
@@ -357,6 +368,11 @@ namespace Dao {
 		mesh_descriptor_writes_info[2].descriptorCount = 1;
 		mesh_descriptor_writes_info[2].pBufferInfo = &mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info;
 
+		mesh_descriptor_writes_info[3] = mesh_descriptor_writes_info[2];
+		mesh_descriptor_writes_info[3].dstBinding = 3;
+		mesh_descriptor_writes_info[3].descriptorType = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		mesh_descriptor_writes_info[3].pBufferInfo = &mesh_inefficient_pick_scene_instance_storage_buffer_info;
+
 		m_rhi->updateDescriptorSets(
 			sizeof(mesh_descriptor_writes_info) / sizeof(mesh_descriptor_writes_info[0]),
 			mesh_descriptor_writes_info, 0, nullptr
@@ -382,34 +398,15 @@ namespace Dao {
 			return 0;
 		}
 
-		struct MeshNode {
-			const Matrix4x4* model_matrix{ nullptr };
-			const Matrix4x4* joint_matrices{ nullptr };
-			uint32_t joint_count{ 0 };
-			uint32_t node_id;
-		};
-
-		std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
-
-		//reorganize mesh
-		for (RenderMeshNode& node : *(m_visible_nodes.p_main_camera_visible_mesh_nodes)) {
-			auto& mesh_instanced = main_camera_mesh_drawcall_batch[node.ref_material];
-			auto& mesh_nodes = mesh_instanced[node.ref_mesh];
-			MeshNode temp;
-			temp.model_matrix = node.model_matrix;
-			temp.node_id = node.node_id;
-			if (node.ref_mesh->enable_vertex_blending) {
-				temp.joint_matrices = node.joint_matrices;
-				temp.joint_count = node.joint_count;
-			}
-			mesh_nodes.push_back(temp);
-		}
+		_draw_list.build(*(m_visible_nodes.p_main_camera_visible_mesh_nodes), draw_list_pass_pick, 0);
 
 		m_rhi->prepareContext();
 		//reset storage buffer offset
 		m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()];
 
 		m_rhi->waitForFences();
+		m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.flush(m_rhi->getCurrentFrameIndex());
+		const uint32_t instance_base_index = m_global_render_resource->m_storage_buffer.m_scene_instance_buffer.getFrameBaseIndex(m_rhi->getCurrentFrameIndex());
 
 		m_rhi->resetCommandPool();
 
@@ -481,101 +478,95 @@ namespace Dao {
 
 		(*reinterpret_cast<MeshInefficientPickPerframeStorageBufferObject*>(reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perframe_dynamic_offset)) = _mesh_inefficient_pick_perframe_storage_buffer_object;
 
-		for (auto& pair1 : main_camera_mesh_drawcall_batch) {
-			VulkanPBRMaterial& material = (*pair1.first);
-			auto& mesh_instanced = pair1.second;
-			//TODO(render from near to far)
-			for (auto& pair2 : mesh_instanced) {
-				VulkanMesh& mesh = (*pair2.first);
-				auto& mesh_nodes = pair2.second;
-
-				uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-				if (total_instance_count > 0) {
-					//bind per mesh
-					m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-						RHI_PIPELINE_BIND_POINT_GRAPHICS,
-						m_render_pipelines[0].layout,
-						1, 1,
-						&mesh.mesh_vertex_blending_descriptor_set,
-						0, nullptr);
-
-					RHIBuffer* vertex_buffers[] = { mesh.mesh_vertex_position_buffer };
-					RHIDeviceSize offsets[] = { 0 };
-					m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, vertex_buffers, offsets);
-					m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
-					uint32_t drawcall_max_instance_count = (sizeof(MeshInefficientPickPerdrawcallStorageBufferObject::model_matrices) / sizeof(MeshInefficientPickPerdrawcallStorageBufferObject::model_matrices[0]));
-					uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
-
-					for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index) {
-						uint32_t current_instance_count = ((total_instance_count - drawcall_max_instance_count * drawcall_index) < drawcall_max_instance_count) ? (total_instance_count - drawcall_max_instance_count * drawcall_index) : drawcall_max_instance_count;
-						//perdrawcall storage buffer
-						uint32_t perdrawcall_dynamic_offset = roundUp(
-							m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-							m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment
-						);
-						m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perdrawcall_dynamic_offset + sizeof(MeshInefficientPickPerdrawcallStorageBufferObject);
-
-						ASSERT(
-							m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-							(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-								m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-						);
-
-						MeshInefficientPickPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object = (*reinterpret_cast<MeshInefficientPickPerdrawcallStorageBufferObject*>(
-							reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_dynamic_offset));
-
-						for (uint32_t i = 0; i < current_instance_count; ++i) {
-							perdrawcall_storage_buffer_object.model_matrices[i] = *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-							perdrawcall_storage_buffer_object.node_ids[i] = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].node_id;
-						}
-						//per drawcall vertex blending storage buffer
-						uint32_t per_drawcall_vertex_blending_dynamic_offset;
-						if (mesh.enable_vertex_blending) {
-							per_drawcall_vertex_blending_dynamic_offset = roundUp(
-								m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-								m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment
-							);
-							m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = per_drawcall_vertex_blending_dynamic_offset + sizeof(MeshInefficientPickPerdrawcallVertexBlendingStorageBufferObject);
-
-							ASSERT(
-								m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-								(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-									m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
-							);
-
-							MeshInefficientPickPerdrawcallVertexBlendingStorageBufferObject& perdrawcall_vertex_blending_storage_buffer_object = (*reinterpret_cast<MeshInefficientPickPerdrawcallVertexBlendingStorageBufferObject*>(
-								reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + per_drawcall_vertex_blending_dynamic_offset));
-
-							for (uint32_t i = 0; i < current_instance_count; ++i) {
-								for (uint32_t j = 0; j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count; ++j) {
-									perdrawcall_vertex_blending_storage_buffer_object.joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices[j];
-								}
-							}
-						}
-						else {
-							per_drawcall_vertex_blending_dynamic_offset = 0;
+		for (const RenderDrawBatch& batch : _draw_list.getBatches()) {
+			VulkanMesh& mesh = *batch.mesh;
+			const RenderDrawInstance* mesh_nodes = _draw_list.getInstances(batch);
+			uint32_t total_instance_count = batch.instance_count;
+
+			//bind per mesh
+			m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+				RHI_PIPELINE_BIND_POINT_GRAPHICS,
+				m_render_pipelines[0].layout,
+				1, 1,
+				&mesh.mesh_vertex_blending_descriptor_set,
+				0, nullptr);
+
+			RHIBuffer* vertex_buffers[] = { mesh.mesh_vertex_position_buffer };
+			RHIDeviceSize offsets[] = { 0 };
+			m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(), 0, 1, vertex_buffers, offsets);
+			m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, mesh.mesh_index_type);
+
+			uint32_t drawcall_max_instance_count = (sizeof(MeshInefficientPickPerdrawcallStorageBufferObject::instance_indices) / sizeof(MeshInefficientPickPerdrawcallStorageBufferObject::instance_indices[0]));
+			uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
+
+			for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index) {
+				uint32_t current_instance_count = ((total_instance_count - drawcall_max_instance_count * drawcall_index) < drawcall_max_instance_count) ? (total_instance_count - drawcall_max_instance_count * drawcall_index) : drawcall_max_instance_count;
+				//perdrawcall storage buffer
+				uint32_t perdrawcall_dynamic_offset = roundUp(
+					m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+					m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment
+				);
+				m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = perdrawcall_dynamic_offset + sizeof(MeshInefficientPickPerdrawcallStorageBufferObject);
+
+				ASSERT(
+					m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
+					(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
+						m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
+				);
+
+				MeshInefficientPickPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object = (*reinterpret_cast<MeshInefficientPickPerdrawcallStorageBufferObject*>(
+					reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + perdrawcall_dynamic_offset));
+
+				for (uint32_t i = 0; i < current_instance_count; ++i) {
+					perdrawcall_storage_buffer_object.instance_indices[i] = instance_base_index + mesh_nodes[drawcall_max_instance_count * drawcall_index + i].instance_slot;
+				}
+				//per drawcall vertex blending storage buffer
+				uint32_t per_drawcall_vertex_blending_dynamic_offset;
+				if (mesh.enable_vertex_blending) {
+					per_drawcall_vertex_blending_dynamic_offset = roundUp(
+						m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+						m_global_render_resource->m_storage_buffer.m_min_storage_buffer_offset_alignment
+					);
+					m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] = per_drawcall_vertex_blending_dynamic_offset + sizeof(MeshInefficientPickPerdrawcallVertexBlendingStorageBufferObject);
+
+					ASSERT(
+						m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
+						(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
+							m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()])
+					);
+
+					MeshInefficientPickPerdrawcallVertexBlendingStorageBufferObject& perdrawcall_vertex_blending_storage_buffer_object = (*reinterpret_cast<MeshInefficientPickPerdrawcallVertexBlendingStorageBufferObject*>(
+						reinterpret_cast<uintptr_t>(m_global_render_resource->m_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + per_drawcall_vertex_blending_dynamic_offset));
+
+					for (uint32_t i = 0; i < current_instance_count; ++i) {
+						for (uint32_t j = 0; j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count; ++j) {
+							perdrawcall_vertex_blending_storage_buffer_object.joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices[j];
 						}
-						//bind perdrawcall
-						uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,perdrawcall_dynamic_offset,per_drawcall_vertex_blending_dynamic_offset };
-						m_rhi->cmdBindDescriptorSetsPFN(
-							m_rhi->getCurrentCommandBuffer(),
-							RHI_PIPELINE_BIND_POINT_GRAPHICS,
-							m_render_pipelines[0].layout,
-							0, 1,
-							&m_descriptor_infos[0].descriptor_set,
-							sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]),
-							dynamic_offsets
-						);
-
-						m_rhi->cmdDrawIndexedPFN(
-							m_rhi->getCurrentCommandBuffer(),
-							mesh.mesh_index_count,
-							current_instance_count,
-							0, 0, 0
-						);
 					}
 				}
+				else {
+					per_drawcall_vertex_blending_dynamic_offset = 0;
+				}
+				//bind perdrawcall
+				uint32_t dynamic_offsets[3] = { perframe_dynamic_offset,perdrawcall_dynamic_offset,per_drawcall_vertex_blending_dynamic_offset };
+				m_rhi->cmdBindDescriptorSetsPFN(
+					m_rhi->getCurrentCommandBuffer(),
+					RHI_PIPELINE_BIND_POINT_GRAPHICS,
+					m_render_pipelines[0].layout,
+					0, 1,
+					&m_descriptor_infos[0].descriptor_set,
+					sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]),
+					dynamic_offsets
+				);
+
+				m_rhi->cmdDrawIndexedPFN(
+					m_rhi->getCurrentCommandBuffer(),
+					mesh.mesh_index_count,
+					current_instance_count,
+					mesh.mesh_first_index,
+					mesh.mesh_first_vertex,
+					0
+				);
 			}
 		}
 		m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
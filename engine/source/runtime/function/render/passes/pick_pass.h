@@ -2,6 +2,7 @@
 
 #include "runtime/core/math/vector2.h"
 #include "runtime/function/render/render_pass.h"
+#include "runtime/function/render/render_draw_list.h"
 
 namespace Dao {
 
@@ -35,5 +36,6 @@ namespace Dao {
 		RHIDeviceMemory* _object_id_mage_memory = nullptr;
 		RHIDescriptorSetLayout* _per_mesh_layout = nullptr;
 		MeshInefficientPickPerframeStorageBufferObject _mesh_inefficient_pick_perframe_storage_buffer_object;
+		RenderDrawList _draw_list;
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "runtime/function/render/render_pass.h"
+#include "runtime/function/render/render_draw_list.h"
 
 namespace Dao {
 	
@@ -11,6 +12,9 @@ namespace Dao {
 		void initialize(const RenderPassInitInfo* init_info) override final;
 		void postInitialize() override final;
 		void preparePassData(std::shared_ptr<RenderResourceBase> render_resource) override final;
+		/// record the mesh draws into a secondary command buffer, safe to run on a job worker next to other passes
+		void recordCommandBuffer(uint32_t thread_index);
+		/// run the pass with the command buffer of recordCommandBuffer
 		void draw() override final;
 
 		void setPerMeshLayout(RHIDescriptorSetLayout* layout) { _per_mesh_layout = layout; }
@@ -22,10 +26,12 @@ namespace Dao {
 		void setupDescriptorSetLayout();
 		void setupPipelines();
 		void setupDescriptorSet();
-		void drawModel();
+		void drawModel(RHICommandBuffer* command_buffer, UploadRingbufferAllocator& upload_allocator);
 
 	private:
 		RHIDescriptorSetLayout* _per_mesh_layout;
 		MeshPointLightShadowPerframeStorageBufferObject _mesh_point_light_shadow_perframe_storage_buffer_object;
+		RenderDrawList _draw_list;
+		RHICommandBuffer* _command_buffer{ nullptr };
 	};
 }
\ No newline at end of file
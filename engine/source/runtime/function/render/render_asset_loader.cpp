@@ -0,0 +1,98 @@
+#include "runtime/function/render/render_asset_loader.h"
+
+#include "runtime/function/render/render_resource_base.h"
+#include "runtime/function/global/global_context.h"
+#include "runtime/core/base/macro.h"
+
+namespace Dao {
+
+	RenderAssetLoader::~RenderAssetLoader() {
+		clear();
+	}
+
+	void RenderAssetLoader::initialize(std::shared_ptr<RenderResourceBase> render_resource) {
+		_render_resource = render_resource;
+	}
+
+	void RenderAssetLoader::clear() {
+		//jobs reference the loader, they have to finish before it goes away
+		if (g_runtime_global_context.m_job_system) {
+			g_runtime_global_context.m_job_system->wait(_decode_counter);
+		}
+		_pending_meshes.clear();
+		_pending_materials.clear();
+		std::lock_guard<std::mutex> lock(_loaded_mutex);
+		_loaded_meshes.clear();
+		_loaded_materials.clear();
+	}
+
+	void RenderAssetLoader::requestMesh(const MeshSourceDesc& source) {
+		ASSERT(_render_resource);
+		if (!_pending_meshes.insert(source).second) {
+			return;
+		}
+		submitMeshJob(source);
+	}
+
+	void RenderAssetLoader::requestMaterial(const MaterialSourceDesc& source) {
+		ASSERT(_render_resource);
+		if (!_pending_materials.insert(source).second) {
+			return;
+		}
+		submitMaterialJob(source);
+	}
+
+	void RenderAssetLoader::submitMeshJob(const MeshSourceDesc& source) {
+		g_runtime_global_context.m_job_system->submitBackground([this, source]() {
+			LoadedMesh loaded_mesh;
+			loaded_mesh.source = source;
+			bool is_busy = false;
+			loaded_mesh.data = _render_resource->loadMeshData(source, loaded_mesh.bounding_box, &is_busy);
+			if (is_busy) {
+				submitMeshJob(source);
+				return;
+			}
+			std::lock_guard<std::mutex> lock(_loaded_mutex);
+			_loaded_meshes.push_back(std::move(loaded_mesh));
+		}, &_decode_counter);
+	}
+
+	void RenderAssetLoader::submitMaterialJob(const MaterialSourceDesc& source) {
+		g_runtime_global_context.m_job_system->submitBackground([this, source]() {
+			LoadedMaterial loaded_material;
+			loaded_material.source = source;
+			bool is_busy = false;
+			loaded_material.data = _render_resource->loadMaterialData(source, &is_busy);
+			if (is_busy) {
+				submitMaterialJob(source);
+				return;
+			}
+			std::lock_guard<std::mutex> lock(_loaded_mutex);
+			_loaded_materials.push_back(std::move(loaded_material));
+		}, &_decode_counter);
+	}
+
+	bool RenderAssetLoader::isMeshPending(const MeshSourceDesc& source) const {
+		return _pending_meshes.find(source) != _pending_meshes.end();
+	}
+
+	bool RenderAssetLoader::isMaterialPending(const MaterialSourceDesc& source) const {
+		return _pending_materials.find(source) != _pending_materials.end();
+	}
+
+	void RenderAssetLoader::collectLoadedAssets(std::vector<LoadedMesh>& out_meshes, std::vector<LoadedMaterial>& out_materials) {
+		{
+			std::lock_guard<std::mutex> lock(_loaded_mutex);
+			out_meshes.swap(_loaded_meshes);
+			out_materials.swap(_loaded_materials);
+			_loaded_meshes.clear();
+			_loaded_materials.clear();
+		}
+		for (const LoadedMesh& loaded_mesh : out_meshes) {
+			_pending_meshes.erase(loaded_mesh.source);
+		}
+		for (const LoadedMaterial& loaded_material : out_materials) {
+			_pending_materials.erase(loaded_material.source);
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "runtime/core/job/job_system.h"
+#include "runtime/core/math/axis_aligned.h"
+#include "runtime/function/render/render_type.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace Dao {
+
+	class RenderResourceBase;
+
+	/// decodes mesh and material source files as background jobs.
+	/// the render thread requests a source once and collects the decoded cpu data on a later frame,
+	/// so entities appearing for the first time do not stall rendering while files are parsed
+	class RenderAssetLoader {
+	public:
+		struct LoadedMesh {
+			MeshSourceDesc	source;
+			RenderMeshData	data;
+			AxisAlignedBox	bounding_box;
+		};
+
+		struct LoadedMaterial {
+			MaterialSourceDesc	source;
+			RenderMaterialData	data;
+		};
+
+		~RenderAssetLoader();
+
+		void initialize(std::shared_ptr<RenderResourceBase> render_resource);
+		/// wait for the decode jobs in flight and drop every result
+		void clear();
+
+		/// queue a decode job unless the source is already being decoded
+		void requestMesh(const MeshSourceDesc& source);
+		void requestMaterial(const MaterialSourceDesc& source);
+
+		/// true from the request until the decoded mesh was collected
+		bool isMeshPending(const MeshSourceDesc& source) const;
+		bool isMaterialPending(const MaterialSourceDesc& source) const;
+
+		/// move the results finished since the last call into out_meshes and out_materials
+		void collectLoadedAssets(std::vector<LoadedMesh>& out_meshes, std::vector<LoadedMaterial>& out_materials);
+
+	private:
+		//a job that finds one of its files being cooked by another job queues itself again instead of waiting
+		void submitMeshJob(const MeshSourceDesc& source);
+		void submitMaterialJob(const MaterialSourceDesc& source);
+
+	private:
+		std::shared_ptr<RenderResourceBase>		_render_resource;
+		JobCounter								_decode_counter;
+
+		//requested and not yet collected, only touched by the render thread
+		std::unordered_set<MeshSourceDesc>		_pending_meshes;
+		std::unordered_set<MaterialSourceDesc>	_pending_materials;
+
+		//written by the decode jobs
+		std::mutex								_loaded_mutex;
+		std::vector<LoadedMesh>					_loaded_meshes;
+		std::vector<LoadedMaterial>				_loaded_materials;
+	};
+}
@@ -0,0 +1,302 @@
+#include "runtime/function/render/render_bvh.h"
+
+#include "runtime/core/base/macro.h"
+
+#include <algorithm>
+
+namespace Dao {
+
+	namespace {
+		// world units added around every leaf so small movements do not touch the tree
+		constexpr float s_bvh_fat_margin = 0.1f;
+
+		BoundingBox combineBox(const BoundingBox& lhs, const BoundingBox& rhs) {
+			BoundingBox box = lhs;
+			box.merge(rhs);
+			return box;
+		}
+
+		float boxCost(const BoundingBox& box) {
+			const Vector3 size = box.max_bound - box.min_bound;
+			return size.x * size.y + size.y * size.z + size.z * size.x;
+		}
+
+		bool boxContains(const BoundingBox& outer, const BoundingBox& inner) {
+			return outer.min_bound.x <= inner.min_bound.x && outer.min_bound.y <= inner.min_bound.y && outer.min_bound.z <= inner.min_bound.z &&
+				outer.max_bound.x >= inner.max_bound.x && outer.max_bound.y >= inner.max_bound.y && outer.max_bound.z >= inner.max_bound.z;
+		}
+
+		BoundingBox fattenBox(const BoundingBox& box) {
+			const Vector3 margin(s_bvh_fat_margin, s_bvh_fat_margin, s_bvh_fat_margin);
+			return BoundingBox(box.min_bound - margin, box.max_bound + margin);
+		}
+	}
+
+	uint32_t RenderBVH::insert(const BoundingBox& box, uint32_t user_data) {
+		uint32_t leaf = allocateNode();
+		m_nodes[leaf].box = fattenBox(box);
+		m_nodes[leaf].tight_box = box;
+		m_nodes[leaf].user_data = user_data;
+		m_nodes[leaf].height = 0;
+		insertLeaf(leaf);
+		return leaf;
+	}
+
+	void RenderBVH::remove(uint32_t proxy_id) {
+		ASSERT(proxy_id < m_nodes.size() && m_nodes[proxy_id].isLeaf());
+		removeLeaf(proxy_id);
+		freeNode(proxy_id);
+	}
+
+	bool RenderBVH::update(uint32_t proxy_id, const BoundingBox& box) {
+		ASSERT(proxy_id < m_nodes.size() && m_nodes[proxy_id].isLeaf());
+		m_nodes[proxy_id].tight_box = box;
+		if (boxContains(m_nodes[proxy_id].box, box)) {
+			return false;
+		}
+		removeLeaf(proxy_id);
+		m_nodes[proxy_id].box = fattenBox(box);
+		insertLeaf(proxy_id);
+		return true;
+	}
+
+	void RenderBVH::clear() {
+		m_nodes.clear();
+		m_root = s_invalid_bvh_node;
+		m_free_list = s_invalid_bvh_node;
+	}
+
+	uint32_t RenderBVH::allocateNode() {
+		uint32_t node_id;
+		if (m_free_list != s_invalid_bvh_node) {
+			node_id = m_free_list;
+			m_free_list = m_nodes[node_id].parent;
+		}
+		else {
+			node_id = static_cast<uint32_t>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+		Node& node = m_nodes[node_id];
+		node.parent = s_invalid_bvh_node;
+		node.child_left = s_invalid_bvh_node;
+		node.child_right = s_invalid_bvh_node;
+		node.height = 0;
+		node.user_data = 0;
+		return node_id;
+	}
+
+	void RenderBVH::freeNode(uint32_t node_id) {
+		// free nodes are chained through their parent index
+		m_nodes[node_id].parent = m_free_list;
+		m_nodes[node_id].height = -1;
+		m_free_list = node_id;
+	}
+
+	void RenderBVH::insertLeaf(uint32_t leaf) {
+		if (m_root == s_invalid_bvh_node) {
+			m_root = leaf;
+			m_nodes[leaf].parent = s_invalid_bvh_node;
+			return;
+		}
+
+		// descend towards the sibling with the lowest surface area cost
+		const BoundingBox leaf_box = m_nodes[leaf].box;
+		uint32_t index = m_root;
+		while (!m_nodes[index].isLeaf()) {
+			const Node& node = m_nodes[index];
+			const float area = boxCost(node.box);
+			const float combined_area = boxCost(combineBox(node.box, leaf_box));
+
+			// cost of creating a new parent for this node and the leaf
+			const float cost = 2.0f * combined_area;
+			// minimum cost of pushing the leaf further down
+			const float inheritance_cost = 2.0f * (combined_area - area);
+
+			auto descend_cost = [&](uint32_t child) {
+				const Node& child_node = m_nodes[child];
+				const float new_area = boxCost(combineBox(child_node.box, leaf_box));
+				if (child_node.isLeaf()) {
+					return new_area + inheritance_cost;
+				}
+				return new_area - boxCost(child_node.box) + inheritance_cost;
+			};
+			const float cost_left = descend_cost(node.child_left);
+			const float cost_right = descend_cost(node.child_right);
+
+			if (cost < cost_left && cost < cost_right) {
+				break;
+			}
+			index = cost_left < cost_right ? node.child_left : node.child_right;
+		}
+
+		const uint32_t sibling = index;
+		const uint32_t old_parent = m_nodes[sibling].parent;
+		const uint32_t new_parent = allocateNode();
+		m_nodes[new_parent].parent = old_parent;
+		m_nodes[new_parent].box = combineBox(leaf_box, m_nodes[sibling].box);
+		m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+		m_nodes[new_parent].child_left = sibling;
+		m_nodes[new_parent].child_right = leaf;
+		m_nodes[sibling].parent = new_parent;
+		m_nodes[leaf].parent = new_parent;
+
+		if (old_parent != s_invalid_bvh_node) {
+			if (m_nodes[old_parent].child_left == sibling) {
+				m_nodes[old_parent].child_left = new_parent;
+			}
+			else {
+				m_nodes[old_parent].child_right = new_parent;
+			}
+		}
+		else {
+			m_root = new_parent;
+		}
+
+		refitAncestors(m_nodes[leaf].parent);
+	}
+
+	void RenderBVH::removeLeaf(uint32_t leaf) {
+		if (leaf == m_root) {
+			m_root = s_invalid_bvh_node;
+			return;
+		}
+
+		const uint32_t parent = m_nodes[leaf].parent;
+		const uint32_t grand_parent = m_nodes[parent].parent;
+		const uint32_t sibling = m_nodes[parent].child_left == leaf ? m_nodes[parent].child_right : m_nodes[parent].child_left;
+
+		if (grand_parent != s_invalid_bvh_node) {
+			if (m_nodes[grand_parent].child_left == parent) {
+				m_nodes[grand_parent].child_left = sibling;
+			}
+			else {
+				m_nodes[grand_parent].child_right = sibling;
+			}
+			m_nodes[sibling].parent = grand_parent;
+			freeNode(parent);
+			refitAncestors(grand_parent);
+		}
+		else {
+			m_root = sibling;
+			m_nodes[sibling].parent = s_invalid_bvh_node;
+			freeNode(parent);
+		}
+		m_nodes[leaf].parent = s_invalid_bvh_node;
+	}
+
+	void RenderBVH::refitAncestors(uint32_t node_id) {
+		while (node_id != s_invalid_bvh_node) {
+			node_id = balance(node_id);
+
+			Node& node = m_nodes[node_id];
+			const Node& left = m_nodes[node.child_left];
+			const Node& right = m_nodes[node.child_right];
+			node.height = 1 + std::max(left.height, right.height);
+			node.box = combineBox(left.box, right.box);
+
+			node_id = node.parent;
+		}
+	}
+
+	uint32_t RenderBVH::balance(uint32_t node_id) {
+		// rotate the taller grandchild up when the subtrees differ by more than one level
+		Node& a = m_nodes[node_id];
+		if (a.isLeaf() || a.height < 2) {
+			return node_id;
+		}
+
+		const uint32_t index_b = a.child_left;
+		const uint32_t index_c = a.child_right;
+		Node& b = m_nodes[index_b];
+		Node& c = m_nodes[index_c];
+		const int32_t height_diff = c.height - b.height;
+
+		// rotate c up
+		if (height_diff > 1) {
+			const uint32_t index_f = c.child_left;
+			const uint32_t index_g = c.child_right;
+			Node& f = m_nodes[index_f];
+			Node& g = m_nodes[index_g];
+
+			c.child_left = node_id;
+			c.parent = a.parent;
+			a.parent = index_c;
+			if (c.parent != s_invalid_bvh_node) {
+				if (m_nodes[c.parent].child_left == node_id) {
+					m_nodes[c.parent].child_left = index_c;
+				}
+				else {
+					m_nodes[c.parent].child_right = index_c;
+				}
+			}
+			else {
+				m_root = index_c;
+			}
+
+			if (f.height > g.height) {
+				c.child_right = index_f;
+				a.child_right = index_g;
+				g.parent = node_id;
+				a.box = combineBox(b.box, g.box);
+				c.box = combineBox(a.box, f.box);
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else {
+				c.child_right = index_g;
+				a.child_right = index_f;
+				f.parent = node_id;
+				a.box = combineBox(b.box, f.box);
+				c.box = combineBox(a.box, g.box);
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+			return index_c;
+		}
+
+		// rotate b up
+		if (height_diff < -1) {
+			const uint32_t index_d = b.child_left;
+			const uint32_t index_e = b.child_right;
+			Node& d = m_nodes[index_d];
+			Node& e = m_nodes[index_e];
+
+			b.child_left = node_id;
+			b.parent = a.parent;
+			a.parent = index_b;
+			if (b.parent != s_invalid_bvh_node) {
+				if (m_nodes[b.parent].child_left == node_id) {
+					m_nodes[b.parent].child_left = index_b;
+				}
+				else {
+					m_nodes[b.parent].child_right = index_b;
+				}
+			}
+			else {
+				m_root = index_b;
+			}
+
+			if (d.height > e.height) {
+				b.child_right = index_d;
+				a.child_left = index_e;
+				e.parent = node_id;
+				a.box = combineBox(c.box, e.box);
+				b.box = combineBox(a.box, d.box);
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else {
+				b.child_right = index_e;
+				a.child_left = index_d;
+				d.parent = node_id;
+				a.box = combineBox(c.box, d.box);
+				b.box = combineBox(a.box, e.box);
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+			return index_b;
+		}
+
+		return node_id;
+	}
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "runtime/function/render/render_helper.h"
+#include "runtime/core/base/macro.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Dao {
+
+	static constexpr uint32_t s_invalid_bvh_node = 0xFFFFFFFF;
+	// the traversal stack never holds more than tree height + 1 nodes, a balanced tree stays far below this
+	static constexpr uint32_t s_bvh_query_stack_size = 64;
+	// marks stack entries of subtrees that are known to be inside, node ids stay below it
+	static constexpr uint32_t s_bvh_inside_flag = 0x80000000;
+
+	/// dynamic aabb tree over world space bounds of render entities.
+	/// leaves keep the exact box plus a fattened box, moving an entity inside its fattened box costs nothing,
+	/// leaving it reinserts the leaf. the tree is kept balanced with rotations on the way up.
+	class RenderBVH {
+	public:
+		struct Node {
+			// fattened for leaves, union of the children for inner nodes
+			BoundingBox	box;
+			BoundingBox	tight_box;
+			uint32_t	parent{ s_invalid_bvh_node };
+			uint32_t	child_left{ s_invalid_bvh_node };
+			uint32_t	child_right{ s_invalid_bvh_node };
+			// -1 while the node sits in the free list
+			int32_t		height{ -1 };
+			uint32_t	user_data{ 0 };
+
+			bool isLeaf() const { return child_left == s_invalid_bvh_node; }
+		};
+
+		/// @return: proxy id, stable until remove
+		uint32_t insert(const BoundingBox& box, uint32_t user_data);
+		void remove(uint32_t proxy_id);
+		/// @return: true if the leaf had to be reinserted
+		bool update(uint32_t proxy_id, const BoundingBox& box);
+		void clear();
+
+		uint32_t getUserData(uint32_t proxy_id) const { return m_nodes[proxy_id].user_data; }
+		void setUserData(uint32_t proxy_id, uint32_t user_data) { m_nodes[proxy_id].user_data = user_data; }
+		const BoundingBox& getTightBox(uint32_t proxy_id) const { return m_nodes[proxy_id].tight_box; }
+
+		bool isEmpty() const { return m_root == s_invalid_bvh_node; }
+		/// fattened bounds of everything in the tree, only valid if not empty
+		const BoundingBox& getRootBox() const { return m_nodes[m_root].box; }
+
+		/// walk every node whose box passes box_test, visitor receives (user_data, tight_box) of leaves that pass too.
+		/// read only, safe to run concurrently with other queries
+		template<typename TBoxTest, typename TLeafVisitor>
+		void query(const TBoxTest& box_test, const TLeafVisitor& visitor) const {
+			if (m_root == s_invalid_bvh_node) {
+				return;
+			}
+			ASSERT(m_nodes[m_root].height + 1 < static_cast<int32_t>(s_bvh_query_stack_size));
+			uint32_t stack[s_bvh_query_stack_size];
+			uint32_t stack_size = 0;
+			stack[stack_size++] = m_root;
+			while (stack_size > 0) {
+				const Node& node = m_nodes[stack[--stack_size]];
+				if (!box_test(node.box)) {
+					continue;
+				}
+				if (node.isLeaf()) {
+					if (box_test(node.tight_box)) {
+						visitor(node.user_data, node.tight_box);
+					}
+				}
+				else {
+					stack[stack_size++] = node.child_left;
+					stack[stack_size++] = node.child_right;
+				}
+			}
+		}
+
+		/// like query, but box_classify(box) returns a BoxOverlap. subtrees of inside nodes are walked without further
+		/// tests and their leaves go to inside_visitor, leaves whose fattened box only intersects go to intersecting_visitor
+		/// with their tight box untested. both visitors receive (user_data, tight_box)
+		template<typename TBoxClassify, typename TInsideVisitor, typename TIntersectingVisitor>
+		void queryClassified(const TBoxClassify& box_classify, const TInsideVisitor& inside_visitor, const TIntersectingVisitor& intersecting_visitor) const {
+			if (m_root == s_invalid_bvh_node) {
+				return;
+			}
+			ASSERT(m_nodes[m_root].height + 1 < static_cast<int32_t>(s_bvh_query_stack_size));
+			ASSERT(m_nodes.size() <= s_bvh_inside_flag);
+			uint32_t stack[s_bvh_query_stack_size];
+			uint32_t stack_size = 0;
+			stack[stack_size++] = m_root;
+			while (stack_size > 0) {
+				const uint32_t entry = stack[--stack_size];
+				const Node& node = m_nodes[entry & ~s_bvh_inside_flag];
+				uint32_t inside_flag = entry & s_bvh_inside_flag;
+				if (inside_flag == 0) {
+					const BoxOverlap overlap = box_classify(node.box);
+					if (overlap == BoxOverlap::outside) {
+						continue;
+					}
+					inside_flag = overlap == BoxOverlap::inside ? s_bvh_inside_flag : 0;
+				}
+				if (node.isLeaf()) {
+					if (inside_flag != 0) {
+						inside_visitor(node.user_data, node.tight_box);
+					}
+					else {
+						intersecting_visitor(node.user_data, node.tight_box);
+					}
+				}
+				else {
+					stack[stack_size++] = node.child_left | inside_flag;
+					stack[stack_size++] = node.child_right | inside_flag;
+				}
+			}
+		}
+
+	private:
+		uint32_t allocateNode();
+		void freeNode(uint32_t node_id);
+		void insertLeaf(uint32_t leaf);
+		void removeLeaf(uint32_t leaf);
+		void refitAncestors(uint32_t node_id);
+		uint32_t balance(uint32_t node_id);
+
+	private:
+		std::vector<Node>	m_nodes;
+		uint32_t			m_root{ s_invalid_bvh_node };
+		uint32_t			m_free_list{ s_invalid_bvh_node };
+	};
+}
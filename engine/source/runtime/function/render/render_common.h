@@ -18,6 +18,10 @@ namespace Dao {
 	static constexpr uint32_t s_mesh_vertex_blending_max_joint_count = 1024;
 	static constexpr uint32_t s_max_point_light_count = 15;
 	static constexpr uint32_t s_particle_billboard_buffer_size = 4096;
+	static constexpr uint32_t s_scene_instance_max_count = 1 << 16;
+	static constexpr uint32_t s_mesh_indirect_max_instance_count = 4096;
+	static constexpr uint32_t s_mesh_pool_max_vertex_count = 1 << 20;
+	static constexpr uint32_t s_mesh_pool_max_index_count = 1 << 22;
 
 	struct VulkanSceneDirectionalLight {
 		Vector3 direction;
@@ -50,14 +54,15 @@ namespace Dao {
 
 	struct VulkanMeshInstance {
 		float enable_vertex_blending;
-		float padding_enable_vertex_blending_1;
+		uint32_t node_id;
 		float padding_enable_vertex_blending_2;
 		float padding_enable_vertex_blending_3;
 		Matrix4x4 model_matrix;
 	};
 
 	struct MeshPerdrawcallStorageBufferObject {
-		VulkanMeshInstance mesh_instances[s_mesh_per_drawcall_max_instance_count];
+		//indices into the scene instance buffer
+		uint32_t instance_indices[s_mesh_per_drawcall_max_instance_count];
 	};
 
 	struct MeshPerdrawcallVertexBlendingStorageBufferObject {
@@ -84,7 +89,7 @@ namespace Dao {
 	};
 
 	struct MeshPointLightShadowPerdrawcallStorageBufferObject {
-		VulkanMeshInstance mesh_instances[s_mesh_per_drawcall_max_instance_count];
+		uint32_t instance_indices[s_mesh_per_drawcall_max_instance_count];
 	};
 
 	struct MeshPointLightShadowPerdrawcallVertexBlendingStorageBufferObject {
@@ -96,7 +101,7 @@ namespace Dao {
 	};
 
 	struct MeshDirectionalLightShadowPerdrawcallStorageBufferObject {
-		VulkanMeshInstance mesh_instances[s_mesh_per_drawcall_max_instance_count];
+		uint32_t instance_indices[s_mesh_per_drawcall_max_instance_count];
 	};
 
 	struct MeshDirectionalLightShadowPerDrawcallVertexBlendingStorageBufferObject {
@@ -137,9 +142,7 @@ namespace Dao {
 	};
 
 	struct MeshInefficientPickPerdrawcallStorageBufferObject {
-		Matrix4x4 model_matrices[s_mesh_per_drawcall_max_instance_count];
-		uint32_t node_ids[s_mesh_per_drawcall_max_instance_count];
-		float enable_vertex_blending[s_mesh_per_drawcall_max_instance_count];
+		uint32_t instance_indices[s_mesh_per_drawcall_max_instance_count];
 	};
 
 	struct MeshInefficientPickPerdrawcallVertexBlendingStorageBufferObject {
@@ -165,9 +168,19 @@ namespace Dao {
 		VmaAllocation mesh_vertex_varying_buffer_allocation;
 
 		uint32_t mesh_index_count;
+		RHIIndexType mesh_index_type{ RHI_INDEX_TYPE_UINT16 };
 
 		RHIBuffer* mesh_index_buffer;
 		VmaAllocation mesh_index_buffer_allocation;
+
+		//static meshes share the buffers of the mesh pool, draws start at these offsets
+		bool in_mesh_pool{ false };
+		uint32_t mesh_first_vertex{ 0 };
+		uint32_t mesh_first_index{ 0 };
+
+		//buffers are filled asynchronously, the mesh is only drawn once the upload completed
+		uint64_t upload_id{ 0 };
+		bool is_ready{ false };
 	};
 
 	struct VulkanPBRMaterial {
@@ -195,6 +208,10 @@ namespace Dao {
 		VmaAllocation material_uniform_buffer_allocation;
 
 		RHIDescriptorSet* material_descriptor_set;
+
+		//textures are filled asynchronously, the default material is bound until the upload completed
+		uint64_t upload_id{ 0 };
+		bool is_ready{ false };
 	};
 
 	struct RenderMeshNode {
@@ -203,7 +220,10 @@ namespace Dao {
 		uint32_t joint_count{ 0 };
 		VulkanMesh* ref_mesh{ nullptr };
 		VulkanPBRMaterial* ref_material{ nullptr };
+		size_t mesh_asset_id{ 0 };
+		size_t material_asset_id{ 0 };
 		uint32_t node_id;
+		uint32_t instance_slot{ 0 };
 		bool enable_vertex_blending{ false };
 	};
 
@@ -219,22 +239,27 @@ namespace Dao {
 		uint32_t base_color_image_width;
 		uint32_t base_color_image_height;
 		RHIFormat base_color_image_format;
+		uint32_t base_color_image_miplevels;
 		void* metallic_roughness_image_pixels;
 		uint32_t metallic_roughness_image_width;
 		uint32_t metallic_roughness_image_height;
 		RHIFormat metallic_roughness_image_format;
+		uint32_t metallic_roughness_image_miplevels;
 		void* normal_image_pixels;
 		uint32_t normal_image_width;
 		uint32_t normal_image_height;
 		RHIFormat normal_image_format;
+		uint32_t normal_image_miplevels;
 		void* occlusion_image_pixels;
 		uint32_t occlusion_image_width;
 		uint32_t occlusion_image_height;
 		RHIFormat occlusion_image_format;
+		uint32_t occlusion_image_miplevels;
 		void* emissive_image_pixels;
 		uint32_t emissive_image_width;
 		uint32_t emissive_image_height;
 		RHIFormat emissive_image_format;
+		uint32_t emissive_image_miplevels;
 		VulkanPBRMaterial* now_material;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "runtime/function/render/render_culling.h"
+
+#include "runtime/core/math/simd.h"
+
+#include <cmath>
+
+namespace Dao {
+
+	void BoundingBoxSoA::resize(size_t count) {
+		m_center_x.resize(count);
+		m_center_y.resize(count);
+		m_center_z.resize(count);
+		m_extent_x.resize(count);
+		m_extent_y.resize(count);
+		m_extent_z.resize(count);
+	}
+
+	void BoundingBoxSoA::clear() {
+		resize(0);
+	}
+
+	void BoundingBoxSoA::set(size_t index, const BoundingBox& box) {
+		m_center_x[index] = (box.max_bound.x + box.min_bound.x) * 0.5f;
+		m_center_y[index] = (box.max_bound.y + box.min_bound.y) * 0.5f;
+		m_center_z[index] = (box.max_bound.z + box.min_bound.z) * 0.5f;
+		m_extent_x[index] = (box.max_bound.x - box.min_bound.x) * 0.5f;
+		m_extent_y[index] = (box.max_bound.y - box.min_bound.y) * 0.5f;
+		m_extent_z[index] = (box.max_bound.z - box.min_bound.z) * 0.5f;
+	}
+
+	void BoundingBoxSoA::pushBack(const BoundingBox& box) {
+		resize(size() + 1);
+		set(size() - 1, box);
+	}
+
+	void BoundingBoxSoA::moveElement(size_t src_index, size_t dst_index) {
+		m_center_x[dst_index] = m_center_x[src_index];
+		m_center_y[dst_index] = m_center_y[src_index];
+		m_center_z[dst_index] = m_center_z[src_index];
+		m_extent_x[dst_index] = m_extent_x[src_index];
+		m_extent_y[dst_index] = m_extent_y[src_index];
+		m_extent_z[dst_index] = m_extent_z[src_index];
+	}
+
+	namespace {
+		static constexpr uint32_t s_frustum_plane_count = 6;
+
+		struct CullingPlanes {
+			float a[s_frustum_plane_count];
+			float b[s_frustum_plane_count];
+			float c[s_frustum_plane_count];
+			float d[s_frustum_plane_count];
+			float abs_a[s_frustum_plane_count];
+			float abs_b[s_frustum_plane_count];
+			float abs_c[s_frustum_plane_count];
+		};
+
+		CullingPlanes makeCullingPlanes(ClusterFrustum const& frustum) {
+			const Vector4* planes[s_frustum_plane_count] = {
+				&frustum.m_plane_right,
+				&frustum.m_plane_left,
+				&frustum.m_plane_top,
+				&frustum.m_plane_bottom,
+				&frustum.m_plane_near,
+				&frustum.m_plane_far
+			};
+			CullingPlanes culling_planes;
+			for (uint32_t i = 0; i < s_frustum_plane_count; ++i) {
+				culling_planes.a[i] = planes[i]->x;
+				culling_planes.b[i] = planes[i]->y;
+				culling_planes.c[i] = planes[i]->z;
+				culling_planes.d[i] = planes[i]->w;
+				culling_planes.abs_a[i] = std::fabs(planes[i]->x);
+				culling_planes.abs_b[i] = std::fabs(planes[i]->y);
+				culling_planes.abs_c[i] = std::fabs(planes[i]->z);
+			}
+			return culling_planes;
+		}
+
+		// out has room for every tested box, returns the new write position
+		uint32_t cullScalar(const CullingPlanes& planes, const BoundingBoxSoA& boxes, uint32_t begin, uint32_t end, uint32_t* out, uint32_t out_count) {
+			for (uint32_t i = begin; i < end; ++i) {
+				bool visible = true;
+				for (uint32_t p = 0; p < s_frustum_plane_count; ++p) {
+					const float signed_distance = planes.a[p] * boxes.m_center_x[i] + planes.b[p] * boxes.m_center_y[i] + planes.c[p] * boxes.m_center_z[i] + planes.d[p];
+					const float radius = planes.abs_a[p] * boxes.m_extent_x[i] + planes.abs_b[p] * boxes.m_extent_y[i] + planes.abs_c[p] * boxes.m_extent_z[i];
+					visible = visible && (signed_distance < radius);
+				}
+				out[out_count] = i;
+				out_count += visible ? 1 : 0;
+			}
+			return out_count;
+		}
+
+#if DAO_SIMD_X86
+		uint32_t cullSSE(const CullingPlanes& planes, const BoundingBoxSoA& boxes, uint32_t begin, uint32_t end, uint32_t* out, uint32_t out_count, uint32_t& out_next) {
+			uint32_t i = begin;
+			for (; i + 4 <= end; i += 4) {
+				const __m128 center_x = _mm_loadu_ps(&boxes.m_center_x[i]);
+				const __m128 center_y = _mm_loadu_ps(&boxes.m_center_y[i]);
+				const __m128 center_z = _mm_loadu_ps(&boxes.m_center_z[i]);
+				const __m128 extent_x = _mm_loadu_ps(&boxes.m_extent_x[i]);
+				const __m128 extent_y = _mm_loadu_ps(&boxes.m_extent_y[i]);
+				const __m128 extent_z = _mm_loadu_ps(&boxes.m_extent_z[i]);
+
+				__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+				for (uint32_t p = 0; p < s_frustum_plane_count; ++p) {
+					__m128 signed_distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.a[p]), center_x), _mm_set1_ps(planes.d[p]));
+					signed_distance = _mm_add_ps(signed_distance, _mm_mul_ps(_mm_set1_ps(planes.b[p]), center_y));
+					signed_distance = _mm_add_ps(signed_distance, _mm_mul_ps(_mm_set1_ps(planes.c[p]), center_z));
+					__m128 radius = _mm_mul_ps(_mm_set1_ps(planes.abs_a[p]), extent_x);
+					radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(planes.abs_b[p]), extent_y));
+					radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(planes.abs_c[p]), extent_z));
+					visible = _mm_and_ps(visible, _mm_cmplt_ps(signed_distance, radius));
+				}
+
+				const uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(visible));
+				for (uint32_t lane = 0; lane < 4; ++lane) {
+					out[out_count] = i + lane;
+					out_count += (mask >> lane) & 1;
+				}
+			}
+			out_next = i;
+			return out_count;
+		}
+
+		DAO_TARGET_AVX2
+		uint32_t cullAVX2(const CullingPlanes& planes, const BoundingBoxSoA& boxes, uint32_t begin, uint32_t end, uint32_t* out, uint32_t out_count, uint32_t& out_next) {
+			uint32_t i = begin;
+			for (; i + 8 <= end; i += 8) {
+				const __m256 center_x = _mm256_loadu_ps(&boxes.m_center_x[i]);
+				const __m256 center_y = _mm256_loadu_ps(&boxes.m_center_y[i]);
+				const __m256 center_z = _mm256_loadu_ps(&boxes.m_center_z[i]);
+				const __m256 extent_x = _mm256_loadu_ps(&boxes.m_extent_x[i]);
+				const __m256 extent_y = _mm256_loadu_ps(&boxes.m_extent_y[i]);
+				const __m256 extent_z = _mm256_loadu_ps(&boxes.m_extent_z[i]);
+
+				__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+				for (uint32_t p = 0; p < s_frustum_plane_count; ++p) {
+					__m256 signed_distance = _mm256_fmadd_ps(_mm256_set1_ps(planes.a[p]), center_x, _mm256_set1_ps(planes.d[p]));
+					signed_distance = _mm256_fmadd_ps(_mm256_set1_ps(planes.b[p]), center_y, signed_distance);
+					signed_distance = _mm256_fmadd_ps(_mm256_set1_ps(planes.c[p]), center_z, signed_distance);
+					__m256 radius = _mm256_mul_ps(_mm256_set1_ps(planes.abs_a[p]), extent_x);
+					radius = _mm256_fmadd_ps(_mm256_set1_ps(planes.abs_b[p]), extent_y, radius);
+					radius = _mm256_fmadd_ps(_mm256_set1_ps(planes.abs_c[p]), extent_z, radius);
+					visible = _mm256_and_ps(visible, _mm256_cmp_ps(signed_distance, radius, _CMP_LT_OQ));
+				}
+
+				const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(visible));
+				for (uint32_t lane = 0; lane < 8; ++lane) {
+					out[out_count] = i + lane;
+					out_count += (mask >> lane) & 1;
+				}
+			}
+			out_next = i;
+			return out_count;
+		}
+#endif
+
+		// out has room for every tested box, returns the new write position
+		uint32_t cullRange(const CullingPlanes& planes, const BoundingBoxSoA& boxes, uint32_t begin, uint32_t end, uint32_t* out, uint32_t out_count) {
+			uint32_t next = begin;
+#if DAO_SIMD_X86
+			if (Simd::hasAVX2()) {
+				out_count = cullAVX2(planes, boxes, next, end, out, out_count, next);
+			}
+			out_count = cullSSE(planes, boxes, next, end, out, out_count, next);
+#endif
+			return cullScalar(planes, boxes, next, end, out, out_count);
+		}
+	}
+
+	BoxOverlap ClassifyBoxInFrustum(ClusterFrustum const& frustum, BoundingBox const& box) {
+		const Vector4* planes[s_frustum_plane_count] = {
+			&frustum.m_plane_right,
+			&frustum.m_plane_left,
+			&frustum.m_plane_top,
+			&frustum.m_plane_bottom,
+			&frustum.m_plane_near,
+			&frustum.m_plane_far
+		};
+		const float center_x = (box.max_bound.x + box.min_bound.x) * 0.5f;
+		const float center_y = (box.max_bound.y + box.min_bound.y) * 0.5f;
+		const float center_z = (box.max_bound.z + box.min_bound.z) * 0.5f;
+		const float extent_x = (box.max_bound.x - box.min_bound.x) * 0.5f;
+		const float extent_y = (box.max_bound.y - box.min_bound.y) * 0.5f;
+		const float extent_z = (box.max_bound.z - box.min_bound.z) * 0.5f;
+		BoxOverlap overlap = BoxOverlap::inside;
+		for (uint32_t p = 0; p < s_frustum_plane_count; ++p) {
+			const Vector4& plane = *planes[p];
+			const float signed_distance = plane.x * center_x + plane.y * center_y + plane.z * center_z + plane.w;
+			const float radius = std::fabs(plane.x) * extent_x + std::fabs(plane.y) * extent_y + std::fabs(plane.z) * extent_z;
+			if (signed_distance >= radius) {
+				return BoxOverlap::outside;
+			}
+			if (signed_distance > -radius) {
+				overlap = BoxOverlap::intersecting;
+			}
+		}
+		return overlap;
+	}
+
+	uint32_t FrustumCullBoxes(
+		ClusterFrustum const&	frustum,
+		BoundingBoxSoA const&	boxes,
+		uint32_t				begin,
+		uint32_t				end,
+		std::vector<uint32_t>&	out_visible_indices
+	) {
+		if (end <= begin) {
+			return 0;
+		}
+		const CullingPlanes planes = makeCullingPlanes(frustum);
+
+		// write branchless into a worst case sized tail and trim afterwards
+		const uint32_t first_output = static_cast<uint32_t>(out_visible_indices.size());
+		out_visible_indices.resize(first_output + (end - begin));
+		const uint32_t out_count = cullRange(planes, boxes, begin, end, out_visible_indices.data(), first_output);
+
+		out_visible_indices.resize(out_count);
+		return out_count - first_output;
+	}
+
+	uint32_t FrustumCullBoxRuns(
+		ClusterFrustum const&			frustum,
+		BoundingBoxSoA const&			boxes,
+		std::vector<uint32_t> const&	sorted_indices,
+		std::vector<uint32_t>&			out_visible_indices
+	) {
+		if (sorted_indices.empty()) {
+			return 0;
+		}
+		const CullingPlanes planes = makeCullingPlanes(frustum);
+
+		const uint32_t first_output = static_cast<uint32_t>(out_visible_indices.size());
+		out_visible_indices.resize(first_output + sorted_indices.size());
+		uint32_t* out = out_visible_indices.data();
+		uint32_t out_count = first_output;
+
+		const size_t index_count = sorted_indices.size();
+		for (size_t run_begin = 0; run_begin < index_count;) {
+			size_t run_end = run_begin + 1;
+			while (run_end < index_count && sorted_indices[run_end] == sorted_indices[run_end - 1] + 1) {
+				++run_end;
+			}
+			out_count = cullRange(planes, boxes, sorted_indices[run_begin], sorted_indices[run_end - 1] + 1, out, out_count);
+			run_begin = run_end;
+		}
+
+		out_visible_indices.resize(out_count);
+		return out_count - first_output;
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "runtime/function/render/render_helper.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Dao {
+
+	/// world space boxes stored as center/half extent streams so culling kernels can test several boxes per instruction
+	class BoundingBoxSoA {
+	public:
+		size_t size() const { return m_center_x.size(); }
+		void resize(size_t count);
+		void clear();
+
+		void set(size_t index, const BoundingBox& box);
+		void pushBack(const BoundingBox& box);
+		/// copy the box at src_index over dst_index, used for swap and pop removal
+		void moveElement(size_t src_index, size_t dst_index);
+
+		std::vector<float> m_center_x;
+		std::vector<float> m_center_y;
+		std::vector<float> m_center_z;
+		std::vector<float> m_extent_x;
+		std::vector<float> m_extent_y;
+		std::vector<float> m_extent_z;
+	};
+
+	/// classify one box with the plane rule of FrustumCullBoxes, inside means the box is behind every plane
+	BoxOverlap ClassifyBoxInFrustum(ClusterFrustum const& frustum, BoundingBox const& box);
+
+	/// test boxes [begin, end) against all six planes of the frustum, same rule as TiledFrustumIntersectBox.
+	/// indices of boxes that are inside or intersecting are appended to out_visible_indices in ascending order.
+	/// runs 8 boxes at once with avx2, 4 with sse and falls back to scalar code elsewhere
+	/// @return: number of appended indices
+	uint32_t FrustumCullBoxes(
+		ClusterFrustum const&	frustum,
+		BoundingBoxSoA const&	boxes,
+		uint32_t				begin,
+		uint32_t				end,
+		std::vector<uint32_t>&	out_visible_indices
+	);
+
+	/// FrustumCullBoxes over every run of consecutive indices in sorted_indices, which has to be ascending without duplicates.
+	/// used for the bvh leaves crossing a plane, runs are tested with the same simd kernel
+	/// @return: number of appended indices
+	uint32_t FrustumCullBoxRuns(
+		ClusterFrustum const&			frustum,
+		BoundingBoxSoA const&			boxes,
+		std::vector<uint32_t> const&	sorted_indices,
+		std::vector<uint32_t>&			out_visible_indices
+	);
+}
@@ -0,0 +1,131 @@
+#include "runtime/function/render/render_draw_list.h"
+
+#include <cstring>
+
+namespace Dao {
+
+	namespace {
+		constexpr uint32_t s_radix_bits = 8;
+		constexpr uint32_t s_radix_size = 1 << s_radix_bits;
+		constexpr uint32_t s_radix_pass_count = 64 / s_radix_bits;
+
+		uint32_t maskBits(uint64_t value, uint32_t bits) {
+			return static_cast<uint32_t>(value & ((uint64_t(1) << bits) - 1));
+		}
+
+		// the bit pattern of a non negative float grows with its value, the high half is enough to order draws
+		uint32_t quantizeDepth(float squared_distance) {
+			uint32_t bits;
+			std::memcpy(&bits, &squared_distance, sizeof(bits));
+			return bits >> (32 - RenderDrawList::s_depth_bits);
+		}
+	}
+
+	uint64_t RenderDrawList::makeSortKey(uint32_t pass, uint32_t pipeline, uint32_t material_id, uint32_t mesh_id, uint32_t depth) {
+		uint64_t key = maskBits(pass, s_pass_bits);
+		key = (key << s_pipeline_bits) | maskBits(pipeline, s_pipeline_bits);
+		key = (key << s_material_bits) | maskBits(material_id, s_material_bits);
+		key = (key << s_mesh_bits) | maskBits(mesh_id, s_mesh_bits);
+		key = (key << s_depth_bits) | maskBits(depth, s_depth_bits);
+		return key;
+	}
+
+	void RenderDrawList::build(const std::vector<RenderMeshNode>& nodes, uint32_t pass, uint32_t pipeline, const Vector3* view_position) {
+		const uint32_t node_count = static_cast<uint32_t>(nodes.size());
+		m_items.resize(node_count);
+		for (uint32_t i = 0; i < node_count; ++i) {
+			const RenderMeshNode& node = nodes[i];
+			uint32_t depth = 0;
+			if (view_position) {
+				depth = quantizeDepth(node.model_matrix->getTrans().squaredDistance(*view_position));
+			}
+			m_items[i].sort_key = makeSortKey(
+				pass, pipeline,
+				static_cast<uint32_t>(node.material_asset_id),
+				static_cast<uint32_t>(node.mesh_asset_id),
+				depth
+			);
+			m_items[i].node_index = i;
+		}
+
+		sortItems();
+
+		//asset ids are truncated in the key, so batches are split on the actual resources
+		m_instances.resize(node_count);
+		m_batches.clear();
+		for (uint32_t i = 0; i < node_count; ++i) {
+			const RenderMeshNode& node = nodes[m_items[i].node_index];
+			RenderDrawInstance& instance = m_instances[i];
+			instance.model_matrix = node.model_matrix;
+			instance.joint_matrices = node.enable_vertex_blending ? node.joint_matrices : nullptr;
+			instance.joint_count = node.enable_vertex_blending ? node.joint_count : 0;
+			instance.node_id = node.node_id;
+			instance.instance_slot = node.instance_slot;
+
+			if (m_batches.empty() || m_batches.back().material != node.ref_material || m_batches.back().mesh != node.ref_mesh) {
+				RenderDrawBatch batch;
+				batch.material = node.ref_material;
+				batch.mesh = node.ref_mesh;
+				batch.first_instance = i;
+				batch.indirect_drawable = node.ref_mesh->in_mesh_pool;
+				m_batches.push_back(batch);
+			}
+			++m_batches.back().instance_count;
+			m_batches.back().indirect_drawable &= (instance.joint_matrices == nullptr);
+		}
+	}
+
+	uint32_t RenderDrawList::getIndirectRunEnd(uint32_t first_batch, uint32_t max_instance_count, bool split_on_material) const {
+		const uint32_t batch_count = static_cast<uint32_t>(m_batches.size());
+		uint32_t run_end = first_batch;
+		uint32_t run_instance_count = 0;
+		while (run_end < batch_count) {
+			const RenderDrawBatch& batch = m_batches[run_end];
+			if (!batch.indirect_drawable || run_instance_count + batch.instance_count > max_instance_count) {
+				break;
+			}
+			if (split_on_material && batch.material != m_batches[first_batch].material) {
+				break;
+			}
+			run_instance_count += batch.instance_count;
+			++run_end;
+		}
+		return run_end;
+	}
+
+	void RenderDrawList::sortItems() {
+		const uint32_t item_count = static_cast<uint32_t>(m_items.size());
+		if (item_count < 2) {
+			return;
+		}
+
+		//lsd radix sort, stable so equal keys keep the visible order.
+		//all histograms come from one read, digits every key shares are skipped
+		uint32_t histograms[s_radix_pass_count][s_radix_size] = {};
+		for (const DrawItem& item : m_items) {
+			for (uint32_t digit = 0; digit < s_radix_pass_count; ++digit) {
+				++histograms[digit][(item.sort_key >> (digit * s_radix_bits)) & (s_radix_size - 1)];
+			}
+		}
+
+		m_sort_scratch.resize(item_count);
+		for (uint32_t digit = 0; digit < s_radix_pass_count; ++digit) {
+			uint32_t* histogram = histograms[digit];
+			const uint32_t shift = digit * s_radix_bits;
+			if (histogram[(m_items[0].sort_key >> shift) & (s_radix_size - 1)] == item_count) {
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < s_radix_size; ++bucket) {
+				uint32_t count = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += count;
+			}
+			for (const DrawItem& item : m_items) {
+				m_sort_scratch[histogram[(item.sort_key >> shift) & (s_radix_size - 1)]++] = item;
+			}
+			m_items.swap(m_sort_scratch);
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "runtime/function/render/render_common.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Dao {
+
+	enum {
+		draw_list_pass_directional_light_shadow = 0,
+		draw_list_pass_point_light_shadow,
+		draw_list_pass_main_camera,
+		draw_list_pass_pick,
+		draw_list_pass_count
+	};
+
+	struct RenderDrawInstance {
+		const Matrix4x4* model_matrix{ nullptr };
+		// null if vertex blending is disabled for the node
+		const Matrix4x4* joint_matrices{ nullptr };
+		uint32_t joint_count{ 0 };
+		uint32_t node_id{ 0 };
+		// slot of the instance in the scene instance buffer
+		uint32_t instance_slot{ 0 };
+	};
+
+	/// instances [first_instance, first_instance + instance_count) share the material and the mesh
+	struct RenderDrawBatch {
+		VulkanPBRMaterial* material{ nullptr };
+		VulkanMesh* mesh{ nullptr };
+		uint32_t first_instance{ 0 };
+		uint32_t instance_count{ 0 };
+		// the mesh lives in the mesh pool and no instance blends vertices
+		bool indirect_drawable{ false };
+	};
+
+	/// turns the visible mesh nodes of one view into instanced batches.
+	/// every node gets a 64 bit key, msb to lsb: pass(4) pipeline(4) material(20) mesh(20) depth(16),
+	/// keys are radix sorted and equal material/mesh runs become batches ordered near to far.
+	/// storage is kept between frames so building does not allocate once the capacity is reached
+	class RenderDrawList {
+	public:
+		static constexpr uint32_t s_pass_bits = 4;
+		static constexpr uint32_t s_pipeline_bits = 4;
+		static constexpr uint32_t s_material_bits = 20;
+		static constexpr uint32_t s_mesh_bits = 20;
+		static constexpr uint32_t s_depth_bits = 16;
+
+		static uint64_t makeSortKey(uint32_t pass, uint32_t pipeline, uint32_t material_id, uint32_t mesh_id, uint32_t depth);
+
+		/// @param view_position: nodes are sorted by distance to it inside a batch, nullptr keeps the visible order
+		void build(
+			const std::vector<RenderMeshNode>&	nodes,
+			uint32_t							pass,
+			uint32_t							pipeline,
+			const Vector3*						view_position = nullptr
+		);
+
+		const std::vector<RenderDrawBatch>& getBatches() const { return m_batches; }
+		const RenderDrawInstance* getInstances(const RenderDrawBatch& batch) const { return m_instances.data() + batch.first_instance; }
+
+		/// end of the batches from first_batch on that one indirect draw can cover, they are indirect drawable,
+		/// hold at most max_instance_count instances together and share the material if split_on_material is set
+		/// @return: first_batch if the batch has to be drawn directly
+		uint32_t getIndirectRunEnd(uint32_t first_batch, uint32_t max_instance_count, bool split_on_material) const;
+
+	private:
+		struct DrawItem {
+			uint64_t sort_key;
+			uint32_t node_index;
+		};
+
+		void sortItems();
+
+	private:
+		std::vector<DrawItem>			m_items;
+		std::vector<DrawItem>			m_sort_scratch;
+		std::vector<RenderDrawInstance>	m_instances;
+		std::vector<RenderDrawBatch>	m_batches;
+	};
+}
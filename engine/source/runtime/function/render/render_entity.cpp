@@ -0,0 +1,122 @@
+#include "runtime/function/render/render_entity.h"
+
+#include <algorithm>
+
+namespace Dao {
+
+	void RenderEntityStorage::pushBack(const RenderEntity& entity) {
+		m_instance_ids.push_back(entity.m_instance_id);
+		m_model_matrices.push_back(entity.m_model_matrix);
+		m_mesh_asset_ids.push_back(entity.m_mesh_asset_id);
+		m_material_asset_ids.push_back(entity.m_material_asset_id);
+		m_enable_vertex_blending.push_back(entity.m_enable_vertex_blending ? 1 : 0);
+		m_joint_palette_ids.push_back(s_invalid_joint_palette_id);
+	}
+
+	void RenderEntityStorage::set(uint32_t index, const RenderEntity& entity) {
+		m_instance_ids[index] = entity.m_instance_id;
+		m_model_matrices[index] = entity.m_model_matrix;
+		m_mesh_asset_ids[index] = entity.m_mesh_asset_id;
+		m_material_asset_ids[index] = entity.m_material_asset_id;
+		m_enable_vertex_blending[index] = entity.m_enable_vertex_blending ? 1 : 0;
+	}
+
+	void RenderEntityStorage::removeSwapBack(uint32_t index) {
+		uint32_t last_index = static_cast<uint32_t>(size()) - 1;
+		if (index != last_index) {
+			m_instance_ids[index] = m_instance_ids[last_index];
+			m_model_matrices[index] = m_model_matrices[last_index];
+			m_mesh_asset_ids[index] = m_mesh_asset_ids[last_index];
+			m_material_asset_ids[index] = m_material_asset_ids[last_index];
+			m_enable_vertex_blending[index] = m_enable_vertex_blending[last_index];
+			m_joint_palette_ids[index] = m_joint_palette_ids[last_index];
+		}
+		m_instance_ids.pop_back();
+		m_model_matrices.pop_back();
+		m_mesh_asset_ids.pop_back();
+		m_material_asset_ids.pop_back();
+		m_enable_vertex_blending.pop_back();
+		m_joint_palette_ids.pop_back();
+	}
+
+	void RenderEntityStorage::clear() {
+		m_instance_ids.clear();
+		m_model_matrices.clear();
+		m_mesh_asset_ids.clear();
+		m_material_asset_ids.clear();
+		m_enable_vertex_blending.clear();
+		m_joint_palette_ids.clear();
+		m_joint_palettes.clear();
+		m_free_joint_palette_ids.clear();
+		m_joint_palette_pool.clear();
+		m_released_joint_count = 0;
+	}
+
+	const Matrix4x4* RenderEntityStorage::getJointMatrices(uint32_t index) const {
+		const uint32_t palette_id = m_joint_palette_ids[index];
+		if (palette_id == s_invalid_joint_palette_id || m_joint_palettes[palette_id].m_count == 0) {
+			return nullptr;
+		}
+		return m_joint_palette_pool.data() + m_joint_palettes[palette_id].m_offset;
+	}
+
+	uint32_t RenderEntityStorage::getJointCount(uint32_t index) const {
+		const uint32_t palette_id = m_joint_palette_ids[index];
+		return palette_id != s_invalid_joint_palette_id ? m_joint_palettes[palette_id].m_count : 0;
+	}
+
+	uint32_t RenderEntityStorage::createJointPalette() {
+		if (!m_free_joint_palette_ids.empty()) {
+			const uint32_t palette_id = m_free_joint_palette_ids.back();
+			m_free_joint_palette_ids.pop_back();
+			return palette_id;
+		}
+		m_joint_palettes.emplace_back();
+		return static_cast<uint32_t>(m_joint_palettes.size()) - 1;
+	}
+
+	void RenderEntityStorage::destroyJointPalette(uint32_t palette_id) {
+		releaseJointRange(m_joint_palettes[palette_id]);
+		m_free_joint_palette_ids.push_back(palette_id);
+		if (m_free_joint_palette_ids.size() == m_joint_palettes.size()) {
+			m_joint_palettes.clear();
+			m_free_joint_palette_ids.clear();
+			m_joint_palette_pool.clear();
+			m_released_joint_count = 0;
+		}
+	}
+
+	Matrix4x4* RenderEntityStorage::resizeJointPalette(uint32_t palette_id, uint32_t joint_count) {
+		RenderJointPaletteRange& range = m_joint_palettes[palette_id];
+		//animated objects keep their skeleton, so the palette is almost always rewritten in place
+		if (range.m_count != joint_count) {
+			releaseJointRange(range);
+			range.m_offset = static_cast<uint32_t>(m_joint_palette_pool.size());
+			range.m_count = joint_count;
+			m_joint_palette_pool.resize(m_joint_palette_pool.size() + joint_count);
+
+			if (m_released_joint_count > 1024 && m_released_joint_count * 2 > m_joint_palette_pool.size()) {
+				compactJointPalettes();
+			}
+		}
+		return range.m_count > 0 ? m_joint_palette_pool.data() + range.m_offset : nullptr;
+	}
+
+	void RenderEntityStorage::releaseJointRange(RenderJointPaletteRange& range) {
+		m_released_joint_count += range.m_count;
+		range.m_offset = 0;
+		range.m_count = 0;
+	}
+
+	void RenderEntityStorage::compactJointPalettes() {
+		std::vector<Matrix4x4> compacted_pool;
+		compacted_pool.reserve(m_joint_palette_pool.size() - m_released_joint_count);
+		for (RenderJointPaletteRange& range : m_joint_palettes) {
+			uint32_t new_offset = static_cast<uint32_t>(compacted_pool.size());
+			compacted_pool.insert(compacted_pool.end(), m_joint_palette_pool.begin() + range.m_offset, m_joint_palette_pool.begin() + range.m_offset + range.m_count);
+			range.m_offset = new_offset;
+		}
+		m_joint_palette_pool.swap(compacted_pool);
+		m_released_joint_count = 0;
+	}
+}
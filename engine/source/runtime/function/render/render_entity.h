@@ -15,7 +15,6 @@ namespace Dao {
 		//mesh
 		size_t m_mesh_asset_id{ 0 };
 		bool m_enable_vertex_blending{ false };
-		std::vector<Matrix4x4> m_joint_matrices;
 		AxisAlignedBox m_bounding_box;
 		//material
 		size_t m_material_asset_id{ 0 };
@@ -28,4 +27,63 @@ namespace Dao {
 		float m_occlusion_strength{ 1.0f };
 		Vector3 m_emissive_factor{ 0.0f,0.0f,0.0f };
 	};
-}
\ No newline at end of file
+
+	struct RenderJointPaletteRange {
+		uint32_t m_offset{ 0 };
+		uint32_t m_count{ 0 };
+	};
+
+	static constexpr uint32_t s_invalid_joint_palette_id = 0xFFFFFFFF;
+
+	/// dense structure of arrays storage for the render entities of a scene.
+	/// culling and draw building only walk the hot streams (instance id, transform, mesh, material),
+	/// skinning palettes are packed into one shared pool and referenced by id, so every part of a skinned
+	/// object reads the same palette. material factors are only needed when the material is uploaded and are not kept here
+	class RenderEntityStorage {
+	public:
+		size_t size() const { return m_instance_ids.size(); }
+		bool empty() const { return m_instance_ids.empty(); }
+
+		/// the entity starts without joints, a palette is attached through setJointPalette
+		void pushBack(const RenderEntity& entity);
+		/// keeps the joint palette of the entity
+		void set(uint32_t index, const RenderEntity& entity);
+		/// the last entity is moved into index, then the last slot is dropped
+		void removeSwapBack(uint32_t index);
+		/// drops the entities and the palettes
+		void clear();
+
+		/// @return: nullptr for entities without palette or with an empty one
+		const Matrix4x4* getJointMatrices(uint32_t index) const;
+		uint32_t getJointCount(uint32_t index) const;
+		/// palette_id may be s_invalid_joint_palette_id to detach the palette
+		void setJointPalette(uint32_t index, uint32_t palette_id) { m_joint_palette_ids[index] = palette_id; }
+
+		/// @return: id of a new empty palette, valid until destroyJointPalette
+		uint32_t createJointPalette();
+		void destroyJointPalette(uint32_t palette_id);
+		/// resize the palette, its range is reused while the joint count stays the same
+		/// @return: the joint_count matrices of the palette for the caller to fill, nullptr for 0 joints.
+		/// the pointer is invalidated by the next resize
+		Matrix4x4* resizeJointPalette(uint32_t palette_id, uint32_t joint_count);
+
+		std::vector<uint32_t>					m_instance_ids;
+		std::vector<Matrix4x4>					m_model_matrices;
+		std::vector<size_t>						m_mesh_asset_ids;
+		std::vector<size_t>						m_material_asset_ids;
+		std::vector<uint8_t>					m_enable_vertex_blending;
+		std::vector<uint32_t>					m_joint_palette_ids;
+
+	private:
+		void releaseJointRange(RenderJointPaletteRange& range);
+		void compactJointPalettes();
+
+	private:
+		// range of every palette id, destroyed ids keep an empty range and wait in the free list
+		std::vector<RenderJointPaletteRange>	m_joint_palettes;
+		std::vector<uint32_t>					m_free_joint_palette_ids;
+		std::vector<Matrix4x4>					m_joint_palette_pool;
+		// matrices in the pool no range points to anymore
+		uint32_t								m_released_joint_count{ 0 };
+	};
+}
@@ -1,38 +1,63 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 namespace Dao {
 	static const size_t s_invalid_guid = 0;
 
+	/// guids are generational handles packed into 32 bits so they can double as gpu instance ids:
+	/// the low bits hold slot index + 1 (never 0), the high bits the slot generation.
+	/// freed slots are recycled through a free list with a bumped generation, so stale guids stop resolving
 	template<typename T>
 	class GuidAllocator {
 	public:
-		static bool isValidGuid(size_t guid) { 
+		static constexpr size_t s_guid_index_bits = 24;
+		static constexpr size_t s_guid_index_mask = (size_t(1) << s_guid_index_bits) - 1;
+		static constexpr size_t s_guid_generation_mask = 0xFF;
+
+		static bool isValidGuid(size_t guid) {
 			return guid != s_invalid_guid;
 		}
 
+		/// dense slot index of a guid, stays below the number of slots ever allocated
+		static size_t getGuidIndex(size_t guid) {
+			return (guid & s_guid_index_mask) - 1;
+		}
+
 		size_t allocGuid(const T& t) {
 			auto find_it = _elements_guid_map.find(t);
 			if (find_it != _elements_guid_map.end()) {
 				return find_it->second;
 			}
-			for (size_t i = 0; i <= _guid_elements_map.size(); ++i) {
-				size_t guid = i + 1;
-				if (_guid_elements_map.find(guid) == _guid_elements_map.end()) {
-					_guid_elements_map.insert(std::make_pair(guid, t));
-					_elements_guid_map.insert(std::make_pair(t, guid));
-					return guid;
+
+			size_t index;
+			if (!_free_slots.empty()) {
+				index = _free_slots.back();
+				_free_slots.pop_back();
+			}
+			else {
+				index = _slots.size();
+				if (index + 1 > s_guid_index_mask) {
+					return s_invalid_guid;
 				}
+				_slots.emplace_back();
 			}
-			return s_invalid_guid;
-		}
 
+			Slot& slot = _slots[index];
+			slot.element = t;
+			slot.guid = makeGuid(index, slot.generation);
+			_elements_guid_map.insert(std::make_pair(t, slot.guid));
+			return slot.guid;
+		}
 
 		bool getGuidRelatedElement(size_t guid, T& t) {
-			auto find_it = _guid_elements_map.find(guid);
-			if (find_it != _guid_elements_map.end()) {
-				t = find_it->second;
+			const Slot* slot = findSlot(guid);
+			if (slot) {
+				t = slot->element;
 				return true;
 			}
 			return false;
@@ -52,38 +77,70 @@ namespace Dao {
 		}
 
 		void freeGuid(size_t guid) {
-			auto find_it = _guid_elements_map.find(guid);
-			if (find_it != _guid_elements_map.end()) {
-				const auto& element = find_it->second;
-				_elements_guid_map.erase(element);
-				_guid_elements_map.erase(guid);
+			Slot* slot = findSlot(guid);
+			if (slot) {
+				_elements_guid_map.erase(slot->element);
+				slot->element = T();
+				slot->guid = s_invalid_guid;
+				slot->generation = (slot->generation + 1) & s_guid_generation_mask;
+				_free_slots.push_back(getGuidIndex(guid));
 			}
 		}
 
 		void freeElement(const T& t) {
 			auto find_it = _elements_guid_map.find(t);
 			if (find_it != _elements_guid_map.end()) {
-				const auto& guid = find_it->second;
-				_guid_elements_map.erase(guid);
-				_elements_guid_map.erase(t);
+				freeGuid(find_it->second);
 			}
 		}
 
 		std::vector<size_t> getAllocatedGuids() const {
 			std::vector<size_t> allocated_guids;
-			for (const auto& entry : _guid_elements_map) {
-				allocated_guids.push_back(entry.first);
+			for (const Slot& slot : _slots) {
+				if (isValidGuid(slot.guid)) {
+					allocated_guids.push_back(slot.guid);
+				}
 			}
 			return allocated_guids;
 		}
 
 		void clear() {
 			_elements_guid_map.clear();
-			_guid_elements_map.clear();
+			_slots.clear();
+			_free_slots.clear();
+		}
+
+	private:
+		struct Slot {
+			T		element{};
+			// s_invalid_guid while the slot is free
+			size_t	guid{ s_invalid_guid };
+			size_t	generation{ 0 };
+		};
+
+		static size_t makeGuid(size_t index, size_t generation) {
+			assert(index + 1 <= s_guid_index_mask);
+			return ((generation & s_guid_generation_mask) << s_guid_index_bits) | (index + 1);
+		}
+
+		const Slot* findSlot(size_t guid) const {
+			if (!isValidGuid(guid) || (guid & s_guid_index_mask) == 0) {
+				return nullptr;
+			}
+			size_t index = getGuidIndex(guid);
+			if (index < _slots.size() && _slots[index].guid == guid) {
+				return &_slots[index];
+			}
+			return nullptr;
+		}
+
+		Slot* findSlot(size_t guid) {
+			return const_cast<Slot*>(static_cast<const GuidAllocator*>(this)->findSlot(guid));
 		}
 
 	private:
-		std::unordered_map<T, size_t> _elements_guid_map;
-		std::unordered_map<size_t, T> _guid_elements_map;
+		std::unordered_map<T, size_t>	_elements_guid_map;
+		std::vector<Slot>				_slots;
+		std::vector<size_t>				_free_slots;
 	};
-}
\ No newline at end of file
+}
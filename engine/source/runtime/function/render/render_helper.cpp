@@ -295,13 +295,11 @@ namespace Dao {
             scene_bounding_box.min_bound = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
             scene_bounding_box.max_bound = Vector3(FLT_MIN, FLT_MIN, FLT_MIN);
 
-            for (const RenderEntity& entity : scene.m_render_entities)
+            // the scene bvh already holds the union of all world space entity bounds
+            BoundingBox entities_bounding_box;
+            if (scene.getSceneBoundingBox(entities_bounding_box))
             {
-                BoundingBox mesh_asset_bounding_box{ entity.m_bounding_box.getMinCorner(),
-                                                     entity.m_bounding_box.getMaxCorner() };
-
-                BoundingBox mesh_bounding_box_world = BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix);
-                scene_bounding_box.merge(mesh_bounding_box_world);
+                scene_bounding_box.merge(entities_bounding_box);
             }
         }
 
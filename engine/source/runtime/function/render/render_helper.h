@@ -55,6 +55,13 @@ namespace Dao {
         }
     };
 
+    // where a box lies relative to a volume, lets hierarchical queries accept whole subtrees
+    enum class BoxOverlap : uint8_t {
+        outside,
+        intersecting,
+        inside
+    };
+
     struct BoundingSphere {
         Vector3   m_center;
         float     m_radius;
@@ -0,0 +1,53 @@
+#include "runtime/function/render/render_instance_buffer.h"
+
+#include "runtime/function/render/interface/rhi.h"
+#include "runtime/core/base/macro.h"
+
+namespace Dao {
+
+	void RenderInstanceBuffer::initialize(std::shared_ptr<RHI> rhi, uint32_t frames_in_flight) {
+		ASSERT(frames_in_flight <= 8);
+		m_frames_in_flight = frames_in_flight;
+		m_pending_slots.resize(frames_in_flight);
+
+		rhi->createBuffer(
+			getBufferSize(), RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			m_buffer, m_buffer_memory
+		);
+		void* mapped_memory = nullptr;
+		rhi->mapMemory(m_buffer_memory, 0, RHI_WHOLE_SIZE, 0, &mapped_memory);
+		m_mapped_instances = static_cast<VulkanMeshInstance*>(mapped_memory);
+	}
+
+	void RenderInstanceBuffer::setInstance(uint32_t instance_slot, const VulkanMeshInstance& instance) {
+		if (instance_slot >= s_scene_instance_max_count) {
+			LOG_ERROR("instance slot {} exceeds the scene instance buffer capacity", instance_slot);
+			return;
+		}
+		if (instance_slot >= m_instances.size()) {
+			m_instances.resize(instance_slot + 1);
+			m_pending_region_masks.resize(instance_slot + 1, 0);
+		}
+		m_instances[instance_slot] = instance;
+
+		const uint8_t all_regions_mask = static_cast<uint8_t>((1u << m_frames_in_flight) - 1);
+		uint8_t& pending_mask = m_pending_region_masks[instance_slot];
+		for (uint32_t region = 0; region < m_frames_in_flight; ++region) {
+			if (!(pending_mask & (1u << region))) {
+				m_pending_slots[region].push_back(instance_slot);
+			}
+		}
+		pending_mask = all_regions_mask;
+	}
+
+	void RenderInstanceBuffer::flush(uint32_t frame_index) {
+		std::vector<uint32_t>& pending_slots = m_pending_slots[frame_index];
+		VulkanMeshInstance* region_instances = m_mapped_instances + getFrameBaseIndex(frame_index);
+		for (uint32_t instance_slot : pending_slots) {
+			region_instances[instance_slot] = m_instances[instance_slot];
+			m_pending_region_masks[instance_slot] &= static_cast<uint8_t>(~(1u << frame_index));
+		}
+		pending_slots.clear();
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "runtime/function/render/render_common.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Dao {
+
+	class RHI;
+
+	/// persistent gpu copy of the per instance data, indexed by the instance slot (guid index of the instance id).
+	/// the buffer holds one region per frame in flight, a changed instance is written once into every region
+	/// right before the frame owning that region is recorded, so static instances cost nothing per frame.
+	/// passes only upload the global index (region base + slot) of every drawn instance
+	class RenderInstanceBuffer {
+	public:
+		void initialize(std::shared_ptr<RHI> rhi, uint32_t frames_in_flight);
+
+		void setInstance(uint32_t instance_slot, const VulkanMeshInstance& instance);
+		/// write the instances changed since the region of frame_index was last used, the frame fence must be signaled
+		void flush(uint32_t frame_index);
+
+		uint32_t getFrameBaseIndex(uint32_t frame_index) const { return frame_index * s_scene_instance_max_count; }
+		RHIBuffer* getBuffer() const { return m_buffer; }
+		uint64_t getBufferSize() const { return uint64_t(sizeof(VulkanMeshInstance)) * s_scene_instance_max_count * m_frames_in_flight; }
+
+	private:
+		RHIBuffer*			m_buffer{ nullptr };
+		RHIDeviceMemory*	m_buffer_memory{ nullptr };
+		VulkanMeshInstance* m_mapped_instances{ nullptr };
+		uint32_t			m_frames_in_flight{ 0 };
+
+		//latest data of every slot
+		std::vector<VulkanMeshInstance>		m_instances;
+		//per slot, one bit for every region that still has to receive the latest data
+		std::vector<uint8_t>				m_pending_region_masks;
+		std::vector<std::vector<uint32_t>>	m_pending_slots;
+	};
+}
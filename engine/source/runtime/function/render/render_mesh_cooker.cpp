@@ -0,0 +1,110 @@
+#include "runtime/function/render/render_mesh_cooker.h"
+
+#include "runtime/platform/file_system/cooked_file.h"
+#include "runtime/platform/file_system/mapped_file.h"
+#include "runtime/core/base/macro.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace Dao {
+
+	namespace {
+		uint64_t alignStreamOffset(uint64_t offset) {
+			return (offset + RenderMeshCooker::s_stream_alignment - 1) & ~(RenderMeshCooker::s_stream_alignment - 1);
+		}
+
+		bool isStreamInFile(uint64_t offset, uint64_t size, size_t file_size) {
+			return offset % RenderMeshCooker::s_stream_alignment == 0 && offset <= file_size && size <= file_size - offset;
+		}
+	}
+
+	std::filesystem::path RenderMeshCooker::getCookedPath(const std::filesystem::path& source_path) {
+		std::filesystem::path cooked_path = source_path;
+		cooked_path += ".dmesh";
+		return cooked_path;
+	}
+
+	bool RenderMeshCooker::cook(const std::filesystem::path& cooked_path, int64_t source_write_time, const RenderMeshData& mesh_data, const AxisAlignedBox& bounding_box) {
+		const std::shared_ptr<BufferData>& vertex_buffer = mesh_data.m_static_mesh_data.m_vertex_buffer;
+		const std::shared_ptr<BufferData>& index_buffer = mesh_data.m_static_mesh_data.m_index_buffer;
+		const std::shared_ptr<BufferData>& skeleton_binding_buffer = mesh_data.m_skeleton_binding_buffer;
+		if (!vertex_buffer || !index_buffer) {
+			return false;
+		}
+
+		CookedMeshHeader header{};
+		header.magic = s_magic;
+		header.version = s_version;
+		header.source_write_time = source_write_time;
+		header.vertex_count = static_cast<uint32_t>(vertex_buffer->m_size / sizeof(MeshVertexDataDefinition));
+		header.index_stride = getIndexStride(mesh_data.m_static_mesh_data.m_index_type);
+		header.index_count = static_cast<uint32_t>(index_buffer->m_size / header.index_stride);
+		header.has_skeleton_binding = skeleton_binding_buffer ? 1 : 0;
+		header.skeleton_binding_count = skeleton_binding_buffer ? static_cast<uint32_t>(skeleton_binding_buffer->m_size / sizeof(MeshVertexBindingDataDefinition)) : 0;
+		if (header.vertex_count > 0) {
+			header.bounding_box_min[0] = bounding_box.getMinCorner().x;
+			header.bounding_box_min[1] = bounding_box.getMinCorner().y;
+			header.bounding_box_min[2] = bounding_box.getMinCorner().z;
+			header.bounding_box_max[0] = bounding_box.getMaxCorner().x;
+			header.bounding_box_max[1] = bounding_box.getMaxCorner().y;
+			header.bounding_box_max[2] = bounding_box.getMaxCorner().z;
+		}
+
+		const uint64_t vertex_size = uint64_t(header.vertex_count) * sizeof(MeshVertexDataDefinition);
+		const uint64_t index_size = uint64_t(header.index_count) * header.index_stride;
+		const uint64_t skeleton_binding_size = uint64_t(header.skeleton_binding_count) * sizeof(MeshVertexBindingDataDefinition);
+		header.vertex_offset = alignStreamOffset(sizeof(CookedMeshHeader));
+		header.index_offset = alignStreamOffset(header.vertex_offset + vertex_size);
+		header.skeleton_binding_offset = alignStreamOffset(header.index_offset + index_size);
+
+		std::vector<CookedFileChunk> chunks{
+			{ 0, &header, sizeof(header) },
+			{ header.vertex_offset, vertex_buffer->m_data, vertex_size },
+			{ header.index_offset, index_buffer->m_data, index_size }
+		};
+		if (skeleton_binding_size > 0) {
+			chunks.push_back({ header.skeleton_binding_offset, skeleton_binding_buffer->m_data, skeleton_binding_size });
+		}
+		return WriteCookedFile(cooked_path, chunks);
+	}
+
+	bool RenderMeshCooker::load(const std::filesystem::path& cooked_path, int64_t source_write_time, RenderMeshData& out_mesh_data, AxisAlignedBox& out_bounding_box) {
+		std::shared_ptr<MappedFile> mapped_file = std::make_shared<MappedFile>();
+		if (!mapped_file->open(cooked_path) || mapped_file->size() < sizeof(CookedMeshHeader)) {
+			return false;
+		}
+
+		CookedMeshHeader header;
+		memcpy(&header, mapped_file->data(), sizeof(header));
+		if (header.magic != s_magic || header.version != s_version || header.source_write_time != source_write_time ||
+			(header.index_stride != sizeof(uint16_t) && header.index_stride != sizeof(uint32_t))) {
+			return false;
+		}
+		const uint64_t vertex_size = uint64_t(header.vertex_count) * sizeof(MeshVertexDataDefinition);
+		const uint64_t index_size = uint64_t(header.index_count) * header.index_stride;
+		const uint64_t skeleton_binding_size = uint64_t(header.skeleton_binding_count) * sizeof(MeshVertexBindingDataDefinition);
+		if (!isStreamInFile(header.vertex_offset, vertex_size, mapped_file->size()) ||
+			!isStreamInFile(header.index_offset, index_size, mapped_file->size()) ||
+			!isStreamInFile(header.skeleton_binding_offset, skeleton_binding_size, mapped_file->size())) {
+			LOG_WARN("cooked mesh {} is truncated", cooked_path.generic_string());
+			return false;
+		}
+
+		//the buffers alias the mapping, the consumers only read from them
+		uint8_t* base = static_cast<uint8_t*>(const_cast<void*>(mapped_file->data()));
+		out_mesh_data.m_static_mesh_data.m_vertex_buffer = std::make_shared<BufferData>(base + header.vertex_offset, static_cast<size_t>(vertex_size), mapped_file);
+		out_mesh_data.m_static_mesh_data.m_index_buffer = std::make_shared<BufferData>(base + header.index_offset, static_cast<size_t>(index_size), mapped_file);
+		out_mesh_data.m_static_mesh_data.m_index_type = header.index_stride == sizeof(uint32_t) ? RHI_INDEX_TYPE_UINT32 : RHI_INDEX_TYPE_UINT16;
+		if (header.has_skeleton_binding) {
+			out_mesh_data.m_skeleton_binding_buffer = std::make_shared<BufferData>(base + header.skeleton_binding_offset, static_cast<size_t>(skeleton_binding_size), mapped_file);
+		}
+
+		if (header.vertex_count > 0) {
+			out_bounding_box.merge(Vector3(header.bounding_box_min[0], header.bounding_box_min[1], header.bounding_box_min[2]));
+			out_bounding_box.merge(Vector3(header.bounding_box_max[0], header.bounding_box_max[1], header.bounding_box_max[2]));
+		}
+		return true;
+	}
+}
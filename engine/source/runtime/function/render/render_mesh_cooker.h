@@ -0,0 +1,58 @@
+#pragma once
+
+#include "runtime/core/math/axis_aligned.h"
+#include "runtime/function/render/render_type.h"
+
+#include <cstdint>
+#include <filesystem>
+
+namespace Dao {
+
+	/// layout of a cooked mesh file, every stream starts at an offset aligned to s_stream_alignment.
+	/// the streams are stored in the layout updateMeshData consumes, so loading only maps the file
+	struct CookedMeshHeader {
+		uint32_t	magic;
+		uint32_t	version;
+		//last write time of the source file the mesh was cooked from
+		int64_t		source_write_time;
+		uint32_t	vertex_count;
+		uint32_t	index_count;
+		//2 or 4 bytes, the same as the index type of the mesh
+		uint32_t	index_stride;
+		//0 for meshes without skin, the skin binding stream holds one entry per vertex
+		uint32_t	has_skeleton_binding;
+		uint32_t	skeleton_binding_count;
+		uint32_t	reserved;
+		float		bounding_box_min[3];
+		float		bounding_box_max[3];
+		uint64_t	vertex_offset;
+		uint64_t	index_offset;
+		uint64_t	skeleton_binding_offset;
+	};
+
+	/// versioned binary container for mesh data, cooked once from the .obj/.json source and memory mapped afterwards
+	class RenderMeshCooker {
+	public:
+		static constexpr uint32_t s_magic = 0x48534D44; //"DMSH"
+		static constexpr uint32_t s_version = 2;
+		static constexpr uint64_t s_stream_alignment = 16;
+
+		/// the cooked file lives next to its source
+		static std::filesystem::path getCookedPath(const std::filesystem::path& source_path);
+
+		static bool cook(
+			const std::filesystem::path&	cooked_path,
+			int64_t							source_write_time,
+			const RenderMeshData&			mesh_data,
+			const AxisAlignedBox&			bounding_box
+		);
+		/// map a cooked file, the buffers of out_mesh_data point into the mapping and keep it alive.
+		/// fails for missing files, other versions and files cooked from a different source write time
+		static bool load(
+			const std::filesystem::path&	cooked_path,
+			int64_t							source_write_time,
+			RenderMeshData&					out_mesh_data,
+			AxisAlignedBox&					out_bounding_box
+		);
+	};
+}
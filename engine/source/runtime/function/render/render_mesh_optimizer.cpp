@@ -0,0 +1,199 @@
+#include "runtime/function/render/render_mesh_optimizer.h"
+
+#include "runtime/core/base/hash.h"
+#include "runtime/core/math/vector3.h"
+
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace Dao {
+
+	namespace {
+		//the part of a vertex that decides whether two vertices can be merged
+		struct WeldKey {
+			float values[8];
+
+			bool operator==(const WeldKey& rhs) const { return memcmp(values, rhs.values, sizeof(values)) == 0; }
+		};
+
+		struct WeldKeyHash {
+			size_t operator()(const WeldKey& key) const {
+				size_t hash = 0;
+				for (float value : key.values) {
+					uint32_t bits;
+					memcpy(&bits, &value, sizeof(bits));
+					hash_combine(hash, bits);
+				}
+				return hash;
+			}
+		};
+
+		WeldKey makeWeldKey(const MeshVertexDataDefinition& vertex) {
+			//+0.0f turns -0.0f into 0.0f so both weld together
+			return WeldKey{ {
+				vertex.x + 0.0f, vertex.y + 0.0f, vertex.z + 0.0f,
+				vertex.nx + 0.0f, vertex.ny + 0.0f, vertex.nz + 0.0f,
+				vertex.u + 0.0f, vertex.v + 0.0f
+			} };
+		}
+
+		static constexpr uint32_t s_invalid_vertex = std::numeric_limits<uint32_t>::max();
+	}
+
+	void WeldMeshVertices(const std::vector<MeshVertexDataDefinition>& vertices, std::vector<MeshVertexDataDefinition>& out_vertices, std::vector<uint32_t>& out_indices) {
+		out_vertices.clear();
+		out_indices.resize(vertices.size());
+		std::unordered_map<WeldKey, uint32_t, WeldKeyHash> vertex_map;
+		vertex_map.reserve(vertices.size());
+
+		std::vector<Vector3> tangent_sums;
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			const MeshVertexDataDefinition& vertex = vertices[i];
+			auto res = vertex_map.emplace(makeWeldKey(vertex), static_cast<uint32_t>(out_vertices.size()));
+			if (res.second) {
+				out_vertices.push_back(vertex);
+				tangent_sums.push_back(Vector3(vertex.tx, vertex.ty, vertex.tz));
+			}
+			else {
+				tangent_sums[res.first->second] += Vector3(vertex.tx, vertex.ty, vertex.tz);
+			}
+			out_indices[i] = res.first->second;
+		}
+
+		for (size_t i = 0; i < out_vertices.size(); ++i) {
+			//opposite tangents of mirrored uvs cancel out, keep the first one then
+			if (tangent_sums[i].squaredLength() < 1e-12f) {
+				continue;
+			}
+			Vector3 tangent = tangent_sums[i].normalisedCopy();
+			out_vertices[i].tx = tangent.x;
+			out_vertices[i].ty = tangent.y;
+			out_vertices[i].tz = tangent.z;
+		}
+	}
+
+	void OptimizeMeshVertexCache(std::vector<uint32_t>& indices, uint32_t vertex_count, uint32_t cache_size) {
+		const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+		if (triangle_count == 0 || vertex_count == 0) {
+			return;
+		}
+
+		//triangles around every vertex
+		std::vector<uint32_t> live_triangle_counts(vertex_count, 0);
+		for (uint32_t index : indices) {
+			++live_triangle_counts[index];
+		}
+		std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+		for (uint32_t v = 0; v < vertex_count; ++v) {
+			adjacency_offsets[v + 1] = adjacency_offsets[v] + live_triangle_counts[v];
+		}
+		std::vector<uint32_t> adjacency(adjacency_offsets[vertex_count]);
+		{
+			std::vector<uint32_t> fill_offsets(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+			for (uint32_t t = 0; t < triangle_count; ++t) {
+				for (uint32_t k = 0; k < 3; ++k) {
+					adjacency[fill_offsets[indices[t * 3 + k]]++] = t;
+				}
+			}
+		}
+
+		std::vector<uint32_t> cache_timestamps(vertex_count, 0);
+		std::vector<bool> is_triangle_emitted(triangle_count, false);
+		std::vector<uint32_t> dead_end_stack;
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> optimized_indices;
+		optimized_indices.reserve(indices.size());
+
+		uint32_t timestamp = cache_size + 1;
+		uint32_t cursor = 0;
+		uint32_t fanning_vertex = 0;
+		while (fanning_vertex != s_invalid_vertex) {
+			//emit every remaining triangle around the fanning vertex
+			candidates.clear();
+			for (uint32_t a = adjacency_offsets[fanning_vertex]; a < adjacency_offsets[fanning_vertex + 1]; ++a) {
+				const uint32_t t = adjacency[a];
+				if (is_triangle_emitted[t]) {
+					continue;
+				}
+				for (uint32_t k = 0; k < 3; ++k) {
+					const uint32_t v = indices[t * 3 + k];
+					optimized_indices.push_back(v);
+					dead_end_stack.push_back(v);
+					candidates.push_back(v);
+					--live_triangle_counts[v];
+					if (timestamp - cache_timestamps[v] > cache_size) {
+						cache_timestamps[v] = timestamp++;
+					}
+				}
+				is_triangle_emitted[t] = true;
+			}
+
+			//continue with the candidate that stays in the cache longest and still has triangles
+			fanning_vertex = s_invalid_vertex;
+			uint32_t best_priority = 0;
+			for (uint32_t v : candidates) {
+				if (live_triangle_counts[v] == 0) {
+					continue;
+				}
+				uint32_t priority = 0;
+				if (timestamp - cache_timestamps[v] + 2 * live_triangle_counts[v] <= cache_size) {
+					priority = timestamp - cache_timestamps[v];
+				}
+				if (fanning_vertex == s_invalid_vertex || priority > best_priority) {
+					fanning_vertex = v;
+					best_priority = priority;
+				}
+			}
+
+			//dead end, fall back to recently used vertices, then to the next vertex in input order
+			while (fanning_vertex == s_invalid_vertex && !dead_end_stack.empty()) {
+				const uint32_t v = dead_end_stack.back();
+				dead_end_stack.pop_back();
+				if (live_triangle_counts[v] > 0) {
+					fanning_vertex = v;
+				}
+			}
+			while (fanning_vertex == s_invalid_vertex && cursor < vertex_count) {
+				if (live_triangle_counts[cursor] > 0) {
+					fanning_vertex = cursor;
+				}
+				++cursor;
+			}
+		}
+
+		indices.swap(optimized_indices);
+	}
+
+	void OptimizeMeshVertexFetch(std::vector<MeshVertexDataDefinition>& vertices, std::vector<uint32_t>& indices) {
+		std::vector<uint32_t> remap(vertices.size(), s_invalid_vertex);
+		std::vector<MeshVertexDataDefinition> optimized_vertices;
+		optimized_vertices.reserve(vertices.size());
+		for (uint32_t& index : indices) {
+			if (remap[index] == s_invalid_vertex) {
+				remap[index] = static_cast<uint32_t>(optimized_vertices.size());
+				optimized_vertices.push_back(vertices[index]);
+			}
+			index = remap[index];
+		}
+		vertices.swap(optimized_vertices);
+	}
+
+	std::shared_ptr<BufferData> CreateMeshIndexBuffer(const std::vector<uint32_t>& indices, uint32_t vertex_count, RHIIndexType& out_index_type) {
+		std::shared_ptr<BufferData> index_buffer;
+		if (vertex_count <= std::numeric_limits<uint16_t>::max()) {
+			out_index_type = RHI_INDEX_TYPE_UINT16;
+			index_buffer = std::make_shared<BufferData>(indices.size() * sizeof(uint16_t));
+			uint16_t* index_data = static_cast<uint16_t*>(index_buffer->m_data);
+			for (size_t i = 0; i < indices.size(); ++i) {
+				index_data[i] = static_cast<uint16_t>(indices[i]);
+			}
+		}
+		else {
+			out_index_type = RHI_INDEX_TYPE_UINT32;
+			index_buffer = std::make_shared<BufferData>(indices.size() * sizeof(uint32_t));
+			memcpy(index_buffer->m_data, indices.data(), indices.size() * sizeof(uint32_t));
+		}
+		return index_buffer;
+	}
+}
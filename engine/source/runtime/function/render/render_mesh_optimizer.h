@@ -0,0 +1,27 @@
+#pragma once
+
+#include "runtime/function/render/render_type.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Dao {
+
+	/// merge vertices with the same position, normal and uv. the tangents of merged vertices are averaged,
+	/// out_indices holds one index per input vertex into out_vertices
+	void WeldMeshVertices(
+		const std::vector<MeshVertexDataDefinition>&	vertices,
+		std::vector<MeshVertexDataDefinition>&			out_vertices,
+		std::vector<uint32_t>&							out_indices
+	);
+
+	/// reorder triangles so consecutive triangles reuse the post transform vertex cache (tipsify, Sander et al. 2007)
+	void OptimizeMeshVertexCache(std::vector<uint32_t>& indices, uint32_t vertex_count, uint32_t cache_size = 16);
+
+	/// reorder vertices into first use order of the indices so vertex fetch walks memory linearly, unused vertices are dropped
+	void OptimizeMeshVertexFetch(std::vector<MeshVertexDataDefinition>& vertices, std::vector<uint32_t>& indices);
+
+	/// pack indices as uint16 when every vertex is addressable with 16 bits, as uint32 otherwise
+	std::shared_ptr<BufferData> CreateMeshIndexBuffer(const std::vector<uint32_t>& indices, uint32_t vertex_count, RHIIndexType& out_index_type);
+}
@@ -0,0 +1,48 @@
+#include "runtime/function/render/render_mesh_pool.h"
+
+#include "runtime/function/render/render_mesh.h"
+#include "runtime/function/render/interface/rhi.h"
+
+namespace Dao {
+
+	void RenderMeshPool::initialize(std::shared_ptr<RHI> rhi) {
+		RHIBufferCreateInfo buffer_info = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+		VmaAllocationCreateInfo alloc_info = {};
+		alloc_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+		buffer_info.usage = RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
+		buffer_info.size = sizeof(MeshVertex::VulkanMeshVertexPosition) * s_mesh_pool_max_vertex_count;
+		rhi->createBufferVMA(
+			rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
+			m_vertex_position_buffer, &m_vertex_position_buffer_allocation, nullptr
+		);
+		buffer_info.size = sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * s_mesh_pool_max_vertex_count;
+		rhi->createBufferVMA(
+			rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
+			m_vertex_varying_enable_blending_buffer, &m_vertex_varying_enable_blending_buffer_allocation, nullptr
+		);
+		buffer_info.size = sizeof(MeshVertex::VulkanMeshVertexVarying) * s_mesh_pool_max_vertex_count;
+		rhi->createBufferVMA(
+			rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
+			m_vertex_varying_buffer, &m_vertex_varying_buffer_allocation, nullptr
+		);
+
+		buffer_info.usage = RHI_BUFFER_USAGE_INDEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
+		buffer_info.size = sizeof(uint16_t) * s_mesh_pool_max_index_count;
+		rhi->createBufferVMA(
+			rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
+			m_index_buffer, &m_index_buffer_allocation, nullptr
+		);
+	}
+
+	bool RenderMeshPool::allocate(uint32_t vertex_count, uint32_t index_count, uint32_t& out_first_vertex, uint32_t& out_first_index) {
+		if (vertex_count > s_mesh_pool_max_vertex_count - m_vertex_count || index_count > s_mesh_pool_max_index_count - m_index_count) {
+			return false;
+		}
+		out_first_vertex = m_vertex_count;
+		out_first_index = m_index_count;
+		m_vertex_count += vertex_count;
+		m_index_count += index_count;
+		return true;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "runtime/function/render/render_common.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace Dao {
+
+	class RHI;
+
+	/// vertex and index buffers shared by all static meshes, a mesh is a range of vertices and indices in them.
+	/// with every static mesh behind the same buffers the mesh passes bind them once and submit many meshes
+	/// per indirect draw. meshes are only appended, like the per mesh buffers they live as long as the render resource
+	class RenderMeshPool {
+	public:
+		void initialize(std::shared_ptr<RHI> rhi);
+
+		/// @return: false if the pool is full, the mesh has to keep its own buffers then
+		bool allocate(uint32_t vertex_count, uint32_t index_count, uint32_t& out_first_vertex, uint32_t& out_first_index);
+
+		RHIBuffer* getVertexPositionBuffer() const { return m_vertex_position_buffer; }
+		RHIBuffer* getVertexVaryingEnableBlendingBuffer() const { return m_vertex_varying_enable_blending_buffer; }
+		RHIBuffer* getVertexVaryingBuffer() const { return m_vertex_varying_buffer; }
+		RHIBuffer* getIndexBuffer() const { return m_index_buffer; }
+
+	private:
+		RHIBuffer*		m_vertex_position_buffer{ nullptr };
+		VmaAllocation	m_vertex_position_buffer_allocation{ nullptr };
+		RHIBuffer*		m_vertex_varying_enable_blending_buffer{ nullptr };
+		VmaAllocation	m_vertex_varying_enable_blending_buffer_allocation{ nullptr };
+		RHIBuffer*		m_vertex_varying_buffer{ nullptr };
+		VmaAllocation	m_vertex_varying_buffer_allocation{ nullptr };
+		RHIBuffer*		m_index_buffer{ nullptr };
+		VmaAllocation	m_index_buffer_allocation{ nullptr };
+
+		uint32_t		m_vertex_count{ 0 };
+		uint32_t		m_index_count{ 0 };
+	};
+}
@@ -3,6 +3,7 @@
 #include "runtime/core/math/matrix4.h"
 #include "runtime/function/framework/object/object_id_allocator.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -64,7 +65,6 @@ namespace Dao {
 		GameObjectTransformDesc m_transform_desc;
 		bool					m_with_animation{ false };
 		SkeletonBindingDesc		m_skeleton_binding_desc;
-		SkeletonAnimationResult	m_skeleton_animation_result;
 	};
 
 	constexpr size_t k_invalid_part_id = std::numeric_limits<size_t>::max();
@@ -88,13 +88,18 @@ namespace Dao {
 	public:
 		GameObjectDesc() :m_go_id(0) {}
 		GameObjectDesc(size_t go_id, const std::vector<GameObjectPartDesc>& parts) :m_go_id(go_id), m_object_parts(parts) {}
+		GameObjectDesc(size_t go_id, const std::vector<GameObjectPartDesc>& parts, std::shared_ptr<const SkeletonAnimationResult> skeleton_animation_result) :
+			m_go_id(go_id), m_object_parts(parts), m_skeleton_animation_result(std::move(skeleton_animation_result)) {}
 
 		GObjectID getId() const { return m_go_id; }
 		const std::vector<GameObjectPartDesc>& getObjectParts() const { return m_object_parts; }
+		/// skinning palette shared by all parts, nullptr for objects without animation
+		const std::shared_ptr<const SkeletonAnimationResult>& getSkeletonAnimationResult() const { return m_skeleton_animation_result; }
 
 	private:
 		GObjectID						m_go_id{ k_invalid_gobject_id };
 		std::vector<GameObjectPartDesc> m_object_parts;
+		std::shared_ptr<const SkeletonAnimationResult> m_skeleton_animation_result;
 	};
 }
 
@@ -35,4 +35,46 @@ namespace Dao {
 		}
 		return layouts;
 	}
+
+	RenderPass::IndirectDraws RenderPass::uploadIndirectDraws(
+		UploadRingbufferAllocator&	upload_allocator,
+		const RenderDrawList&		draw_list,
+		uint32_t					first_batch,
+		uint32_t					last_batch,
+		uint32_t					instance_base_index
+	) {
+		const std::vector<RenderDrawBatch>& batches = draw_list.getBatches();
+
+		uint32_t instance_count = 0;
+		for (uint32_t batch_index = first_batch; batch_index < last_batch; ++batch_index) {
+			instance_count += batches[batch_index].instance_count;
+		}
+		ASSERT(instance_count <= s_mesh_indirect_max_instance_count);
+
+		IndirectDraws indirect_draws;
+		indirect_draws.command_count = last_batch - first_batch;
+		indirect_draws.instance_indices_dynamic_offset = upload_allocator.allocate(sizeof(uint32_t) * instance_count);
+		indirect_draws.commands_offset = upload_allocator.allocate(sizeof(RHIDrawIndexedIndirectCommand) * indirect_draws.command_count);
+
+		uint32_t* instance_indices = static_cast<uint32_t*>(upload_allocator.getMemoryPointer(indirect_draws.instance_indices_dynamic_offset));
+		RHIDrawIndexedIndirectCommand* commands = static_cast<RHIDrawIndexedIndirectCommand*>(upload_allocator.getMemoryPointer(indirect_draws.commands_offset));
+
+		uint32_t first_instance = 0;
+		for (uint32_t batch_index = first_batch; batch_index < last_batch; ++batch_index) {
+			const RenderDrawBatch& batch = batches[batch_index];
+			const RenderDrawInstance* instances = draw_list.getInstances(batch);
+			for (uint32_t i = 0; i < batch.instance_count; ++i) {
+				instance_indices[first_instance + i] = instance_base_index + instances[i].instance_slot;
+			}
+
+			RHIDrawIndexedIndirectCommand& command = commands[batch_index - first_batch];
+			command.indexCount = batch.mesh->mesh_index_count;
+			command.instanceCount = batch.instance_count;
+			command.firstIndex = batch.mesh->mesh_first_index;
+			command.vertexOffset = static_cast<int32_t>(batch.mesh->mesh_first_vertex);
+			command.firstInstance = first_instance;
+			first_instance += batch.instance_count;
+		}
+		return indirect_draws;
+	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "runtime/function/render/render_common.h"
+#include "runtime/function/render/render_draw_list.h"
 #include "runtime/function/render/render_pass_base.h"
 #include "runtime/function/render/render_resource.h"
 
@@ -88,6 +89,25 @@ namespace Dao {
 		virtual std::vector<RHIDescriptorSetLayout*> getDescriptorSetLayouts() const;
 
 		static VisibleNodes m_visible_nodes;
+
+	protected:
+		struct IndirectDraws {
+			//dynamic offset of the instance index array, bound in place of the per drawcall storage buffer
+			uint32_t instance_indices_dynamic_offset;
+			//byte offset of the draw commands in the upload ringbuffer
+			uint32_t commands_offset;
+			uint32_t command_count;
+		};
+
+		/// write one indexed draw per batch in [first_batch, last_batch) of draw_list and the scene instance indices
+		/// the draws reach through their first instance into the upload ringbuffer of the current frame
+		IndirectDraws uploadIndirectDraws(
+			UploadRingbufferAllocator&	upload_allocator,
+			const RenderDrawList&		draw_list,
+			uint32_t					first_batch,
+			uint32_t					last_batch,
+			uint32_t					instance_base_index
+		);
 	};
 
 }
\ No newline at end of file
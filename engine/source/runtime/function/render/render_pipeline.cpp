@@ -1,6 +1,5 @@
 #include "runtime/function/render/render_pipeline.h"
 
-#include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 #include "runtime/function/render/passes/color_grading_pass.h"
 #include "runtime/function/render/passes/combine_ui_pass.h"
 #include "runtime/function/render/passes/directional_light_shadow_pass.h"
@@ -12,6 +11,8 @@
 #include "runtime/function/render/passes/tone_mapping_pass.h"
 #include "runtime/function/render/passes/ui_pass.h"
 #include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
+#include "runtime/function/global/global_context.h"
 
 namespace Dao {
 	void RenderPipeline::initialize(RenderPipelineInitInfo init_info) {
@@ -26,6 +27,8 @@ namespace Dao {
 		m_fxaa_pass = std::make_shared<FXAAPass>();
 		m_particle_pass = std::make_shared<ParticlePass>();
 
+		m_rhi->createThreadCommandPools(render_pipeline_record_slot_count);
+
 		RenderPassCommonInfo pass_common_info;
 		pass_common_info.m_rhi = m_rhi;
 		pass_common_info.m_render_resource = init_info.m_render_resource;
@@ -99,19 +102,18 @@ namespace Dao {
 	}
 
 	void RenderPipeline::forwardRender(std::shared_ptr<RHI> rhi, std::shared_ptr<RenderResourceBase> render_resource) {
-		auto vk_rhi = static_cast<VulkanRHI*>(rhi.get());
 		auto vk_resource = static_cast<RenderResource*>(render_resource.get());
-		vk_resource->resetRingBufferOffset(vk_rhi->m_current_frame_index);
-		vk_rhi->waitForFences();
-		vk_rhi->resetCommandPool();
-		bool recreate_swapchain = vk_rhi->prepareBeforePass(std::bind(&RenderPipeline::passUpdateAfterRecreateSwapchain, this));
+		vk_resource->resetRingBufferOffset(rhi->getCurrentFrameIndex());
+		rhi->waitForFences();
+		vk_resource->flushSceneInstanceBuffer(rhi->getCurrentFrameIndex());
+		rhi->resetCommandPool();
+		bool recreate_swapchain = rhi->prepareBeforePass(std::bind(&RenderPipeline::passUpdateAfterRecreateSwapchain, this));
 		if (recreate_swapchain) {
 			return;
 		}
 
-		static_cast<DirectionalLightShadowPass*>(m_directional_light_shadow_pass.get())->draw();
-		static_cast<PointLightShadowPass*>(m_point_light_shadow_pass.get())->draw();
-
+		DirectionalLightShadowPass& directional_light_shadow_pass = *(static_cast<DirectionalLightShadowPass*>(m_directional_light_shadow_pass.get()));
+		PointLightShadowPass& point_light_shadow_pass = *(static_cast<PointLightShadowPass*>(m_point_light_shadow_pass.get()));
 		ColorGradingPass& color_grading_pass = *(static_cast<ColorGradingPass*>(m_color_grading_pass.get()));
 		FXAAPass& fxaa_pass = *(static_cast<FXAAPass*>(m_fxaa_pass.get()));
 		ToneMappingPass& tone_mapping_pass = *(static_cast<ToneMappingPass*>(m_tone_mapping_pass.get()));
@@ -120,28 +122,39 @@ namespace Dao {
 		ParticlePass& particle_pass = *(static_cast<ParticlePass*>(m_particle_pass.get()));
 		MainCameraPass& main_camera_pass = *(static_cast<MainCameraPass*>(m_main_camera_pass.get()));
 
-		static_cast<ParticlePass*>(m_particle_pass.get())->setRenderCommandBufferHandle(main_camera_pass.getRenderCommandBuffer());
-		static_cast<MainCameraPass*>(m_main_camera_pass.get())->drawForward(color_grading_pass, fxaa_pass, tone_mapping_pass, ui_pass, combine_ui_pass, particle_pass, vk_rhi->m_current_swapchain_image_index);
-
-		vk_rhi->submitRendering(std::bind(&RenderPipeline::passUpdateAfterRecreateSwapchain, this));
+		//record the mesh heavy passes into secondary command buffers in parallel, each job owns its own pool slot
+		const uint32_t current_swapchain_image_index = rhi->getCurrentSwapchainImageIndex();
+		JobSystem& job_system = *g_runtime_global_context.m_job_system;
+		JobCounter record_counter;
+		job_system.submit([&]() { directional_light_shadow_pass.recordCommandBuffer(render_pipeline_record_slot_directional_light_shadow); }, &record_counter);
+		job_system.submit([&]() { point_light_shadow_pass.recordCommandBuffer(render_pipeline_record_slot_point_light_shadow); }, &record_counter);
+		job_system.submit([&]() {
+			main_camera_pass.recordForwardLighting(render_pipeline_record_slot_main_camera, current_swapchain_image_index, particle_pass);
+		}, &record_counter);
+		job_system.wait(record_counter);
+
+		directional_light_shadow_pass.draw();
+		point_light_shadow_pass.draw();
+		static_cast<MainCameraPass*>(m_main_camera_pass.get())->drawForward(color_grading_pass, fxaa_pass, tone_mapping_pass, ui_pass, combine_ui_pass, particle_pass, current_swapchain_image_index);
+
+		rhi->submitRendering(std::bind(&RenderPipeline::passUpdateAfterRecreateSwapchain, this));
 		static_cast<ParticlePass*>(m_particle_pass.get())->copyNormalAndDepthImage();
 		static_cast<ParticlePass*>(m_particle_pass.get())->simulate();
 	}
 
 	void RenderPipeline::deferredRender(std::shared_ptr<RHI> rhi, std::shared_ptr<RenderResourceBase> render_resource) {
-		auto vk_rhi = static_cast<VulkanRHI*>(rhi.get());
 		auto vk_resource = static_cast<RenderResource*>(render_resource.get());
-		vk_resource->resetRingBufferOffset(vk_rhi->m_current_frame_index);
-		vk_rhi->waitForFences();
-		vk_rhi->resetCommandPool();
-		bool recreate_swapchain = vk_rhi->prepareBeforePass(std::bind(&RenderPipeline::passUpdateAfterRecreateSwapchain, this));
+		vk_resource->resetRingBufferOffset(rhi->getCurrentFrameIndex());
+		rhi->waitForFences();
+		vk_resource->flushSceneInstanceBuffer(rhi->getCurrentFrameIndex());
+		rhi->resetCommandPool();
+		bool recreate_swapchain = rhi->prepareBeforePass(std::bind(&RenderPipeline::passUpdateAfterRecreateSwapchain, this));
 		if (recreate_swapchain) {
 			return;
 		}
 
-		static_cast<DirectionalLightShadowPass*>(m_directional_light_shadow_pass.get())->draw();
-		static_cast<PointLightShadowPass*>(m_point_light_shadow_pass.get())->draw();
-
+		DirectionalLightShadowPass& directional_light_shadow_pass = *(static_cast<DirectionalLightShadowPass*>(m_directional_light_shadow_pass.get()));
+		PointLightShadowPass& point_light_shadow_pass = *(static_cast<PointLightShadowPass*>(m_point_light_shadow_pass.get()));
 		ColorGradingPass& color_grading_pass = *(static_cast<ColorGradingPass*>(m_color_grading_pass.get()));
 		FXAAPass& fxaa_pass = *(static_cast<FXAAPass*>(m_fxaa_pass.get()));
 		ToneMappingPass& tone_mapping_pass = *(static_cast<ToneMappingPass*>(m_tone_mapping_pass.get()));
@@ -150,10 +163,21 @@ namespace Dao {
 		ParticlePass& particle_pass = *(static_cast<ParticlePass*>(m_particle_pass.get()));
 		MainCameraPass& main_camera_pass = *(static_cast<MainCameraPass*>(m_main_camera_pass.get()));
 
+		//record the mesh heavy passes into secondary command buffers in parallel, each job owns its own pool slot
+		const uint32_t current_swapchain_image_index = rhi->getCurrentSwapchainImageIndex();
+		JobSystem& job_system = *g_runtime_global_context.m_job_system;
+		JobCounter record_counter;
+		job_system.submit([&]() { directional_light_shadow_pass.recordCommandBuffer(render_pipeline_record_slot_directional_light_shadow); }, &record_counter);
+		job_system.submit([&]() { point_light_shadow_pass.recordCommandBuffer(render_pipeline_record_slot_point_light_shadow); }, &record_counter);
+		job_system.submit([&]() { main_camera_pass.recordMeshGbuffer(render_pipeline_record_slot_main_camera, current_swapchain_image_index); }, &record_counter);
+		job_system.wait(record_counter);
+
+		directional_light_shadow_pass.draw();
+		point_light_shadow_pass.draw();
 		static_cast<ParticlePass*>(m_particle_pass.get())->setRenderCommandBufferHandle(main_camera_pass.getRenderCommandBuffer());
-		static_cast<MainCameraPass*>(m_main_camera_pass.get())->draw(color_grading_pass, fxaa_pass, tone_mapping_pass, ui_pass, combine_ui_pass, particle_pass, vk_rhi->m_current_swapchain_image_index);
+		static_cast<MainCameraPass*>(m_main_camera_pass.get())->draw(color_grading_pass, fxaa_pass, tone_mapping_pass, ui_pass, combine_ui_pass, particle_pass, current_swapchain_image_index);
 
-		vk_rhi->submitRendering(std::bind(&RenderPipeline::passUpdateAfterRecreateSwapchain, this));
+		rhi->submitRendering(std::bind(&RenderPipeline::passUpdateAfterRecreateSwapchain, this));
 		static_cast<ParticlePass*>(m_particle_pass.get())->copyNormalAndDepthImage();
 		static_cast<ParticlePass*>(m_particle_pass.get())->simulate();
 	}
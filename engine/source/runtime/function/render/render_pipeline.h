@@ -3,6 +3,14 @@
 #include "runtime/function/render/render_pipeline_base.h"
 
 namespace Dao {
+
+	//slots of the secondary command buffer pools, one per pass recorded in parallel
+	enum RenderPipelineRecordSlot : uint32_t {
+		render_pipeline_record_slot_directional_light_shadow = 0,
+		render_pipeline_record_slot_point_light_shadow,
+		render_pipeline_record_slot_main_camera,
+		render_pipeline_record_slot_count
+	};
 	
 	class RenderPipeline :public RenderPipelineBase {
 	public:
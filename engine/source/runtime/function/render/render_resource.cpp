@@ -3,10 +3,9 @@
 #include "runtime/function/render/render_camera.h"
 #include "runtime/function/render/render_helper.h"
 #include "runtime/function/render/render_mesh.h"
-#include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
-#include "runtime/function/render/interface/vulkan/vulkan_util.h"
 #include "runtime/core/base/macro.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace Dao {
@@ -16,24 +15,26 @@ namespace Dao {
 	void RenderResource::uploadGloabalRenderResource(std::shared_ptr<RHI> rhi, LevelResourceDesc level_resource_desc) {
 		// create and map global storage buffer
 		createAndMapStorageBuffer(rhi);
+		//shared vertex and index buffers of static meshes
+		m_global_render_resource.m_mesh_pool.initialize(rhi);
 
 		//sky box irradiance
 		SkyBoxIrradianceMap skybox_irradiance_map = level_resource_desc.m_ibl_resource_desc.m_skybox_irradiance_map;
-		std::shared_ptr<TextureData> irradiance_pos_x_map = loadTextureHDR(skybox_irradiance_map.m_positive_x_map);
-		std::shared_ptr<TextureData> irradiance_neg_x_map = loadTextureHDR(skybox_irradiance_map.m_negative_x_map);
-		std::shared_ptr<TextureData> irradiance_pos_y_map = loadTextureHDR(skybox_irradiance_map.m_positive_y_map);
-		std::shared_ptr<TextureData> irradiance_neg_y_map = loadTextureHDR(skybox_irradiance_map.m_negative_y_map);
-		std::shared_ptr<TextureData> irradiance_pos_z_map = loadTextureHDR(skybox_irradiance_map.m_positive_z_map);
-		std::shared_ptr<TextureData> irradiance_neg_z_map = loadTextureHDR(skybox_irradiance_map.m_negative_z_map);
+		std::shared_ptr<TextureData> irradiance_pos_x_map = loadCookedTexture(skybox_irradiance_map.m_positive_x_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> irradiance_neg_x_map = loadCookedTexture(skybox_irradiance_map.m_negative_x_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> irradiance_pos_y_map = loadCookedTexture(skybox_irradiance_map.m_positive_y_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> irradiance_neg_y_map = loadCookedTexture(skybox_irradiance_map.m_negative_y_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> irradiance_pos_z_map = loadCookedTexture(skybox_irradiance_map.m_positive_z_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> irradiance_neg_z_map = loadCookedTexture(skybox_irradiance_map.m_negative_z_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
 
 		//sky box specular
 		SkyBoxSpecularMap sky_box_specular_map = level_resource_desc.m_ibl_resource_desc.m_skybox_specular_map;
-		std::shared_ptr<TextureData> specular_pos_x_map = loadTextureHDR(sky_box_specular_map.m_positive_x_map);
-		std::shared_ptr<TextureData> specular_neg_x_map = loadTextureHDR(sky_box_specular_map.m_negative_x_map);
-		std::shared_ptr<TextureData> specular_pos_y_map = loadTextureHDR(sky_box_specular_map.m_positive_y_map);
-		std::shared_ptr<TextureData> specular_neg_y_map = loadTextureHDR(sky_box_specular_map.m_negative_y_map);
-		std::shared_ptr<TextureData> specular_pos_z_map = loadTextureHDR(sky_box_specular_map.m_positive_z_map);
-		std::shared_ptr<TextureData> specular_neg_z_map = loadTextureHDR(sky_box_specular_map.m_negative_z_map);
+		std::shared_ptr<TextureData> specular_pos_x_map = loadCookedTexture(sky_box_specular_map.m_positive_x_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> specular_neg_x_map = loadCookedTexture(sky_box_specular_map.m_negative_x_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> specular_pos_y_map = loadCookedTexture(sky_box_specular_map.m_positive_y_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> specular_neg_y_map = loadCookedTexture(sky_box_specular_map.m_negative_y_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> specular_pos_z_map = loadCookedTexture(sky_box_specular_map.m_positive_z_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
+		std::shared_ptr<TextureData> specular_neg_z_map = loadCookedTexture(sky_box_specular_map.m_negative_z_map, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR);
 
 		//brdf
 		std::shared_ptr<TextureData> brdf_map = loadTextureHDR(level_resource_desc.m_ibl_resource_desc.m_brdf_map);
@@ -80,16 +81,16 @@ namespace Dao {
 		);
 	}
 
-	void RenderResource::uploadGameObjectRenderResource(std::shared_ptr<RHI> rhi, RenderEntity render_entity, RenderMeshData mesh_data, RenderMaterialData material_data) {
+	void RenderResource::uploadGameObjectRenderResource(std::shared_ptr<RHI> rhi, const RenderEntity& render_entity, RenderMeshData mesh_data, RenderMaterialData material_data) {
 		getOrCreateVulkanMesh(rhi, render_entity, mesh_data);
 		getOrCreateVulkanMaterial(rhi, render_entity, material_data);
 	}
 
-	void RenderResource::uploadGameObjectRenderResource(std::shared_ptr<RHI> rhi, RenderEntity render_entity, RenderMeshData mesh_data) {
+	void RenderResource::uploadGameObjectRenderResource(std::shared_ptr<RHI> rhi, const RenderEntity& render_entity, RenderMeshData mesh_data) {
 		getOrCreateVulkanMesh(rhi, render_entity, mesh_data);
 	}
 
-	void RenderResource::uploadGameObjectRenderResource(std::shared_ptr<RHI> rhi, RenderEntity render_entity, RenderMaterialData material_data) {
+	void RenderResource::uploadGameObjectRenderResource(std::shared_ptr<RHI> rhi, const RenderEntity& render_entity, RenderMaterialData material_data) {
 		getOrCreateVulkanMaterial(rhi, render_entity, material_data);
 	}
 
@@ -131,10 +132,25 @@ namespace Dao {
 		m_particle_billboard_perframe_storage_buffer_object.right_direction = camera->right();
 		m_particle_billboard_perframe_storage_buffer_object.forward_direction = camera->forward();
 		m_particle_billboard_perframe_storage_buffer_object.up_direction = camera->up();
+
+		//scene instances touched by the swap data since the last frame
+		RenderInstanceBuffer& scene_instance_buffer = m_global_render_resource.m_storage_buffer.m_scene_instance_buffer;
+		const RenderEntityStorage& render_entities = render_scene->m_render_entities;
+		for (uint32_t instance_id : render_scene->getDirtyInstanceIds()) {
+			uint32_t entity_index;
+			if (!render_scene->getRenderEntityIndex(instance_id, entity_index)) {
+				continue;
+			}
+			VulkanMeshInstance instance{};
+			instance.model_matrix = render_entities.m_model_matrices[entity_index];
+			instance.enable_vertex_blending = (render_entities.m_enable_vertex_blending[entity_index] && render_entities.getJointCount(entity_index) > 0) ? 1.0f : -1.0f;
+			instance.node_id = instance_id;
+			scene_instance_buffer.setInstance(render_scene->getInstanceSlot(instance_id), instance);
+		}
+		render_scene->clearDirtyInstanceIds();
 	}
 
 	void RenderResource::createIBLSamplers(std::shared_ptr<RHI> rhi) {
-		VulkanRHI* raw_rhi = static_cast<VulkanRHI*>(rhi.get());
 		RHIPhysicalDeviceProperties physical_device_properties{};
 		rhi->getPhysicalDeviceProperties(&physical_device_properties);
 
@@ -181,8 +197,7 @@ namespace Dao {
 	}
 
 	void RenderResource::createIBLTextures(std::shared_ptr<RHI> rhi, std::array<std::shared_ptr<TextureData>, 6> irradiance_maps, std::array<std::shared_ptr<TextureData>, 6> specular_maps) {
-		//assume all textures have same width, height and format
-		uint32_t irradiance_cubemap_miplevels = static_cast<uint32_t>(std::floor(log2(std::max(irradiance_maps[0]->m_width, irradiance_maps[0]->m_height)))) + 1;
+		//assume all textures have same width, height, format and mip levels, the levels are cooked with the faces
 		rhi->createCubeMap(
 			m_global_render_resource.m_ibl_resource.m_irradiance_texture_image,
 			m_global_render_resource.m_ibl_resource.m_irradiance_texture_image_view,
@@ -196,9 +211,8 @@ namespace Dao {
 			 irradiance_maps[4]->m_pixels,
 			 irradiance_maps[5]->m_pixels },
 			irradiance_maps[0]->m_format,
-			irradiance_cubemap_miplevels
+			irradiance_maps[0]->m_mip_levels
 		);
-		uint32_t specular_cubemap_miplevels = static_cast<uint32_t>(std::floor(log2(std::max(specular_maps[0]->m_width, specular_maps[0]->m_height)))) + 1;
 		rhi->createCubeMap(
 			m_global_render_resource.m_ibl_resource.m_specular_texture_image,
 			m_global_render_resource.m_ibl_resource.m_specular_texture_image_view,
@@ -212,11 +226,11 @@ namespace Dao {
 			  specular_maps[4]->m_pixels,
 			  specular_maps[5]->m_pixels },
 			specular_maps[0]->m_format,
-			specular_cubemap_miplevels
+			specular_maps[0]->m_mip_levels
 		);
 	}
 
-	VulkanMesh& RenderResource::getOrCreateVulkanMesh(std::shared_ptr<RHI> rhi, RenderEntity entity, RenderMeshData mesh_data) {
+	VulkanMesh& RenderResource::getOrCreateVulkanMesh(std::shared_ptr<RHI> rhi, const RenderEntity& entity, RenderMeshData mesh_data) {
 		size_t assetid = entity.m_mesh_asset_id;
 		auto it = m_vulkan_meshs.find(assetid);
 		if (it != m_vulkan_meshs.end()) {
@@ -227,6 +241,7 @@ namespace Dao {
 			auto res = m_vulkan_meshs.insert(std::make_pair(assetid, std::move(temp)));
 			ASSERT(res.second);
 
+			RHIIndexType index_type = mesh_data.m_static_mesh_data.m_index_type;
 			uint32_t index_buffer_size = static_cast<uint32_t>(mesh_data.m_static_mesh_data.m_index_buffer->m_size);
 			void* index_buffer_data = mesh_data.m_static_mesh_data.m_index_buffer->m_data;
 
@@ -234,20 +249,22 @@ namespace Dao {
 			MeshVertexDataDefinition* vertex_buffer_data = reinterpret_cast<MeshVertexDataDefinition*>(mesh_data.m_static_mesh_data.m_vertex_buffer->m_data);
 
 			VulkanMesh& mesh = res.first->second;
+			mesh.upload_id = 0;
+			mesh.is_ready = false;
 			if (mesh_data.m_skeleton_binding_buffer) {
 				uint32_t joint_binding_buffer_size = (uint32_t)mesh_data.m_skeleton_binding_buffer->m_size;
 				MeshVertexBindingDataDefinition* joint_binding_buffer_data = reinterpret_cast<MeshVertexBindingDataDefinition*>(mesh_data.m_skeleton_binding_buffer->m_data);
-				updateMeshData(rhi, true, index_buffer_size, index_buffer_data, vertex_buffer_size, vertex_buffer_data, joint_binding_buffer_size, joint_binding_buffer_data, mesh);
+				updateMeshData(rhi, true, index_type, index_buffer_size, index_buffer_data, vertex_buffer_size, vertex_buffer_data, joint_binding_buffer_size, joint_binding_buffer_data, mesh);
 			}
 			else {
-				updateMeshData(rhi, false, index_buffer_size, index_buffer_data, vertex_buffer_size, vertex_buffer_data, 0, nullptr, mesh);
+				updateMeshData(rhi, false, index_type, index_buffer_size, index_buffer_data, vertex_buffer_size, vertex_buffer_data, 0, nullptr, mesh);
 			}
+			_uploading_mesh_asset_ids.push_back(assetid);
 			return mesh;
 		}
 	}
 
-	VulkanPBRMaterial& RenderResource::getOrCreateVulkanMaterial(std::shared_ptr<RHI> rhi, RenderEntity entity, RenderMaterialData material_data) {
-		VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
+	VulkanPBRMaterial& RenderResource::getOrCreateVulkanMaterial(std::shared_ptr<RHI> rhi, const RenderEntity& entity, RenderMaterialData material_data) {
 		size_t assetid = entity.m_material_asset_id;
 
 		auto it = m_vulkan_pbr_material.find(assetid);
@@ -259,241 +276,258 @@ namespace Dao {
 			auto res = m_vulkan_pbr_material.insert(std::make_pair(assetid, std::move(temp)));
 			ASSERT(res.second);
 
-			float empty_image[] = { 0.5f,0.5f,0.5f,0.5f };
-
-			void* base_color_image_pixels = empty_image;
-			uint32_t base_color_image_width = 1;
-			uint32_t base_color_image_height = 1;
-			RHIFormat base_color_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB;
-			if (material_data.m_base_color_texture) {
-				base_color_image_pixels = material_data.m_base_color_texture->m_pixels;
-				base_color_image_width = static_cast<uint32_t>(material_data.m_base_color_texture->m_width);
-				base_color_image_height = static_cast<uint32_t>(material_data.m_base_color_texture->m_height);
-				base_color_image_format = material_data.m_base_color_texture->m_format;
-			}
-
-			void* metallic_roughness_image_pixels = empty_image;
-			uint32_t metallic_roughness_image_width = 1;
-			uint32_t metallic_roughness_image_height = 1;
-			RHIFormat metallic_roughness_image_format = RHI_FORMAT_R8G8B8A8_UNORM;
-			if (material_data.m_metallic_roughness_texture) {
-				metallic_roughness_image_pixels = material_data.m_metallic_roughness_texture->m_pixels;
-				metallic_roughness_image_width = material_data.m_metallic_roughness_texture->m_width;
-				metallic_roughness_image_height = material_data.m_metallic_roughness_texture->m_height;
-				metallic_roughness_image_format = material_data.m_metallic_roughness_texture->m_format;
-			}
-
-			void* normal_image_pixels = empty_image;
-			uint32_t normal_image_width = 1;
-			uint32_t normal_image_height = 1;
-			RHIFormat normal_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
-			if (material_data.m_normal_texture) {
-				normal_image_pixels = material_data.m_normal_texture->m_pixels;
-				normal_image_width = static_cast<uint32_t>(material_data.m_normal_texture->m_width);
-				normal_image_height = static_cast<uint32_t>(material_data.m_normal_texture->m_height);
-				normal_image_format = material_data.m_normal_texture->m_format;
-			}
-
-			void* occlusion_image_pixels = empty_image;
-			uint32_t occlusion_image_width = 1;
-			uint32_t occlusion_image_height = 1;
-			RHIFormat occlusion_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
-			if (material_data.m_occlusion_texture) {
-				occlusion_image_pixels = material_data.m_occlusion_texture->m_pixels;
-				occlusion_image_width = static_cast<uint32_t>(material_data.m_occlusion_texture->m_width);
-				occlusion_image_height = static_cast<uint32_t>(material_data.m_occlusion_texture->m_height);
-				occlusion_image_format = material_data.m_occlusion_texture->m_format;
-			}
-
-			void* emissive_image_pixels = empty_image;
-			uint32_t emissive_image_width = 1;
-			uint32_t emissive_image_height = 1;
-			RHIFormat emissive_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
-			if (material_data.m_emissive_texture) {
-				emissive_image_pixels = material_data.m_emissive_texture->m_pixels;
-				emissive_image_width = static_cast<uint32_t>(material_data.m_emissive_texture->m_width);
-				emissive_image_height = static_cast<uint32_t>(material_data.m_emissive_texture->m_height);
-				emissive_image_format = material_data.m_emissive_texture->m_format;
-			}
-
 			VulkanPBRMaterial& material = res.first->second;
-			//similiarly to the vertex/index buffer, we should allocate the uniform
-			//buffer in DEVICE_LOCAL memory and use the temp stage buffer to copy the
-			//data
-			{
-				RHIDeviceSize buffer_size = sizeof(MeshPerMaterialUniformBufferObject);
-				RHIBuffer* inefficient_staging_buffer = RHI_NULL_HANDLE;
-				RHIDeviceMemory* inefficient_staging_buffer_memory = RHI_NULL_HANDLE;
-				rhi->createBuffer(
-					buffer_size, RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-					RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-					inefficient_staging_buffer, inefficient_staging_buffer_memory
-				);
-
-				void* staging_buffer_data = nullptr;
-				rhi->mapMemory(inefficient_staging_buffer_memory, 0, buffer_size, 0, &staging_buffer_data);
-				MeshPerMaterialUniformBufferObject& material_uniform_buffer_info = (*static_cast<MeshPerMaterialUniformBufferObject*>(staging_buffer_data));
-				material_uniform_buffer_info.is_blend = entity.m_blend;
-				material_uniform_buffer_info.is_double_sided = entity.m_double_sided;
-				material_uniform_buffer_info.baseColorFractor = entity.m_base_color_factor;
-				material_uniform_buffer_info.metallicFactor = entity.m_metallic_factor;
-				material_uniform_buffer_info.roughnessFactor = entity.m_roughness_factor;
-				material_uniform_buffer_info.normalScale = entity.m_normal_scale;
-				material_uniform_buffer_info.occlusionStrength = entity.m_occlusion_strength;
-				material_uniform_buffer_info.emessiveFactor = entity.m_emissive_factor;
-				rhi->unmapMemory(inefficient_staging_buffer_memory);
-
-				RHIBufferCreateInfo buffer_info = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
-				buffer_info.size = buffer_size;
-				buffer_info.usage = RHI_BUFFER_USAGE_UNIFORM_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
-				VmaAllocationCreateInfo alloc_info = {};
-				alloc_info.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-				rhi->createBufferWithAlignmentVMA(
-					vulkan_context->m_assets_allocator, &buffer_info, &alloc_info,
-					m_global_render_resource.m_storage_buffer.m_min_uniform_buffer_offset_alignment,
-					material.material_uniform_buffer, &material.material_uniform_buffer_allocation, nullptr
-				);
-
-				rhi->copyBuffer(inefficient_staging_buffer, material.material_uniform_buffer, 0, 0, buffer_size);
-				rhi->destroyBuffer(inefficient_staging_buffer);
-				rhi->freeMemory(inefficient_staging_buffer_memory);
-			}
-
-			TextureDataToUpdate update_texture_data;
+			createVulkanMaterial(rhi, entity, material_data, material);
+			_uploading_material_asset_ids.push_back(assetid);
+			return material;
+		}
+	}
 
-			update_texture_data.base_color_image_pixels = base_color_image_pixels;
-			update_texture_data.base_color_image_width = base_color_image_width;
-			update_texture_data.base_color_image_height = base_color_image_height;
-			update_texture_data.base_color_image_format = base_color_image_format;
+	void RenderResource::createVulkanMaterial(std::shared_ptr<RHI> rhi, const RenderEntity& entity, const RenderMaterialData& material_data, VulkanPBRMaterial& material) {
+		material.upload_id = 0;
+		material.is_ready = false;
+
+		float empty_image[] = { 0.5f,0.5f,0.5f,0.5f };
+
+		void* base_color_image_pixels = empty_image;
+		uint32_t base_color_image_width = 1;
+		uint32_t base_color_image_height = 1;
+		RHIFormat base_color_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB;
+		uint32_t base_color_image_miplevels = 1;
+		if (material_data.m_base_color_texture) {
+			base_color_image_pixels = material_data.m_base_color_texture->m_pixels;
+			base_color_image_width = static_cast<uint32_t>(material_data.m_base_color_texture->m_width);
+			base_color_image_height = static_cast<uint32_t>(material_data.m_base_color_texture->m_height);
+			base_color_image_format = material_data.m_base_color_texture->m_format;
+			base_color_image_miplevels = material_data.m_base_color_texture->m_mip_levels;
+		}
 
-			update_texture_data.metallic_roughness_image_pixels = metallic_roughness_image_pixels;
-			update_texture_data.metallic_roughness_image_width = metallic_roughness_image_width;
-			update_texture_data.metallic_roughness_image_height = metallic_roughness_image_height;
-			update_texture_data.metallic_roughness_image_format = metallic_roughness_image_format;
+		void* metallic_roughness_image_pixels = empty_image;
+		uint32_t metallic_roughness_image_width = 1;
+		uint32_t metallic_roughness_image_height = 1;
+		RHIFormat metallic_roughness_image_format = RHI_FORMAT_R8G8B8A8_UNORM;
+		uint32_t metallic_roughness_image_miplevels = 1;
+		if (material_data.m_metallic_roughness_texture) {
+			metallic_roughness_image_pixels = material_data.m_metallic_roughness_texture->m_pixels;
+			metallic_roughness_image_width = material_data.m_metallic_roughness_texture->m_width;
+			metallic_roughness_image_height = material_data.m_metallic_roughness_texture->m_height;
+			metallic_roughness_image_format = material_data.m_metallic_roughness_texture->m_format;
+			metallic_roughness_image_miplevels = material_data.m_metallic_roughness_texture->m_mip_levels;
+		}
 
-			update_texture_data.normal_image_pixels = normal_image_pixels;
-			update_texture_data.normal_image_width = normal_image_width;
-			update_texture_data.normal_image_height = normal_image_height;
-			update_texture_data.normal_image_format = normal_image_format;
+		void* normal_image_pixels = empty_image;
+		uint32_t normal_image_width = 1;
+		uint32_t normal_image_height = 1;
+		RHIFormat normal_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
+		uint32_t normal_image_miplevels = 1;
+		if (material_data.m_normal_texture) {
+			normal_image_pixels = material_data.m_normal_texture->m_pixels;
+			normal_image_width = static_cast<uint32_t>(material_data.m_normal_texture->m_width);
+			normal_image_height = static_cast<uint32_t>(material_data.m_normal_texture->m_height);
+			normal_image_format = material_data.m_normal_texture->m_format;
+			normal_image_miplevels = material_data.m_normal_texture->m_mip_levels;
+		}
 
-			update_texture_data.occlusion_image_pixels = occlusion_image_pixels;
-			update_texture_data.occlusion_image_width = occlusion_image_width;
-			update_texture_data.occlusion_image_height = occlusion_image_height;
-			update_texture_data.occlusion_image_format = occlusion_image_format;
+		void* occlusion_image_pixels = empty_image;
+		uint32_t occlusion_image_width = 1;
+		uint32_t occlusion_image_height = 1;
+		RHIFormat occlusion_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
+		uint32_t occlusion_image_miplevels = 1;
+		if (material_data.m_occlusion_texture) {
+			occlusion_image_pixels = material_data.m_occlusion_texture->m_pixels;
+			occlusion_image_width = static_cast<uint32_t>(material_data.m_occlusion_texture->m_width);
+			occlusion_image_height = static_cast<uint32_t>(material_data.m_occlusion_texture->m_height);
+			occlusion_image_format = material_data.m_occlusion_texture->m_format;
+			occlusion_image_miplevels = material_data.m_occlusion_texture->m_mip_levels;
+		}
 
-			update_texture_data.emissive_image_pixels = emissive_image_pixels;
-			update_texture_data.emissive_image_width = emissive_image_width;
-			update_texture_data.emissive_image_height = emissive_image_height;
-			update_texture_data.emissive_image_format = emissive_image_format;
+		void* emissive_image_pixels = empty_image;
+		uint32_t emissive_image_width = 1;
+		uint32_t emissive_image_height = 1;
+		RHIFormat emissive_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
+		uint32_t emissive_image_miplevels = 1;
+		if (material_data.m_emissive_texture) {
+			emissive_image_pixels = material_data.m_emissive_texture->m_pixels;
+			emissive_image_width = static_cast<uint32_t>(material_data.m_emissive_texture->m_width);
+			emissive_image_height = static_cast<uint32_t>(material_data.m_emissive_texture->m_height);
+			emissive_image_format = material_data.m_emissive_texture->m_format;
+			emissive_image_miplevels = material_data.m_emissive_texture->m_mip_levels;
+		}
 
-			update_texture_data.now_material = &material;
+		{
+			MeshPerMaterialUniformBufferObject material_uniform_buffer_info;
+			material_uniform_buffer_info.is_blend = entity.m_blend;
+			material_uniform_buffer_info.is_double_sided = entity.m_double_sided;
+			material_uniform_buffer_info.baseColorFractor = entity.m_base_color_factor;
+			material_uniform_buffer_info.metallicFactor = entity.m_metallic_factor;
+			material_uniform_buffer_info.roughnessFactor = entity.m_roughness_factor;
+			material_uniform_buffer_info.normalScale = entity.m_normal_scale;
+			material_uniform_buffer_info.occlusionStrength = entity.m_occlusion_strength;
+			material_uniform_buffer_info.emessiveFactor = entity.m_emissive_factor;
+
+			RHIDeviceSize buffer_size = sizeof(MeshPerMaterialUniformBufferObject);
+			RHIBufferCreateInfo buffer_info = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+			buffer_info.size = buffer_size;
+			buffer_info.usage = RHI_BUFFER_USAGE_UNIFORM_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
+			VmaAllocationCreateInfo alloc_info = {};
+			alloc_info.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+			rhi->createBufferWithAlignmentVMA(
+				rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
+				m_global_render_resource.m_storage_buffer.m_min_uniform_buffer_offset_alignment,
+				material.material_uniform_buffer, &material.material_uniform_buffer_allocation, nullptr
+			);
 
-			updateTextureImageData(rhi, update_texture_data);
-			RHIDescriptorSetAllocateInfo material_descriptor_set_alloc_info;
-			material_descriptor_set_alloc_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			material_descriptor_set_alloc_info.pNext = nullptr;
-			material_descriptor_set_alloc_info.descriptorPool = vulkan_context->m_descriptor_pool;
-			material_descriptor_set_alloc_info.descriptorSetCount = 1;
-			material_descriptor_set_alloc_info.pSetLayouts = m_material_descriptor_set_layout;
+			material.upload_id = std::max(material.upload_id, rhi->uploadBuffer(material.material_uniform_buffer, 0, &material_uniform_buffer_info, buffer_size));
+		}
 
-			bool success = rhi->allocateDescriptorSets(&material_descriptor_set_alloc_info, material.material_descriptor_set) == RHI_SUCCESS;
-			if (!success) {
-				LOG_FATAL("allocate material descriptor set failed");
-			}
+		TextureDataToUpdate update_texture_data;
+
+		update_texture_data.base_color_image_pixels = base_color_image_pixels;
+		update_texture_data.base_color_image_width = base_color_image_width;
+		update_texture_data.base_color_image_height = base_color_image_height;
+		update_texture_data.base_color_image_format = base_color_image_format;
+		update_texture_data.base_color_image_miplevels = base_color_image_miplevels;
+
+		update_texture_data.metallic_roughness_image_pixels = metallic_roughness_image_pixels;
+		update_texture_data.metallic_roughness_image_width = metallic_roughness_image_width;
+		update_texture_data.metallic_roughness_image_height = metallic_roughness_image_height;
+		update_texture_data.metallic_roughness_image_format = metallic_roughness_image_format;
+		update_texture_data.metallic_roughness_image_miplevels = metallic_roughness_image_miplevels;
+
+		update_texture_data.normal_image_pixels = normal_image_pixels;
+		update_texture_data.normal_image_width = normal_image_width;
+		update_texture_data.normal_image_height = normal_image_height;
+		update_texture_data.normal_image_format = normal_image_format;
+		update_texture_data.normal_image_miplevels = normal_image_miplevels;
+
+		update_texture_data.occlusion_image_pixels = occlusion_image_pixels;
+		update_texture_data.occlusion_image_width = occlusion_image_width;
+		update_texture_data.occlusion_image_height = occlusion_image_height;
+		update_texture_data.occlusion_image_format = occlusion_image_format;
+		update_texture_data.occlusion_image_miplevels = occlusion_image_miplevels;
+
+		update_texture_data.emissive_image_pixels = emissive_image_pixels;
+		update_texture_data.emissive_image_width = emissive_image_width;
+		update_texture_data.emissive_image_height = emissive_image_height;
+		update_texture_data.emissive_image_format = emissive_image_format;
+		update_texture_data.emissive_image_miplevels = emissive_image_miplevels;
+
+		update_texture_data.now_material = &material;
+
+		updateTextureImageData(rhi, update_texture_data);
+		RHIDescriptorSetAllocateInfo material_descriptor_set_alloc_info;
+		material_descriptor_set_alloc_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		material_descriptor_set_alloc_info.pNext = nullptr;
+		material_descriptor_set_alloc_info.descriptorPool = rhi->getDescriptorPool();
+		material_descriptor_set_alloc_info.descriptorSetCount = 1;
+		material_descriptor_set_alloc_info.pSetLayouts = m_material_descriptor_set_layout;
+
+		bool success = rhi->allocateDescriptorSets(&material_descriptor_set_alloc_info, material.material_descriptor_set) == RHI_SUCCESS;
+		if (!success) {
+			LOG_FATAL("allocate material descriptor set failed");
+		}
 
-			RHIDescriptorBufferInfo material_uniform_buffer_info = {};
-			material_uniform_buffer_info.offset = 0;
-			material_uniform_buffer_info.range = sizeof(MeshPerMaterialUniformBufferObject);
-			material_uniform_buffer_info.buffer = material.material_uniform_buffer;
-
-			RHIDescriptorImageInfo base_color_image_info = {};
-			base_color_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			base_color_image_info.imageView = material.base_color_image_view;
-			base_color_image_info.sampler = rhi->getOrCreateMipmapSampler(base_color_image_width, base_color_image_height);
-
-			RHIDescriptorImageInfo metallic_roughness_image_info = {};
-			metallic_roughness_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			metallic_roughness_image_info.imageView = material.metallic_roughness_image_view;
-			metallic_roughness_image_info.sampler = rhi->getOrCreateMipmapSampler(metallic_roughness_image_width, metallic_roughness_image_height);
-
-			RHIDescriptorImageInfo normal_image_info = {};
-			normal_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			normal_image_info.imageView = material.normal_image_view;
-			normal_image_info.sampler = rhi->getOrCreateMipmapSampler(normal_image_width, normal_image_height);
-
-			RHIDescriptorImageInfo occlusion_image_info = {};
-			occlusion_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			occlusion_image_info.imageView = material.occlusion_image_view;
-			occlusion_image_info.sampler = rhi->getOrCreateMipmapSampler(occlusion_image_width, occlusion_image_height);
-
-			RHIDescriptorImageInfo emissive_image_info = {};
-			emissive_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			emissive_image_info.imageView = material.emissive_image_view;
-			emissive_image_info.sampler = rhi->getOrCreateMipmapSampler(emissive_image_width, emissive_image_height);
-
-			RHIWriteDescriptorSet mesh_descriptor_writes_info[6];
-
-			mesh_descriptor_writes_info[0].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			mesh_descriptor_writes_info[0].pNext = nullptr;
-			mesh_descriptor_writes_info[0].dstSet = material.material_descriptor_set;
-			mesh_descriptor_writes_info[0].dstBinding = 0;
-			mesh_descriptor_writes_info[0].dstArrayElement = 0;
-			mesh_descriptor_writes_info[0].descriptorType = RHI_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			mesh_descriptor_writes_info[0].descriptorCount = 1;
-			mesh_descriptor_writes_info[0].pBufferInfo = &material_uniform_buffer_info;
-
-			mesh_descriptor_writes_info[1].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			mesh_descriptor_writes_info[1].pNext = nullptr;
-			mesh_descriptor_writes_info[1].dstSet = material.material_descriptor_set;
-			mesh_descriptor_writes_info[1].dstBinding = 1;
-			mesh_descriptor_writes_info[1].dstArrayElement = 0;
-			mesh_descriptor_writes_info[1].descriptorType = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			mesh_descriptor_writes_info[1].descriptorCount = 1;
-			mesh_descriptor_writes_info[1].pImageInfo = &base_color_image_info;
-
-			mesh_descriptor_writes_info[2] = mesh_descriptor_writes_info[1];
-			mesh_descriptor_writes_info[2].dstBinding = 2;
-			mesh_descriptor_writes_info[2].pImageInfo = &metallic_roughness_image_info;
-
-			mesh_descriptor_writes_info[3] = mesh_descriptor_writes_info[1];
-			mesh_descriptor_writes_info[3].dstBinding = 3;
-			mesh_descriptor_writes_info[3].pImageInfo = &normal_image_info;
-
-			mesh_descriptor_writes_info[4] = mesh_descriptor_writes_info[1];
-			mesh_descriptor_writes_info[4].dstBinding = 4;
-			mesh_descriptor_writes_info[5].pImageInfo = &occlusion_image_info;
-
-			mesh_descriptor_writes_info[5] = mesh_descriptor_writes_info[1];
-			mesh_descriptor_writes_info[5].dstBinding = 5;
-			mesh_descriptor_writes_info[5].pImageInfo = &emissive_image_info;
-
-			rhi->updateDescriptorSets(6, mesh_descriptor_writes_info, 0, nullptr);
+		RHIDescriptorBufferInfo material_uniform_buffer_info = {};
+		material_uniform_buffer_info.offset = 0;
+		material_uniform_buffer_info.range = sizeof(MeshPerMaterialUniformBufferObject);
+		material_uniform_buffer_info.buffer = material.material_uniform_buffer;
+
+		RHIDescriptorImageInfo base_color_image_info = {};
+		base_color_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		base_color_image_info.imageView = material.base_color_image_view;
+		base_color_image_info.sampler = rhi->getOrCreateMipmapSampler(base_color_image_width, base_color_image_height);
+
+		RHIDescriptorImageInfo metallic_roughness_image_info = {};
+		metallic_roughness_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		metallic_roughness_image_info.imageView = material.metallic_roughness_image_view;
+		metallic_roughness_image_info.sampler = rhi->getOrCreateMipmapSampler(metallic_roughness_image_width, metallic_roughness_image_height);
+
+		RHIDescriptorImageInfo normal_image_info = {};
+		normal_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		normal_image_info.imageView = material.normal_image_view;
+		normal_image_info.sampler = rhi->getOrCreateMipmapSampler(normal_image_width, normal_image_height);
+
+		RHIDescriptorImageInfo occlusion_image_info = {};
+		occlusion_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		occlusion_image_info.imageView = material.occlusion_image_view;
+		occlusion_image_info.sampler = rhi->getOrCreateMipmapSampler(occlusion_image_width, occlusion_image_height);
+
+		RHIDescriptorImageInfo emissive_image_info = {};
+		emissive_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		emissive_image_info.imageView = material.emissive_image_view;
+		emissive_image_info.sampler = rhi->getOrCreateMipmapSampler(emissive_image_width, emissive_image_height);
+
+		RHIWriteDescriptorSet mesh_descriptor_writes_info[6];
+
+		mesh_descriptor_writes_info[0].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		mesh_descriptor_writes_info[0].pNext = nullptr;
+		mesh_descriptor_writes_info[0].dstSet = material.material_descriptor_set;
+		mesh_descriptor_writes_info[0].dstBinding = 0;
+		mesh_descriptor_writes_info[0].dstArrayElement = 0;
+		mesh_descriptor_writes_info[0].descriptorType = RHI_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		mesh_descriptor_writes_info[0].descriptorCount = 1;
+		mesh_descriptor_writes_info[0].pBufferInfo = &material_uniform_buffer_info;
+
+		mesh_descriptor_writes_info[1].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		mesh_descriptor_writes_info[1].pNext = nullptr;
+		mesh_descriptor_writes_info[1].dstSet = material.material_descriptor_set;
+		mesh_descriptor_writes_info[1].dstBinding = 1;
+		mesh_descriptor_writes_info[1].dstArrayElement = 0;
+		mesh_descriptor_writes_info[1].descriptorType = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		mesh_descriptor_writes_info[1].descriptorCount = 1;
+		mesh_descriptor_writes_info[1].pImageInfo = &base_color_image_info;
+
+		mesh_descriptor_writes_info[2] = mesh_descriptor_writes_info[1];
+		mesh_descriptor_writes_info[2].dstBinding = 2;
+		mesh_descriptor_writes_info[2].pImageInfo = &metallic_roughness_image_info;
+
+		mesh_descriptor_writes_info[3] = mesh_descriptor_writes_info[1];
+		mesh_descriptor_writes_info[3].dstBinding = 3;
+		mesh_descriptor_writes_info[3].pImageInfo = &normal_image_info;
+
+		mesh_descriptor_writes_info[4] = mesh_descriptor_writes_info[1];
+		mesh_descriptor_writes_info[4].dstBinding = 4;
+		mesh_descriptor_writes_info[5].pImageInfo = &occlusion_image_info;
+
+		mesh_descriptor_writes_info[5] = mesh_descriptor_writes_info[1];
+		mesh_descriptor_writes_info[5].dstBinding = 5;
+		mesh_descriptor_writes_info[5].pImageInfo = &emissive_image_info;
+
+		rhi->updateDescriptorSets(6, mesh_descriptor_writes_info, 0, nullptr);
 
-			return material;
-		}
 	}
 
-	void RenderResource::updateMeshData(std::shared_ptr<RHI> rhi, bool enable_vertex_blending, uint32_t index_buffer_size, void* index_buffer_data, uint32_t vertex_buffer_size, MeshVertexDataDefinition const* vertex_buffer_data, uint32_t joint_binding_buffer_size, MeshVertexBindingDataDefinition const* joint_binding_buffer_data, VulkanMesh& mesh) {
+	void RenderResource::updateMeshData(std::shared_ptr<RHI> rhi, bool enable_vertex_blending, RHIIndexType index_type, uint32_t index_buffer_size, void const* index_buffer_data, uint32_t vertex_buffer_size, MeshVertexDataDefinition const* vertex_buffer_data, uint32_t joint_binding_buffer_size, MeshVertexBindingDataDefinition const* joint_binding_buffer_data, VulkanMesh& mesh) {
 		mesh.enable_vertex_blending = enable_vertex_blending;
 		ASSERT((vertex_buffer_size % sizeof(MeshVertexDataDefinition)) == 0);
 		mesh.mesh_vertex_count = vertex_buffer_size / sizeof(MeshVertexDataDefinition);
+		const uint32_t index_stride = getIndexStride(index_type);
+		ASSERT((index_buffer_size % index_stride) == 0);
+		//static meshes go into the mesh pool so the mesh passes can draw them indirectly,
+		//skinned meshes index their joint bindings by vertex index and keep their own buffers.
+		//the pool index buffer is 16 bit, meshes with 32 bit indices keep their own buffers as well
+		mesh.mesh_index_type = index_type;
+		mesh.mesh_first_vertex = 0;
+		mesh.mesh_first_index = 0;
+		mesh.in_mesh_pool = !enable_vertex_blending && index_type == RHI_INDEX_TYPE_UINT16 && m_global_render_resource.m_mesh_pool.allocate(
+			mesh.mesh_vertex_count, index_buffer_size / index_stride,
+			mesh.mesh_first_vertex, mesh.mesh_first_index
+		);
 		updateVertexBuffer(
 			rhi, enable_vertex_blending, vertex_buffer_size, vertex_buffer_data,
-			joint_binding_buffer_size, joint_binding_buffer_data, index_buffer_size,
-			reinterpret_cast<uint16_t*>(index_buffer_data), mesh
+			joint_binding_buffer_size, joint_binding_buffer_data, index_type, index_buffer_size,
+			index_buffer_data, mesh
 		);
-		ASSERT((index_buffer_size % sizeof(uint16_t)) == 0);
-		mesh.mesh_index_count = index_buffer_size / sizeof(uint16_t);
+		mesh.mesh_index_count = index_buffer_size / index_stride;
 		updateIndexBuffer(rhi, index_buffer_size, index_buffer_data, mesh);
 	}
 
-	void RenderResource::updateVertexBuffer(std::shared_ptr<RHI> rhi, bool enable_vertex_blending, uint32_t vertex_buffer_size, MeshVertexDataDefinition const* vertex_buffer_data, uint32_t joint_binding_buffer_size, MeshVertexBindingDataDefinition const* joint_binding_buffer_data, uint32_t index_buffer_size, uint16_t* index_buffer_data, VulkanMesh& mesh) {
-		VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
+	void RenderResource::updateVertexBuffer(std::shared_ptr<RHI> rhi, bool enable_vertex_blending, uint32_t vertex_buffer_size, MeshVertexDataDefinition const* vertex_buffer_data, uint32_t joint_binding_buffer_size, MeshVertexBindingDataDefinition const* joint_binding_buffer_data, RHIIndexType index_type, uint32_t index_buffer_size, void const* index_buffer_data, VulkanMesh& mesh) {
 		if (enable_vertex_blending) {
 			ASSERT((vertex_buffer_size % sizeof(MeshVertexDataDefinition)) == 0);
 			uint32_t vertex_count = vertex_buffer_size / sizeof(MeshVertexDataDefinition);
-			ASSERT((index_buffer_size % sizeof(uint16_t)) == 0);
-			uint32_t index_count = index_buffer_size / sizeof(uint16_t);
+			ASSERT((index_buffer_size % getIndexStride(index_type)) == 0);
+			uint32_t index_count = index_buffer_size / getIndexStride(index_type);
 
 			RHIDeviceSize vertex_position_buffer_size = sizeof(MeshVertex::VulkanMeshVertexPosition) * vertex_count;
 			RHIDeviceSize vertex_varying_enable_blending_buffer_size = sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * vertex_count;
@@ -505,20 +539,11 @@ namespace Dao {
 			RHIDeviceSize vertex_varying_buffer_offset = vertex_varying_enable_blending_buffer_offset + vertex_varying_enable_blending_buffer_size;
 			RHIDeviceSize vertex_joint_binding_buffer_offset = vertex_varying_buffer_offset + vertex_varying_buffer_size;
 
-			//temporary staging buffer
-			RHIDeviceSize inefficient_staging_buffer_size = vertex_position_buffer_size + vertex_varying_enable_blending_buffer_size + vertex_varying_buffer_size + vertex_joint_binding_buffer_size;
-			RHIBuffer* inefficient_staging_buffer = RHI_NULL_HANDLE;
-			RHIDeviceMemory* inefficient_staging_buffer_memory = RHI_NULL_HANDLE;
-			rhi->createBuffer(
-				inefficient_staging_buffer_size, RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-				inefficient_staging_buffer,
-				inefficient_staging_buffer_memory
-			);
-			void* inefficient_staging_buffer_data;
-			rhi->mapMemory(inefficient_staging_buffer_memory, 0, RHI_WHOLE_SIZE, 0, &inefficient_staging_buffer_data);
+			//converted vertex data, copied into the staging ring by uploadBuffer
+			RHIDeviceSize vertex_data_size = vertex_position_buffer_size + vertex_varying_enable_blending_buffer_size + vertex_varying_buffer_size + vertex_joint_binding_buffer_size;
+			std::vector<uint8_t> vertex_data(static_cast<size_t>(vertex_data_size));
 
-			uintptr_t init_address = reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data);
+			uintptr_t init_address = reinterpret_cast<uintptr_t>(vertex_data.data());
 			MeshVertex::VulkanMeshVertexPosition* mesh_verex_positions = reinterpret_cast<MeshVertex::VulkanMeshVertexPosition*>(init_address + vertex_position_buffer_offset);
 			MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_enable_blending_varyings = reinterpret_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(init_address + vertex_varying_enable_blending_buffer_offset);
 			MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings = reinterpret_cast<MeshVertex::VulkanMeshVertexVarying*>(init_address + vertex_varying_buffer_offset);
@@ -552,7 +577,9 @@ namespace Dao {
 
 			for (uint32_t index_index = 0; index_index < index_count; ++index_index) {
 				//TODO(move to assets loading process)
-				uint32_t vertex_buffer_index = index_buffer_data[index_index];
+				uint32_t vertex_buffer_index = index_type == RHI_INDEX_TYPE_UINT32 ?
+					static_cast<uint32_t const*>(index_buffer_data)[index_index] :
+					static_cast<uint16_t const*>(index_buffer_data)[index_index];
 				mesh_vertex_joint_binding[index_index].indices[0] = joint_binding_buffer_data[vertex_buffer_index].m_index0;
 				mesh_vertex_joint_binding[index_index].indices[1] = joint_binding_buffer_data[vertex_buffer_index].m_index1;
 				mesh_vertex_joint_binding[index_index].indices[2] = joint_binding_buffer_data[vertex_buffer_index].m_index2;
@@ -567,7 +594,6 @@ namespace Dao {
 				);
 				mesh_vertex_joint_binding[index_index].weights = weigts;
 			}
-			rhi->unmapMemory(inefficient_staging_buffer_memory);
 
 			//use vamAllocator to allocate asset vertex buffer
 			RHIBufferCreateInfo buffer_info = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
@@ -576,55 +602,52 @@ namespace Dao {
 			buffer_info.usage = RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
 			buffer_info.size = vertex_position_buffer_size;
 			rhi->createBufferVMA(
-				vulkan_context->m_assets_allocator, &buffer_info, &alloc_info,
+				rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
 				mesh.mesh_vertex_position_buffer,
 				&mesh.mesh_vertex_position_buffer_allocation, nullptr
 			);
 			buffer_info.size = vertex_varying_enable_blending_buffer_size;
 			rhi->createBufferVMA(
-				vulkan_context->m_assets_allocator, &buffer_info, &alloc_info,
+				rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
 				mesh.mesh_vertex_varying_enable_blending_buffer,
 				&mesh.mesh_vertex_varying_enable_blending_buffer_allocation, nullptr
 			);
 			buffer_info.size = vertex_varying_buffer_size;
 			rhi->createBufferVMA(
-				vulkan_context->m_assets_allocator, &buffer_info, &alloc_info,
+				rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
 				mesh.mesh_vertex_varying_buffer,
 				&mesh.mesh_vertex_varying_buffer_allocation, nullptr
 			);
 			buffer_info.usage = RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
 			buffer_info.size = vertex_joint_binding_buffer_size;
 			rhi->createBufferVMA(
-				vulkan_context->m_assets_allocator, &buffer_info, &alloc_info,
+				rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
 				mesh.mesh_vertex_joint_binding_buffer,
 				&mesh.mesh_vertex_joint_binding_buffer_allocation, nullptr
 			);
-			//use date from staging buffer
-			rhi->copyBuffer(
-				inefficient_staging_buffer, mesh.mesh_vertex_position_buffer,
-				vertex_position_buffer_offset, 0, vertex_position_buffer_size
-			);
-			rhi->copyBuffer(
-				inefficient_staging_buffer, mesh.mesh_vertex_varying_enable_blending_buffer,
-				vertex_varying_enable_blending_buffer_offset, 0, vertex_varying_enable_blending_buffer_size
-			);
-			rhi->copyBuffer(
-				inefficient_staging_buffer, mesh.mesh_vertex_varying_buffer,
-				vertex_varying_buffer_offset, 0, vertex_varying_buffer_size
-			);
-			rhi->copyBuffer(
-				inefficient_staging_buffer, mesh.mesh_vertex_joint_binding_buffer,
-				vertex_joint_binding_buffer_offset, 0, vertex_joint_binding_buffer_size
-			);
-			//release staging buffer
-			rhi->destroyBuffer(inefficient_staging_buffer);
-			rhi->freeMemory(inefficient_staging_buffer_memory);
+			//the copies run on the transfer queue, the mesh is drawn once they completed
+			mesh.upload_id = std::max(mesh.upload_id, rhi->uploadBuffer(
+				mesh.mesh_vertex_position_buffer, 0,
+				vertex_data.data() + vertex_position_buffer_offset, vertex_position_buffer_size
+			));
+			mesh.upload_id = std::max(mesh.upload_id, rhi->uploadBuffer(
+				mesh.mesh_vertex_varying_enable_blending_buffer, 0,
+				vertex_data.data() + vertex_varying_enable_blending_buffer_offset, vertex_varying_enable_blending_buffer_size
+			));
+			mesh.upload_id = std::max(mesh.upload_id, rhi->uploadBuffer(
+				mesh.mesh_vertex_varying_buffer, 0,
+				vertex_data.data() + vertex_varying_buffer_offset, vertex_varying_buffer_size
+			));
+			mesh.upload_id = std::max(mesh.upload_id, rhi->uploadBuffer(
+				mesh.mesh_vertex_joint_binding_buffer, 0,
+				vertex_data.data() + vertex_joint_binding_buffer_offset, vertex_joint_binding_buffer_size
+			));
 
 			//update descriptor set
 			RHIDescriptorSetAllocateInfo mesh_vertex_blending_per_mesh_descriptor_set_alloc_info{};
 			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.pNext = nullptr;
-			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorPool = vulkan_context->m_descriptor_pool;
+			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorPool = rhi->getDescriptorPool();
 			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorSetCount = 1;
 			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.pSetLayouts = m_mesh_descriptor_set_layout;
 			auto success = rhi->allocateDescriptorSets(&mesh_vertex_blending_per_mesh_descriptor_set_alloc_info, mesh.mesh_vertex_blending_descriptor_set) == RHI_SUCCESS;
@@ -666,20 +689,11 @@ namespace Dao {
 			RHIDeviceSize vertex_varying_enable_blending_buffer_offset = vertex_position_buffer_offset + vertex_position_buffer_size;
 			RHIDeviceSize vertex_varying_buffer_offset = vertex_varying_enable_blending_buffer_offset + vertex_varying_enable_blending_buffer_size;
 
-			//temporary staging buffer
-			RHIDeviceSize inefficient_staging_buffer_size = vertex_position_buffer_size + vertex_varying_enable_blending_buffer_size + vertex_varying_buffer_size;
-			RHIBuffer* inefficient_staging_buffer = RHI_NULL_HANDLE;
-			RHIDeviceMemory* inefficient_staging_buffer_memory = RHI_NULL_HANDLE;
-			rhi->createBuffer(
-				inefficient_staging_buffer_size, RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-				inefficient_staging_buffer,
-				inefficient_staging_buffer_memory
-			);
-			void* inefficient_staging_buffer_data;
-			rhi->mapMemory(inefficient_staging_buffer_memory, 0, RHI_WHOLE_SIZE, 0, &inefficient_staging_buffer_data);
+			//converted vertex data, copied into the staging ring by uploadBuffer
+			RHIDeviceSize vertex_data_size = vertex_position_buffer_size + vertex_varying_enable_blending_buffer_size + vertex_varying_buffer_size;
+			std::vector<uint8_t> vertex_data(static_cast<size_t>(vertex_data_size));
 
-			uintptr_t init_address = reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data);
+			uintptr_t init_address = reinterpret_cast<uintptr_t>(vertex_data.data());
 			MeshVertex::VulkanMeshVertexPosition* mesh_verex_positions = reinterpret_cast<MeshVertex::VulkanMeshVertexPosition*>(init_address + vertex_position_buffer_offset);
 			MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_enable_blending_varyings = reinterpret_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(init_address + vertex_varying_enable_blending_buffer_offset);
 			MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings = reinterpret_cast<MeshVertex::VulkanMeshVertexVarying*>(init_address + vertex_varying_buffer_offset);
@@ -709,55 +723,68 @@ namespace Dao {
 				mesh_vertex_enable_blending_varyings[vertex_index].tangent = tangent;
 				mesh_vertex_varyings[vertex_index].texcoord = texcoord;
 			}
-			rhi->unmapMemory(inefficient_staging_buffer_memory);
-
-			//use vamAllocator to allocate asset vertex buffer
-			RHIBufferCreateInfo buffer_info = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
-			VmaAllocationCreateInfo alloc_info = {};
-			alloc_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-			buffer_info.usage = RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
-			buffer_info.size = vertex_position_buffer_size;
-			rhi->createBufferVMA(
-				vulkan_context->m_assets_allocator, &buffer_info, &alloc_info,
-				mesh.mesh_vertex_position_buffer,
-				&mesh.mesh_vertex_position_buffer_allocation, nullptr
-			);
-			buffer_info.size = vertex_varying_enable_blending_buffer_size;
-			rhi->createBufferVMA(
-				vulkan_context->m_assets_allocator, &buffer_info, &alloc_info,
-				mesh.mesh_vertex_varying_enable_blending_buffer,
-				&mesh.mesh_vertex_varying_enable_blending_buffer_allocation, nullptr
-			);
-			buffer_info.size = vertex_varying_buffer_size;
-			rhi->createBufferVMA(
-				vulkan_context->m_assets_allocator, &buffer_info, &alloc_info,
-				mesh.mesh_vertex_varying_buffer,
-				&mesh.mesh_vertex_varying_buffer_allocation, nullptr
-			);
 
-			//use date from staging buffer
-			rhi->copyBuffer(
-				inefficient_staging_buffer, mesh.mesh_vertex_position_buffer,
-				vertex_position_buffer_offset, 0, vertex_position_buffer_size
-			);
-			rhi->copyBuffer(
-				inefficient_staging_buffer, mesh.mesh_vertex_varying_enable_blending_buffer,
-				vertex_varying_enable_blending_buffer_offset, 0, vertex_varying_enable_blending_buffer_size
-			);
-			rhi->copyBuffer(
-				inefficient_staging_buffer, mesh.mesh_vertex_varying_buffer,
-				vertex_varying_buffer_offset, 0, vertex_varying_buffer_size
-			);
+			RHIDeviceSize vertex_position_buffer_dst_offset = 0;
+			RHIDeviceSize vertex_varying_enable_blending_buffer_dst_offset = 0;
+			RHIDeviceSize vertex_varying_buffer_dst_offset = 0;
+			if (mesh.in_mesh_pool) {
+				//write into the vertex range of the mesh pool
+				const RenderMeshPool& mesh_pool = m_global_render_resource.m_mesh_pool;
+				mesh.mesh_vertex_position_buffer = mesh_pool.getVertexPositionBuffer();
+				mesh.mesh_vertex_position_buffer_allocation = nullptr;
+				mesh.mesh_vertex_varying_enable_blending_buffer = mesh_pool.getVertexVaryingEnableBlendingBuffer();
+				mesh.mesh_vertex_varying_enable_blending_buffer_allocation = nullptr;
+				mesh.mesh_vertex_varying_buffer = mesh_pool.getVertexVaryingBuffer();
+				mesh.mesh_vertex_varying_buffer_allocation = nullptr;
+				vertex_position_buffer_dst_offset = sizeof(MeshVertex::VulkanMeshVertexPosition) * mesh.mesh_first_vertex;
+				vertex_varying_enable_blending_buffer_dst_offset = sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * mesh.mesh_first_vertex;
+				vertex_varying_buffer_dst_offset = sizeof(MeshVertex::VulkanMeshVertexVarying) * mesh.mesh_first_vertex;
+			}
+			else {
+				//use vamAllocator to allocate asset vertex buffer
+				RHIBufferCreateInfo buffer_info = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+				VmaAllocationCreateInfo alloc_info = {};
+				alloc_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+				buffer_info.usage = RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
+				buffer_info.size = vertex_position_buffer_size;
+				rhi->createBufferVMA(
+					rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
+					mesh.mesh_vertex_position_buffer,
+					&mesh.mesh_vertex_position_buffer_allocation, nullptr
+				);
+				buffer_info.size = vertex_varying_enable_blending_buffer_size;
+				rhi->createBufferVMA(
+					rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
+					mesh.mesh_vertex_varying_enable_blending_buffer,
+					&mesh.mesh_vertex_varying_enable_blending_buffer_allocation, nullptr
+				);
+				buffer_info.size = vertex_varying_buffer_size;
+				rhi->createBufferVMA(
+					rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
+					mesh.mesh_vertex_varying_buffer,
+					&mesh.mesh_vertex_varying_buffer_allocation, nullptr
+				);
+			}
 
-			//release staging buffer
-			rhi->destroyBuffer(inefficient_staging_buffer);
-			rhi->freeMemory(inefficient_staging_buffer_memory);
+			//the copies run on the transfer queue, the mesh is drawn once they completed
+			mesh.upload_id = std::max(mesh.upload_id, rhi->uploadBuffer(
+				mesh.mesh_vertex_position_buffer, vertex_position_buffer_dst_offset,
+				vertex_data.data() + vertex_position_buffer_offset, vertex_position_buffer_size
+			));
+			mesh.upload_id = std::max(mesh.upload_id, rhi->uploadBuffer(
+				mesh.mesh_vertex_varying_enable_blending_buffer, vertex_varying_enable_blending_buffer_dst_offset,
+				vertex_data.data() + vertex_varying_enable_blending_buffer_offset, vertex_varying_enable_blending_buffer_size
+			));
+			mesh.upload_id = std::max(mesh.upload_id, rhi->uploadBuffer(
+				mesh.mesh_vertex_varying_buffer, vertex_varying_buffer_dst_offset,
+				vertex_data.data() + vertex_varying_buffer_offset, vertex_varying_buffer_size
+			));
 
 			//update descriptor set
 			RHIDescriptorSetAllocateInfo mesh_vertex_blending_per_mesh_descriptor_set_alloc_info;
 			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.pNext = nullptr;
-			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorPool = vulkan_context->m_descriptor_pool;
+			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorPool = rhi->getDescriptorPool();
 			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorSetCount = 1;
 			mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.pSetLayouts = m_mesh_descriptor_set_layout;
 			auto success = rhi->allocateDescriptorSets(&mesh_vertex_blending_per_mesh_descriptor_set_alloc_info, mesh.mesh_vertex_blending_descriptor_set) == RHI_SUCCESS;
@@ -789,93 +816,129 @@ namespace Dao {
 		}
 	}
 
-	void RenderResource::updateIndexBuffer(std::shared_ptr<RHI> rhi, uint32_t index_buffer_size, void* index_buffer_data, VulkanMesh& mesh) {
-		VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
-
-		//temp staging buffer
+	void RenderResource::updateIndexBuffer(std::shared_ptr<RHI> rhi, uint32_t index_buffer_size, void const* index_buffer_data, VulkanMesh& mesh) {
 		RHIDeviceSize buffer_size = index_buffer_size;
-		RHIBuffer* inefficient_staging_buffer;
-		RHIDeviceMemory* inefficient_staging_buffer_memory;
-		rhi->createBuffer(
-			buffer_size, RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-			inefficient_staging_buffer,
-			inefficient_staging_buffer_memory
-		);
-		void* staging_buffer_data;
-		rhi->mapMemory(inefficient_staging_buffer_memory, 0, buffer_size, 0, &staging_buffer_data);
-		memcpy(staging_buffer_data, index_buffer_data, (size_t)buffer_size);
-		rhi->unmapMemory(inefficient_staging_buffer_memory);
-
-		//use vmaAllocator to allocate asset index buffer
-		RHIBufferCreateInfo buffer_info = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
-		buffer_info.size = buffer_size;
-		buffer_info.usage = RHI_BUFFER_USAGE_INDEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
-		VmaAllocationCreateInfo alloc_info = {};
-		alloc_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-		rhi->createBufferVMA(
-			vulkan_context->m_assets_allocator, &buffer_info, &alloc_info,
-			mesh.mesh_index_buffer, &mesh.mesh_index_buffer_allocation, nullptr
-		);
+		RHIDeviceSize dst_offset = 0;
+		if (mesh.in_mesh_pool) {
+			//write into the index range of the mesh pool, indices stay relative to the first vertex of the mesh
+			mesh.mesh_index_buffer = m_global_render_resource.m_mesh_pool.getIndexBuffer();
+			mesh.mesh_index_buffer_allocation = nullptr;
+			dst_offset = sizeof(uint16_t) * mesh.mesh_first_index;
+		}
+		else {
+			//use vmaAllocator to allocate asset index buffer
+			RHIBufferCreateInfo buffer_info = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+			buffer_info.size = buffer_size;
+			buffer_info.usage = RHI_BUFFER_USAGE_INDEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
+			VmaAllocationCreateInfo alloc_info = {};
+			alloc_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+			rhi->createBufferVMA(
+				rhi->getAssetsAllocator(), &buffer_info, &alloc_info,
+				mesh.mesh_index_buffer, &mesh.mesh_index_buffer_allocation, nullptr
+			);
+		}
 
-		//use data form staging buffer
-		rhi->copyBuffer(inefficient_staging_buffer, mesh.mesh_index_buffer, 0, 0, buffer_size);
-		//release temp staging buffer
-		rhi->destroyBuffer(inefficient_staging_buffer);
-		rhi->freeMemory(inefficient_staging_buffer_memory);
+		mesh.upload_id = std::max(mesh.upload_id, rhi->uploadBuffer(mesh.mesh_index_buffer, dst_offset, index_buffer_data, buffer_size));
 	}
 
 	void RenderResource::updateTextureImageData(std::shared_ptr<RHI> rhi, const TextureDataToUpdate& texture_data) {
-		rhi->createGlobalImage(
-			texture_data.now_material->base_color_texture_image,
-			texture_data.now_material->base_color_image_view,
-			texture_data.now_material->base_color_image_allocation,
+		VulkanPBRMaterial& material = *texture_data.now_material;
+		material.upload_id = std::max(material.upload_id, rhi->createGlobalImageAsync(
+			material.base_color_texture_image,
+			material.base_color_image_view,
+			material.base_color_image_allocation,
 			texture_data.base_color_image_width,
 			texture_data.base_color_image_height,
 			texture_data.base_color_image_pixels,
-			texture_data.base_color_image_format
-		);
-		rhi->createGlobalImage(
-			texture_data.now_material->metallic_roughness_texture_image,
-			texture_data.now_material->metallic_roughness_image_view,
-			texture_data.now_material->metallic_roughness_image_allocation,
+			texture_data.base_color_image_format,
+			texture_data.base_color_image_miplevels
+		));
+		material.upload_id = std::max(material.upload_id, rhi->createGlobalImageAsync(
+			material.metallic_roughness_texture_image,
+			material.metallic_roughness_image_view,
+			material.metallic_roughness_image_allocation,
 			texture_data.metallic_roughness_image_width,
 			texture_data.metallic_roughness_image_height,
 			texture_data.metallic_roughness_image_pixels,
-			texture_data.metallic_roughness_image_format
-		);
-		rhi->createGlobalImage(
-			texture_data.now_material->normal_texture_image,
-			texture_data.now_material->normal_image_view,
-			texture_data.now_material->normal_image_allocation,
+			texture_data.metallic_roughness_image_format,
+			texture_data.metallic_roughness_image_miplevels
+		));
+		material.upload_id = std::max(material.upload_id, rhi->createGlobalImageAsync(
+			material.normal_texture_image,
+			material.normal_image_view,
+			material.normal_image_allocation,
 			texture_data.normal_image_width,
 			texture_data.normal_image_height,
 			texture_data.normal_image_pixels,
-			texture_data.normal_image_format
-		);
-		rhi->createGlobalImage(
-			texture_data.now_material->occlusion_texture_image,
-			texture_data.now_material->occlusion_image_view,
-			texture_data.now_material->occlusion_image_allocation,
+			texture_data.normal_image_format,
+			texture_data.normal_image_miplevels
+		));
+		material.upload_id = std::max(material.upload_id, rhi->createGlobalImageAsync(
+			material.occlusion_texture_image,
+			material.occlusion_image_view,
+			material.occlusion_image_allocation,
 			texture_data.occlusion_image_width,
 			texture_data.occlusion_image_height,
 			texture_data.occlusion_image_pixels,
-			texture_data.occlusion_image_format
-		);
-		rhi->createGlobalImage(
-			texture_data.now_material->emissive_texture_image,
-			texture_data.now_material->emissive_image_view,
-			texture_data.now_material->emissive_image_allocation,
+			texture_data.occlusion_image_format,
+			texture_data.occlusion_image_miplevels
+		));
+		material.upload_id = std::max(material.upload_id, rhi->createGlobalImageAsync(
+			material.emissive_texture_image,
+			material.emissive_image_view,
+			material.emissive_image_allocation,
 			texture_data.emissive_image_width,
 			texture_data.emissive_image_height,
 			texture_data.emissive_image_pixels,
-			texture_data.emissive_image_format
-		);
+			texture_data.emissive_image_format,
+			texture_data.emissive_image_miplevels
+		));
 	}
 
-	VulkanMesh& RenderResource::getEntityMesh(RenderEntity entity) {
-		size_t asset_id = entity.m_mesh_asset_id;
-		auto it = m_vulkan_meshs.find(asset_id);
+	void RenderResource::updateUploadStates(std::shared_ptr<RHI> rhi) {
+		if (!_default_material_created) {
+			//shown in place of materials that are still decoding or uploading
+			createVulkanMaterial(rhi, RenderEntity(), RenderMaterialData(), _default_material);
+			_default_material_created = true;
+		}
+
+		rhi->flushUploads();
+
+		if (!_default_material.is_ready) {
+			_default_material.is_ready = rhi->isUploadComplete(_default_material.upload_id);
+		}
+
+		for (size_t i = 0; i < _uploading_mesh_asset_ids.size();) {
+			VulkanMesh& mesh = getMeshByAssetId(_uploading_mesh_asset_ids[i]);
+			if (rhi->isUploadComplete(mesh.upload_id)) {
+				mesh.is_ready = true;
+				_uploading_mesh_asset_ids[i] = _uploading_mesh_asset_ids.back();
+				_uploading_mesh_asset_ids.pop_back();
+			}
+			else {
+				++i;
+			}
+		}
+
+		for (size_t i = 0; i < _uploading_material_asset_ids.size();) {
+			VulkanPBRMaterial& material = getMaterialByAssetId(_uploading_material_asset_ids[i]);
+			if (rhi->isUploadComplete(material.upload_id)) {
+				material.is_ready = true;
+				_uploading_material_asset_ids[i] = _uploading_material_asset_ids.back();
+				_uploading_material_asset_ids.pop_back();
+			}
+			else {
+				++i;
+			}
+		}
+	}
+
+	VulkanMesh& RenderResource::getEntityMesh(const RenderEntity& entity) {
+		return getMeshByAssetId(entity.m_mesh_asset_id);
+	}
+
+	VulkanMesh& RenderResource::getMeshByAssetId(size_t mesh_asset_id) {
+		auto it = m_vulkan_meshs.find(mesh_asset_id);
 		if (it != m_vulkan_meshs.end()) {
 			return it->second;
 		}
@@ -884,9 +947,17 @@ namespace Dao {
 		}
 	}
 
-	VulkanPBRMaterial& RenderResource::getEntityMaterial(RenderEntity entity) {
-		size_t asset_id = entity.m_material_asset_id;
-		auto it = m_vulkan_pbr_material.find(asset_id);
+	VulkanPBRMaterial& RenderResource::getEntityMaterial(const RenderEntity& entity) {
+		return getMaterialByAssetId(entity.m_material_asset_id);
+	}
+
+	VulkanPBRMaterial* RenderResource::findMaterialByAssetId(size_t material_asset_id) {
+		auto it = m_vulkan_pbr_material.find(material_asset_id);
+		return (it != m_vulkan_pbr_material.end()) ? &it->second : nullptr;
+	}
+
+	VulkanPBRMaterial& RenderResource::getMaterialByAssetId(size_t material_asset_id) {
+		auto it = m_vulkan_pbr_material.find(material_asset_id);
 		if (it != m_vulkan_pbr_material.end()) {
 			return it->second;
 		}
@@ -899,10 +970,40 @@ namespace Dao {
 		m_global_render_resource.m_storage_buffer.m_global_upload_ringbuffers_end[current_frame_index] = m_global_render_resource.m_storage_buffer.m_global_upload_ringbuffers_begin[current_frame_index];
 	}
 
+	void RenderResource::flushSceneInstanceBuffer(uint8_t current_frame_index) {
+		m_global_render_resource.m_storage_buffer.m_scene_instance_buffer.flush(current_frame_index);
+	}
+
+	UploadRingbufferAllocator::UploadRingbufferAllocator(StorageBuffer& storage_buffer, uint8_t frame_index)
+		: _storage_buffer(storage_buffer), _frame_index(frame_index) {
+	}
+
+	uint32_t UploadRingbufferAllocator::allocate(uint32_t size) {
+		const uint32_t alignment = _storage_buffer.m_min_storage_buffer_offset_alignment;
+		uint32_t offset = roundUp(_chunk_cursor, alignment);
+		if (_chunk_end == 0 || offset + size > _chunk_end) {
+			//the tail of the previous chunk is dropped
+			const uint32_t chunk_size = std::max(s_chunk_size, size);
+			std::lock_guard<std::mutex> lock(_storage_buffer.m_global_upload_ringbuffer_mutex);
+			offset = roundUp(_storage_buffer.m_global_upload_ringbuffers_end[_frame_index], alignment);
+			_chunk_end = std::min(
+				offset + chunk_size,
+				_storage_buffer.m_global_upload_ringbuffers_begin[_frame_index] + _storage_buffer.m_global_upload_ringbuffers_size[_frame_index]
+			);
+			ASSERT(offset + size <= _chunk_end);
+			_storage_buffer.m_global_upload_ringbuffers_end[_frame_index] = _chunk_end;
+		}
+		_chunk_cursor = offset + size;
+		return offset;
+	}
+
+	void* UploadRingbufferAllocator::getMemoryPointer(uint32_t offset) const {
+		return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(_storage_buffer.m_global_upload_ringbuffer_memory_pointer) + offset);
+	}
+
 	void RenderResource::createAndMapStorageBuffer(std::shared_ptr<RHI> rhi) {
-		VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
 		StorageBuffer& storage_buffer = m_global_render_resource.m_storage_buffer;
-		uint32_t frames_in_flight = vulkan_context->k_max_frames_in_flight;
+		uint32_t frames_in_flight = rhi->getMaxFramesInFlight();
 
 		RHIPhysicalDeviceProperties properties;
 		rhi->getPhysicalDeviceProperties(&properties);
@@ -916,8 +1017,10 @@ namespace Dao {
 		//The size is 128MB in NVIDIA D3D11
 		//driver(https://developer.nvidia.com/content/constant-buffers-without-constant-pain-0).
 		uint32_t global_storage_buffer_size = 1024 * 1024 * 128;
+		//the per drawcall instance index descriptor covers a whole indirect draw, keep its range inside the buffer at the end of the last frame
+		uint32_t global_storage_buffer_tail_size = sizeof(uint32_t) * s_mesh_indirect_max_instance_count;
 		rhi->createBuffer(
-			global_storage_buffer_size, RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			global_storage_buffer_size + global_storage_buffer_tail_size, RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT | RHI_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
 			RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 			storage_buffer.m_global_upload_ringbuffer, storage_buffer.m_global_upload_ringbuffer_memory
 		);
@@ -930,6 +1033,10 @@ namespace Dao {
 			storage_buffer.m_global_upload_ringbuffers_size[i] = (global_storage_buffer_size * (i + 1)) / frames_in_flight - (global_storage_buffer_size * i) / frames_in_flight;
 		}
 
+		//scene instances
+		storage_buffer.m_scene_instance_buffer.initialize(rhi, frames_in_flight);
+		ASSERT(storage_buffer.m_scene_instance_buffer.getBufferSize() <= storage_buffer.m_max_storage_buffer_range);
+
 		//axis
 		rhi->createBuffer(
 			sizeof(AxisStorageBufferObject), RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT,
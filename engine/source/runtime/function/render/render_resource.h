@@ -4,6 +4,8 @@
 #include "runtime/function/render/render_type.h"
 #include "runtime/function/render/interface/rhi.h"
 #include "runtime/function/render/render_common.h"
+#include "runtime/function/render/render_instance_buffer.h"
+#include "runtime/function/render/render_mesh_pool.h"
 
 #include <vma/vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
@@ -11,6 +13,7 @@
 #include <array>
 #include <cstdint>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <cmath>
 
@@ -80,20 +83,46 @@ namespace Dao {
 		std::vector<uint32_t> m_global_upload_ringbuffers_begin;
 		std::vector<uint32_t> m_global_upload_ringbuffers_end;
 		std::vector<uint32_t> m_global_upload_ringbuffers_size;
+		//guards the ringbuffer ends while passes record on job workers, see UploadRingbufferAllocator
+		std::mutex m_global_upload_ringbuffer_mutex;
 
 		RHIBuffer* m_global_null_descriptor_storage_buffer;
 		RHIDeviceMemory* m_global_null_descriptor_storage_buffer_memory;
 
+		//per instance data of the scene, persistent across frames
+		RenderInstanceBuffer m_scene_instance_buffer;
+
 		//axis
 		RHIBuffer* m_axis_inefficient_storage_buffer;
 		RHIDeviceMemory* m_axis_inefficient_storage_buffer_memory;
 		void* m_axis_inefficient_storage_buffer_memory_pointer;
 	};
 
+	/// hands out ranges of the upload ringbuffer of one frame to a single recording thread.
+	/// whole chunks are taken from the shared ringbuffer end under a lock,
+	/// so passes recording in parallel do not synchronize on every per drawcall upload
+	class UploadRingbufferAllocator {
+	public:
+		static constexpr uint32_t s_chunk_size = 256 * 1024;
+
+		UploadRingbufferAllocator(StorageBuffer& storage_buffer, uint8_t frame_index);
+
+		/// @return: offset of size bytes in the ringbuffer, aligned for a dynamic storage buffer binding
+		uint32_t allocate(uint32_t size);
+		void* getMemoryPointer(uint32_t offset) const;
+
+	private:
+		StorageBuffer&	_storage_buffer;
+		uint8_t			_frame_index;
+		uint32_t		_chunk_cursor{ 0 };
+		uint32_t		_chunk_end{ 0 };
+	};
+
 	struct GlobalRenderResource {
 		IBLResource m_ibl_resource;
 		ColorGradingResource m_color_grading_resource;
 		StorageBuffer m_storage_buffer;
+		RenderMeshPool m_mesh_pool;
 	};
 
 	class RenderResource :public RenderResourceBase {
@@ -107,20 +136,20 @@ namespace Dao {
 
 		virtual void uploadGameObjectRenderResource(
 			std::shared_ptr<RHI> rhi,
-			RenderEntity render_entity,
+			const RenderEntity& render_entity,
 			RenderMeshData mesh_data,
 			RenderMaterialData material_data
 		) override final;
 
 		virtual void uploadGameObjectRenderResource(
 			std::shared_ptr<RHI> rhi,
-			RenderEntity render_entity,
+			const RenderEntity& render_entity,
 			RenderMeshData mesh_data
 		) override final;
 
 		virtual void uploadGameObjectRenderResource(
 			std::shared_ptr<RHI> rhi,
-			RenderEntity render_entity,
+			const RenderEntity& render_entity,
 			RenderMaterialData material_data
 		) override final;
 
@@ -129,11 +158,21 @@ namespace Dao {
 			std::shared_ptr<RenderCamera> camera
 		) override final;
 
-		VulkanMesh& getEntityMesh(RenderEntity entity);
+		virtual void updateUploadStates(std::shared_ptr<RHI> rhi) override final;
+
+		VulkanMesh& getEntityMesh(const RenderEntity& entity);
+		VulkanMesh& getMeshByAssetId(size_t mesh_asset_id);
 
-		VulkanPBRMaterial& getEntityMaterial(RenderEntity entity);
+		VulkanPBRMaterial& getEntityMaterial(const RenderEntity& entity);
+		VulkanPBRMaterial& getMaterialByAssetId(size_t material_asset_id);
+		/// @return: nullptr while the material data is still being decoded
+		VulkanPBRMaterial* findMaterialByAssetId(size_t material_asset_id);
+		/// bound in place of materials that are not ready yet
+		VulkanPBRMaterial& getDefaultMaterial() { return _default_material; }
 
 		void resetRingBufferOffset(uint8_t current_frame_index);
+		/// write instances changed by the swap data into the scene instance buffer region of the frame
+		void flushSceneInstanceBuffer(uint8_t current_frame_index);
 
 		GlobalRenderResource									m_global_render_resource;
 
@@ -162,19 +201,26 @@ namespace Dao {
 		);
 		VulkanMesh& getOrCreateVulkanMesh(
 			std::shared_ptr<RHI> rhi, 
-			RenderEntity entity, 
+			const RenderEntity& entity,
 			RenderMeshData mesh_data
 		);
 		VulkanPBRMaterial& getOrCreateVulkanMaterial(
 			std::shared_ptr<RHI> rhi, 
-			RenderEntity entity, 
+			const RenderEntity& entity,
 			RenderMaterialData material_data
 		);
+		void createVulkanMaterial(
+			std::shared_ptr<RHI> rhi,
+			const RenderEntity& entity,
+			const RenderMaterialData& material_data,
+			VulkanPBRMaterial& material
+		);
 		void updateMeshData(
 			std::shared_ptr<RHI> rhi,
 			bool enable_vertex_blending,
+			RHIIndexType index_type,
 			uint32_t index_buffer_size,
-			void* index_buffer_data,
+			void const* index_buffer_data,
 			uint32_t vertex_buffer_size,
 			MeshVertexDataDefinition const* vertex_buffer_data,
 			uint32_t joint_binding_buffer_size,
@@ -188,19 +234,27 @@ namespace Dao {
 			MeshVertexDataDefinition const* vertex_buffer_data,
 			uint32_t joint_binding_buffer_size,
 			MeshVertexBindingDataDefinition const* joint_binding_buffer_data,
+			RHIIndexType index_type,
 			uint32_t index_buffer_size,
-			uint16_t* index_buffer_data,
+			void const* index_buffer_data,
 			VulkanMesh& mesh
 		);
 		void updateIndexBuffer(
 			std::shared_ptr<RHI> rhi,
 			uint32_t index_buffer_size,
-			void* index_buffer_data,
+			void const* index_buffer_data,
 			VulkanMesh& mesh
 		);
 		void updateTextureImageData(
 			std::shared_ptr<RHI> rhi,
 			const TextureDataToUpdate& texture_data
 		);
+
+	private:
+		VulkanPBRMaterial	_default_material;
+		bool				_default_material_created{ false };
+		//asset ids of meshes and materials whose upload has not completed yet
+		std::vector<size_t>	_uploading_mesh_asset_ids;
+		std::vector<size_t>	_uploading_material_asset_ids;
 	};
 }
\ No newline at end of file
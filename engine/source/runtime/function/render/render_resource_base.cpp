@@ -1,6 +1,11 @@
 #include "runtime/function/render/render_resource_base.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/function/render/render_mesh_cooker.h"
+#include "runtime/function/render/render_mesh_optimizer.h"
+#include "runtime/function/render/render_texture_cooker.h"
+#include "runtime/function/render/render_texture_encoder.h"
+#include "runtime/platform/file_system/cooked_file.h"
 #include "runtime/resource/asset_manager/asset_manager.h"
 #include "runtime/resource/config_manager/config_manager.h"
 #include "runtime/resource/res_type/data/mesh_data.h"
@@ -66,11 +71,68 @@ namespace Dao {
 		return texture;
 	}
 
-	RenderMeshData RenderResourceBase::loadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box) {
+	std::shared_ptr<TextureData> RenderResourceBase::loadCookedTexture(const std::string& file, DAO_TEXTURE_USAGE usage, bool* out_is_busy) {
+		if (file.empty()) {
+			return nullptr;
+		}
 		std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
 		ASSERT(asset_manager);
 
+		const std::filesystem::path source_path = asset_manager->getFullPath(file);
+		const std::filesystem::path cooked_path = RenderTextureCooker::getCookedPath(source_path, usage);
+		const int64_t source_write_time = GetCookSourceWriteTime(source_path);
+		std::shared_ptr<TextureData> texture = RenderTextureCooker::load(cooked_path, source_write_time, usage, m_is_texture_compression_enabled);
+		if (texture) {
+			return texture;
+		}
+		//materials often share textures, only the first job encodes one, the others come back for the result later
+		CookedFileLock cooked_file_lock(cooked_path);
+		if (!cooked_file_lock.ownsLock() && out_is_busy) {
+			*out_is_busy = true;
+			return nullptr;
+		}
+		texture = RenderTextureCooker::load(cooked_path, source_write_time, usage, m_is_texture_compression_enabled);
+		if (texture) {
+			return texture;
+		}
+
+		std::shared_ptr<TextureData> source_texture = (usage == DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR) ?
+			loadTextureHDR(file) : loadTexture(file, usage == DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_COLOR);
+		if (!source_texture) {
+			return nullptr;
+		}
+		texture = EncodeTexture(*source_texture, usage, m_is_texture_compression_enabled);
+		if (!texture) {
+			return source_texture;
+		}
+		if (cooked_file_lock.ownsLock()) {
+			RenderTextureCooker::cook(cooked_path, source_write_time, usage, *texture);
+		}
+		return texture;
+	}
+
+	RenderMeshData RenderResourceBase::loadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box, bool* out_is_busy) {
+		std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+		ASSERT(asset_manager);
+
+		//cooked meshes are mapped as they are, the source is only parsed when its cooked file is missing or stale
+		const std::filesystem::path source_path = asset_manager->getFullPath(source.m_mesh_file);
+		const std::filesystem::path cooked_path = RenderMeshCooker::getCookedPath(source_path);
+		const int64_t source_write_time = GetCookSourceWriteTime(source_path);
 		RenderMeshData ret;
+		if (RenderMeshCooker::load(cooked_path, source_write_time, ret, bounding_box)) {
+			return ret;
+		}
+		//decode jobs run in parallel, only one of them cooks a file, the others come back for the result later
+		CookedFileLock cooked_file_lock(cooked_path);
+		if (!cooked_file_lock.ownsLock() && out_is_busy) {
+			*out_is_busy = true;
+			return ret;
+		}
+		if (RenderMeshCooker::load(cooked_path, source_write_time, ret, bounding_box)) {
+			return ret;
+		}
+
 		if (std::filesystem::path(source.m_mesh_file).extension() == ".obj") {
 			ret.m_static_mesh_data = loadStaticMesh(source.m_mesh_file, bounding_box);
 		}
@@ -97,13 +159,10 @@ namespace Dao {
 				bounding_box.merge(Vector3(vertex[i].x, vertex[i].y, vertex[i].z));
 			}
 
-			//index buffer
-			size_t index_size = binding_data->m_index_buffer.size() * sizeof(uint16_t);
-			ret.m_static_mesh_data.m_index_buffer = std::make_shared<BufferData>(index_size);
-			uint16_t* index = reinterpret_cast<uint16_t*>(ret.m_static_mesh_data.m_index_buffer->m_data);
-			for (size_t i = 0; i < binding_data->m_index_buffer.size(); ++i) {
-				index[i] = (uint16_t)(binding_data->m_index_buffer[i]);
-			}
+			//index buffer, skinned vertices carry a binding per vertex so they are not welded
+			std::vector<uint32_t> indices(binding_data->m_index_buffer.begin(), binding_data->m_index_buffer.end());
+			ret.m_static_mesh_data.m_index_buffer = CreateMeshIndexBuffer(
+				indices, static_cast<uint32_t>(binding_data->m_vertex_buffer.size()), ret.m_static_mesh_data.m_index_type);
 
 			//skeleton binding buffer
 			size_t data_size = binding_data->m_bind.size() * sizeof(MeshVertexBindingDataDefinition);
@@ -120,22 +179,28 @@ namespace Dao {
 				bind_data[i].m_weight3 = binding_data->m_bind[i].m_weight3;
 			}
 		}
-		m_bounding_box_cache_map.insert(std::make_pair(source, bounding_box));
+		if (cooked_file_lock.ownsLock()) {
+			RenderMeshCooker::cook(cooked_path, source_write_time, ret, bounding_box);
+		}
 
 		return ret;
 	}
 
-	RenderMaterialData RenderResourceBase::loadMaterialData(const MaterialSourceDesc& source) {
+	RenderMaterialData RenderResourceBase::loadMaterialData(const MaterialSourceDesc& source, bool* out_is_busy) {
 		RenderMaterialData ret;
-		ret.m_base_color_texture = loadTexture(source.m_base_color_file, true);
-		ret.m_metallic_roughness_texture = loadTexture(source.m_metallic_roughness_file);
-		ret.m_normal_texture = loadTexture(source.m_normal_file);
-		ret.m_occlusion_texture = loadTexture(source.m_occlusion_file);
-		ret.m_emissive_texture = loadTexture(source.m_emissive_file);
+		ret.m_base_color_texture = loadCookedTexture(source.m_base_color_file, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_COLOR, out_is_busy);
+		ret.m_metallic_roughness_texture = loadCookedTexture(source.m_metallic_roughness_file, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_LINEAR, out_is_busy);
+		ret.m_normal_texture = loadCookedTexture(source.m_normal_file, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_NORMAL, out_is_busy);
+		ret.m_occlusion_texture = loadCookedTexture(source.m_occlusion_file, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_LINEAR, out_is_busy);
+		ret.m_emissive_texture = loadCookedTexture(source.m_emissive_file, DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_LINEAR, out_is_busy);
 
 		return ret;
 	}
 
+	void RenderResourceBase::cacheBoundingBox(const MeshSourceDesc& source, const AxisAlignedBox& bounding_box) {
+		m_bounding_box_cache_map.insert(std::make_pair(source, bounding_box));
+	}
+
 	AxisAlignedBox RenderResourceBase::getCachedBoundingBox(const MeshSourceDesc& source) const {
 		auto find_it = m_bounding_box_cache_map.find(source);
 		if (find_it != m_bounding_box_cache_map.end()) {
@@ -271,16 +336,17 @@ namespace Dao {
 			}
 		}
 
+		//obj faces emit one vertex per corner, merge the shared ones and order them for the vertex cache
+		std::vector<MeshVertexDataDefinition> welded_vertices;
+		std::vector<uint32_t> welded_indices;
+		WeldMeshVertices(mesh_vertices, welded_vertices, welded_indices);
+		OptimizeMeshVertexCache(welded_indices, static_cast<uint32_t>(welded_vertices.size()));
+		OptimizeMeshVertexFetch(welded_vertices, welded_indices);
+
 		uint32_t stride = sizeof(MeshVertexDataDefinition);
-		mesh_data.m_vertex_buffer = std::make_shared<BufferData>(mesh_vertices.size() * stride);
-		mesh_data.m_index_buffer = std::make_shared<BufferData>(mesh_vertices.size() * sizeof(uint16_t));
-		ASSERT(mesh_vertices.size() <= std::numeric_limits<uint16_t>::max());//must consistent with the index range used by vulkan
-		MeshVertexDataDefinition* vertices = static_cast<MeshVertexDataDefinition*>(mesh_data.m_vertex_buffer->m_data);
-		uint16_t* indices = static_cast<uint16_t*>(mesh_data.m_index_buffer->m_data);
-		for (size_t i = 0; i < mesh_vertices.size(); ++i) {
-			vertices[i] = mesh_vertices[i];
-			indices[i] = static_cast<uint16_t>(i);
-		}
+		mesh_data.m_vertex_buffer = std::make_shared<BufferData>(welded_vertices.size() * stride);
+		memcpy(mesh_data.m_vertex_buffer->m_data, welded_vertices.data(), welded_vertices.size() * stride);
+		mesh_data.m_index_buffer = CreateMeshIndexBuffer(welded_indices, static_cast<uint32_t>(welded_vertices.size()), mesh_data.m_index_type);
 
 		return mesh_data;
 	}
@@ -24,34 +24,47 @@ namespace Dao {
 		) = 0;
 		virtual void uploadGameObjectRenderResource(
 			std::shared_ptr<RHI> rhi,
-			RenderEntity render_entity,
+			const RenderEntity& render_entity,
 			RenderMeshData mesh_data,
 			RenderMaterialData material_data
 		) = 0;
 		virtual void uploadGameObjectRenderResource(
 			std::shared_ptr<RHI> rhi,
-			RenderEntity render_entity,
+			const RenderEntity& render_entity,
 			RenderMeshData mesh_data
 		) = 0;
 		virtual void uploadGameObjectRenderResource(
 			std::shared_ptr<RHI> rhi,
-			RenderEntity render_entity,
+			const RenderEntity& render_entity,
 			RenderMaterialData material_data
 		) = 0;
 		virtual void updatePerFrameBuffer(
 			std::shared_ptr<RenderScene> render_scene,
 			std::shared_ptr<RenderCamera> camera
 		) = 0;
+		/// submit pending asset uploads and mark the resources whose upload completed as ready
+		virtual void updateUploadStates(std::shared_ptr<RHI> rhi) = 0;
 
 
 		std::shared_ptr<TextureData> loadTextureHDR(std::string file, int desired_channels = 4);
 		std::shared_ptr<TextureData> loadTexture(std::string file, bool is_srgb = false);
-		RenderMeshData loadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box);
-		RenderMaterialData loadMaterialData(const MaterialSourceDesc& source);
+		/// load the encoded texture from its cooked file, the source is decoded, encoded and cooked
+		/// when the cooked file is missing or stale. safe to call on job workers.
+		/// while another thread cooks the same file, out_is_busy is set and nullptr returned so the caller can retry,
+		/// without out_is_busy the texture is encoded again and not cooked
+		std::shared_ptr<TextureData> loadCookedTexture(const std::string& file, DAO_TEXTURE_USAGE usage, bool* out_is_busy = nullptr);
+		/// has to be set before textures are loaded, cooked textures stay uncompressed otherwise
+		void setTextureCompressionEnabled(bool enabled) { m_is_texture_compression_enabled = enabled; }
+		//decoding does not touch the render resource, safe to call on job workers.
+		//out_is_busy works like in loadCookedTexture, the returned data is incomplete when it is set
+		RenderMeshData loadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box, bool* out_is_busy = nullptr);
+		RenderMaterialData loadMaterialData(const MaterialSourceDesc& source, bool* out_is_busy = nullptr);
+		void cacheBoundingBox(const MeshSourceDesc& source, const AxisAlignedBox& bounding_box);
 		AxisAlignedBox	getCachedBoundingBox(const MeshSourceDesc& source) const;
 
 	private:
 		StaticMeshData loadStaticMesh(std::string mesh_file, AxisAlignedBox& bounding_box);
 		std::unordered_map<MeshSourceDesc, AxisAlignedBox> m_bounding_box_cache_map;
+		bool m_is_texture_compression_enabled{ false };
 	};
 }
\ No newline at end of file
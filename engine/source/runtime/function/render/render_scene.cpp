@@ -4,17 +4,51 @@
 #include "runtime/function/render/render_pass.h"
 #include "runtime/function/render/render_resource.h"
 #include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
+#include "runtime/function/global/global_context.h"
+
+#include <algorithm>
 
 namespace Dao {
 
+	//up to this many entities a frustum view is culled with one flat pass of the simd kernel, walking the bvh costs more
+	static constexpr uint32_t s_flat_culling_max_entity_count = 512;
+	static constexpr uint32_t s_invalid_entity_index = 0xFFFFFFFF;
+
 	void RenderScene::clear() {
 
 	}
 
 	void RenderScene::updateVisibleObjects(std::shared_ptr<RenderResource> render_resource, std::shared_ptr<RenderCamera> camera) {
-		updateVisibleObjectsDirectionalLight(render_resource, camera);
-		updateVisibleObjectsPointLight(render_resource);
-		updateVisibleObjectsMainCamera(render_resource, camera);
+		Matrix4x4 directional_light_proj_view = CalculateDirectionalLightCamera(*this, *camera);
+		render_resource->m_mesh_perframe_storage_buffer_object.directional_light_proj_view = directional_light_proj_view;
+		render_resource->m_mesh_directional_light_shadow_perframe_storage_buffer_object.light_proj_view = directional_light_proj_view;
+		ClusterFrustum directional_light_frustum = CreateClusterFrustumFromMatrix(directional_light_proj_view, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
+
+		Matrix4x4 view_matrix = camera->getViewMatrix();
+		Matrix4x4 proj_matrix = camera->getPersProjMatrix();
+		Matrix4x4 proj_view_matrix = proj_matrix * view_matrix;
+		ClusterFrustum main_camera_frustum = CreateClusterFrustumFromMatrix(proj_view_matrix, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
+
+		//one task per view, every view culls into its own buffers and builds its own node list
+		RenderResource& resource = *render_resource;
+		g_runtime_global_context.m_job_system->parallelFor(3, 1, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t view = begin; view < end; ++view) {
+				if (view == 0) {
+					cullFrustum(directional_light_frustum, _directional_light_cull_candidates, _directional_light_visible_indices);
+					buildVisibleMeshNodes(m_directional_light_visible_mesh_nodes, _directional_light_visible_indices, resource);
+				}
+				else if (view == 1) {
+					cullFrustum(main_camera_frustum, _main_camera_cull_candidates, _main_camera_visible_indices);
+					buildVisibleMeshNodes(m_main_camera_visible_mesh_nodes, _main_camera_visible_indices, resource);
+				}
+				else {
+					cullPointLights(_point_light_bounding_spheres, _point_lights_visible_indices);
+					buildVisibleMeshNodes(m_point_lights_visible_mesh_nodes, _point_lights_visible_indices, resource);
+				}
+			}
+		});
+
 		updateVisibleObjectsAxis(render_resource);
 		updateVisibleObjectsParticle(render_resource);
 	}
@@ -38,8 +72,135 @@ namespace Dao {
 		return _material_asset_id_allocator;
 	}
 
+	bool RenderScene::addRenderEntity(const RenderEntity& entity) {
+		ASSERT(!hasRenderEntity(entity.m_instance_id));
+		//the passes index the instance buffer with the slot, an entity without gpu instance data must not reach a draw list
+		if (getInstanceSlot(entity.m_instance_id) >= s_scene_instance_max_count) {
+			LOG_ERROR("instance {} exceeds the scene instance buffer capacity of {}", entity.m_instance_id, s_scene_instance_max_count);
+			return false;
+		}
+		uint32_t entity_index = static_cast<uint32_t>(m_render_entities.size());
+		size_t slot = _instance_id_allocator.getGuidIndex(entity.m_instance_id);
+		if (slot >= _entity_index_by_instance_id.size()) {
+			_entity_index_by_instance_id.resize(slot + 1, s_invalid_entity_index);
+		}
+		_entity_index_by_instance_id[slot] = entity_index;
+
+		const BoundingBox world_bounding_box = calculateWorldBoundingBox(entity);
+		m_render_entities.pushBack(entity);
+		_render_entity_proxies.push_back(_render_entity_bvh.insert(world_bounding_box, entity_index));
+		_render_entity_bounds.pushBack(world_bounding_box);
+		_dirty_instance_ids.push_back(entity.m_instance_id);
+		return true;
+	}
+
+	void RenderScene::updateRenderEntity(const RenderEntity& entity) {
+		if (!hasRenderEntity(entity.m_instance_id)) {
+			return;
+		}
+		uint32_t entity_index = _entity_index_by_instance_id[_instance_id_allocator.getGuidIndex(entity.m_instance_id)];
+		const BoundingBox world_bounding_box = calculateWorldBoundingBox(entity);
+		m_render_entities.set(entity_index, entity);
+		_render_entity_bvh.update(_render_entity_proxies[entity_index], world_bounding_box);
+		_render_entity_bounds.set(entity_index, world_bounding_box);
+		_dirty_instance_ids.push_back(entity.m_instance_id);
+	}
+
+	Matrix4x4* RenderScene::allocateObjectJointPalette(GObjectID go_id, uint32_t joint_count) {
+		auto result = _object_joint_palette_ids.emplace(go_id, s_invalid_joint_palette_id);
+		if (result.second) {
+			result.first->second = m_render_entities.createJointPalette();
+		}
+		return m_render_entities.resizeJointPalette(result.first->second, joint_count);
+	}
+
+	void RenderScene::releaseObjectJointPalette(GObjectID go_id) {
+		auto it = _object_joint_palette_ids.find(go_id);
+		if (it == _object_joint_palette_ids.end()) {
+			return;
+		}
+		auto instance_ids_it = _object_instance_ids_map.find(go_id);
+		if (instance_ids_it != _object_instance_ids_map.end()) {
+			for (uint32_t instance_id : instance_ids_it->second) {
+				uint32_t entity_index;
+				if (getRenderEntityIndex(instance_id, entity_index)) {
+					m_render_entities.setJointPalette(entity_index, s_invalid_joint_palette_id);
+					_dirty_instance_ids.push_back(instance_id);
+				}
+			}
+		}
+		m_render_entities.destroyJointPalette(it->second);
+		_object_joint_palette_ids.erase(it);
+	}
+
+	void RenderScene::attachObjectJointPalette(uint32_t instance_id, GObjectID go_id) {
+		uint32_t entity_index;
+		if (!getRenderEntityIndex(instance_id, entity_index)) {
+			return;
+		}
+		auto it = _object_joint_palette_ids.find(go_id);
+		m_render_entities.setJointPalette(entity_index, it != _object_joint_palette_ids.end() ? it->second : s_invalid_joint_palette_id);
+	}
+
+	void RenderScene::removeRenderEntity(uint32_t instance_id) {
+		if (!hasRenderEntity(instance_id)) {
+			return;
+		}
+		size_t slot = _instance_id_allocator.getGuidIndex(instance_id);
+		uint32_t entity_index = _entity_index_by_instance_id[slot];
+		uint32_t last_index = static_cast<uint32_t>(m_render_entities.size()) - 1;
+		_render_entity_bvh.remove(_render_entity_proxies[entity_index]);
+
+		//swap and pop, the last entity takes over the freed slot
+		if (entity_index != last_index) {
+			_render_entity_proxies[entity_index] = _render_entity_proxies[last_index];
+			_render_entity_bounds.moveElement(last_index, entity_index);
+			_render_entity_bvh.setUserData(_render_entity_proxies[entity_index], entity_index);
+			_entity_index_by_instance_id[_instance_id_allocator.getGuidIndex(m_render_entities.m_instance_ids[last_index])] = entity_index;
+		}
+		m_render_entities.removeSwapBack(entity_index);
+		_render_entity_proxies.pop_back();
+		_render_entity_bounds.resize(last_index);
+		_entity_index_by_instance_id[slot] = s_invalid_entity_index;
+	}
+
+	bool RenderScene::hasRenderEntity(uint32_t instance_id) const {
+		if (!GuidAllocator<GameObjectPartId>::isValidGuid(instance_id)) {
+			return false;
+		}
+		size_t slot = _instance_id_allocator.getGuidIndex(instance_id);
+		if (slot >= _entity_index_by_instance_id.size() || _entity_index_by_instance_id[slot] == s_invalid_entity_index) {
+			return false;
+		}
+		//the slot may already belong to a newer generation of the guid
+		return m_render_entities.m_instance_ids[_entity_index_by_instance_id[slot]] == instance_id;
+	}
+
+	bool RenderScene::getRenderEntityIndex(uint32_t instance_id, uint32_t& out_entity_index) const {
+		if (!hasRenderEntity(instance_id)) {
+			return false;
+		}
+		out_entity_index = _entity_index_by_instance_id[_instance_id_allocator.getGuidIndex(instance_id)];
+		return true;
+	}
+
+	uint32_t RenderScene::getInstanceSlot(uint32_t instance_id) const {
+		return static_cast<uint32_t>(GuidAllocator<GameObjectPartId>::getGuidIndex(instance_id));
+	}
+
+	bool RenderScene::getSceneBoundingBox(BoundingBox& out_bounding_box) const {
+		if (_render_entity_bvh.isEmpty()) {
+			return false;
+		}
+		out_bounding_box = _render_entity_bvh.getRootBox();
+		return true;
+	}
+
 	void RenderScene::addInstanceIdToMap(uint32_t instance_id, GObjectID go_id) {
-		_mesh_object_id_map[instance_id] = go_id;
+		auto result = _mesh_object_id_map.emplace(instance_id, go_id);
+		if (result.second) {
+			_object_instance_ids_map[go_id].push_back(instance_id);
+		}
 	}
 
 	GObjectID RenderScene::getGObjectIDByMeshID(uint32_t mesh_id) const {
@@ -51,68 +212,106 @@ namespace Dao {
 	}
 
 	void RenderScene::deleteEntityByGObjectID(GObjectID go_id) {
-		for (auto it = _mesh_object_id_map.begin(); it != _mesh_object_id_map.end(); ++it) {
-			if (it->second == go_id) {
-				_mesh_object_id_map.erase(it);
-				break;
-			}
+		releaseObjectJointPalette(go_id);
+		auto it = _object_instance_ids_map.find(go_id);
+		if (it == _object_instance_ids_map.end()) {
+			return;
 		}
-
-		GameObjectPartId part_id = { go_id,0 };
-		size_t find_guid;
-		if (_instance_id_allocator.getElementGuid(part_id, find_guid)) {
-			for (auto it = m_render_entities.begin(); it != m_render_entities.end(); ++it) {
-				if (it->m_instance_id == find_guid) {
-					m_render_entities.erase(it);
-					break;
-				}
-			}
+		for (uint32_t instance_id : it->second) {
+			removeRenderEntity(instance_id);
+			_mesh_object_id_map.erase(instance_id);
+			_instance_id_allocator.freeGuid(instance_id);
 		}
+		_object_instance_ids_map.erase(it);
 	}
 
 	void RenderScene::clearForLevelReloading() {
 		_instance_id_allocator.clear();
 		_mesh_object_id_map.clear();
+		_object_instance_ids_map.clear();
+		_object_joint_palette_ids.clear();
 		m_render_entities.clear();
+		_entity_index_by_instance_id.clear();
+		_dirty_instance_ids.clear();
+		_render_entity_bvh.clear();
+		_render_entity_proxies.clear();
+		_render_entity_bounds.clear();
 	}
 
-	void RenderScene::updateVisibleObjectsDirectionalLight(std::shared_ptr<RenderResource> render_resource, std::shared_ptr<RenderCamera> camera) {
-		Matrix4x4 directional_light_proj_view = CalculateDirectionalLightCamera(*this, *camera);
-		
-		render_resource->m_mesh_perframe_storage_buffer_object.directional_light_proj_view = directional_light_proj_view;
-		render_resource->m_mesh_directional_light_shadow_perframe_storage_buffer_object.light_proj_view = directional_light_proj_view;
-		m_directional_light_visible_mesh_nodes.clear();
-
-		ClusterFrustum frustum = CreateClusterFrustumFromMatrix(directional_light_proj_view, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
-
-		for (const RenderEntity& entity : m_render_entities) {
-			BoundingBox mesh_asset_bounding_box{ entity.m_bounding_box.getMinCorner(),entity.m_bounding_box.getMaxCorner() };
-			if (TiledFrustumIntersectBox(frustum, BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix))) {
-				m_directional_light_visible_mesh_nodes.emplace_back();
-				RenderMeshNode& temp_node = m_directional_light_visible_mesh_nodes.back();
-				temp_node.model_matrix = &entity.m_model_matrix;
-				ASSERT(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
-				if (!entity.m_joint_matrices.empty()) {
-					temp_node.joint_count = static_cast<uint32_t>(entity.m_joint_matrices.size());
-					temp_node.joint_matrices = entity.m_joint_matrices.data();
-				}
-				temp_node.node_id = entity.m_instance_id;
-
-				VulkanMesh& mesh_asset = render_resource->getEntityMesh(entity);
-				temp_node.ref_mesh = &mesh_asset;
-				temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
-				
-				VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
-				temp_node.ref_material = &material_asset;
-		
+	BoundingBox RenderScene::calculateWorldBoundingBox(const RenderEntity& entity) {
+		BoundingBox mesh_asset_bounding_box{ entity.m_bounding_box.getMinCorner(),entity.m_bounding_box.getMaxCorner() };
+		return BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix);
+	}
+
+	void RenderScene::appendVisibleMeshNode(std::vector<RenderMeshNode>& visible_mesh_nodes, uint32_t entity_index, RenderResource& render_resource) {
+		//skip entities whose mesh is still uploading, materials fall back to the default material meanwhile
+		VulkanMesh& mesh_asset = render_resource.getMeshByAssetId(m_render_entities.m_mesh_asset_ids[entity_index]);
+		if (!mesh_asset.is_ready) {
+			return;
+		}
+		VulkanPBRMaterial* material_asset = render_resource.findMaterialByAssetId(m_render_entities.m_material_asset_ids[entity_index]);
+		if (!material_asset || !material_asset->is_ready) {
+			material_asset = &render_resource.getDefaultMaterial();
+			if (!material_asset->is_ready) {
+				return;
 			}
 		}
+
+		visible_mesh_nodes.emplace_back();
+		RenderMeshNode& temp_node = visible_mesh_nodes.back();
+		temp_node.model_matrix = &m_render_entities.m_model_matrices[entity_index];
+		const uint32_t joint_count = m_render_entities.getJointCount(entity_index);
+		ASSERT(joint_count <= s_mesh_vertex_blending_max_joint_count);
+		if (joint_count > 0) {
+			temp_node.joint_count = joint_count;
+			temp_node.joint_matrices = m_render_entities.getJointMatrices(entity_index);
+		}
+		temp_node.node_id = m_render_entities.m_instance_ids[entity_index];
+		temp_node.instance_slot = getInstanceSlot(temp_node.node_id);
+		ASSERT(temp_node.instance_slot < s_scene_instance_max_count);
+
+		temp_node.ref_mesh = &mesh_asset;
+		temp_node.enable_vertex_blending = m_render_entities.m_enable_vertex_blending[entity_index] != 0;
+		temp_node.ref_material = material_asset;
+
+		temp_node.mesh_asset_id = m_render_entities.m_mesh_asset_ids[entity_index];
+		temp_node.material_asset_id = m_render_entities.m_material_asset_ids[entity_index];
 	}
 
-	void RenderScene::updateVisibleObjectsPointLight(std::shared_ptr<RenderResource> render_resource) {
-		m_point_lights_visible_mesh_nodes.clear();
-		
-		std::vector<BoundingSphere> point_light_bounding_spheres;
+	void RenderScene::buildVisibleMeshNodes(std::vector<RenderMeshNode>& visible_mesh_nodes, const std::vector<uint32_t>& visible_indices, RenderResource& render_resource) {
+		visible_mesh_nodes.clear();
+		visible_mesh_nodes.reserve(visible_indices.size());
+		for (uint32_t entity_index : visible_indices) {
+			appendVisibleMeshNode(visible_mesh_nodes, entity_index, render_resource);
+		}
+	}
+
+	void RenderScene::cullFrustum(const ClusterFrustum& frustum, std::vector<uint32_t>& candidate_indices, std::vector<uint32_t>& out_visible_indices) const {
+		out_visible_indices.clear();
+		const uint32_t entity_count = static_cast<uint32_t>(_render_entity_bounds.size());
+		if (entity_count <= s_flat_culling_max_entity_count) {
+			FrustumCullBoxes(frustum, _render_entity_bounds, 0, entity_count, out_visible_indices);
+			return;
+		}
+
+		//subtrees inside the frustum are taken as they are, only leaves crossing a plane are left for the kernel
+		candidate_indices.clear();
+		_render_entity_bvh.queryClassified(
+			[&frustum](const BoundingBox& box) { return ClassifyBoxInFrustum(frustum, box); },
+			[&out_visible_indices](uint32_t entity_index, const BoundingBox&) { out_visible_indices.push_back(entity_index); },
+			[&candidate_indices](uint32_t entity_index, const BoundingBox&) { candidate_indices.push_back(entity_index); }
+		);
+
+		//the kernel walks ranges of the box streams, runs of consecutive candidates share one range
+		std::sort(candidate_indices.begin(), candidate_indices.end());
+		FrustumCullBoxRuns(frustum, _render_entity_bounds, candidate_indices, out_visible_indices);
+		//draw lists stay in entity order like the flat pass, independent of the tree layout
+		std::sort(out_visible_indices.begin(), out_visible_indices.end());
+	}
+
+	void RenderScene::cullPointLights(std::vector<BoundingSphere>& point_light_bounding_spheres, std::vector<uint32_t>& out_visible_indices) const {
+		out_visible_indices.clear();
+
 		uint32_t point_light_num = static_cast<uint32_t>(m_point_light_list.m_lights.size());
 		point_light_bounding_spheres.resize(point_light_num);
 
@@ -121,66 +320,28 @@ namespace Dao {
 			point_light_bounding_spheres[i].m_radius = m_point_light_list.m_lights[i].calculateRadius();
 		}
 
-		for (const RenderEntity& entity : m_render_entities) {
-			BoundingBox mesh_asset_bounding_box{ entity.m_bounding_box.getMinCorner(),entity.m_bounding_box.getMaxCorner() };
-			bool intersect_with_point_lights = true;
-			for (size_t i = 0; i < point_light_num; ++i) {
-				if (!BoxIntersectsWithSphere(BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix), point_light_bounding_spheres[i])) {
-					intersect_with_point_lights = false;
-					break;
-				}
-			}
-			if (intersect_with_point_lights) {
-				m_point_lights_visible_mesh_nodes.emplace_back();
-				RenderMeshNode& temp_node = m_point_lights_visible_mesh_nodes.back();
-				temp_node.model_matrix = &entity.m_model_matrix;
-				ASSERT(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
-				if (!entity.m_joint_matrices.empty()) {
-					temp_node.joint_count = static_cast<uint32_t>(entity.m_joint_matrices.size());
-					temp_node.joint_matrices = entity.m_joint_matrices.data();
-				}
-				temp_node.node_id = entity.m_instance_id;
-
-				VulkanMesh& mesh_asset = render_resource->getEntityMesh(entity);
-				temp_node.ref_mesh = &mesh_asset;
-				temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
-
-				VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
-				temp_node.ref_material = &material_asset;
+		//an entity has to touch every point light, without lights nothing can be rejected
+		if (point_light_num == 0) {
+			out_visible_indices.resize(m_render_entities.size());
+			for (uint32_t i = 0; i < static_cast<uint32_t>(out_visible_indices.size()); ++i) {
+				out_visible_indices[i] = i;
 			}
+			return;
 		}
-	}
-
-	void RenderScene::updateVisibleObjectsMainCamera(std::shared_ptr<RenderResource> render_resource, std::shared_ptr<RenderCamera> camera) {
-		m_main_camera_visible_mesh_nodes.clear();
-		Matrix4x4 view_matrix = camera->getViewMatrix();
-		Matrix4x4 proj_matrix = camera->getPersProjMatrix();
-		Matrix4x4 proj_view_matrix = proj_matrix * view_matrix;
 
-		ClusterFrustum frustum = CreateClusterFrustumFromMatrix(proj_view_matrix, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
-
-		for (const RenderEntity& entity : m_render_entities) {
-			BoundingBox mesh_asset_bounding_box{ entity.m_bounding_box.getMinCorner(),entity.m_bounding_box.getMaxCorner() };
-			if (TiledFrustumIntersectBox(frustum, BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix))) {
-				m_main_camera_visible_mesh_nodes.emplace_back();
-				RenderMeshNode& temp_node = m_main_camera_visible_mesh_nodes.back();
-				temp_node.model_matrix = &entity.m_model_matrix;
-				ASSERT(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
-				if (!entity.m_joint_matrices.empty()) {
-					temp_node.joint_count = static_cast<uint32_t>(entity.m_joint_matrices.size());
-					temp_node.joint_matrices = entity.m_joint_matrices.data();
+		//the tree is walked with the first light, the others are tested on the leaves only
+		const BoundingSphere& first_sphere = point_light_bounding_spheres[0];
+		_render_entity_bvh.query(
+			[&first_sphere](const BoundingBox& box) { return BoxIntersectsWithSphere(box, first_sphere); },
+			[&](uint32_t entity_index, const BoundingBox& world_box) {
+				for (size_t i = 1; i < point_light_num; ++i) {
+					if (!BoxIntersectsWithSphere(world_box, point_light_bounding_spheres[i])) {
+						return;
+					}
 				}
-				temp_node.node_id = entity.m_instance_id;
-
-				VulkanMesh& mesh_asset = render_resource->getEntityMesh(entity);
-				temp_node.ref_mesh = &mesh_asset;
-				temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
-
-				VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
-				temp_node.ref_material = &material_asset;
-
+				out_visible_indices.push_back(entity_index);
 			}
-		}
+		);
 	}
 
 	void RenderScene::updateVisibleObjectsAxis(std::shared_ptr<RenderResource> render_resource) {
@@ -190,7 +351,7 @@ namespace Dao {
 			m_axis_node.node_id = axis.m_instance_id;
 
 			VulkanMesh& mesh_asset = render_resource->getEntityMesh(axis);
-			m_axis_node.ref_mesh = &mesh_asset;
+			m_axis_node.ref_mesh = mesh_asset.is_ready ? &mesh_asset : nullptr;
 			m_axis_node.enable_vertex_blending = axis.m_enable_vertex_blending;
 		}
 	}
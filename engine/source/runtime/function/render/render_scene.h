@@ -2,6 +2,8 @@
 
 #include "runtime/function/render/render_light.h"
 #include "runtime/function/render/render_common.h"
+#include "runtime/function/render/render_bvh.h"
+#include "runtime/function/render/render_culling.h"
 #include "runtime/function/render/render_entity.h"
 #include "runtime/function/render/render_object.h"
 #include "runtime/function/render/render_light.h"
@@ -24,7 +26,8 @@ namespace Dao {
 		PDirectionalLight	m_directional_light;
 		PointLightList		m_point_light_list;
 		//render entities
-		std::vector<RenderEntity>	m_render_entities;
+		//hot per entity data only, the full description stays with the swap data that produced it
+		RenderEntityStorage			m_render_entities;
 		//axis for editor
 		std::optional<RenderEntity> m_render_axis;
 		//visible objects(update per frame)
@@ -46,6 +49,30 @@ namespace Dao {
 		GuidAllocator<MeshSourceDesc>& getMeshAssetIdAllocator();
 		GuidAllocator<MaterialSourceDesc>& getMaterialAssetIdAllocator();
 
+		/// @return: false if the instance slot lies outside the scene instance buffer, the entity is not added and never drawn
+		bool addRenderEntity(const RenderEntity& entity);
+		void updateRenderEntity(const RenderEntity& entity);
+		/// palette shared by every part of the game object for the caller to fill, created on first use.
+		/// see RenderEntityStorage::resizeJointPalette
+		/// @return: nullptr if joint_count is 0
+		Matrix4x4* allocateObjectJointPalette(GObjectID go_id, uint32_t joint_count);
+		/// the entities of the object lose their joints
+		void releaseObjectJointPalette(GObjectID go_id);
+		/// point an entity in the scene at the palette of its game object, parts of objects without palette have no joints
+		void attachObjectJointPalette(uint32_t instance_id, GObjectID go_id);
+		void removeRenderEntity(uint32_t instance_id);
+		bool hasRenderEntity(uint32_t instance_id) const;
+		/// @return: false if the instance is not in the scene
+		bool getRenderEntityIndex(uint32_t instance_id, uint32_t& out_entity_index) const;
+		/// slot of the instance in the scene instance buffer
+		uint32_t getInstanceSlot(uint32_t instance_id) const;
+		/// instances added or updated since the last clearDirtyInstanceIds, may contain removed instances
+		const std::vector<uint32_t>& getDirtyInstanceIds() const { return _dirty_instance_ids; }
+		void clearDirtyInstanceIds() { _dirty_instance_ids.clear(); }
+		/// fattened bounds of all render entities
+		/// @return: false if the scene has no entities
+		bool getSceneBoundingBox(BoundingBox& out_bounding_box) const;
+
 		void addInstanceIdToMap(uint32_t instance_id, GObjectID go_id);
 		GObjectID getGObjectIDByMeshID(uint32_t mesh_id) const;
 		void deleteEntityByGObjectID(GObjectID go_id);
@@ -57,16 +84,50 @@ namespace Dao {
 		GuidAllocator<MeshSourceDesc>			_mesh_asset_id_allocator;
 		GuidAllocator<MaterialSourceDesc>		_material_asset_id_allocator;
 		std::unordered_map<uint32_t, GObjectID> _mesh_object_id_map;
+		//instance ids of every part of a game object
+		std::unordered_map<GObjectID, std::vector<uint32_t>> _object_instance_ids_map;
+		//joint palette id in m_render_entities of every skinned game object
+		std::unordered_map<GObjectID, uint32_t>	_object_joint_palette_ids;
+		//slot map from the instance guid index to the dense index in m_render_entities, entities are removed by swap and pop
+		std::vector<uint32_t>					_entity_index_by_instance_id;
+		//instances whose gpu instance data has to be rewritten
+		std::vector<uint32_t>					_dirty_instance_ids;
+		//world space bounds of m_render_entities, leaf user data is the entity index
+		RenderBVH								_render_entity_bvh;
+		//bvh proxy of every entity, same order as m_render_entities
+		std::vector<uint32_t>					_render_entity_proxies;
+		//world space bounds for the frustum culling kernel, same order as m_render_entities
+		BoundingBoxSoA							_render_entity_bounds;
+		//visible entity indices per view, in entity order
+		std::vector<uint32_t>					_directional_light_visible_indices;
+		std::vector<uint32_t>					_main_camera_visible_indices;
+		std::vector<uint32_t>					_point_lights_visible_indices;
+		//leaves crossing a frustum plane, kept across frames to reuse their storage
+		std::vector<uint32_t>					_directional_light_cull_candidates;
+		std::vector<uint32_t>					_main_camera_cull_candidates;
+		std::vector<BoundingSphere>				_point_light_bounding_spheres;
 
-		void updateVisibleObjectsDirectionalLight(
-			std::shared_ptr<RenderResource> render_resource,
-			std::shared_ptr<RenderCamera> camera
+		static BoundingBox calculateWorldBoundingBox(const RenderEntity& entity);
+		void appendVisibleMeshNode(
+			std::vector<RenderMeshNode>& visible_mesh_nodes,
+			uint32_t entity_index,
+			RenderResource& render_resource
 		);
-		void updateVisibleObjectsPointLight(std::shared_ptr<RenderResource> render_resource);
-		void updateVisibleObjectsMainCamera(
-			std::shared_ptr<RenderResource> render_resource,
-			std::shared_ptr<RenderCamera> camera
+		void buildVisibleMeshNodes(
+			std::vector<RenderMeshNode>& visible_mesh_nodes,
+			const std::vector<uint32_t>& visible_indices,
+			RenderResource& render_resource
 		);
+
+		/// query the bvh with the frustum and run the simd kernel over the leaves crossing a plane,
+		/// small scenes are tested with one flat pass instead. candidate_indices is scratch storage
+		void cullFrustum(
+			const ClusterFrustum& frustum,
+			std::vector<uint32_t>& candidate_indices,
+			std::vector<uint32_t>& out_visible_indices
+		) const;
+		/// point_light_bounding_spheres is scratch storage
+		void cullPointLights(std::vector<BoundingSphere>& point_light_bounding_spheres, std::vector<uint32_t>& out_visible_indices) const;
 		void updateVisibleObjectsAxis(std::shared_ptr<RenderResource> render_resource);
 		void updateVisibleObjectsParticle(std::shared_ptr<RenderResource> render_resource);
 	};
@@ -69,7 +69,8 @@ namespace Dao {
 			m_swap_data[m_render_swap_data_index].m_camera_swap_data.has_value() ||
 			m_swap_data[m_render_swap_data_index].m_particle_submit_request.has_value() ||
 			m_swap_data[m_render_swap_data_index].m_emitter_tick_request.has_value() ||
-			m_swap_data[m_render_swap_data_index].m_emitter_transform_request.has_value());
+			m_swap_data[m_render_swap_data_index].m_emitter_transform_request.has_value() ||
+			m_swap_data[m_render_swap_data_index].m_window_swap_data.has_value());
 	}
 
 	void RenderSwapContext::resetLevelResourceSwapData() {
@@ -100,6 +101,10 @@ namespace Dao {
 		m_swap_data[m_render_swap_data_index].m_emitter_transform_request.reset();
 	}
 
+	void RenderSwapContext::resetWindowSwapData() {
+		m_swap_data[m_render_swap_data_index].m_window_swap_data.reset();
+	}
+
 	void RenderSwapContext::swap() {
 		resetLevelResourceSwapData();
 		resetGameObjectResourceSwapData();
@@ -108,6 +113,7 @@ namespace Dao {
 		resetEmitterTickSwapData();
 		resetEmitterTransformSwapData();
 		resetParticleBatchSwapData();
+		resetWindowSwapData();
 		std::swap(m_logic_swap_data_index, m_render_swap_data_index);
 	}
 
@@ -35,6 +35,13 @@ namespace Dao {
 		std::optional<Matrix4x4>		m_view_matrix;
 	};
 
+	// polled on the thread owning the window, glfw must not be queried by the render thread
+	struct WindowSwapData {
+		uint32_t	m_framebuffer_width{ 0 };
+		uint32_t	m_framebuffer_height{ 0 };
+		bool		m_is_minimized{ false };
+	};
+
 	struct GameObjectResourceDesc {
 		std::deque<GameObjectDesc> m_game_object_descs;
 		
@@ -71,6 +78,7 @@ namespace Dao {
 		std::optional<ParticleSubmitRequest>	m_particle_submit_request;
 		std::optional<EmitterTickRequest>		m_emitter_tick_request;
 		std::optional<EmitterTransformRequest>	m_emitter_transform_request;
+		std::optional<WindowSwapData>			m_window_swap_data;
 
 		void addDirtyGameObject(GameObjectDesc&& desc);
 		void addDeleteGameObject(GameObjectDesc&& desc);
@@ -100,6 +108,7 @@ namespace Dao {
 		void resetParticleBatchSwapData();
 		void resetEmitterTickSwapData();
 		void resetEmitterTransformSwapData();
+		void resetWindowSwapData();
 
 	private:
 		uint8_t m_logic_swap_data_index{ LogicSwapDataType };
@@ -1,5 +1,6 @@
 #include "runtime/function/render/render_system.h"
 
+#include "runtime/function/render/render_asset_loader.h"
 #include "runtime/resource/asset_manager/asset_manager.h"
 #include "runtime/resource/config_manager/config_manager.h"
 #include "runtime/function/render/render_camera.h"
@@ -14,9 +15,11 @@
 #include "runtime/function/render/passes/particle_pass.h"
 #include "runtime/function/render/passes/main_camera_pass.h"
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
+#include "runtime/function/render/interface/null/null_rhi.h"
 #include "runtime/function/global/global_context.h"
 #include "runtime/core/base/macro.h"
 
+#include <algorithm>
 
 namespace Dao {
 	RenderSystem::~RenderSystem() {
@@ -30,7 +33,12 @@ namespace Dao {
 		//render context initiallize
 		RHIInitInfo rhi_init_info;
 		rhi_init_info.window_system = init_info.window_system;
-		m_rhi = std::make_shared<VulkanRHI>();
+		if (init_info.window_system->isHeadless()) {
+			m_rhi = std::make_shared<NullRHI>();
+		}
+		else {
+			m_rhi = std::make_shared<VulkanRHI>();
+		}
 		m_rhi->initialize(rhi_init_info);
 		//global rendering resource
 		GlobalRenderingRes global_rendering_res;
@@ -43,7 +51,11 @@ namespace Dao {
 		level_resource_desc.m_ibl_resource_desc.m_brdf_map = global_rendering_res.m_brdf_map;
 		level_resource_desc.m_color_grading_resource_desc.m_color_grading_map = global_rendering_res.m_color_grading_map;
 		m_render_resource = std::make_shared<RenderResource>();
+		m_render_resource->setTextureCompressionEnabled(m_rhi->isTextureCompressionBCEnabled());
 		m_render_resource->uploadGloabalRenderResource(m_rhi, level_resource_desc);
+		//mesh and material files are decoded on job workers
+		m_asset_loader = std::make_shared<RenderAssetLoader>();
+		m_asset_loader->initialize(m_render_resource);
 		//setup render camera
 		const CameraPose& camera_pose = global_rendering_res.m_camera_config.m_pose;
 		m_render_camera = std::make_shared<RenderCamera>();
@@ -72,6 +84,17 @@ namespace Dao {
 	void RenderSystem::tick(float delta_time) {
 		//process swap date between logic and render contexts
 		processSwapData();
+		renderFrame(delta_time);
+	}
+
+	void RenderSystem::renderFrame(float delta_time) {
+		//pick up decoded assets and submit the uploads queued since the last frame
+		processLoadedAssets();
+		m_render_resource->updateUploadStates(m_rhi);
+		//nothing can be presented while the window is minimized, the next frame from logic brings the restored size
+		if (m_is_window_minimized) {
+			return;
+		}
 		//prepare render command context;
 		m_rhi->prepareContext();
 		//update perframe buffer
@@ -91,7 +114,14 @@ namespace Dao {
 			LOG_ERROR("unsupported render pipeline type");
 		}
 	}
+
 	void RenderSystem::clear() {
+		//decode jobs have to finish before the resources they use go away
+		if (m_asset_loader) {
+			m_asset_loader->clear();
+		}
+		m_pending_render_entities.clear();
+
 		if (m_rhi) {
 			m_rhi->clear();
 		}
@@ -112,6 +142,7 @@ namespace Dao {
 		m_render_scene.reset();
 		m_render_resource.reset();
 		m_render_pipeline.reset();
+		m_asset_loader.reset();
 	}
 
 	void RenderSystem::swapLogicRenderData() {
@@ -131,22 +162,22 @@ namespace Dao {
 	}
 
 	void RenderSystem::updateEngineContentViewport(float offset_x, float offset_y, float width, float height) {
-		auto vk_rhi = std::static_pointer_cast<VulkanRHI>(m_rhi);
-		vk_rhi->m_viewport.x = offset_x;
-		vk_rhi->m_viewport.y = offset_y;
-		vk_rhi->m_viewport.width = width;
-		vk_rhi->m_viewport.height = height;
-		vk_rhi->m_viewport.minDepth = 0.0f;
-		vk_rhi->m_viewport.maxDepth = 1.0f;
+		RHIViewport* viewport = m_rhi->getSwapchainInfo().viewport;
+		viewport->x = offset_x;
+		viewport->y = offset_y;
+		viewport->width = width;
+		viewport->height = height;
+		viewport->minDepth = 0.0f;
+		viewport->maxDepth = 1.0f;
 		m_render_camera->setAspect(width / height);
 	}
 
 	EngineContentViewport RenderSystem::getEngineContentViewport() const {
-		auto vk_rhi = std::static_pointer_cast<VulkanRHI>(m_rhi);
-		float x = vk_rhi->m_viewport.x;
-		float y = vk_rhi->m_viewport.y;
-		float width = vk_rhi->m_viewport.width;
-		float height = vk_rhi->m_viewport.height;
+		const RHIViewport* viewport = m_rhi->getSwapchainInfo().viewport;
+		float x = viewport->x;
+		float y = viewport->y;
+		float width = viewport->width;
+		float height = viewport->height;
 		
 		return { x,y,width,height };
 	}
@@ -188,6 +219,7 @@ namespace Dao {
 	}
 
 	void RenderSystem::clearForLevelReloading() {
+		m_pending_render_entities.clear();
 		m_render_scene->clearForLevelReloading();
 	}
 
@@ -214,30 +246,34 @@ namespace Dao {
 		if (swap_data.m_game_object_resource_desc.has_value()) {
 			while (!swap_data.m_game_object_resource_desc->isEmpty()) {
 				GameObjectDesc gobject = swap_data.m_game_object_resource_desc->getNextProcessObject();
+				//the palette belongs to the object, it is copied into the joint pool once and shared by every part
+				const std::shared_ptr<const SkeletonAnimationResult>& skeleton_animation_result = gobject.getSkeletonAnimationResult();
+				bool enable_vertex_blending = false;
+				if (skeleton_animation_result) {
+					const std::vector<SkeletonAnimationResultTransform>& transforms = skeleton_animation_result->m_transforms;
+					Matrix4x4* joint_matrices = m_render_scene->allocateObjectJointPalette(gobject.getId(), static_cast<uint32_t>(transforms.size()));
+					for (size_t i = 0; joint_matrices && i < transforms.size(); ++i) {
+						joint_matrices[i] = transforms[i].m_matrix;
+					}
+					enable_vertex_blending = transforms.size() > 1;
+				}
+				else {
+					m_render_scene->releaseObjectJointPalette(gobject.getId());
+				}
 				for (size_t part_index = 0; part_index < gobject.getObjectParts().size(); ++part_index) {
 					const auto& game_object_part = gobject.getObjectParts()[part_index];
 					GameObjectPartId part_id = { gobject.getId(),part_index };
-					bool is_entity_in_scene = m_render_scene->getInstanceIdAllocator().hasElement(part_id);
 					RenderEntity render_entity;
 					render_entity.m_instance_id = static_cast<uint32_t>(m_render_scene->getInstanceIdAllocator().allocGuid(part_id));
 					render_entity.m_model_matrix = game_object_part.m_transform_desc.m_transform_matrix;
 					m_render_scene->addInstanceIdToMap(render_entity.m_instance_id, gobject.getId());
-					//mesh properties
+					//mesh properties, a mesh seen for the first time is decoded in the background
 					MeshSourceDesc mesh_source = { game_object_part.m_mesh_desc.m_mesh_file };
-					bool is_mesh_loaded = m_render_scene->getMeshAssetIdAllocator().hasElement(mesh_source);
-					RenderMeshData mesh_data;
-					if (!is_mesh_loaded) {
-						mesh_data = m_render_resource->loadMeshData(mesh_source, render_entity.m_bounding_box);
-					}
-					else {
-						render_entity.m_bounding_box = m_render_resource->getCachedBoundingBox(mesh_source);
+					if (!m_render_scene->getMeshAssetIdAllocator().hasElement(mesh_source)) {
+						m_asset_loader->requestMesh(mesh_source);
 					}
 					render_entity.m_mesh_asset_id = m_render_scene->getMeshAssetIdAllocator().allocGuid(mesh_source);
-					render_entity.m_enable_vertex_blending = game_object_part.m_skeleton_animation_result.m_transforms.size() > 1;
-					render_entity.m_joint_matrices.resize(game_object_part.m_skeleton_animation_result.m_transforms.size());
-					for (size_t i = 0; i < game_object_part.m_skeleton_animation_result.m_transforms.size(); ++i) {
-						render_entity.m_joint_matrices[i] = game_object_part.m_skeleton_animation_result.m_transforms[i].m_matrix;
-					}
+					render_entity.m_enable_vertex_blending = enable_vertex_blending;
 					//material properties
 					MaterialSourceDesc material_source;
 					if (game_object_part.m_material_desc.m_with_texture) {
@@ -258,30 +294,19 @@ namespace Dao {
 							""
 						};
 					}
-					bool is_material_loaded = m_render_scene->getMaterialAssetIdAllocator().hasElement(material_source);
-					RenderMaterialData material_data;
-					if (!is_material_loaded) {
-						material_data = m_render_resource->loadMaterialData(material_source);
+					//the default material is drawn until the textures are decoded and uploaded
+					if (!m_render_scene->getMaterialAssetIdAllocator().hasElement(material_source)) {
+						m_asset_loader->requestMaterial(material_source);
 					}
 					render_entity.m_material_asset_id = m_render_scene->getMaterialAssetIdAllocator().allocGuid(material_source);
-					//create game object on the graphics api side
-					if (!is_mesh_loaded) {
-						m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, mesh_data);
-					}
-					if (!is_material_loaded) {
-						m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, material_data);
-					}
-					//add object to render scene if needed
-					if (!is_entity_in_scene) {
-						m_render_scene->m_render_entities.push_back(render_entity);
+					//add object to render scene if needed, entities wait for the decode of their mesh
+					if (m_asset_loader->isMeshPending(mesh_source)) {
+						addPendingRenderEntity(gobject.getId(), mesh_source, render_entity);
 					}
 					else {
-						for (auto& entity : m_render_scene->m_render_entities) {
-							if (entity.m_instance_id == render_entity.m_instance_id) {
-								entity = render_entity;
-								break;
-							}
-						}
+						removePendingRenderEntity(render_entity.m_instance_id);
+						render_entity.m_bounding_box = m_render_resource->getCachedBoundingBox(mesh_source);
+						addOrUpdateRenderEntity(gobject.getId(), render_entity);
 					}
 				}
 				//after finish processing,pop this game object
@@ -294,6 +319,12 @@ namespace Dao {
 		if (swap_data.m_game_object_to_delete.has_value()) {
 			while (!swap_data.m_game_object_to_delete->isEmpty()) {
 				GameObjectDesc gobject = swap_data.m_game_object_to_delete->getNextProcessObject();
+				m_pending_render_entities.erase(
+					std::remove_if(m_pending_render_entities.begin(), m_pending_render_entities.end(), [&](const PendingRenderEntity& pending) {
+						return pending.gobject_id == gobject.getId();
+					}),
+					m_pending_render_entities.end()
+				);
 				m_render_scene->deleteEntityByGObjectID(gobject.getId());
 				swap_data.m_game_object_to_delete->pop();
 			}
@@ -334,5 +365,81 @@ namespace Dao {
 			std::static_pointer_cast<ParticlePass>(m_render_pipeline->m_particle_pass)->setTransformIndices(swap_data.m_emitter_transform_request->m_transform_descs);
 			m_swap_context.resetEmitterTransformSwapData();
 		}
+		//process window state polled by the main thread
+		if (swap_data.m_window_swap_data.has_value()) {
+			const WindowSwapData& window_swap_data = *swap_data.m_window_swap_data;
+			m_rhi->setFramebufferSize(window_swap_data.m_framebuffer_width, window_swap_data.m_framebuffer_height);
+			m_is_window_minimized = window_swap_data.m_is_minimized ||
+				window_swap_data.m_framebuffer_width == 0 || window_swap_data.m_framebuffer_height == 0;
+			m_swap_context.resetWindowSwapData();
+		}
+	}
+
+	void RenderSystem::processLoadedAssets() {
+		std::vector<RenderAssetLoader::LoadedMesh> loaded_meshes;
+		std::vector<RenderAssetLoader::LoadedMaterial> loaded_materials;
+		m_asset_loader->collectLoadedAssets(loaded_meshes, loaded_materials);
+		//create game object resources on the graphics api side
+		for (const RenderAssetLoader::LoadedMesh& loaded_mesh : loaded_meshes) {
+			RenderEntity render_entity;
+			if (!m_render_scene->getMeshAssetIdAllocator().getElementGuid(loaded_mesh.source, render_entity.m_mesh_asset_id)) {
+				continue;
+			}
+			m_render_resource->cacheBoundingBox(loaded_mesh.source, loaded_mesh.bounding_box);
+			m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, loaded_mesh.data);
+		}
+		for (const RenderAssetLoader::LoadedMaterial& loaded_material : loaded_materials) {
+			RenderEntity render_entity;
+			if (!m_render_scene->getMaterialAssetIdAllocator().getElementGuid(loaded_material.source, render_entity.m_material_asset_id)) {
+				continue;
+			}
+			m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, loaded_material.data);
+		}
+		//entities whose mesh arrived can enter the scene
+		for (size_t i = 0; i < m_pending_render_entities.size();) {
+			PendingRenderEntity& pending = m_pending_render_entities[i];
+			if (m_asset_loader->isMeshPending(pending.mesh_source)) {
+				++i;
+				continue;
+			}
+			pending.entity.m_bounding_box = m_render_resource->getCachedBoundingBox(pending.mesh_source);
+			addOrUpdateRenderEntity(pending.gobject_id, pending.entity);
+			m_pending_render_entities[i] = std::move(m_pending_render_entities.back());
+			m_pending_render_entities.pop_back();
+		}
+	}
+
+	void RenderSystem::addOrUpdateRenderEntity(GObjectID gobject_id, const RenderEntity& entity) {
+		if (!m_render_scene->hasRenderEntity(entity.m_instance_id)) {
+			if (!m_render_scene->addRenderEntity(entity)) {
+				return;
+			}
+		}
+		else {
+			m_render_scene->updateRenderEntity(entity);
+		}
+		m_render_scene->attachObjectJointPalette(entity.m_instance_id, gobject_id);
+	}
+
+	void RenderSystem::addPendingRenderEntity(GObjectID gobject_id, const MeshSourceDesc& mesh_source, const RenderEntity& entity) {
+		//a newer swap data of the same part replaces the waiting one
+		for (PendingRenderEntity& pending : m_pending_render_entities) {
+			if (pending.entity.m_instance_id == entity.m_instance_id) {
+				pending.mesh_source = mesh_source;
+				pending.entity = entity;
+				return;
+			}
+		}
+		m_pending_render_entities.push_back({ gobject_id, mesh_source, entity });
+	}
+
+	void RenderSystem::removePendingRenderEntity(uint32_t instance_id) {
+		for (size_t i = 0; i < m_pending_render_entities.size(); ++i) {
+			if (m_pending_render_entities[i].entity.m_instance_id == instance_id) {
+				m_pending_render_entities[i] = std::move(m_pending_render_entities.back());
+				m_pending_render_entities.pop_back();
+				return;
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <array>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace Dao {
 
@@ -17,6 +18,7 @@ namespace Dao {
 	class RenderPipelineBase;
 	class RenderScene;
 	class RenderCamera;
+	class RenderAssetLoader;
 	class WindowUI;
 
 	struct RenderSystemInitInfo {
@@ -37,6 +39,9 @@ namespace Dao {
 
 		void initialize(RenderSystemInitInfo init_info);
 		void tick(float delta_time);
+		// tick split in its two phases, the render thread releases the swap data in between
+		void processSwapData();
+		void renderFrame(float delta_time);
 		void clear();
 
 		void swapLogicRenderData();
@@ -61,10 +66,27 @@ namespace Dao {
 		void clearForLevelReloading();
 
 	private:
-		void processSwapData();
+		//entity waiting for the decode of its mesh, the bounding box is not known before.
+		//the joint palette of its object is already in the scene and attached when the entity is added
+		struct PendingRenderEntity {
+			GObjectID				gobject_id;
+			MeshSourceDesc			mesh_source;
+			RenderEntity			entity;
+		};
+
+		/// upload the assets decoded since the last frame and add the entities that waited for them
+		void processLoadedAssets();
+		/// add the entity to the scene or update it, then attach the joint palette of its game object
+		void addOrUpdateRenderEntity(GObjectID gobject_id, const RenderEntity& entity);
+		void addPendingRenderEntity(
+			GObjectID				gobject_id,
+			const MeshSourceDesc&	mesh_source,
+			const RenderEntity&		entity
+		);
+		void removePendingRenderEntity(uint32_t instance_id);
 
-	private:
 		RENDER_PIPELINE_TYPE m_render_pipeline_type{ RENDER_PIPELINE_TYPE::DEFERRED_PIPELINE };
+		bool m_is_window_minimized{ false };
 		
 		RenderSwapContext m_swap_context;
 
@@ -73,5 +95,8 @@ namespace Dao {
 		std::shared_ptr<RenderScene> m_render_scene;
 		std::shared_ptr<RenderResourceBase> m_render_resource;
 		std::shared_ptr<RenderPipelineBase> m_render_pipeline;
+		std::shared_ptr<RenderAssetLoader> m_asset_loader;
+
+		std::vector<PendingRenderEntity> m_pending_render_entities;
 	};
 }
\ No newline at end of file
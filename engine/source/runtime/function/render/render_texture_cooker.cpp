@@ -0,0 +1,107 @@
+#include "runtime/function/render/render_texture_cooker.h"
+
+#include "runtime/function/render/render_texture_encoder.h"
+#include "runtime/platform/file_system/cooked_file.h"
+#include "runtime/platform/file_system/mapped_file.h"
+#include "runtime/core/base/macro.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Dao {
+
+	namespace {
+		const char* getUsageName(DAO_TEXTURE_USAGE usage) {
+			switch (usage) {
+			case DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_COLOR:
+				return "color";
+			case DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_LINEAR:
+				return "linear";
+			case DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_NORMAL:
+				return "normal";
+			case DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR:
+				return "hdr";
+			default:
+				return "unknown";
+			}
+		}
+
+		uint64_t getLevelsByteSize(RHIFormat format, uint32_t width, uint32_t height, uint32_t mip_levels) {
+			uint64_t size = 0;
+			for (uint32_t level = 0; level < mip_levels; ++level) {
+				size += GetTextureLevelByteSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+			}
+			return size;
+		}
+	}
+
+	std::filesystem::path RenderTextureCooker::getCookedPath(const std::filesystem::path& source_path, DAO_TEXTURE_USAGE usage) {
+		std::filesystem::path cooked_path = source_path;
+		cooked_path += ".";
+		cooked_path += getUsageName(usage);
+		cooked_path += ".dtex";
+		return cooked_path;
+	}
+
+	bool RenderTextureCooker::cook(const std::filesystem::path& cooked_path, int64_t source_write_time, DAO_TEXTURE_USAGE usage, const TextureData& texture) {
+		if (!texture.isValid()) {
+			return false;
+		}
+		CookedTextureHeader header{};
+		header.magic = s_magic;
+		header.version = s_version;
+		header.source_write_time = source_write_time;
+		header.format = static_cast<uint32_t>(texture.m_format);
+		header.usage = static_cast<uint32_t>(usage);
+		header.width = texture.m_width;
+		header.height = texture.m_height;
+		header.mip_levels = texture.m_mip_levels;
+		header.data_offset = (sizeof(CookedTextureHeader) + s_data_alignment - 1) & ~(s_data_alignment - 1);
+		header.data_size = getLevelsByteSize(texture.m_format, texture.m_width, texture.m_height, texture.m_mip_levels);
+		if (header.data_size == 0) {
+			return false;
+		}
+
+		return WriteCookedFile(cooked_path, {
+			{ 0, &header, sizeof(header) },
+			{ header.data_offset, texture.m_pixels, header.data_size }
+		});
+	}
+
+	std::shared_ptr<TextureData> RenderTextureCooker::load(const std::filesystem::path& cooked_path, int64_t source_write_time, DAO_TEXTURE_USAGE usage, bool is_compression_enabled) {
+		std::shared_ptr<MappedFile> mapped_file = std::make_shared<MappedFile>();
+		if (!mapped_file->open(cooked_path) || mapped_file->size() < sizeof(CookedTextureHeader)) {
+			return nullptr;
+		}
+
+		CookedTextureHeader header;
+		memcpy(&header, mapped_file->data(), sizeof(header));
+		if (header.magic != s_magic || header.version != s_version || header.source_write_time != source_write_time ||
+			header.usage != static_cast<uint32_t>(usage)) {
+			return nullptr;
+		}
+		const RHIFormat format = static_cast<RHIFormat>(header.format);
+		if (IsTextureFormatBlockCompressed(format) && !is_compression_enabled) {
+			return nullptr;
+		}
+		const uint64_t data_size = getLevelsByteSize(format, header.width, header.height, header.mip_levels);
+		if (data_size == 0 || data_size != header.data_size || header.data_offset % s_data_alignment != 0 ||
+			header.data_offset > mapped_file->size() || data_size > mapped_file->size() - header.data_offset) {
+			LOG_WARN("cooked texture {} is truncated", cooked_path.generic_string());
+			return nullptr;
+		}
+
+		std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
+		texture->m_width = header.width;
+		texture->m_height = header.height;
+		texture->m_depth = 1;
+		texture->m_array_layers = 1;
+		texture->m_mip_levels = header.mip_levels;
+		texture->m_format = format;
+		texture->m_type = DAO_IMAGE_TYPE::DAO_IMAGE_TYPE_2D;
+		//the pixels alias the mapping, the upload only reads from them
+		texture->m_pixels = static_cast<uint8_t*>(const_cast<void*>(mapped_file->data())) + header.data_offset;
+		texture->m_owner = mapped_file;
+		return texture;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "runtime/function/render/render_type.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace Dao {
+
+	/// layout of a cooked texture file, the levels follow each other from the largest one in the layout the gpu copies from
+	struct CookedTextureHeader {
+		uint32_t	magic;
+		uint32_t	version;
+		//last write time of the source file the texture was cooked from
+		int64_t		source_write_time;
+		//RHIFormat of the levels
+		uint32_t	format;
+		//DAO_TEXTURE_USAGE the texture was cooked for
+		uint32_t	usage;
+		uint32_t	width;
+		uint32_t	height;
+		uint32_t	mip_levels;
+		uint32_t	reserved;
+		uint64_t	data_offset;
+		uint64_t	data_size;
+	};
+
+	/// versioned binary container for encoded textures, cooked once from the png/jpg/hdr source and memory mapped afterwards
+	class RenderTextureCooker {
+	public:
+		static constexpr uint32_t s_magic = 0x58455444; //"DTEX"
+		static constexpr uint32_t s_version = 2;
+		static constexpr uint64_t s_data_alignment = 16;
+
+		/// the cooked file lives next to its source, one per usage the source is loaded with
+		static std::filesystem::path getCookedPath(const std::filesystem::path& source_path, DAO_TEXTURE_USAGE usage);
+
+		static bool cook(
+			const std::filesystem::path&	cooked_path,
+			int64_t							source_write_time,
+			DAO_TEXTURE_USAGE				usage,
+			const TextureData&				texture
+		);
+		/// map a cooked file, the pixels of the texture point into the mapping and keep it alive.
+		/// fails for missing files, other versions, files cooked from a different source write time
+		/// and block compressed files when is_compression_enabled is false
+		static std::shared_ptr<TextureData> load(
+			const std::filesystem::path&	cooked_path,
+			int64_t							source_write_time,
+			DAO_TEXTURE_USAGE				usage,
+			bool							is_compression_enabled
+		);
+	};
+}
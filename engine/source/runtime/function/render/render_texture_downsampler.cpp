@@ -0,0 +1,164 @@
+#include "runtime/function/render/render_texture_downsampler.h"
+
+#include "runtime/core/math/simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Dao {
+
+	namespace {
+		//radius in target texels, alpha trades main lobe width against side lobes
+		constexpr float s_kaiser_radius = 3.0f;
+		constexpr float s_kaiser_alpha = 4.0f;
+		constexpr float s_pi = 3.14159265358979f;
+
+		//the filter taps of every target texel along one axis, all texels have the same tap count
+		struct AxisTaps {
+			uint32_t				tap_count{ 0 };
+			std::vector<uint32_t>	indices;
+			std::vector<float>		weights;
+		};
+
+		//modified bessel function of the first kind, order zero
+		float besselI0(float x) {
+			const float half_x = x * 0.5f;
+			float sum = 1.0f;
+			float term = 1.0f;
+			for (int k = 1; k < 32; ++k) {
+				term *= half_x / static_cast<float>(k);
+				sum += term * term;
+				if (term * term < sum * 1e-9f) {
+					break;
+				}
+			}
+			return sum;
+		}
+
+		float kaiserSinc(float x) {
+			const float abs_x = std::fabs(x);
+			if (abs_x >= s_kaiser_radius) {
+				return 0.0f;
+			}
+			const float sinc = abs_x < 1e-6f ? 1.0f : std::sin(s_pi * x) / (s_pi * x);
+			const float t = x / s_kaiser_radius;
+			return sinc * besselI0(s_kaiser_alpha * std::sqrt(1.0f - t * t)) / besselI0(s_kaiser_alpha);
+		}
+
+		AxisTaps buildAxisTaps(uint32_t src_count, uint32_t dst_count, DAO_MIP_FILTER filter) {
+			const float scale = static_cast<float>(src_count) / static_cast<float>(dst_count);
+			const float support = (filter == DAO_MIP_FILTER::DAO_MIP_FILTER_BOX ? 0.5f : s_kaiser_radius) * scale;
+
+			AxisTaps taps;
+			taps.tap_count = static_cast<uint32_t>(std::ceil(support * 2.0f)) + 1;
+			taps.indices.resize(size_t(dst_count) * taps.tap_count);
+			taps.weights.resize(size_t(dst_count) * taps.tap_count);
+			for (uint32_t i = 0; i < dst_count; ++i) {
+				const float center = (static_cast<float>(i) + 0.5f) * scale;
+				const int32_t first = static_cast<int32_t>(std::floor(center - support));
+				float weight_sum = 0.0f;
+				for (uint32_t t = 0; t < taps.tap_count; ++t) {
+					const int32_t j = first + static_cast<int32_t>(t);
+					float weight;
+					if (filter == DAO_MIP_FILTER::DAO_MIP_FILTER_BOX) {
+						//overlap of the source texel [j, j + 1] with the target footprint
+						weight = std::max(0.0f, std::min(j + 1.0f, center + support) - std::max(static_cast<float>(j), center - support));
+					}
+					else {
+						weight = kaiserSinc((j + 0.5f - center) / scale);
+					}
+					const size_t tap = size_t(i) * taps.tap_count + t;
+					taps.indices[tap] = static_cast<uint32_t>(std::clamp(j, 0, static_cast<int32_t>(src_count) - 1));
+					taps.weights[tap] = weight;
+					weight_sum += weight;
+				}
+				for (uint32_t t = 0; t < taps.tap_count; ++t) {
+					taps.weights[size_t(i) * taps.tap_count + t] /= weight_sum;
+				}
+			}
+			return taps;
+		}
+
+		//weighted sum of rgba texels, texel k of the taps is at src + indices[k] * stride
+		inline void filterTexel(const float* src, size_t stride, const uint32_t* indices, const float* weights, uint32_t tap_count, float* out) {
+#if DAO_SIMD_X86
+			__m128 sum = _mm_setzero_ps();
+			for (uint32_t t = 0; t < tap_count; ++t) {
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(src + indices[t] * stride)));
+			}
+			_mm_storeu_ps(out, sum);
+#else
+			float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (uint32_t t = 0; t < tap_count; ++t) {
+				const float* texel = src + indices[t] * stride;
+				for (uint32_t c = 0; c < 4; ++c) {
+					sum[c] += weights[t] * texel[c];
+				}
+			}
+			for (uint32_t c = 0; c < 4; ++c) {
+				out[c] = sum[c];
+			}
+#endif
+		}
+
+		float srgbToLinear(float value) {
+			return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+
+		float linearToSrgb(float value) {
+			return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+		}
+
+		uint8_t quantize(float value) {
+			return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+		}
+	}
+
+	void DownsampleTextureLevel(const float* src, uint32_t src_width, uint32_t src_height, float* dst, DAO_MIP_FILTER filter) {
+		const uint32_t dst_width = std::max(src_width / 2, 1u);
+		const uint32_t dst_height = std::max(src_height / 2, 1u);
+		const AxisTaps horizontal_taps = buildAxisTaps(src_width, dst_width, filter);
+		const AxisTaps vertical_taps = buildAxisTaps(src_height, dst_height, filter);
+
+		//rows first into a src_height x dst_width level, then the columns of that
+		std::vector<float> rows(size_t(src_height) * dst_width * 4);
+		for (uint32_t y = 0; y < src_height; ++y) {
+			const float* src_row = src + size_t(y) * src_width * 4;
+			float* row = rows.data() + size_t(y) * dst_width * 4;
+			for (uint32_t x = 0; x < dst_width; ++x) {
+				const size_t tap = size_t(x) * horizontal_taps.tap_count;
+				filterTexel(src_row, 4, &horizontal_taps.indices[tap], &horizontal_taps.weights[tap], horizontal_taps.tap_count, row + size_t(x) * 4);
+			}
+		}
+		for (uint32_t y = 0; y < dst_height; ++y) {
+			const size_t tap = size_t(y) * vertical_taps.tap_count;
+			float* dst_row = dst + size_t(y) * dst_width * 4;
+			for (uint32_t x = 0; x < dst_width; ++x) {
+				filterTexel(rows.data() + size_t(x) * 4, size_t(dst_width) * 4, &vertical_taps.indices[tap], &vertical_taps.weights[tap], vertical_taps.tap_count, dst_row + size_t(x) * 4);
+			}
+		}
+	}
+
+	void ConvertTextureToLinear(const uint8_t* src, size_t texel_count, bool is_srgb, float* dst) {
+		//decoding is a table lookup, there are only 256 inputs
+		static const std::vector<float> s_srgb_to_linear = []() {
+			std::vector<float> table(256);
+			for (uint32_t i = 0; i < 256; ++i) {
+				table[i] = srgbToLinear(i / 255.0f);
+			}
+			return table;
+		}();
+		for (size_t i = 0; i < texel_count * 4; ++i) {
+			const bool is_color_channel = (i & 3) != 3;
+			dst[i] = (is_srgb && is_color_channel) ? s_srgb_to_linear[src[i]] : src[i] / 255.0f;
+		}
+	}
+
+	void ConvertTextureFromLinear(const float* src, size_t texel_count, bool is_srgb, uint8_t* dst) {
+		for (size_t i = 0; i < texel_count * 4; ++i) {
+			const bool is_color_channel = (i & 3) != 3;
+			dst[i] = quantize((is_srgb && is_color_channel) ? linearToSrgb(std::max(src[i], 0.0f)) : src[i]);
+		}
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Dao {
+
+	enum class DAO_MIP_FILTER : uint8_t {
+		DAO_MIP_FILTER_BOX = 0,	//average over the footprint of the target texel
+		DAO_MIP_FILTER_KAISER	//kaiser windowed sinc, sharper mips at the cost of slight ringing
+	};
+
+	/// resample a linear rgba32f level to max(width / 2, 1) x max(height / 2, 1) with a separable filter, edges are clamped
+	void DownsampleTextureLevel(const float* src, uint32_t src_width, uint32_t src_height, float* dst, DAO_MIP_FILTER filter);
+
+	/// rgba8 texels to linear floats, the color channels of srgb textures are decoded, alpha is always linear
+	void ConvertTextureToLinear(const uint8_t* src, size_t texel_count, bool is_srgb, float* dst);
+	/// linear floats back to rgba8 texels, values are clamped to [0, 1]
+	void ConvertTextureFromLinear(const float* src, size_t texel_count, bool is_srgb, uint8_t* dst);
+}
@@ -0,0 +1,246 @@
+#include "runtime/function/render/render_texture_encoder.h"
+
+#include "runtime/function/render/render_texture_downsampler.h"
+
+#include "runtime/core/base/macro.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+//the implementation expects memcpy and memset to be declared
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+namespace Dao {
+
+	namespace {
+		uint32_t getBlockCount(uint32_t size) {
+			return (size + 3) / 4;
+		}
+
+		uint16_t floatToHalf(float value) {
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			const uint32_t sign = (bits >> 16) & 0x8000;
+			const uint32_t float_exponent = (bits >> 23) & 0xff;
+			uint32_t mantissa = bits & 0x7fffff;
+			if (float_exponent == 0xff) {
+				//inf stays inf, nan stays nan
+				return static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+			}
+			const int32_t exponent = static_cast<int32_t>(float_exponent) - 127 + 15;
+			if (exponent >= 31) {
+				return static_cast<uint16_t>(sign | 0x7c00);
+			}
+			if (exponent <= 0) {
+				//subnormal half
+				if (exponent < -10) {
+					return static_cast<uint16_t>(sign);
+				}
+				mantissa |= 0x800000;
+				const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+				uint32_t half_mantissa = mantissa >> shift;
+				half_mantissa += (mantissa >> (shift - 1)) & 1;
+				return static_cast<uint16_t>(sign | half_mantissa);
+			}
+			//a rounding carry into the exponent is still the correctly rounded value
+			uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+			half += (mantissa >> 12) & 1;
+			return static_cast<uint16_t>(half);
+		}
+
+		//filtered normals are shorter than one, they are pushed back onto the unit sphere
+		void renormalizeNormals(float* texels, size_t texel_count) {
+			for (size_t i = 0; i < texel_count; ++i) {
+				float* texel = texels + i * 4;
+				const float x = texel[0] * 2.0f - 1.0f;
+				const float y = texel[1] * 2.0f - 1.0f;
+				const float z = texel[2] * 2.0f - 1.0f;
+				const float length = std::sqrt(x * x + y * y + z * z);
+				if (length < 1e-6f) {
+					continue;
+				}
+				texel[0] = (x / length) * 0.5f + 0.5f;
+				texel[1] = (y / length) * 0.5f + 0.5f;
+				texel[2] = (z / length) * 0.5f + 0.5f;
+			}
+		}
+
+		void encodeLevelBlocks(const uint8_t* pixels, uint32_t width, uint32_t height, RHIFormat format, uint8_t* out_blocks) {
+			const uint32_t block_count_x = getBlockCount(width);
+			const uint32_t block_count_y = getBlockCount(height);
+			const size_t block_size = (format == RHI_FORMAT_BC3_SRGB_BLOCK || format == RHI_FORMAT_BC3_UNORM_BLOCK || format == RHI_FORMAT_BC5_UNORM_BLOCK) ? 16 : 8;
+			uint8_t block_rgba[16 * 4];
+			uint8_t block_rg[16 * 2];
+			for (uint32_t block_y = 0; block_y < block_count_y; ++block_y) {
+				for (uint32_t block_x = 0; block_x < block_count_x; ++block_x) {
+					//blocks over the edge repeat the last texel
+					for (uint32_t i = 0; i < 16; ++i) {
+						const uint32_t x = std::min(block_x * 4 + (i & 3), width - 1);
+						const uint32_t y = std::min(block_y * 4 + (i >> 2), height - 1);
+						memcpy(block_rgba + i * 4, pixels + (size_t(y) * width + x) * 4, 4);
+						block_rg[i * 2 + 0] = block_rgba[i * 4 + 0];
+						block_rg[i * 2 + 1] = block_rgba[i * 4 + 1];
+					}
+					uint8_t* out_block = out_blocks + (size_t(block_y) * block_count_x + block_x) * block_size;
+					switch (format) {
+					case RHI_FORMAT_BC1_RGB_UNORM_BLOCK:
+					case RHI_FORMAT_BC1_RGB_SRGB_BLOCK:
+						stb_compress_dxt_block(out_block, block_rgba, 0, STB_DXT_HIGHQUAL);
+						break;
+					case RHI_FORMAT_BC3_UNORM_BLOCK:
+					case RHI_FORMAT_BC3_SRGB_BLOCK:
+						stb_compress_dxt_block(out_block, block_rgba, 1, STB_DXT_HIGHQUAL);
+						break;
+					case RHI_FORMAT_BC5_UNORM_BLOCK:
+						stb_compress_bc5_block(out_block, block_rg);
+						break;
+					default:
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	size_t GetTextureLevelByteSize(RHIFormat format, uint32_t width, uint32_t height) {
+		switch (format) {
+		case RHI_FORMAT_R8G8B8A8_UNORM:
+		case RHI_FORMAT_R8G8B8A8_SRGB:
+			return size_t(width) * height * 4;
+		case RHI_FORMAT_R16G16B16A16_SFLOAT:
+			return size_t(width) * height * 8;
+		case RHI_FORMAT_R32G32B32A32_SFLOAT:
+			return size_t(width) * height * 16;
+		case RHI_FORMAT_BC1_RGB_UNORM_BLOCK:
+		case RHI_FORMAT_BC1_RGB_SRGB_BLOCK:
+			return size_t(getBlockCount(width)) * getBlockCount(height) * 8;
+		case RHI_FORMAT_BC3_UNORM_BLOCK:
+		case RHI_FORMAT_BC3_SRGB_BLOCK:
+		case RHI_FORMAT_BC5_UNORM_BLOCK:
+			return size_t(getBlockCount(width)) * getBlockCount(height) * 16;
+		default:
+			return 0;
+		}
+	}
+
+	uint32_t GetTextureMipLevelCount(uint32_t width, uint32_t height) {
+		uint32_t mip_levels = 1;
+		while ((width >> mip_levels) > 0 || (height >> mip_levels) > 0) {
+			++mip_levels;
+		}
+		return mip_levels;
+	}
+
+	bool IsTextureFormatBlockCompressed(RHIFormat format) {
+		return format >= RHI_FORMAT_BC1_RGB_UNORM_BLOCK && format <= RHI_FORMAT_BC7_SRGB_BLOCK;
+	}
+
+	RHIFormat GetCookedTextureFormat(DAO_TEXTURE_USAGE usage, bool has_alpha, bool is_compression_enabled) {
+		switch (usage) {
+		case DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_COLOR:
+			if (!is_compression_enabled) {
+				return RHI_FORMAT_R8G8B8A8_SRGB;
+			}
+			return has_alpha ? RHI_FORMAT_BC3_SRGB_BLOCK : RHI_FORMAT_BC1_RGB_SRGB_BLOCK;
+		case DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_LINEAR:
+			if (!is_compression_enabled) {
+				return RHI_FORMAT_R8G8B8A8_UNORM;
+			}
+			return has_alpha ? RHI_FORMAT_BC3_UNORM_BLOCK : RHI_FORMAT_BC1_RGB_UNORM_BLOCK;
+		case DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_NORMAL:
+			return is_compression_enabled ? RHI_FORMAT_BC5_UNORM_BLOCK : RHI_FORMAT_R8G8B8A8_UNORM;
+		case DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR:
+			return RHI_FORMAT_R16G16B16A16_SFLOAT;
+		default:
+			return RHI_FORMAT_MAX_ENUM;
+		}
+	}
+
+	std::shared_ptr<TextureData> EncodeTexture(const TextureData& source, DAO_TEXTURE_USAGE usage, bool is_compression_enabled) {
+		if (!source.isValid() || source.m_width == 0 || source.m_height == 0) {
+			return nullptr;
+		}
+		const bool is_hdr = usage == DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_HDR;
+		if (is_hdr && source.m_format != RHI_FORMAT_R32G32B32A32_SFLOAT) {
+			LOG_ERROR("hdr textures have to be decoded as rgba32f");
+			return nullptr;
+		}
+		if (!is_hdr && source.m_format != RHI_FORMAT_R8G8B8A8_UNORM && source.m_format != RHI_FORMAT_R8G8B8A8_SRGB) {
+			LOG_ERROR("ldr textures have to be decoded as rgba8");
+			return nullptr;
+		}
+
+		//mips are filtered in linear space, srgb colors are decoded first
+		const bool is_srgb = usage == DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_COLOR;
+		const size_t texel_count = size_t(source.m_width) * source.m_height;
+		std::vector<float> level_texels(texel_count * 4);
+		bool has_alpha = false;
+		if (is_hdr) {
+			memcpy(level_texels.data(), source.m_pixels, texel_count * 4 * sizeof(float));
+		}
+		else {
+			const uint8_t* src_pixels = static_cast<const uint8_t*>(source.m_pixels);
+			for (size_t i = 0; i < texel_count && !has_alpha; ++i) {
+				has_alpha = src_pixels[i * 4 + 3] != 255;
+			}
+			ConvertTextureToLinear(src_pixels, texel_count, is_srgb, level_texels.data());
+		}
+
+		std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
+		texture->m_width = source.m_width;
+		texture->m_height = source.m_height;
+		texture->m_depth = 1;
+		texture->m_array_layers = 1;
+		texture->m_type = DAO_IMAGE_TYPE::DAO_IMAGE_TYPE_2D;
+		texture->m_format = GetCookedTextureFormat(usage, has_alpha, is_compression_enabled);
+		texture->m_mip_levels = GetTextureMipLevelCount(source.m_width, source.m_height);
+
+		size_t total_size = 0;
+		for (uint32_t level = 0; level < texture->m_mip_levels; ++level) {
+			total_size += GetTextureLevelByteSize(texture->m_format, std::max(source.m_width >> level, 1u), std::max(source.m_height >> level, 1u));
+		}
+		texture->m_pixels = malloc(total_size);
+
+		//the sinc lobes ring around very bright texels such as the sun of a sky, hdr maps are box filtered
+		const DAO_MIP_FILTER filter = is_hdr ? DAO_MIP_FILTER::DAO_MIP_FILTER_BOX : DAO_MIP_FILTER::DAO_MIP_FILTER_KAISER;
+		std::vector<float> next_level_texels;
+		std::vector<uint8_t> level_pixels;
+		uint8_t* dst = static_cast<uint8_t*>(texture->m_pixels);
+		for (uint32_t level = 0; level < texture->m_mip_levels; ++level) {
+			const uint32_t width = std::max(source.m_width >> level, 1u);
+			const uint32_t height = std::max(source.m_height >> level, 1u);
+			const size_t level_texel_count = size_t(width) * height;
+			if (is_hdr) {
+				uint16_t* dst_values = reinterpret_cast<uint16_t*>(dst);
+				for (size_t i = 0; i < level_texel_count * 4; ++i) {
+					dst_values[i] = floatToHalf(level_texels[i]);
+				}
+			}
+			else {
+				level_pixels.resize(level_texel_count * 4);
+				ConvertTextureFromLinear(level_texels.data(), level_texel_count, is_srgb, level_pixels.data());
+				if (IsTextureFormatBlockCompressed(texture->m_format)) {
+					encodeLevelBlocks(level_pixels.data(), width, height, texture->m_format, dst);
+				}
+				else {
+					memcpy(dst, level_pixels.data(), level_pixels.size());
+				}
+			}
+			dst += GetTextureLevelByteSize(texture->m_format, width, height);
+
+			if (level + 1 < texture->m_mip_levels) {
+				const size_t next_texel_count = size_t(std::max(width / 2, 1u)) * std::max(height / 2, 1u);
+				next_level_texels.resize(next_texel_count * 4);
+				DownsampleTextureLevel(level_texels.data(), width, height, next_level_texels.data(), filter);
+				if (usage == DAO_TEXTURE_USAGE::DAO_TEXTURE_USAGE_NORMAL) {
+					renormalizeNormals(next_level_texels.data(), next_texel_count);
+				}
+				level_texels.swap(next_level_texels);
+			}
+		}
+		return texture;
+	}
+}
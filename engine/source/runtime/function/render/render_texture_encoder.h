@@ -0,0 +1,26 @@
+#pragma once
+
+#include "runtime/function/render/render_type.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Dao {
+
+	/// byte size of one mip level, block compressed levels are padded to whole 4x4 blocks
+	/// @return: 0 for formats the texture cooker does not produce
+	size_t GetTextureLevelByteSize(RHIFormat format, uint32_t width, uint32_t height);
+	/// number of levels of a full mip chain down to 1x1
+	uint32_t GetTextureMipLevelCount(uint32_t width, uint32_t height);
+	bool IsTextureFormatBlockCompressed(RHIFormat format);
+
+	/// color textures become BC1, or BC3 when they have alpha, linear ones BC1 and normal maps BC5.
+	/// without block compression support they stay 8 bit per channel, hdr textures are stored as half floats
+	RHIFormat GetCookedTextureFormat(DAO_TEXTURE_USAGE usage, bool has_alpha, bool is_compression_enabled);
+
+	/// encode a decoded texture, rgba8 or rgba32f for hdr usage, into the format of its usage.
+	/// the full mip chain is filtered in linear space and packed into m_pixels
+	/// @return: nullptr for unsupported sources
+	std::shared_ptr<TextureData> EncodeTexture(const TextureData& source, DAO_TEXTURE_USAGE usage, bool is_compression_enabled);
+}
@@ -15,6 +15,15 @@ namespace Dao
         DAO_IMAGE_TYPE_2D
     };
 
+    // decides the format a texture is cooked into
+    enum class DAO_TEXTURE_USAGE : uint8_t
+    {
+        DAO_TEXTURE_USAGE_COLOR = 0, // srgb color, alpha is kept when the source has one
+        DAO_TEXTURE_USAGE_LINEAR,    // linear color or packed material parameters
+        DAO_TEXTURE_USAGE_NORMAL,    // tangent space normal, only xy are stored
+        DAO_TEXTURE_USAGE_HDR        // float color
+    };
+
     enum class RENDER_PIPELINE_TYPE : uint8_t
     {
         FORWARD_PIPELINE = 0,
@@ -27,6 +36,8 @@ namespace Dao
     public:
         size_t m_size{ 0 };
         void* m_data{ nullptr };
+        // set for views into memory the buffer does not own, e.g. a mapped cooked file kept alive by the owner
+        std::shared_ptr<const void> m_owner;
 
         BufferData() = delete;
         BufferData(size_t size)
@@ -34,9 +45,15 @@ namespace Dao
             m_size = size;
             m_data = malloc(size);
         }
+        BufferData(void* data, size_t size, std::shared_ptr<const void> owner)
+        {
+            m_size = size;
+            m_data = data;
+            m_owner = std::move(owner);
+        }
         ~BufferData()
         {
-            if (m_data)
+            if (m_data && !m_owner)
             {
                 free(m_data);
             }
@@ -52,7 +69,10 @@ namespace Dao
         uint32_t m_depth{ 0 };
         uint32_t m_mip_levels{ 0 };
         uint32_t m_array_layers{ 0 };
+        // holds m_mip_levels levels packed one after another, starting with the largest one
         void* m_pixels{ nullptr };
+        // set when m_pixels points into memory owned by someone else, e.g. a mapped cooked file
+        std::shared_ptr<const void> m_owner;
 
         RHIFormat m_format = RHI_FORMAT_MAX_ENUM;
         DAO_IMAGE_TYPE   m_type{ DAO_IMAGE_TYPE::DAO_IMAGE_TYPE_UNKNOWN };
@@ -60,7 +80,7 @@ namespace Dao
         TextureData() = default;
         ~TextureData()
         {
-            if (m_pixels)
+            if (m_pixels && !m_owner)
             {
                 free(m_pixels);
             }
@@ -131,8 +151,15 @@ namespace Dao
     {
         std::shared_ptr<BufferData> m_vertex_buffer;
         std::shared_ptr<BufferData> m_index_buffer;
+        // meshes with more than 65535 vertices use 32 bit indices
+        RHIIndexType                m_index_type{ RHI_INDEX_TYPE_UINT16 };
     };
 
+    inline uint32_t getIndexStride(RHIIndexType index_type)
+    {
+        return index_type == RHI_INDEX_TYPE_UINT32 ? sizeof(uint32_t) : sizeof(uint16_t);
+    }
+
     struct RenderMeshData
     {
         StaticMeshData              m_static_mesh_data;
@@ -5,11 +5,23 @@
 namespace Dao {
 
 	WindowSystem::~WindowSystem() {
+		if (_is_headless) {
+			return;
+		}
 		glfwDestroyWindow(_window);
 		glfwTerminate();
 	}
 
 	void WindowSystem::initialize(WindowCreateInfo create_info) {
+		if (create_info.headless) {
+			_is_headless = true;
+			_width = create_info.width;
+			_height = create_info.height;
+			_framebuffer_width = create_info.width;
+			_framebuffer_height = create_info.height;
+			LOG_INFO("window system running headless");
+			return;
+		}
 		if (!glfwInit()) {
 			LOG_FATAL("failed to initialize GLFW");
 			return;
@@ -23,6 +35,7 @@ namespace Dao {
 			glfwTerminate();
 			return;
 		}
+		glfwGetFramebufferSize(_window, &_framebuffer_width, &_framebuffer_height);
 		glfwSetWindowUserPointer(_window, this);
 		glfwSetKeyCallback(_window, keyCallback);
 		glfwSetCharCallback(_window, charCallBack);
@@ -33,19 +46,44 @@ namespace Dao {
 		glfwSetScrollCallback(_window, scrollCallBack);
 		glfwSetDropCallback(_window, dropCallBack);
 		glfwSetWindowSizeCallback(_window, windowSizeCallBack);
+		glfwSetFramebufferSizeCallback(_window, framebufferSizeCallback);
+		glfwSetWindowIconifyCallback(_window, windowIconifyCallback);
 		glfwSetWindowCloseCallback(_window, windowCloseCallback);
 		glfwSetInputMode(_window, GLFW_RAW_MOUSE_MOTION, GLFW_FALSE);
 	}
 
 	void WindowSystem::pollEvents() const { 
+		if (_is_headless) {
+			return;
+		}
 		glfwPollEvents();
 	}
 
+	void WindowSystem::waitEvents() const {
+		if (_is_headless) {
+			return;
+		}
+		glfwWaitEvents();
+	}
+
 	bool WindowSystem::shouldClose() const {
+		if (_is_headless) {
+			return _should_close;
+		}
 		return glfwWindowShouldClose(_window);
 	}
 
+	void WindowSystem::setShouldClose(bool should_close) {
+		_should_close = should_close;
+		if (!_is_headless) {
+			glfwSetWindowShouldClose(_window, should_close);
+		}
+	}
+
 	void WindowSystem::setTitle(const char* title) {
+		if (_is_headless) {
+			return;
+		}
 		glfwSetWindowTitle(_window, title);
 	}
 
@@ -57,8 +95,15 @@ namespace Dao {
 		return std::array<int, 2>({ _width,_height });
 	}
 
+	std::array<int, 2> WindowSystem::getFramebufferSize() const {
+		return std::array<int, 2>({ _framebuffer_width,_framebuffer_height });
+	}
+
 	void WindowSystem::setFocusMode(bool mode) {
 		_is_focus_mode = mode;
+		if (_is_headless) {
+			return;
+		}
 		glfwSetInputMode(
 			_window, GLFW_CURSOR, 
 			_is_focus_mode ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL
@@ -14,6 +14,8 @@ namespace Dao {
 		int height{ 720 };
 		const char* title{ "Dao" };
 		bool fullscreen{ false };
+		// no glfw window is created, the render system falls back to the null rhi
+		bool headless{ false };
 	};
 
 	class WindowSystem {
@@ -22,10 +24,17 @@ namespace Dao {
 		~WindowSystem();
 		void initialize(WindowCreateInfo create_info);
 		void pollEvents() const;
+		// blocks until an event arrives, main thread only like pollEvents
+		void waitEvents() const;
 		bool shouldClose() const;
 		void setTitle(const char* title);
 		GLFWwindow* getWindow() const;
 		std::array<int, 2> getWindowSize() const;
+		// size in pixels and iconify state, updated by pollEvents. the render thread must not query glfw itself
+		std::array<int, 2> getFramebufferSize() const;
+		bool isMinimized() const { return _is_minimized; }
+		bool isHeadless() const { return _is_headless; }
+		void setShouldClose(bool should_close);
 
 		typedef std::function<void()>					onResetFunc;
 		typedef std::function<void(int, int, int, int)> onKeyFunc;
@@ -52,7 +61,7 @@ namespace Dao {
 		void registerOnWindowCloseFunc(onWindowCloseFunc func) { _onWindowCloseFunc.push_back(func); }
 
 		bool isMouseButtonDown(int button) const {
-			if (button<GLFW_MOUSE_BUTTON_1 || button>GLFW_MOUSE_BUTTON_LAST) {
+			if (button<GLFW_MOUSE_BUTTON_1 || button>GLFW_MOUSE_BUTTON_LAST || _window == nullptr) {
 				return false;
 			}
 			return glfwGetMouseButton(_window, button) == GLFW_PRESS;
@@ -192,6 +201,21 @@ namespace Dao {
 			}
 		}
 
+		static void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+			WindowSystem* app_window = (WindowSystem*)glfwGetWindowUserPointer(window);
+			if (app_window) {
+				app_window->_framebuffer_width = width;
+				app_window->_framebuffer_height = height;
+			}
+		}
+
+		static void windowIconifyCallback(GLFWwindow* window, int iconified) {
+			WindowSystem* app_window = (WindowSystem*)glfwGetWindowUserPointer(window);
+			if (app_window) {
+				app_window->_is_minimized = iconified == GLFW_TRUE;
+			}
+		}
+
 		static void windowCloseCallback(GLFWwindow* window) {
 			glfwSetWindowShouldClose(window, true);
 		}
@@ -200,7 +224,12 @@ namespace Dao {
 		GLFWwindow* _window{ nullptr };
 		int _width{ 0 };
 		int _height{ 0 };
+		int _framebuffer_width{ 0 };
+		int _framebuffer_height{ 0 };
+		bool _is_minimized{ false };
 		bool _is_focus_mode{ false };
+		bool _is_headless{ false };
+		bool _should_close{ false };
 
 		std::vector<onResetFunc>			_onResetFunc;
 		std::vector<onKeyFunc>				_onKeyFunc;
@@ -0,0 +1,98 @@
+#include "runtime/platform/file_system/cooked_file.h"
+
+#include "runtime/core/base/macro.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace Dao {
+
+	namespace {
+		std::atomic<uint64_t> s_temp_file_counter{ 0 };
+
+		std::mutex						s_cooking_mutex;
+		std::set<std::filesystem::path>	s_cooking_paths;
+
+		//temporary file next to a cooked file, unique for every call so concurrent writers never share one
+		std::filesystem::path getUniqueCookTempPath(const std::filesystem::path& cooked_path) {
+			std::filesystem::path temp_path = cooked_path;
+			temp_path += ".";
+			temp_path += std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+			temp_path += ".";
+			temp_path += std::to_string(s_temp_file_counter.fetch_add(1, std::memory_order_relaxed));
+			temp_path += ".tmp";
+			return temp_path;
+		}
+
+		//move a fully written temporary file over the cooked file, the temporary file is removed on failure
+		bool commitCookTempFile(const std::filesystem::path& temp_path, const std::filesystem::path& cooked_path) {
+			std::error_code error;
+			std::filesystem::rename(temp_path, cooked_path, error);
+			if (error) {
+				std::filesystem::remove(temp_path, error);
+				return false;
+			}
+			return true;
+		}
+	}
+
+	int64_t GetCookSourceWriteTime(const std::filesystem::path& source_path) {
+		std::error_code error;
+		std::filesystem::file_time_type write_time = std::filesystem::last_write_time(source_path, error);
+		if (error) {
+			return 0;
+		}
+		return static_cast<int64_t>(write_time.time_since_epoch().count());
+	}
+
+	bool WriteCookedFile(const std::filesystem::path& cooked_path, const std::vector<CookedFileChunk>& chunks) {
+		const std::filesystem::path temp_path = getUniqueCookTempPath(cooked_path);
+		bool is_written = false;
+		{
+			std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+			if (!file) {
+				LOG_WARN("write cooked file {} failed, can not open {}", cooked_path.generic_string(), temp_path.generic_string());
+				return false;
+			}
+			static const char zeros[64] = {};
+			uint64_t offset = 0;
+			for (const CookedFileChunk& chunk : chunks) {
+				ASSERT(chunk.offset >= offset);
+				while (offset < chunk.offset) {
+					const uint64_t padding_size = std::min<uint64_t>(chunk.offset - offset, sizeof(zeros));
+					file.write(zeros, static_cast<std::streamsize>(padding_size));
+					offset += padding_size;
+				}
+				file.write(static_cast<const char*>(chunk.data), static_cast<std::streamsize>(chunk.size));
+				offset += chunk.size;
+			}
+			is_written = static_cast<bool>(file);
+		}
+		if (!is_written) {
+			LOG_WARN("write cooked file {} failed", cooked_path.generic_string());
+			std::error_code error;
+			std::filesystem::remove(temp_path, error);
+			return false;
+		}
+		return commitCookTempFile(temp_path, cooked_path);
+	}
+
+	CookedFileLock::CookedFileLock(const std::filesystem::path& cooked_path) : _cooked_path(cooked_path) {
+		std::lock_guard<std::mutex> lock(s_cooking_mutex);
+		_owns_lock = s_cooking_paths.insert(_cooked_path).second;
+	}
+
+	CookedFileLock::~CookedFileLock() {
+		if (_owns_lock) {
+			std::lock_guard<std::mutex> lock(s_cooking_mutex);
+			s_cooking_paths.erase(_cooked_path);
+		}
+	}
+}
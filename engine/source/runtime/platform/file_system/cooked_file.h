@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace Dao {
+
+	/// @return: last write time of a cook source in the encoding stored by cooked headers, 0 if the file is missing
+	int64_t GetCookSourceWriteTime(const std::filesystem::path& source_path);
+	/// bytes placed at an offset of a cooked file, the gap before the offset is zero filled
+	struct CookedFileChunk {
+		uint64_t	offset;
+		const void*	data;
+		uint64_t	size;
+	};
+	/// write the chunks, sorted by offset, to a temporary file of this writer and move it over the cooked file,
+	/// so a reader never sees a half written file
+	bool WriteCookedFile(const std::filesystem::path& cooked_path, const std::vector<CookedFileChunk>& chunks);
+
+	/// claims the cook of one cooked file across threads without blocking. a second thread asking for a file
+	/// that is being cooked does not own the lock, it should retry later or go on without cooking the file
+	class CookedFileLock {
+	public:
+		explicit CookedFileLock(const std::filesystem::path& cooked_path);
+		~CookedFileLock();
+		CookedFileLock(const CookedFileLock&) = delete;
+		CookedFileLock& operator=(const CookedFileLock&) = delete;
+
+		bool ownsLock() const { return _owns_lock; }
+
+	private:
+		std::filesystem::path	_cooked_path;
+		bool					_owns_lock{ false };
+	};
+}
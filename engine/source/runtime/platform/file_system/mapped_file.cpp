@@ -0,0 +1,97 @@
+#include "runtime/platform/file_system/mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Dao {
+
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+#if defined(_WIN32)
+	bool MappedFile::open(const std::filesystem::path& file_path) {
+		close();
+		HANDLE file_handle = CreateFileW(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file_handle == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0) {
+			CloseHandle(file_handle);
+			return false;
+		}
+		HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping_handle) {
+			CloseHandle(file_handle);
+			return false;
+		}
+		void* data = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+		if (!data) {
+			CloseHandle(mapping_handle);
+			CloseHandle(file_handle);
+			return false;
+		}
+		_file_handle = file_handle;
+		_mapping_handle = mapping_handle;
+		_data = data;
+		_size = static_cast<size_t>(file_size.QuadPart);
+		return true;
+	}
+
+	void MappedFile::close() {
+		if (_data) {
+			UnmapViewOfFile(_data);
+		}
+		if (_mapping_handle) {
+			CloseHandle(_mapping_handle);
+		}
+		if (_file_handle) {
+			CloseHandle(_file_handle);
+		}
+		_data = nullptr;
+		_size = 0;
+		_mapping_handle = nullptr;
+		_file_handle = nullptr;
+	}
+#else
+	bool MappedFile::open(const std::filesystem::path& file_path) {
+		close();
+		int file_descriptor = ::open(file_path.c_str(), O_RDONLY);
+		if (file_descriptor < 0) {
+			return false;
+		}
+		struct stat file_stat;
+		if (fstat(file_descriptor, &file_stat) != 0 || file_stat.st_size == 0) {
+			::close(file_descriptor);
+			return false;
+		}
+		void* data = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+		//the mapping keeps the file referenced on its own
+		::close(file_descriptor);
+		if (data == MAP_FAILED) {
+			return false;
+		}
+		_data = data;
+		_size = static_cast<size_t>(file_stat.st_size);
+		return true;
+	}
+
+	void MappedFile::close() {
+		if (_data) {
+			munmap(_data, _size);
+		}
+		_data = nullptr;
+		_size = 0;
+	}
+#endif
+}
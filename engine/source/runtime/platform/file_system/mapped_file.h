@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace Dao {
+
+	/// read only view of a whole file mapped into the address space, pages are loaded by the os on first access
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool open(const std::filesystem::path& file_path);
+		void close();
+
+		bool isOpen() const { return _data != nullptr; }
+		const void* data() const { return _data; }
+		size_t size() const { return _size; }
+
+	private:
+		void*	_data{ nullptr };
+		size_t	_size{ 0 };
+#if defined(_WIN32)
+		void*	_file_handle{ nullptr };
+		void*	_mapping_handle{ nullptr };
+#endif
+	};
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <string>
 
 namespace Dao {
 
@@ -14,6 +16,11 @@ namespace Dao {
 		const std::string& getDefaultWorldUrl() const { return _default_world_url; }
 		const std::string& getGlobalRenderingResUrl() const { return _global_rendering_res_url; }
 		const std::string& getGlobalParticleResUrl() const { return _global_particle_res_url; }
+		bool isHeadless() const { return _is_headless; }
+		bool isPipelinedRendering() const { return _is_pipelined_rendering; }
+		uint32_t getMaxFrameLatency() const { return _max_frame_latency; }
+		// frames a headless run ticks before it stops, 0 runs until shutdown is requested
+		uint32_t getHeadlessFrameCount() const { return _headless_frame_count; }
 
 	private:
 		std::filesystem::path _root_folder;
@@ -23,5 +30,10 @@ namespace Dao {
 		std::string _default_world_url;
 		std::string _global_rendering_res_url;
 		std::string _global_particle_res_url;
+
+		bool _is_headless{ false };
+		bool _is_pipelined_rendering{ false };
+		uint32_t _max_frame_latency{ 1 };
+		uint32_t _headless_frame_count{ 0 };
 	};
 }
\ No newline at end of file
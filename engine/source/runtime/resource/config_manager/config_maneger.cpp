@@ -1,5 +1,6 @@
 #include "runtime/resource/config_manager/config_manager.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <string>
@@ -32,6 +33,18 @@ namespace Dao {
                 else if (name == "GlobalParticleRes") {
                     _global_particle_res_url = value;
                 }
+                else if (name == "Headless") {
+                    _is_headless = (value == "true" || value == "1");
+                }
+                else if (name == "PipelinedRendering") {
+                    _is_pipelined_rendering = (value == "true" || value == "1");
+                }
+                else if (name == "MaxFrameLatency") {
+                    _max_frame_latency = static_cast<uint32_t>(std::max(1, std::stoi(value)));
+                }
+                else if (name == "HeadlessFrameCount") {
+                    _headless_frame_count = static_cast<uint32_t>(std::max(0, std::stoi(value)));
+                }
             }
         }
     }
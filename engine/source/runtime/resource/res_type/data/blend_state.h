@@ -9,26 +9,6 @@
 
 namespace Dao {
 
-    REFLECTION_TYPE(BoneBlendWeight);
-    CLASS(BoneBlendWeight, Fields)
-    {
-        REFLECTION_BODY(BoneBlendWeight);
-    public:
-        std::vector<float> blend_weight;
-    };
-
-    REFLECTION_TYPE(BlendStateWithClipData);
-    CLASS(BlendStateWithClipData, Fields)
-    {
-        REFLECTION_BODY(BlendStateWithClipData);
-    public:
-        int                          m_clip_count;
-        std::vector<AnimationClip>   m_blend_clip;
-        std::vector<AnimSkelMap>     m_blend_anim_skel_map;
-        std::vector<BoneBlendWeight> m_blend_weight;
-        std::vector<float>           m_blend_ratio;
-    };
-
     REFLECTION_TYPE(BlendState);
     CLASS(BlendState, Fields)
     {